@@ -0,0 +1,228 @@
+/*
+    Core micro-benchmarks
+
+    Times the hot paths of the C core on the host and counts the app-heap
+    traffic each one causes:
+
+    - storing the 12-hour HOUR_DATA blob, formatting a page from it, and
+      unpacking the precipitation package
+    - resource selection (init/deinit of the per-forecast icon sets)
+    - kimaybe slice preparation (km_make_transformation_kmanimation + dispose)
+    - kimaybe per-frame updates, stepped on the virtual clock
+    - the same resource selection and slice preparation out of the arenas
+      the viewer and image_animation give them, with each arena's peak
+
+    Wall times are host nanoseconds and only meaningful relative to each other;
+    allocation counts and bytes match what the watch would see.
+*/
+
+#include <pebble_host.h>
+
+#include "utils/forecast.h"
+#include "utils/msgproc.h"
+#include "utils/prefs.h"
+#include "utils/weather.h"
+#include "gfx/resources.h"
+#include "gfx/kimaybe/transform.h"
+#include "gfx/animation/image_animation.h"
+
+#include "bench_fixtures.h"
+#include "bench_runner.h"
+
+// ── Unpacking ─────────────────────────────────────────────────────────────────
+
+static void prv_set_hour_data(void* context) {
+  forecast_set_hour_data(s_hour_data);
+}
+
+static void prv_format_airflow(void* context) {
+  static char s_text[MAX_STRING_LENGTH];
+  static uint8_t s_hour;
+  format_hour_airflow(forecast_data, s_hour, s_text);
+  s_hour = (s_hour + 1) % 12;
+}
+
+static void prv_unpack_precipitation(void* context) {
+  unpack_precipitation(s_precipitation_package, &precipitation);
+}
+
+// ── Resource selection ────────────────────────────────────────────────────────
+
+static void prv_condition_images(void* context) {
+  deinit_25px_condition_images(init_25px_condition_images());
+  deinit_50px_condition_images(init_50px_condition_images());
+}
+
+static void prv_airflow_images(void* context) {
+  deinit_wind_vane_images(init_wind_vane_images());
+  deinit_wind_speed_images(init_wind_speed_images());
+}
+
+static void prv_experiential_images(void* context) {
+  deinit_25px_experiential_images(init_25px_experiential_images());
+  deinit_50px_experiential_images(init_50px_experiential_images());
+}
+
+// A viewer window's worth: every page's sets, freed in the viewer's order
+static void prv_window_images(void* context) {
+  Arena* arena = context;
+  GDrawCommandImage** condition_25px = init_25px_condition_images();
+  GDrawCommandImage** condition_50px = init_50px_condition_images();
+  GDrawCommandImage** wind_vane = init_wind_vane_images();
+  GDrawCommandImage** wind_speed = init_wind_speed_images();
+  GDrawCommandImage** experiential_25px = init_25px_experiential_images();
+  GDrawCommandImage** experiential_50px = init_50px_experiential_images();
+  deinit_25px_condition_images(condition_25px);
+  deinit_50px_condition_images(condition_50px);
+  deinit_wind_vane_images(wind_vane);
+  deinit_wind_speed_images(wind_speed);
+  deinit_25px_experiential_images(experiential_25px);
+  deinit_50px_experiential_images(experiential_50px);
+  if (arena) {
+    arena_reset(arena);
+  }
+}
+
+static void prv_print_arena(const Arena* arena) {
+  ArenaStats stats = arena_get_stats(arena);
+  printf("%-32s peak %zu of %zu bytes, %u overflows\n", "  arena", stats.peak, stats.capacity,
+         (unsigned)stats.overflows);
+}
+
+static void prv_bench_window_images(uint32_t iterations) {
+  prv_run("window images, heap", iterations, prv_window_images, NULL);
+
+  Arena arena;
+  arena_init(&arena, RESOURCES_ARENA_SIZE);
+  resources_set_arena(&arena);
+  prv_run("window images, arena", iterations, prv_window_images, &arena);
+  prv_print_arena(&arena);
+  resources_set_arena(NULL);
+  arena_deinit(&arena);
+}
+
+// ── kimaybe ───────────────────────────────────────────────────────────────────
+
+typedef struct KmFixture {
+  Layer* layer;
+  GDrawCommandImage* source;
+  GDrawCommandImage* image;
+  Arena* arena;
+  uint32_t frames;
+  uint32_t points;
+} KmFixture;
+
+static const GRect KM_FROM = {{0, 0}, {25, 25}};
+static const GRect KM_TO = {{40, 40}, {50, 50}};
+
+static uint32_t prv_count_points(GDrawCommandImage* image) {
+  GDrawCommandList* list = gdraw_command_image_get_command_list(image);
+  uint32_t points = 0;
+  for (uint32_t i = 0; i < gdraw_command_list_get_num_commands(list); i++) {
+    points += gdraw_command_get_num_points(gdraw_command_list_get_command(list, i));
+  }
+  return points;
+}
+
+static void prv_km_prepare(void* context) {
+  KmFixture* fixture = context;
+  KMAnimation* kmanim = km_make_transformation_kmanimation(fixture->layer, fixture->image, KM_FROM, KM_TO,
+                                                           KM_SWEEP_DOWN, 200, KM_TRANSLATE_AND_SCALE);
+  km_dispose_kmanimation(kmanim);
+  if (fixture->arena) {
+    arena_reset(fixture->arena);
+  }
+}
+
+static void prv_km_clone_and_prepare(void* context) {
+  KmFixture* fixture = context;
+  GDrawCommandImage* clone = gdraw_command_image_clone(fixture->source);
+  KMAnimation* kmanim = km_make_transformation_kmanimation(fixture->layer, clone, KM_FROM, KM_TO,
+                                                           KM_SWEEP_DOWN, 200, KM_TRANSLATE_AND_SCALE);
+  km_dispose_kmanimation(kmanim);
+  gdraw_command_image_destroy(clone);
+}
+
+static void prv_km_frames(void* context) {
+  KmFixture* fixture = context;
+  KMAnimation* kmanim = km_make_transformation_kmanimation(fixture->layer, fixture->image, KM_FROM, KM_TO,
+                                                           KM_SWEEP_DOWN, 200, KM_TRANSLATE_AND_SCALE);
+  HostClockStats before, after;
+  host_clock_get_stats(&before);
+  km_start_kmanimation(kmanim, NULL);
+  host_run_until_idle(1000);
+  host_clock_get_stats(&after);
+  fixture->frames += after.frames - before.frames;
+  km_dispose_kmanimation(kmanim);
+}
+
+static void prv_bench_kimaybe(const char* label, uint32_t resource_id, uint32_t iterations) {
+  KmFixture fixture = {0};
+  fixture.layer = layer_create(GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT));
+  fixture.source = gdraw_command_image_create_with_resource(resource_id);
+  fixture.image = gdraw_command_image_clone(fixture.source);
+  if (!fixture.source || !fixture.image) {
+    printf("%-32s missing resource %u\n", label, (unsigned)resource_id);
+    return;
+  }
+  fixture.points = prv_count_points(fixture.source);
+
+  char name[64];
+  snprintf(name, sizeof(name), "km_prepare %s (%u pts)", label, (unsigned)fixture.points);
+  prv_run(name, iterations, prv_km_prepare, &fixture);
+
+  snprintf(name, sizeof(name), "km_clone_prepare %s", label);
+  prv_run(name, iterations, prv_km_clone_and_prepare, &fixture);
+
+  snprintf(name, sizeof(name), "km_animation %s", label);
+  BenchResult result = prv_run(name, iterations / 10, prv_km_frames, &fixture);
+  printf("%-32s %10u %12.1f\n", "  per frame", fixture.frames, (double)result.wall_ns / fixture.frames);
+
+  Arena arena;
+  arena_init(&arena, KM_ARENA_SIZE);
+  km_set_arena(&arena);
+  fixture.arena = &arena;
+  snprintf(name, sizeof(name), "km_prepare %s, arena", label);
+  prv_run(name, iterations, prv_km_prepare, &fixture);
+  prv_print_arena(&arena);
+  km_set_arena(NULL);
+  arena_deinit(&arena);
+
+  gdraw_command_image_destroy(fixture.image);
+  gdraw_command_image_destroy(fixture.source);
+  layer_destroy(fixture.layer);
+}
+
+int main(int argc, char** argv) {
+  uint32_t scale = argc > 1 ? (uint32_t)atoi(argv[1]) : 1;
+  if (scale == 0) {
+    scale = 1;
+  }
+
+  prefs_init();
+  prv_build_fixtures();
+  forecast_set_hour_data(s_hour_data);
+
+  HostHeapStats baseline;
+  host_heap_get_stats(&baseline);
+
+  prv_print_header();
+  prv_run("forecast_set_hour_data", 20000 * scale, prv_set_hour_data, NULL);
+  prv_run("format_hour_airflow", 20000 * scale, prv_format_airflow, NULL);
+  prv_run("unpack_precipitation", 20000 * scale, prv_unpack_precipitation, NULL);
+  prv_run("condition images 25+50", 200 * scale, prv_condition_images, NULL);
+  prv_run("airflow images vane+speed", 200 * scale, prv_airflow_images, NULL);
+  prv_run("experiential images 25+50", 200 * scale, prv_experiential_images, NULL);
+  prv_bench_window_images(200 * scale);
+  prv_bench_kimaybe("sunny_50px", RESOURCE_ID_SUNNY_50PX, 2000 * scale);
+  prv_bench_kimaybe("heavy_rain_50px", RESOURCE_ID_HEAVY_RAIN_50PX, 2000 * scale);
+  prv_bench_kimaybe("wind_vane", RESOURCE_ID_WIND_VANE, 2000 * scale);
+
+  HostHeapStats final;
+  host_heap_get_stats(&final);
+  if (final.bytes_in_use != baseline.bytes_in_use) {
+    printf("leak: %zu bytes still in use\n", final.bytes_in_use - baseline.bytes_in_use);
+    return 1;
+  }
+  return 0;
+}
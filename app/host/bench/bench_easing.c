@@ -0,0 +1,136 @@
+/*
+    Easing curve benchmark
+
+    Per-call cost of the baked easing curves (gfx/animation/easing.h)
+    against the float versions they replaced, kept here as the baseline,
+    and how far each table strays from its float original over every
+    AnimationProgress value. The last curve goes through
+    easing_register_curve(), as a curve that is only data would. The host has an FPU, so the float baseline is
+    far cheaper here than the watch's soft-float; the gap on the watch is
+    wider than these numbers.
+
+    Usage: bench_easing [scale]
+*/
+
+#include <pebble_host.h>
+
+#include "gfx/animation/animation.h"
+#include "gfx/animation/easing.h"
+
+#include "bench_runner.h"
+
+// ── The float curves, as they were ──────────────────────────────────────────
+
+static AnimationProgress prv_float_back_out_overshoot(AnimationProgress linear_distance) {
+  float t = (float)linear_distance / ANIMATION_NORMALIZED_MAX;
+  float s = 1.5f;
+  t = t - 1.0f;
+  float result = t * t * t * (1.0f + s) + t * t * s + 1.0f;
+  if (result < 0.0f) result = 0.0f;
+  if (result > 1.2f) result = 1.2f;
+  return (AnimationProgress)(result * ANIMATION_NORMALIZED_MAX);
+}
+
+static AnimationProgress prv_float_out_and_back(AnimationProgress linear_distance) {
+  float t = (float)linear_distance / ANIMATION_NORMALIZED_MAX;
+  float result = t < 0.5f ? t * 2.0f : 1.0f - ((t - 0.5f) * 2.0f);
+  result = result * result * (3.0f - 2.0f * result);
+  if (result < 0.0f) result = 0.0f;
+  if (result > 1.0f) result = 1.0f;
+  return (AnimationProgress)(result * ANIMATION_NORMALIZED_MAX);
+}
+
+static AnimationProgress prv_float_pronounced_ease(AnimationProgress linear_progress) {
+  float t = (float)linear_progress / ANIMATION_NORMALIZED_MAX;
+  float result;
+  if (t < 0.5f) {
+    result = 4.0f * t * t * t;
+  } else {
+    float f = 1.0f - t;
+    result = 1.0f - 4.0f * f * f * f;
+  }
+  return (AnimationProgress)(result * ANIMATION_NORMALIZED_MAX);
+}
+
+// background_animation.c keeps its curve private; bake the same one here,
+// and once more as a table registered at run time
+#define PRONOUNCED_EASE(t) ((t) < 0.5 ? 4.0 * (t) * (t) * (t) : 1.0 - 4.0 * (1.0 - (t)) * (1.0 - (t)) * (1.0 - (t)))
+static AnimationProgress prv_pronounced_ease(AnimationProgress linear_progress);
+EASING_CURVE(prv_pronounced_ease, PRONOUNCED_EASE)
+EASING_TABLE(s_pronounced_ease_samples, PRONOUNCED_EASE)
+
+// ── Bench ───────────────────────────────────────────────────────────────────
+
+typedef struct CurveFixture {
+  AnimationCurveFunction curve;
+  volatile AnimationProgress sink;
+} CurveFixture;
+
+// One animation's worth of frames: 30 evenly spaced calls
+#define FRAMES 30
+
+static AnimationProgress s_frames[FRAMES];
+
+static void prv_call(void* context) {
+  CurveFixture* fixture = context;
+  for (int i = 0; i < FRAMES; i++) {
+    fixture->sink = fixture->curve(s_frames[i]);
+  }
+}
+
+static AnimationProgress prv_max_error(AnimationCurveFunction baked, AnimationCurveFunction original) {
+  AnimationProgress worst = 0;
+  for (AnimationProgress p = 0; p <= ANIMATION_NORMALIZED_MAX; p++) {
+    AnimationProgress error = baked(p) - original(p);
+    if (error < 0) {
+      error = -error;
+    }
+    if (error > worst) {
+      worst = error;
+    }
+  }
+  return worst;
+}
+
+static void prv_bench_curve(const char* label, AnimationCurveFunction baked, AnimationCurveFunction original,
+                            uint32_t iterations) {
+  char name[64];
+  CurveFixture fixture = {.curve = original};
+  snprintf(name, sizeof(name), "%s, float", label);
+  BenchResult before = prv_run(name, iterations, prv_call, &fixture);
+
+  fixture = (CurveFixture){.curve = baked};
+  snprintf(name, sizeof(name), "%s, table", label);
+  BenchResult after = prv_run(name, iterations, prv_call, &fixture);
+
+  AnimationProgress error = prv_max_error(baked, original);
+  double calls = (double)iterations * FRAMES;
+  printf("  per call: float %.1f ns, table %.1f ns; max error %d (%.3f%%)\n", before.wall_ns / calls,
+         after.wall_ns / calls, (int)error, 100.0 * error / ANIMATION_NORMALIZED_MAX);
+}
+
+int main(int argc, char** argv) {
+  uint32_t scale = argc > 1 ? (uint32_t)atoi(argv[1]) : 1;
+  if (scale == 0) {
+    scale = 1;
+  }
+  uint32_t iterations = 100000 * scale;
+  for (int i = 0; i < FRAMES; i++) {
+    s_frames[i] = (AnimationProgress)((int64_t)ANIMATION_NORMALIZED_MAX * i / (FRAMES - 1));
+  }
+
+  printf("%u calls per op\n", FRAMES);
+  prv_print_header();
+  prv_bench_curve("back_out_overshoot", animation_back_out_overshoot_curve, prv_float_back_out_overshoot, iterations);
+  prv_bench_curve("out_and_back", animation_transition_out_and_back_curve, prv_float_out_and_back, iterations);
+  prv_bench_curve("pronounced_ease", prv_pronounced_ease, prv_float_pronounced_ease, iterations);
+
+  AnimationCurveFunction registered = easing_register_curve(s_pronounced_ease_samples);
+  if (!registered) {
+    fprintf(stderr, "bench_easing: no free easing slot\n");
+    return 1;
+  }
+  prv_bench_curve("pronounced_ease, registered", registered, prv_float_pronounced_ease, iterations);
+  easing_unregister_curve(registered);
+  return 0;
+}
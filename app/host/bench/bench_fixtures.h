@@ -0,0 +1,45 @@
+/*
+    Shared benchmark fixtures
+
+    A varied day of forecast data in the wire format the JS side sends:
+    every condition and experiential icon, all wind speed bands, with and
+    without gust/direction/AQI flags, plus a precipitation package that steps
+    through each intensity level. s_forecast_hours continues the same
+    pattern out to the longest forecast the phone can stream; its first 12
+    hours are s_hour_data.
+*/
+
+#pragma once
+
+#include <pebble.h>
+
+#include "utils/weather.h"
+#include "utils/forecast.h"
+
+static uint8_t s_hour_data[12 * 10];
+static uint8_t s_forecast_hours[FORECAST_MAX_HOURS * 10];
+static uint8_t s_precipitation_package[7];
+
+static void prv_build_fixtures(void) {
+  memset(s_precipitation_package, 0, sizeof(s_precipitation_package));
+  for (int i = 0; i < FORECAST_MAX_HOURS; i++) {
+    uint8_t* p = &s_forecast_hours[i * 10];
+    p[0] = (uint8_t)((8 + i) % 24);
+    p[1] = (uint8_t)(int8_t)(40 + i * 3);
+    p[2] = (uint8_t)(int8_t)(36 + i * 3);
+    p[3] = (uint8_t)(i * 5);
+    p[4] = (uint8_t)(i * 7);
+    p[5] = (uint8_t)(10 + i);
+    p[6] = (uint8_t)(int8_t)(i - 6);
+    p[7] = (uint8_t)(((i * 3) % 16) << 4 | (i % 11));
+    p[8] = (uint8_t)((i % 12) << 4 | (i % 8));
+    p[9] = (uint8_t)((i % 13) << 4 | (i % 8));
+  }
+  memcpy(s_hour_data, s_forecast_hours, sizeof(s_hour_data));
+
+  s_precipitation_package[0] = 1;
+  for (int i = 0; i < PRECIPITATION_INTERVALS; i++) {
+    uint8_t level = (uint8_t)((i / 3) % 4);
+    s_precipitation_package[1 + i / 4] |= level << ((i % 4) * 2);
+  }
+}
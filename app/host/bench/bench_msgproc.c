@@ -0,0 +1,152 @@
+/*
+    Decoder throughput
+
+    Decodes the shared corpus (fuzz/corpus/msgproc, generated from msgproc.js)
+    in a loop and reports time per record, per hour package and per
+    precipitation package, plus MB/s over the wire bytes. "decode corpus"
+    formats every page of every hour; "format one page" is what the viewer
+    actually pays per hour change. The fuzz target
+    decodes the same records, so a format change is tracked for speed and
+    robustness at once.
+
+    Also checks the compile-time message sizes in protocol.h against
+    dict_calc_buffer_size() and reports the AppMessage buffers they give.
+
+    Usage: bench_msgproc [corpus dir] [scale]
+*/
+
+#include <pebble_host.h>
+
+#include "bench_runner.h"
+#include "msgproc_record.h"
+#include "utils/protocol.h"
+
+#define MAX_RECORDS 1024
+// What AppMessage took before its buffers were sized from the protocol
+#define FIXED_APP_MESSAGE_BYTES (APP_MESSAGE_INBOX_SIZE_MINIMUM + 1024)
+
+typedef struct Corpus {
+  MsgprocRecord records[MAX_RECORDS];
+  size_t count;
+} Corpus;
+
+static Corpus s_corpus;
+static MsgprocStrings s_strings;
+
+static void prv_decode_corpus(void* context) {
+  for (size_t i = 0; i < s_corpus.count; i++) {
+    msgproc_record_decode(&s_corpus.records[i], &s_strings);
+  }
+}
+
+static void prv_set_hour_data(void* context) {
+  for (size_t i = 0; i < s_corpus.count; i++) {
+    forecast_set_hour_data(s_corpus.records[i].hour_data);
+  }
+}
+
+static void prv_format_one_page(void* context) {
+  for (size_t i = 0; i < s_corpus.count; i++) {
+    const uint8_t* hour_data = s_corpus.records[i].hour_data;
+    uint8_t hour = i % 12;
+    switch (i % 3) {
+      case 0: format_hour_conditions(hour_data, hour, s_strings.conditions[hour]); break;
+      case 1: format_hour_airflow(hour_data, hour, s_strings.airflow[hour]); break;
+      default: format_hour_experiential(hour_data, hour, s_strings.experiential[hour]); break;
+    }
+  }
+}
+
+static void prv_unpack_precipitation(void* context) {
+  for (size_t i = 0; i < s_corpus.count; i++) {
+    unpack_precipitation(s_corpus.records[i].precipitation_package, &precipitation);
+  }
+}
+
+static void prv_unpack_precipitation_minutes(void* context) {
+  for (size_t i = 0; i < s_corpus.count; i++) {
+    unpack_precipitation_minutes(s_corpus.records[i].precipitation_minutes, PRECIPITATION_MINUTES_PACKAGE_SIZE,
+                                 &precipitation);
+  }
+}
+
+static bool prv_check_size(const char* name, uint32_t protocol_size, uint32_t calculated) {
+  if (protocol_size != calculated) {
+    fprintf(stderr, "bench_msgproc: %s is %u bytes in protocol.h, dict_calc_buffer_size says %u\n", name,
+            protocol_size, calculated);
+    return false;
+  }
+  return true;
+}
+
+static bool prv_check_protocol_sizes(void) {
+  const uint32_t i = PROTOCOL_INT_SIZE;
+  bool ok = true;
+  ok &= prv_check_size("JS_READY", PROTOCOL_JS_READY_SIZE, dict_calc_buffer_size(2, i, i));
+  ok &= prv_check_size("RESPONSE_DATA", PROTOCOL_RESPONSE_DATA_SIZE, dict_calc_buffer_size(2, i, i));
+  ok &= prv_check_size("hour blocks", PROTOCOL_HOUR_BLOCKS_SIZE,
+                       dict_calc_buffer_size(4, (uint32_t)sizeof(forecast_data), i, i, i));
+  ok &= prv_check_size("precipitation", PROTOCOL_PRECIPITATION_SIZE,
+                       dict_calc_buffer_size(3, (uint32_t)PRECIPITATION_PACKAGE_SIZE,
+                                             (uint32_t)PRECIPITATION_MINUTES_PACKAGE_SIZE, i));
+  ok &= prv_check_size("request", PROTOCOL_REQUEST_SIZE, dict_calc_buffer_size(1, i));
+  return ok;
+}
+
+static void prv_print_throughput(const BenchResult* result, size_t units_per_iteration, size_t bytes_per_unit,
+                                 const char* unit) {
+  double units = (double)result->iterations * units_per_iteration;
+  double seconds = result->wall_ns / 1e9;
+  char label[64];
+  snprintf(label, sizeof(label), "  per %s", unit);
+  printf("%-32s %10.0f %12.1f %10s %12s %9.1f MB/s\n", label, units, result->wall_ns / units, "", "",
+         units * bytes_per_unit / seconds / 1e6);
+}
+
+int main(int argc, char** argv) {
+  const char* dir = argc > 1 ? argv[1] : "fuzz/corpus/msgproc";
+  uint32_t scale = argc > 2 ? (uint32_t)atoi(argv[2]) : 1;
+  if (scale == 0) {
+    scale = 1;
+  }
+
+  if (!prv_check_protocol_sizes()) {
+    return 1;
+  }
+
+  prefs_init();
+  s_corpus.count = msgproc_record_load_dir(dir, s_corpus.records, MAX_RECORDS);
+  if (s_corpus.count == 0) {
+    fprintf(stderr, "bench_msgproc: no records in %s (run tools/gen_corpus.js)\n", dir);
+    return 1;
+  }
+
+  uint32_t iterations = (uint32_t)(20000 * scale / s_corpus.count) + 1;
+  char name[64];
+  prv_print_header();
+
+  snprintf(name, sizeof(name), "decode corpus (%zu records)", s_corpus.count);
+  BenchResult result = prv_run(name, iterations, prv_decode_corpus, NULL);
+  prv_print_throughput(&result, s_corpus.count, MSGPROC_RECORD_SIZE - 1, "record");
+
+  // The app's default (imperial) units for the decoders on their own.
+  msgproc_record_apply_settings(0);
+  result = prv_run("forecast_set_hour_data", iterations, prv_set_hour_data, NULL);
+  prv_print_throughput(&result, s_corpus.count * 12, HOUR_PACKAGE_SIZE, "hour");
+
+  result = prv_run("format one page", iterations, prv_format_one_page, NULL);
+  prv_print_throughput(&result, s_corpus.count, HOUR_PACKAGE_SIZE, "page");
+
+  result = prv_run("unpack_precipitation", iterations, prv_unpack_precipitation, NULL);
+  prv_print_throughput(&result, s_corpus.count, PRECIPITATION_PACKAGE_SIZE, "package");
+
+  result = prv_run("unpack_precipitation_minutes", iterations, prv_unpack_precipitation_minutes, NULL);
+  prv_print_throughput(&result, s_corpus.count, PRECIPITATION_MINUTES_PACKAGE_SIZE, "package");
+
+  printf("\nretained forecast: %zu bytes (HOUR_DATA) + %zu bytes (precipitation), %d byte page buffer\n",
+         sizeof(forecast_data), sizeof(precipitation), MAX_STRING_LENGTH);
+  printf("AppMessage buffers: %d byte inbox + %d byte outbox, %d bytes less than the fixed %d\n",
+         PROTOCOL_INBOX_SIZE, PROTOCOL_OUTBOX_SIZE,
+         FIXED_APP_MESSAGE_BYTES - PROTOCOL_INBOX_SIZE - PROTOCOL_OUTBOX_SIZE, FIXED_APP_MESSAGE_BYTES);
+  return 0;
+}
@@ -0,0 +1,513 @@
+/*
+    Animation replay benchmark
+
+    Boots the whole app (main.c) on the virtual clock, feeds it the same
+    AppMessages PebbleKit JS would send, then replays scripted button
+    sequences against the viewer and reports what each animation subsystem
+    cost. Everything except the *_ns fields is deterministic, so the JSON can
+    be diffed between commits to gate changes; --counts-only zeroes the wall
+    times to make that diff exact.
+
+    A script is a list of whitespace-separated steps:
+
+      [N*]button[@gap]   press up/down/select/back N times, `gap` ms apart
+      [N*]hold:button    the same, as held-button repeats
+      wait:ms            let the clock run
+
+    The default gap is 400 ms. An input counts as dropped when an animation
+    was running as it arrived and the view did not change; the drop is charged
+    to every subsystem that was active at the time.
+
+    Scenarios with a forecast length boot with the first 12-hour block of a
+    forecast that long and answer the app's REQUEST_HOUR messages the way
+    the phone does, one step after they are sent. Lossy scenarios lose every
+    Nth message the watch sends and deliver every answer twice, as the phone
+    does when the watch's ACK is lost.
+
+    Usage: bench_replay [--counts-only] [-o file] [--script name=steps] [name...]
+*/
+
+#include <pebble_host.h>
+
+#include "utils/prefs.h"
+#include "utils/transport.h"
+#include "gfx/windows/viewer.h"
+#include "gfx/animation/text_animation.h"
+#include "gfx/animation/image_animation.h"
+#include "gfx/animation/transition.h"
+#include "gfx/animation/background_animation.h"
+#include "gfx/animation/precip_animation.h"
+#include "gfx/animation/frame_clock.h"
+#include "gfx/page_snapshot.h"
+
+#include "bench_fixtures.h"
+
+int dribble_main(void);
+
+#define DEFAULT_GAP_MS 400
+#define SETTLE_MS 1000
+#define MAX_SCENARIOS 16
+
+typedef struct Scenario {
+  const char* name;
+  const char* script;
+  // 0 for a plain 12-hour HOUR_DATA without the block keys
+  uint8_t forecast_hours;
+  // Loses every Nth send from the watch and repeats every answer; 0 for none
+  uint8_t lose_every;
+} Scenario;
+
+static const Scenario s_builtin_scenarios[] = {
+  {"down_x11", "11*down@450"},
+  {"page_cycle", "3*select@450"},
+  {"rapid_up_down", "6*down@80 6*up@80"},
+  {"hold_down", "11*hold:down@150"},
+  {"browse", "2*down select down@200 select@600 up wait:500 select 3*up@120"},
+  {"long_scroll", "47*down@450 24*up@450", FORECAST_MAX_HOURS},
+  {"lossy_scroll", "23*down@450", 24, 2},
+};
+
+// ── Subsystems ────────────────────────────────────────────────────────────────
+
+typedef enum {
+  SUBSYSTEM_TEXT,
+  SUBSYSTEM_IMAGE,
+  SUBSYSTEM_TRANSITION,
+  SUBSYSTEM_BACKGROUND,
+  SUBSYSTEM_PRECIP,
+  SUBSYSTEM_COUNT,
+} Subsystem;
+
+static const char* const s_subsystem_names[SUBSYSTEM_COUNT] = {
+  [SUBSYSTEM_TEXT] = "text_animation",
+  [SUBSYSTEM_IMAGE] = "image_animation",
+  [SUBSYSTEM_TRANSITION] = "transition",
+  [SUBSYSTEM_BACKGROUND] = "background_animation",
+  [SUBSYSTEM_PRECIP] = "precip_animation",
+};
+
+static bool prv_subsystem_active(Subsystem subsystem) {
+  switch (subsystem) {
+    case SUBSYSTEM_TEXT:
+      return text_animation_is_active();
+    case SUBSYSTEM_IMAGE:
+      return image_animation_is_active();
+    case SUBSYSTEM_TRANSITION:
+      return transition_animation_is_active();
+    case SUBSYSTEM_BACKGROUND:
+      return background_animation_is_active();
+    case SUBSYSTEM_PRECIP:
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
+      return precip_animation_is_active();
+#else
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
+// ── Run state ─────────────────────────────────────────────────────────────────
+
+typedef struct ReplayRun {
+  const Scenario* scenario;
+  bool script_ok;
+  uint32_t inputs;
+  uint32_t dropped_inputs;
+  uint32_t subsystem_drops[SUBSYSTEM_COUNT];
+  uint64_t start_ms;
+  uint32_t duration_ms;
+  HostClockStats clock;
+  HostRenderStats render;
+  HostHeapStats heap;
+  HostProfileZoneStats zones[SUBSYSTEM_COUNT];
+  FrameClockStats frame_clock;  // over the run only; the clock's own counters never reset
+  IconCacheStats icons;         // over the run, except bytes: held at the end
+  PageSnapshotStats snapshots;  // over the run
+  size_t baseline_bytes;
+  size_t leaked_bytes;
+  uint32_t hour_requests;
+  int pending_hour;  // first hour of a REQUEST_HOUR not answered yet, or -1
+  uint8_t phone_seq;
+  uint8_t final_hour;
+  TransportStats transport;
+  HostMessageStats messages;
+} ReplayRun;
+
+static bool prv_parse_button(const char* name, size_t length, ButtonId* button) {
+  static const struct {
+    const char* name;
+    ButtonId id;
+  } buttons[] = {
+    {"up", BUTTON_ID_UP},
+    {"down", BUTTON_ID_DOWN},
+    {"select", BUTTON_ID_SELECT},
+    {"back", BUTTON_ID_BACK},
+  };
+  for (size_t i = 0; i < ARRAY_LENGTH(buttons); i++) {
+    if (strlen(buttons[i].name) == length && strncmp(buttons[i].name, name, length) == 0) {
+      *button = buttons[i].id;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void prv_press(ReplayRun* run, ButtonId button, bool repeating) {
+  bool active[SUBSYSTEM_COUNT];
+  bool any_active = false;
+  for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+    active[i] = prv_subsystem_active(i);
+    any_active |= active[i];
+  }
+  uint8_t hour = viewer_get_current_hour();
+  uint8_t page = viewer_get_current_page();
+
+  host_click(button, repeating);
+  run->inputs++;
+
+  if (button == BUTTON_ID_BACK || !any_active) {
+    return;
+  }
+  if (viewer_get_current_hour() == hour && viewer_get_current_page() == page) {
+    run->dropped_inputs++;
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+      if (active[i]) {
+        run->subsystem_drops[i]++;
+      }
+    }
+  }
+}
+
+// ── Phone ─────────────────────────────────────────────────────────────────────
+
+static void prv_deliver(uint32_t key, const uint8_t* data, uint16_t size) {
+  uint8_t buffer[256];
+  DictionaryIterator iter;
+  dict_write_begin(&iter, buffer, sizeof(buffer));
+  if (data) {
+    dict_write_data(&iter, key, data, size);
+  } else {
+    dict_write_int32(&iter, key, 1);
+  }
+  host_app_message_deliver(buffer, (uint16_t)dict_write_end(&iter));
+}
+
+static void prv_deliver_hour_block(ReplayRun* run, uint8_t first_hour) {
+  uint8_t buffer[256];
+  DictionaryIterator iter;
+  dict_write_begin(&iter, buffer, sizeof(buffer));
+  dict_write_data(&iter, MESSAGE_KEY_HOUR_DATA, &s_forecast_hours[first_hour * HOUR_PACKAGE_SIZE], HOUR_DATA_SIZE);
+  dict_write_int32(&iter, MESSAGE_KEY_HOUR_BLOCK, first_hour);
+  dict_write_int32(&iter, MESSAGE_KEY_FORECAST_HOURS, run->scenario->forecast_hours);
+  // PebbleKit JS numbers its messages 1-255
+  run->phone_seq = run->phone_seq % 255 + 1;
+  dict_write_int32(&iter, MESSAGE_KEY_SEQ, run->phone_seq);
+  uint16_t size = (uint16_t)dict_write_end(&iter);
+  host_app_message_deliver(buffer, size);
+  if (run->scenario->lose_every) {
+    host_app_message_deliver(buffer, size);
+  }
+}
+
+// Runs inside app_message_outbox_send(), so only note the request; answering
+// here would re-enter the inbox handler from the app's own click handler.
+static void prv_outbox_hook(const uint8_t* buffer, uint16_t size, void* context) {
+  ReplayRun* run = context;
+  DictionaryIterator iter;
+  dict_read_begin_from_buffer(&iter, buffer, size);
+  Tuple* request = dict_find(&iter, MESSAGE_KEY_REQUEST_HOUR);
+  if (request) {
+    run->pending_hour = request->value->uint8;
+    run->hour_requests++;
+  }
+}
+
+static void prv_answer_hour_request(ReplayRun* run) {
+  if (run->pending_hour < 0) {
+    return;
+  }
+  uint8_t first_hour = (uint8_t)run->pending_hour;
+  run->pending_hour = -1;
+  if (first_hour < run->scenario->forecast_hours) {
+    prv_deliver_hour_block(run, first_hour);
+  }
+}
+
+// ── Script ────────────────────────────────────────────────────────────────────
+
+// Runs one step of the script; returns false if it does not parse.
+static bool prv_run_step(ReplayRun* run, const char* step, size_t length) {
+  const char* end = step + length;
+
+  if (length > 5 && strncmp(step, "wait:", 5) == 0) {
+    host_advance((uint32_t)strtoul(step + 5, NULL, 10));
+    prv_answer_hour_request(run);
+    return true;
+  }
+
+  uint32_t count = 1;
+  const char* star = memchr(step, '*', length);
+  if (star) {
+    count = (uint32_t)strtoul(step, NULL, 10);
+    step = star + 1;
+  }
+
+  bool repeating = false;
+  if ((size_t)(end - step) > 5 && strncmp(step, "hold:", 5) == 0) {
+    repeating = true;
+    step += 5;
+  }
+
+  uint32_t gap_ms = DEFAULT_GAP_MS;
+  const char* at = memchr(step, '@', end - step);
+  const char* name_end = at ? at : end;
+  if (at) {
+    gap_ms = (uint32_t)strtoul(at + 1, NULL, 10);
+  }
+
+  ButtonId button;
+  if (count == 0 || !prv_parse_button(step, name_end - step, &button)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    prv_press(run, button, repeating);
+    host_advance(gap_ms);
+    prv_answer_hour_request(run);
+  }
+  return true;
+}
+
+static bool prv_run_script(ReplayRun* run, const char* script) {
+  const char* cursor = script;
+  while (*cursor) {
+    while (*cursor == ' ') {
+      cursor++;
+    }
+    size_t length = strcspn(cursor, " ");
+    if (length == 0) {
+      break;
+    }
+    if (!prv_run_step(run, cursor, length)) {
+      fprintf(stderr, "bench_replay: bad step '%.*s' in %s\n", (int)length, cursor, run->scenario->name);
+      return false;
+    }
+    cursor += length;
+  }
+  return true;
+}
+
+// ── Boot ──────────────────────────────────────────────────────────────────────
+
+// Plays the startup handshake and waits for the splash to hand over to the
+// viewer, so every scenario starts from the same resting screen.
+static void prv_boot(ReplayRun* run) {
+  prv_deliver(MESSAGE_KEY_JS_READY, NULL, 0);
+  if (run->scenario->forecast_hours) {
+    prv_deliver_hour_block(run, 0);
+  } else {
+    prv_deliver(MESSAGE_KEY_HOUR_DATA, s_hour_data, sizeof(s_hour_data));
+  }
+  prv_deliver(MESSAGE_KEY_PRECIPITATION_PACKAGE, s_precipitation_package, sizeof(s_precipitation_package));
+  host_advance(1500);
+  host_run_until_idle(2000);
+  prv_answer_hour_request(run);
+}
+
+static void prv_event_loop(void* context) {
+  ReplayRun* run = context;
+  prv_boot(run);
+
+  host_heap_reset_counters();
+  host_clock_reset_stats();
+  host_render_reset_stats();
+  host_profile_reset();
+  FrameClockStats frame_clock_start = *frame_clock_get_stats();
+  IconCacheStats icons_start = *icon_cache_get_stats();
+  PageSnapshotStats snapshots_start = *page_snapshot_get_stats();
+  run->start_ms = host_now_ms();
+
+  run->script_ok = prv_run_script(run, run->scenario->script);
+  host_advance(SETTLE_MS);
+
+  run->duration_ms = (uint32_t)(host_now_ms() - run->start_ms);
+  run->final_hour = viewer_get_current_hour();
+  run->transport = *transport_get_stats();
+  host_app_message_get_stats(&run->messages);
+  host_clock_get_stats(&run->clock);
+  host_render_get_stats(&run->render);
+  host_heap_get_stats(&run->heap);
+  const FrameClockStats* frame_clock = frame_clock_get_stats();
+  run->frame_clock = (FrameClockStats){
+    .frames = frame_clock->frames - frame_clock_start.frames,
+    .invalidations = frame_clock->invalidations - frame_clock_start.invalidations,
+    .marks = frame_clock->marks - frame_clock_start.marks,
+    .drivers = frame_clock->drivers - frame_clock_start.drivers,
+  };
+  const PageSnapshotStats* snapshots = page_snapshot_get_stats();
+  run->snapshots = (PageSnapshotStats){
+    .blits = snapshots->blits - snapshots_start.blits,
+    .fallbacks = snapshots->fallbacks - snapshots_start.fallbacks,
+  };
+  const IconCacheStats* icons = icon_cache_get_stats();
+  run->icons = (IconCacheStats){
+    .captures = icons->captures - icons_start.captures,
+    .blits = icons->blits - icons_start.blits,
+    .bytes = icons->bytes,
+  };
+  for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+    // Zone 0 is "unattributed"; a subsystem that never ran has no zone yet.
+    uint8_t zone = host_profile_zone_find(s_subsystem_names[i]);
+    if (zone != 0) {
+      host_profile_get(zone, &run->zones[i]);
+    }
+  }
+}
+
+static void prv_replay(ReplayRun* run) {
+  host_reset();
+  prefs_init();
+  prv_build_fixtures();
+
+  HostHeapStats before;
+  host_heap_get_stats(&before);
+  run->baseline_bytes = before.bytes_in_use;
+  run->pending_hour = -1;
+
+  host_app_message_set_outbox_hook(prv_outbox_hook, run);
+  host_app_message_set_send_loss(run->scenario->lose_every);
+  host_set_event_loop(prv_event_loop, run);
+  dribble_main();
+  host_set_event_loop(NULL, NULL);
+  host_app_message_set_outbox_hook(NULL, NULL);
+  host_app_exit();
+
+  HostHeapStats after;
+  host_heap_get_stats(&after);
+  run->leaked_bytes = after.bytes_in_use > run->baseline_bytes ? after.bytes_in_use - run->baseline_bytes : 0;
+}
+
+// ── Output ────────────────────────────────────────────────────────────────────
+
+static bool s_counts_only;
+
+static uint64_t prv_ns(uint64_t ns) {
+  return s_counts_only ? 0 : ns;
+}
+
+static void prv_print_run(FILE* out, const ReplayRun* run, bool last) {
+  uint32_t frames = run->clock.frames ? run->clock.frames : 1;
+  fprintf(out, "    {\n");
+  fprintf(out, "      \"name\": \"%s\",\n", run->scenario->name);
+  fprintf(out, "      \"script\": \"%s\",\n", run->scenario->script);
+  fprintf(out, "      \"inputs\": %u,\n", run->inputs);
+  fprintf(out, "      \"dropped_inputs\": %u,\n", run->dropped_inputs);
+  fprintf(out, "      \"duration_ms\": %u,\n", run->duration_ms);
+  fprintf(out, "      \"final_hour\": %u,\n", run->final_hour);
+  fprintf(out, "      \"hour_requests\": %u,\n", run->hour_requests);
+  fprintf(out,
+          "      \"transport\": {\"sent\": %u, \"delivered\": %u, \"retries\": %u, \"failed\": %u, "
+          "\"received\": %u, \"duplicates\": %u, \"sync_ms\": %u},\n",
+          run->transport.sent, run->transport.delivered, run->transport.retries, run->transport.failed,
+          run->transport.received, run->transport.duplicates, run->transport.sync_ms);
+  fprintf(out, "      \"app_message\": {\"inbox_bytes\": %u, \"outbox_bytes\": %u, \"oversized\": %u},\n",
+          run->messages.inbox_size, run->messages.outbox_size, run->messages.oversized);
+  fprintf(out, "      \"frames\": %u,\n", run->clock.frames);
+  fprintf(out, "      \"renders\": %u,\n", run->render.renders);
+  fprintf(out, "      \"pdc_points_drawn\": %u,\n", run->render.pdc_points_drawn);
+  fprintf(out, "      \"render_ns_per_frame\": %llu,\n",
+          (unsigned long long)prv_ns(run->render.render_ns / frames));
+  fprintf(out, "      \"heap\": {\"allocs\": %u, \"bytes_allocated\": %zu, \"peak_bytes\": %zu, \"leaked_bytes\": %zu},\n",
+          run->heap.allocs, run->heap.bytes_allocated, run->heap.peak_bytes_in_use - run->baseline_bytes,
+          run->leaked_bytes);
+  fprintf(out, "      \"frame_clock\": {\"frames\": %u, \"drivers\": %u, \"invalidations\": %u, \"marks\": %u},\n",
+          run->frame_clock.frames, run->frame_clock.drivers, run->frame_clock.invalidations, run->frame_clock.marks);
+  fprintf(out, "      \"icon_cache\": {\"captures\": %u, \"blits\": %u, \"bytes\": %zu},\n",
+          run->icons.captures, run->icons.blits, run->icons.bytes);
+  fprintf(out, "      \"page_snapshots\": {\"blits\": %u, \"fallbacks\": %u},\n",
+          run->snapshots.blits, run->snapshots.fallbacks);
+  fprintf(out, "      \"subsystems\": {\n");
+  for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+    const HostProfileZoneStats* zone = &run->zones[i];
+    uint32_t zone_frames = zone->frames ? zone->frames : 1;
+    fprintf(out,
+            "        \"%s\": {\"frames\": %u, \"frames_rendered\": %u, \"updates\": %u, "
+            "\"update_ns_per_frame\": %llu, \"callback_ns\": %llu, \"allocs\": %u, "
+            "\"bytes_allocated\": %zu, \"peak_live_bytes\": %zu, \"dropped_inputs\": %u}%s\n",
+            s_subsystem_names[i], zone->frames, zone->frames_rendered, zone->updates,
+            (unsigned long long)prv_ns(zone->update_ns / zone_frames), (unsigned long long)prv_ns(zone->callback_ns),
+            zone->allocs, zone->bytes_allocated, zone->peak_live_bytes, run->subsystem_drops[i],
+            i + 1 < SUBSYSTEM_COUNT ? "," : "");
+  }
+  fprintf(out, "      }\n");
+  fprintf(out, "    }%s\n", last ? "" : ",");
+}
+
+int main(int argc, char** argv) {
+  Scenario scenarios[MAX_SCENARIOS];
+  size_t scenario_count = 0;
+  const char* filters[MAX_SCENARIOS];
+  size_t filter_count = 0;
+  const char* out_path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--counts-only") == 0) {
+      s_counts_only = true;
+    } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      out_path = argv[++i];
+    } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+      char* spec = argv[++i];
+      char* equals = strchr(spec, '=');
+      if (!equals || scenario_count >= MAX_SCENARIOS) {
+        fprintf(stderr, "bench_replay: --script expects name=steps\n");
+        return 2;
+      }
+      *equals = '\0';
+      scenarios[scenario_count++] = (Scenario){spec, equals + 1};
+    } else if (filter_count < MAX_SCENARIOS) {
+      filters[filter_count++] = argv[i];
+    }
+  }
+
+  // Custom scripts replace the built-in set; names filter whichever set is used.
+  if (scenario_count == 0) {
+    for (size_t i = 0; i < ARRAY_LENGTH(s_builtin_scenarios); i++) {
+      scenarios[scenario_count++] = s_builtin_scenarios[i];
+    }
+  }
+  if (filter_count > 0) {
+    size_t kept = 0;
+    for (size_t i = 0; i < scenario_count; i++) {
+      for (size_t f = 0; f < filter_count; f++) {
+        if (strcmp(scenarios[i].name, filters[f]) == 0) {
+          scenarios[kept++] = scenarios[i];
+          break;
+        }
+      }
+    }
+    scenario_count = kept;
+  }
+
+  FILE* out = out_path ? fopen(out_path, "w") : stdout;
+  if (!out) {
+    perror(out_path);
+    return 2;
+  }
+
+  bool ok = true;
+  fprintf(out, "{\n  \"platform\": \"%s\",\n  \"frame_interval_ms\": %d,\n  \"scenarios\": [\n",
+          HOST_PLATFORM_NAME, HOST_FRAME_INTERVAL_MS);
+  for (size_t i = 0; i < scenario_count; i++) {
+    ReplayRun run = {.scenario = &scenarios[i]};
+    prv_replay(&run);
+    prv_print_run(out, &run, i + 1 == scenario_count);
+    // An oversized message would be dropped on the watch
+    ok &= run.script_ok && run.leaked_bytes == 0 && run.messages.oversized == 0;
+  }
+  fprintf(out, "  ]\n}\n");
+
+  if (out != stdout) {
+    fclose(out);
+  }
+  return ok ? 0 : 1;
+}
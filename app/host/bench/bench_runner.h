@@ -0,0 +1,56 @@
+/*
+    Benchmark runner
+
+    Runs a function N times and prints one table row with wall time and the
+    app-heap traffic per call. Shared by the bench_* programs.
+*/
+
+#pragma once
+
+#include <pebble_host.h>
+
+typedef struct BenchResult {
+  const char* name;
+  uint32_t iterations;
+  uint64_t wall_ns;
+  uint32_t allocs;
+  uint32_t frees;
+  size_t bytes_allocated;
+  size_t peak_bytes;
+} BenchResult;
+
+typedef void (*BenchFn)(void* context);
+
+static void prv_print_header(void) {
+  printf("%-32s %10s %12s %10s %12s %12s\n", "benchmark", "iters", "ns/op", "allocs/op", "bytes/op", "peak bytes");
+}
+
+static void prv_print(const BenchResult* result) {
+  double iters = result->iterations;
+  printf("%-32s %10u %12.1f %10.2f %12.1f %12zu\n", result->name, result->iterations,
+         result->wall_ns / iters, result->allocs / iters, result->bytes_allocated / iters, result->peak_bytes);
+}
+
+static BenchResult prv_run(const char* name, uint32_t iterations, BenchFn fn, void* context) {
+  HostHeapStats before, after;
+  host_heap_reset_counters();
+  host_heap_get_stats(&before);
+  uint64_t start = host_wall_ns();
+  for (uint32_t i = 0; i < iterations; i++) {
+    fn(context);
+  }
+  uint64_t end = host_wall_ns();
+  host_heap_get_stats(&after);
+
+  BenchResult result = {
+    .name = name,
+    .iterations = iterations,
+    .wall_ns = end - start,
+    .allocs = after.allocs - before.allocs,
+    .frees = after.frees - before.frees,
+    .bytes_allocated = after.bytes_allocated - before.bytes_allocated,
+    .peak_bytes = after.peak_bytes_in_use - before.bytes_in_use,
+  };
+  prv_print(&result);
+  return result;
+}
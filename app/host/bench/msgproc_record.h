@@ -0,0 +1,137 @@
+/*
+    Decoder corpus records
+
+    One record is what a fuzz input or a throughput sample feeds to msgproc:
+
+      uint8      settings selector (see below)
+      uint8[120] HOUR_DATA, as packed by msgproc.js packAllHourData()
+      uint8[7]   PRECIPITATION_PACKAGE, as packed by packPrecipitation()
+      uint8[33]  PRECIPITATION_MINUTES, as packed by packPrecipitationMinutes()
+
+    Selector bits pick the unit preferences the strings are formatted with:
+
+      bit 0     temperature in C (else F)
+      bits 1-2  velocity: 0 mph, 1 kph, 2 m/s, 3 mph
+      bit 3     distance in km (else mi)
+      bit 4     pressure in inHg (else mb)
+      bit 5     wind vane shows origin (else heading)
+      bit 6     precipitation arrives before any hour data
+
+    Shorter inputs are zero-padded: the inbox handlers reject short tuples,
+    so the decoders only ever see full-size buffers. A zeroed minutes package
+    reads as version 0 and is skipped, as an older phone would leave it out.
+
+    tools/gen_corpus.js writes the seed corpus in this format.
+*/
+
+#pragma once
+
+#include <dirent.h>
+#include <pebble.h>
+
+#include "utils/forecast.h"
+#include "utils/msgproc.h"
+#include "utils/prefs.h"
+#include "utils/weather.h"
+
+#define MSGPROC_RECORD_SIZE \
+  (1 + HOUR_DATA_SIZE + PRECIPITATION_PACKAGE_SIZE + PRECIPITATION_MINUTES_PACKAGE_SIZE)
+
+#define MSGPROC_RECORD_PRECIPITATION_FIRST 0x40
+
+typedef struct MsgprocRecord {
+  uint8_t selector;
+  uint8_t hour_data[HOUR_DATA_SIZE];
+  uint8_t precipitation_package[PRECIPITATION_PACKAGE_SIZE];
+  uint8_t precipitation_minutes[PRECIPITATION_MINUTES_PACKAGE_SIZE];
+} MsgprocRecord;
+
+// Every string the viewer can show for a forecast. The app only ever formats
+// one of these at a time; decoding a record formats all of them so the fuzzer
+// and the bench cover every formatter.
+typedef struct MsgprocStrings {
+  char conditions[12][MAX_STRING_LENGTH];
+  char airflow[12][MAX_STRING_LENGTH];
+  char experiential[12][MAX_STRING_LENGTH];
+  char precipitation[MAX_STRING_LENGTH];
+} MsgprocStrings;
+
+static void msgproc_record_load(MsgprocRecord* record, const uint8_t* data, size_t size) {
+  uint8_t raw[MSGPROC_RECORD_SIZE] = {0};
+  memcpy(raw, data, size < sizeof(raw) ? size : sizeof(raw));
+  record->selector = raw[0];
+  memcpy(record->hour_data, &raw[1], HOUR_DATA_SIZE);
+  memcpy(record->precipitation_package, &raw[1 + HOUR_DATA_SIZE], PRECIPITATION_PACKAGE_SIZE);
+  memcpy(record->precipitation_minutes, &raw[1 + HOUR_DATA_SIZE + PRECIPITATION_PACKAGE_SIZE],
+         PRECIPITATION_MINUTES_PACKAGE_SIZE);
+}
+
+static void msgproc_record_apply_settings(uint8_t selector) {
+  static const VelocityUnits velocity_units[] = {VELOCITY_MPH, VELOCITY_KPH, VELOCITY_MPS, VELOCITY_MPH};
+  ClaySettings* settings = prefs_get_settings();
+  settings->temperature_units = (selector & 0x01) ? TEMPERATURE_CELSIUS : TEMPERATURE_FAHRENHEIT;
+  settings->velocity_units = velocity_units[(selector >> 1) & 0x03];
+  settings->distance_units = (selector & 0x08) ? DISTANCE_KILOMETERS : DISTANCE_MILES;
+  settings->pressure_units = (selector & 0x10) ? PRESSURE_INCHES : PRESSURE_MILLIBARS;
+  settings->wind_vane_direction = (selector & 0x20) ? 1 : 0;
+}
+
+// Both precipitation packages, in the order precipitation_receive() reads them
+static void msgproc_record_unpack_precipitation(const MsgprocRecord* record) {
+  unpack_precipitation((PrecipitationPackage)record->precipitation_package, &precipitation);
+  unpack_precipitation_minutes(record->precipitation_minutes, PRECIPITATION_MINUTES_PACKAGE_SIZE, &precipitation);
+}
+
+static void msgproc_record_format_precipitation(MsgprocStrings* strings) {
+  char temp_line[MAX_STRING_LENGTH];
+  format_hour_temperature(forecast_data, 0, temp_line);
+  format_precipitation_string(&precipitation, temp_line, strings->precipitation);
+}
+
+// Decodes a record the way the inbox handlers would, in the order it selects,
+// then formats every page of every hour into `strings`.
+static void msgproc_record_decode(const MsgprocRecord* record, MsgprocStrings* strings) {
+  msgproc_record_apply_settings(record->selector);
+  if (record->selector & MSGPROC_RECORD_PRECIPITATION_FIRST) {
+    memset(forecast_data, 0, sizeof(forecast_data));
+    msgproc_record_unpack_precipitation(record);
+    msgproc_record_format_precipitation(strings);
+    forecast_set_hour_data(record->hour_data);
+  } else {
+    forecast_set_hour_data(record->hour_data);
+    msgproc_record_unpack_precipitation(record);
+    msgproc_record_format_precipitation(strings);
+  }
+  for (uint8_t i = 0; i < 12; i++) {
+    format_hour_conditions(forecast_data, i, strings->conditions[i]);
+    format_hour_airflow(forecast_data, i, strings->airflow[i]);
+    format_hour_experiential(forecast_data, i, strings->experiential[i]);
+  }
+}
+
+// Loads every file in `dir` as a record. Returns the number loaded.
+static size_t msgproc_record_load_dir(const char* dir, MsgprocRecord* records, size_t max_records) {
+  DIR* handle = opendir(dir);
+  if (!handle) {
+    return 0;
+  }
+  size_t count = 0;
+  struct dirent* entry;
+  while (count < max_records && (entry = readdir(handle))) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+      continue;
+    }
+    uint8_t data[MSGPROC_RECORD_SIZE];
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    msgproc_record_load(&records[count++], data, size);
+  }
+  closedir(handle);
+  return count;
+}
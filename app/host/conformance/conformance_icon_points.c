@@ -0,0 +1,67 @@
+/*
+    Icon point conformance
+
+    The image transition prepares two KiMaybe animations at once, and their
+    points come out of an arena sized for KM_ARENA_POINTS between them
+    (gfx/animation/image_animation.h). Past that they silently fall back
+    to the heap, so this loads every PDC image in package.json and checks
+    that the two with the most points still fit together. Any pair the
+    transition can animate then fits too.
+
+    Usage: conformance_icon_points
+*/
+
+#include <pebble_host.h>
+
+#include "gfx/animation/image_animation.h"
+
+static uint32_t prv_count_points(GDrawCommandImage* image) {
+  GDrawCommandList* commands = gdraw_command_image_get_command_list(image);
+  uint32_t points = 0;
+  uint32_t num_commands = gdraw_command_list_get_num_commands(commands);
+  for (uint32_t i = 0; i < num_commands; i++) {
+    points += gdraw_command_get_num_points(gdraw_command_list_get_command(commands, i));
+  }
+  return points;
+}
+
+int main(void) {
+  uint32_t most = 0;
+  uint32_t second = 0;
+  uint32_t most_id = 0;
+  uint32_t second_id = 0;
+  int images = 0;
+
+  for (uint32_t id = 1; id <= HOST_RESOURCE_COUNT; id++) {
+    // Bitmaps and sequences are not PDCI images and do not load
+    GDrawCommandImage* image = gdraw_command_image_create_with_resource(id);
+    if (!image) {
+      continue;
+    }
+    uint32_t points = prv_count_points(image);
+    gdraw_command_image_destroy(image);
+    images++;
+
+    if (points > most) {
+      second = most;
+      second_id = most_id;
+      most = points;
+      most_id = id;
+    } else if (points > second) {
+      second = points;
+      second_id = id;
+    }
+  }
+
+  if (images < 2) {
+    fprintf(stderr, "only %d PDC images loaded\n", images);
+    return 1;
+  }
+  printf("icon points: %d images, largest pair %u + %u = %u (resources %u and %u), arena holds %d\n", images, most,
+         second, most + second, most_id, second_id, KM_ARENA_POINTS);
+  if (most + second > KM_ARENA_POINTS) {
+    fprintf(stderr, "the largest icon pair has %u points; raise KM_ARENA_POINTS\n", most + second);
+    return 1;
+  }
+  return 0;
+}
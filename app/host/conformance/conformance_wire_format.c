@@ -0,0 +1,128 @@
+/*
+    Wire format conformance
+
+    Reads the vectors wire_format_vectors.js writes (packages packed by the
+    generated JS packers, with the values the schema says they decode to)
+    and checks every generated C accessor against them. Array fields are
+    checked through both the indexed accessor and the unrolled _all unpack.
+
+    Usage: conformance_wire_format <vectors file>
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wire_format_fields.auto.h"
+
+#define MAX_LINE 1024
+#define MAX_PACKAGE 64
+#define MAX_VALUES 64
+
+static int prv_parse_hex(const char* hex, uint8_t* out, size_t max) {
+  size_t len = strlen(hex);
+  if (len % 2 != 0 || len / 2 > max) {
+    return -1;
+  }
+  for (size_t i = 0; i < len / 2; i++) {
+    unsigned int byte;
+    if (sscanf(&hex[i * 2], "%2x", &byte) != 1) {
+      return -1;
+    }
+    out[i] = byte;
+  }
+  return len / 2;
+}
+
+// Finds " name=" in the field list and parses its comma-separated values
+static int prv_find_values(const char* fields, const char* name, int* values, int max) {
+  char key[64];
+  snprintf(key, sizeof(key), " %s=", name);
+  const char* at = strstr(fields, key);
+  if (!at) {
+    return -1;
+  }
+  const char* p = at + strlen(key);
+  int count = 0;
+  while (count < max) {
+    char* end;
+    values[count++] = strtol(p, &end, 10);
+    if (*end != ',') {
+      break;
+    }
+    p = end + 1;
+  }
+  return count;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <vectors file>\n", argv[0]);
+    return 2;
+  }
+  FILE* file = fopen(argv[1], "r");
+  if (!file) {
+    perror(argv[1]);
+    return 2;
+  }
+
+  char line[MAX_LINE];
+  int packages = 0;
+  int checks = 0;
+  int failures = 0;
+  while (fgets(line, sizeof(line), file)) {
+    line[strcspn(line, "\n")] = '\0';
+    char record[32];
+    char hex[MAX_PACKAGE * 2 + 1];
+    int consumed;
+    if (sscanf(line, "%31s %128s%n", record, hex, &consumed) != 2) {
+      continue;
+    }
+    uint8_t pkg[MAX_PACKAGE];
+    if (prv_parse_hex(hex, pkg, sizeof(pkg)) < 0) {
+      fprintf(stderr, "bad package: %s\n", line);
+      failures++;
+      continue;
+    }
+    const char* fields = &line[consumed];
+    packages++;
+
+    bool matched = false;
+    for (size_t f = 0; f < sizeof(s_wire_fields) / sizeof(s_wire_fields[0]); f++) {
+      const WireField* field = &s_wire_fields[f];
+      if (strcmp(field->record, record) != 0) {
+        continue;
+      }
+      matched = true;
+      int want[MAX_VALUES];
+      int count = prv_find_values(fields, field->name, want, MAX_VALUES);
+      if (count != field->count) {
+        fprintf(stderr, "%s.%s: expected %d values, vector has %d\n", record, field->name, field->count, count);
+        failures++;
+        continue;
+      }
+      for (int n = 0; n < count; n++) {
+        int got = field->get(pkg, n);
+        checks++;
+        if (got != want[n]) {
+          if (failures < 10) {
+            fprintf(stderr, "%s %s: %s[%d] reads %d, schema says %d\n", record, hex, field->name, n, got, want[n]);
+          }
+          failures++;
+        }
+      }
+    }
+    if (!matched) {
+      fprintf(stderr, "no C accessors for record %s\n", record);
+      failures++;
+    }
+  }
+  fclose(file);
+
+  if (packages == 0) {
+    fprintf(stderr, "no vectors in %s\n", argv[1]);
+    return 1;
+  }
+  printf("C decode: %d packages, %d field reads, %d mismatches\n", packages, checks, failures);
+  return failures == 0 ? 0 : 1;
+}
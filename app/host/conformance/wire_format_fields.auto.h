@@ -0,0 +1,124 @@
+// Generated by app/tools/gen_wire_format.py from app/schema/wire_format.json, do not edit
+
+#pragma once
+
+#include "utils/wire_format.auto.h"
+
+typedef struct WireField {
+  const char* record;
+  const char* name;
+  uint8_t count;
+  int (*get)(const uint8_t* pkg, uint8_t n);
+} WireField;
+
+static int prv_hour_of_day(const uint8_t* pkg, uint8_t n) {
+  return hour_of_day(pkg, 0);
+}
+
+static int prv_hour_temp(const uint8_t* pkg, uint8_t n) {
+  return hour_temp(pkg, 0);
+}
+
+static int prv_hour_feels_like(const uint8_t* pkg, uint8_t n) {
+  return hour_feels_like(pkg, 0);
+}
+
+static int prv_hour_wind_speed(const uint8_t* pkg, uint8_t n) {
+  return hour_wind_speed(pkg, 0);
+}
+
+static int prv_hour_wind_gust(const uint8_t* pkg, uint8_t n) {
+  return hour_wind_gust(pkg, 0);
+}
+
+static int prv_hour_visibility(const uint8_t* pkg, uint8_t n) {
+  return hour_visibility(pkg, 0);
+}
+
+static int prv_hour_pressure_mb(const uint8_t* pkg, uint8_t n) {
+  return hour_pressure_mb(pkg, 0);
+}
+
+static int prv_hour_wind_dir16(const uint8_t* pkg, uint8_t n) {
+  return hour_wind_dir16(pkg, 0);
+}
+
+static int prv_hour_aqi(const uint8_t* pkg, uint8_t n) {
+  return hour_aqi(pkg, 0);
+}
+
+static int prv_hour_uv_index(const uint8_t* pkg, uint8_t n) {
+  return hour_uv_index(pkg, 0);
+}
+
+static int prv_hour_flags(const uint8_t* pkg, uint8_t n) {
+  return hour_flags(pkg, 0);
+}
+
+static int prv_hour_conditions_icon(const uint8_t* pkg, uint8_t n) {
+  return hour_conditions_icon(pkg, 0);
+}
+
+static int prv_hour_experiential_icon(const uint8_t* pkg, uint8_t n) {
+  return hour_experiential_icon(pkg, 0);
+}
+
+static int prv_precip_type(const uint8_t* pkg, uint8_t n) {
+  return precip_type(pkg);
+}
+
+static int prv_precip_intensity(const uint8_t* pkg, uint8_t n) {
+  return precip_intensity(pkg, n);
+}
+
+static int prv_precip_intensity_all(const uint8_t* pkg, uint8_t n) {
+  uint8_t values[24];
+  precip_intensity_all(pkg, values);
+  return values[n];
+}
+
+static int prv_precip_minutes_version(const uint8_t* pkg, uint8_t n) {
+  return precip_minutes_version(pkg);
+}
+
+static int prv_precip_minutes_type(const uint8_t* pkg, uint8_t n) {
+  return precip_minutes_type(pkg);
+}
+
+static int prv_precip_minutes_chance(const uint8_t* pkg, uint8_t n) {
+  return precip_minutes_chance(pkg);
+}
+
+static int prv_precip_minutes_steps(const uint8_t* pkg, uint8_t n) {
+  return precip_minutes_steps(pkg, n);
+}
+
+static int prv_precip_minutes_steps_all(const uint8_t* pkg, uint8_t n) {
+  uint8_t values[60];
+  precip_minutes_steps_all(pkg, values);
+  return values[n];
+}
+
+static const WireField s_wire_fields[] = {
+  {"hour", "of_day", 1, prv_hour_of_day},
+  {"hour", "temp", 1, prv_hour_temp},
+  {"hour", "feels_like", 1, prv_hour_feels_like},
+  {"hour", "wind_speed", 1, prv_hour_wind_speed},
+  {"hour", "wind_gust", 1, prv_hour_wind_gust},
+  {"hour", "visibility", 1, prv_hour_visibility},
+  {"hour", "pressure_mb", 1, prv_hour_pressure_mb},
+  {"hour", "wind_dir16", 1, prv_hour_wind_dir16},
+  {"hour", "aqi", 1, prv_hour_aqi},
+  {"hour", "uv_index", 1, prv_hour_uv_index},
+  {"hour", "flags", 1, prv_hour_flags},
+  {"hour", "conditions_icon", 1, prv_hour_conditions_icon},
+  {"hour", "experiential_icon", 1, prv_hour_experiential_icon},
+  {"precipitation", "type", 1, prv_precip_type},
+  {"precipitation", "intensity", 24, prv_precip_intensity},
+  {"precipitation", "intensity", 24, prv_precip_intensity_all},
+  {"precipitation_minutes", "version", 1, prv_precip_minutes_version},
+  {"precipitation_minutes", "type", 1, prv_precip_minutes_type},
+  {"precipitation_minutes", "chance", 1, prv_precip_minutes_chance},
+  {"precipitation_minutes", "steps", 60, prv_precip_minutes_steps},
+  {"precipitation_minutes", "steps", 60, prv_precip_minutes_steps_all},
+};
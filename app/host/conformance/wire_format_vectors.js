@@ -0,0 +1,152 @@
+/**
+ * wire_format_vectors.js
+ *
+ * Round-trip check for the generated JS packers, and test vectors for the
+ * C side. For each record in app/schema/wire_format.json it packs random
+ * and edge-case values with the generated pack*() function, works out from
+ * the schema alone what a decoder must read back, checks unpack*() agrees,
+ * and prints one line per package:
+ *
+ *   <record> <hex bytes> <field>=<value>[,<value>...] ...
+ *
+ * conformance_wire_format.c reads the same lines through the C accessors.
+ *
+ *   node conformance/wire_format_vectors.js [count] > vectors
+ */
+
+var path = require('path');
+
+var APP_DIR = path.join(__dirname, '..', '..');
+var schema = require(path.join(APP_DIR, 'schema', 'wire_format.json'));
+var wire = require(path.join(APP_DIR, 'src', 'pkjs', 'wire_format.auto.js'));
+
+var COUNT = parseInt(process.argv[2] || '2000', 10);
+
+// Deterministic, so a failure reproduces
+var state = 0x2545F491;
+function random() {
+    state ^= state << 13;
+    state ^= state >>> 17;
+    state ^= state << 5;
+    return (state >>> 0) / 4294967296;
+}
+
+function camel(name) {
+    return name.replace(/_([a-z0-9])/g, function (m, c) { return c.toUpperCase(); });
+}
+
+function range(field) {
+    var bits = field.bits;
+    return field.signed ? [-(1 << (bits - 1)), (1 << (bits - 1)) - 1] : [0, (1 << bits) - 1];
+}
+
+function scale(field) {
+    return field.scale || 1;
+}
+
+function offset(field) {
+    return field.offset || 0;
+}
+
+// A decoded-unit input: mostly in range, sometimes past either end, sometimes
+// fractional, and the exact limits every so often
+function input(field, k) {
+    var r = range(field);
+    var lo = r[0] * scale(field) + offset(field);
+    var hi = r[1] * scale(field) + offset(field);
+    var span = hi - lo;
+    if (k === 0) {
+        return lo;
+    }
+    if (k === 1) {
+        return hi;
+    }
+    var roll = random();
+    if (roll < 0.1) {
+        return lo - random() * span;
+    }
+    if (roll < 0.2) {
+        return hi + random() * span;
+    }
+    if (roll < 0.4) {
+        return lo + random() * span;
+    }
+    return lo + Math.floor(random() * (r[1] - r[0] + 1)) * scale(field);
+}
+
+// What the schema says a decoder reads back for `value`
+function expected(field, value) {
+    if (field.const !== undefined) {
+        return field.const;
+    }
+    var r = range(field);
+    var raw = Math.max(r[0], Math.min(r[1], Math.round((value - offset(field)) / scale(field))));
+    var decoded = raw * scale(field) + offset(field);
+    if (field.wrap !== undefined) {
+        decoded %= field.wrap;
+    }
+    if (field.codes !== undefined && decoded >= field.codes) {
+        decoded = field.fallback;
+    }
+    return decoded;
+}
+
+function hex(bytes) {
+    return bytes.map(function (b) { return (b < 16 ? '0' : '') + b.toString(16); }).join('');
+}
+
+var failures = 0;
+var lines = [];
+
+schema.records.forEach(function (record) {
+    var pack = wire['pack' + record.js_name];
+    var unpack = wire['unpack' + record.js_name];
+    var size = wire[record.name.toUpperCase() + '_PACKAGE_SIZE'];
+
+    for (var k = 0; k < COUNT; k++) {
+        var fields = {};
+        var want = {};
+        record.fields.forEach(function (field) {
+            var count = field.count || 1;
+            var values = [];
+            var decoded = [];
+            for (var n = 0; n < count; n++) {
+                var value = input(field, k);
+                values.push(value);
+                decoded.push(expected(field, value));
+            }
+            fields[camel(field.name)] = count === 1 ? values[0] : values;
+            want[field.name] = decoded;
+        });
+
+        var bytes = pack(fields);
+        var got = unpack(bytes, 0);
+        var ok = bytes.length === size && bytes.every(function (b) { return b >= 0 && b <= 255; });
+        record.fields.forEach(function (field) {
+            var value = got[camel(field.name)];
+            var values = (field.count || 1) === 1 ? [value] : value;
+            if (JSON.stringify(values) !== JSON.stringify(want[field.name])) {
+                ok = false;
+            }
+        });
+        if (!ok) {
+            failures++;
+            if (failures <= 10) {
+                console.error('JS round trip failed for ' + record.name + ': ' + JSON.stringify(fields) +
+                    ' -> ' + hex(bytes) + ' -> ' + JSON.stringify(got));
+            }
+            continue;
+        }
+
+        lines.push(record.name + ' ' + hex(bytes) + ' ' + record.fields.map(function (field) {
+            return field.name + '=' + want[field.name].join(',');
+        }).join(' '));
+    }
+});
+
+if (failures > 0) {
+    console.error(failures + ' JS round trips failed');
+    process.exit(1);
+}
+console.error('JS round trip: ' + lines.length + ' packages ok');
+process.stdout.write(lines.join('\n') + '\n');
@@ -0,0 +1,198 @@
+/*
+    End-to-end watch
+
+    The watch half of js/bench_e2e.js: boots the whole app (main.c) and lets
+    a PebbleKit JS process on the other end of stdin/stdout play the phone.
+    Everything the phone sends goes through host_app_message_deliver() and
+    the app's own inbox handlers; everything the app sends comes back out.
+
+    Times are milliseconds since boot on the phone's clock. Each command
+    first runs the virtual clock up to its time, so the app's timers and
+    animations keep pace with the phone:
+
+      deliver <ms> <key>=i:<int>|x:<hex> ...   -> done <ms> <AppMessageResult>
+      advance <ms>                              -> done <ms> 0
+      state <ms>                                -> state ..., then done
+      quit
+
+    and the app's side of things is reported as it happens:
+
+      send <ms> <key>=i:<int>|x:<hex> ...       a message from the watch
+      viewer <ms>                               the forecast is on screen
+      startup <stage>=<ms> ...                  when each startup stage was
+                                                reached, once the viewer is
+
+    Keys are the numeric MESSAGE_KEY_* values.
+
+    Usage: e2e_watch
+*/
+
+#include <pebble_host.h>
+
+#include "utils/forecast.h"
+#include "utils/prefs.h"
+#include "utils/startup.h"
+#include "utils/weather.h"
+
+int dribble_main(void);
+
+#define MAX_LINE 4096
+#define MAX_MESSAGE 1024
+
+static uint64_t s_boot_ms;
+static Window* s_first_window;
+static bool s_viewer_shown;
+
+static uint32_t prv_now(void) {
+  return (uint32_t)(host_now_ms() - s_boot_ms);
+}
+
+static void prv_print_hex(const uint8_t* data, uint16_t length) {
+  for (uint16_t i = 0; i < length; i++) {
+    printf("%02x", data[i]);
+  }
+}
+
+// The splash is the first window; the viewer replacing it on top is when
+// the user first sees the forecast
+static void prv_check_viewer(void) {
+  Window* top = window_stack_get_top_window();
+  if (!s_first_window) {
+    s_first_window = top;
+  } else if (!s_viewer_shown && top && top != s_first_window) {
+    s_viewer_shown = true;
+    printf("viewer %u\n", prv_now());
+    const StartupStats* startup = startup_get_stats();
+    printf("startup viewer_built=%u icons_loaded=%u data_ready=%u viewer_shown=%u\n",
+           startup->stage_ms[STARTUP_STAGE_VIEWER_BUILT], startup->stage_ms[STARTUP_STAGE_ICONS_LOADED],
+           startup->stage_ms[STARTUP_STAGE_DATA_READY], startup->stage_ms[STARTUP_STAGE_VIEWER_SHOWN]);
+  }
+}
+
+static void prv_advance_to(uint32_t ms) {
+  // In frame-sized steps, so the viewer is noticed close to when it appears
+  while (prv_now() < ms) {
+    uint32_t step = ms - prv_now();
+    host_advance(step < HOST_FRAME_INTERVAL_MS ? step : HOST_FRAME_INTERVAL_MS);
+    prv_check_viewer();
+  }
+}
+
+static void prv_outbox_hook(const uint8_t* buffer, uint16_t size, void* context) {
+  DictionaryIterator iter;
+  printf("send %u", prv_now());
+  for (Tuple* tuple = dict_read_begin_from_buffer(&iter, buffer, size); tuple; tuple = dict_read_next(&iter)) {
+    if (tuple->type == TUPLE_BYTE_ARRAY || tuple->type == TUPLE_CSTRING) {
+      printf(" %u=x:", (unsigned)tuple->key);
+      prv_print_hex(tuple->value->data, tuple->length);
+    } else {
+      printf(" %u=i:%d", (unsigned)tuple->key, (int)tuple->value->int32);
+    }
+  }
+  printf("\n");
+}
+
+static bool prv_parse_hex(const char* hex, size_t length, uint8_t* out, size_t max) {
+  if (length % 2 != 0 || length / 2 > max) {
+    return false;
+  }
+  for (size_t i = 0; i < length / 2; i++) {
+    unsigned int byte;
+    if (sscanf(&hex[i * 2], "%2x", &byte) != 1) {
+      return false;
+    }
+    out[i] = (uint8_t)byte;
+  }
+  return true;
+}
+
+// Builds the dictionary for a deliver line's key=value pairs
+static bool prv_parse_message(char* pairs, uint8_t* buffer, uint16_t* size) {
+  DictionaryIterator iter;
+  static uint8_t s_data[MAX_MESSAGE];
+  dict_write_begin(&iter, buffer, MAX_MESSAGE);
+  for (char* pair = strtok(pairs, " \n"); pair; pair = strtok(NULL, " \n")) {
+    char* equals = strchr(pair, '=');
+    if (!equals || strlen(equals) < 3 || equals[2] != ':') {
+      return false;
+    }
+    uint32_t key = (uint32_t)strtoul(pair, NULL, 10);
+    const char* value = equals + 3;
+    if (equals[1] == 'i') {
+      dict_write_int32(&iter, key, (int32_t)strtol(value, NULL, 10));
+    } else if (equals[1] == 'x') {
+      size_t length = strlen(value);
+      if (!prv_parse_hex(value, length, s_data, sizeof(s_data))) {
+        return false;
+      }
+      dict_write_data(&iter, key, s_data, (uint16_t)(length / 2));
+    } else {
+      return false;
+    }
+  }
+  *size = (uint16_t)dict_write_end(&iter);
+  return true;
+}
+
+// What the app ended up holding, for the phone to check against what it sent
+static void prv_print_state(void) {
+  uint8_t length = forecast_length();
+  printf("state hours=%u first_hour=", length);
+  if (length > 0 && forecast_has_hour(0)) {
+    prv_print_hex(&forecast_data[forecast_slot(0) * HOUR_PACKAGE_SIZE], HOUR_PACKAGE_SIZE);
+  }
+  printf(" precipitation_type=%u chance=%u minute_steps=", precipitation.precipitation_type,
+         precipitation.chance);
+  for (int i = 0; i < PRECIPITATION_MINUTES; i++) {
+    printf("%x", precipitation.minute_steps[i]);
+  }
+  printf("\n");
+}
+
+static void prv_event_loop(void* context) {
+  static char s_line[MAX_LINE];
+  static uint8_t s_buffer[MAX_MESSAGE];
+  s_boot_ms = host_now_ms();
+  prv_check_viewer();
+  fflush(stdout);
+
+  while (fgets(s_line, sizeof(s_line), stdin)) {
+    char command[16];
+    unsigned int ms = 0;
+    int consumed = 0;
+    if (sscanf(s_line, "%15s %u%n", command, &ms, &consumed) < 1 || strcmp(command, "quit") == 0) {
+      break;
+    }
+    prv_advance_to(ms);
+
+    int result = 0;
+    if (strcmp(command, "deliver") == 0) {
+      uint16_t size;
+      if (prv_parse_message(&s_line[consumed], s_buffer, &size)) {
+        result = host_app_message_deliver(s_buffer, size);
+      } else {
+        fprintf(stderr, "e2e_watch: bad message: %s", s_line);
+        result = APP_MSG_INVALID_ARGS;
+      }
+      prv_check_viewer();
+    } else if (strcmp(command, "state") == 0) {
+      prv_print_state();
+    } else if (strcmp(command, "advance") != 0) {
+      fprintf(stderr, "e2e_watch: unknown command: %s", s_line);
+    }
+    printf("done %u %d\n", prv_now(), result);
+    fflush(stdout);
+  }
+}
+
+int main(int argc, char** argv) {
+  host_reset();
+  prefs_init();
+  host_app_message_set_outbox_hook(prv_outbox_hook, NULL);
+  host_set_event_loop(prv_event_loop, NULL);
+  dribble_main();
+  host_set_event_loop(NULL, NULL);
+  host_app_message_set_outbox_hook(NULL, NULL);
+  host_app_exit();
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*
+    Fuzz target for the forecast decoders
+
+    Feeds arbitrary bytes through the forecast view (forecast.h) and
+    unpack_precipitation() under every unit preference, then checks the
+    invariants the pages rely on: icon codes index their image arrays, and
+    every formatted string is terminated inside its buffer.
+
+    Builds with libFuzzer (make fuzz FUZZ_ENGINE=libfuzzer CC=clang) or, on a
+    gcc-only box, with standalone_driver.c, which replays a corpus and mutates
+    it. The input format is described in bench/msgproc_record.h.
+*/
+
+#include <pebble_host.h>
+
+#include "../bench/msgproc_record.h"
+
+static void prv_check_string(const char* string, size_t capacity, const char* what) {
+  if (memchr(string, '\0', capacity) == NULL) {
+    fprintf(stderr, "fuzz_msgproc: %s is not terminated\n", what);
+    abort();
+  }
+}
+
+static void prv_check_invariants(const MsgprocStrings* strings) {
+  for (uint8_t i = 0; i < 12; i++) {
+    uint8_t conditions_icon = hour_conditions_icon(forecast_data, i);
+    if (conditions_icon >= NUM_WEATHER_CONDITIONS) {
+      fprintf(stderr, "fuzz_msgproc: hour %d conditions_icon %u out of range\n", i, conditions_icon);
+      abort();
+    }
+    uint8_t experiential_icon = hour_experiential_icon(forecast_data, i);
+    if (experiential_icon > NUM_EXPERIENTIAL_ICONS) {
+      fprintf(stderr, "fuzz_msgproc: hour %d experiential_icon %u out of range\n", i, experiential_icon);
+      abort();
+    }
+    int8_t wind_direction = hour_wind_direction(forecast_data, i);
+    if (wind_direction < -1 || wind_direction >= WIND_DIRECTIONS) {
+      fprintf(stderr, "fuzz_msgproc: hour %d wind direction %d out of range\n", i, wind_direction);
+      abort();
+    }
+    uint8_t wind_speed_level = hour_wind_speed_level(forecast_data, i);
+    if (wind_speed_level >= WIND_SPEED_LEVELS) {
+      fprintf(stderr, "fuzz_msgproc: hour %d wind speed level %u out of range\n", i, wind_speed_level);
+      abort();
+    }
+    prv_check_string(hour_label(forecast_data, i), 5, "hour_label");
+    prv_check_string(strings->conditions[i], sizeof(strings->conditions[i]), "conditions");
+    prv_check_string(strings->airflow[i], sizeof(strings->airflow[i]), "airflow");
+    prv_check_string(strings->experiential[i], sizeof(strings->experiential[i]), "experiential");
+  }
+  for (int i = 0; i < PRECIPITATION_INTERVALS; i++) {
+    if (precipitation.precipitation_intensity[i] > 3) {
+      fprintf(stderr, "fuzz_msgproc: precipitation interval %d out of range\n", i);
+      abort();
+    }
+  }
+  for (int i = 0; i < PRECIPITATION_MINUTES; i++) {
+    if (precipitation.minute_steps[i] > PRECIPITATION_MAX_STEPS) {
+      fprintf(stderr, "fuzz_msgproc: precipitation minute %d out of range\n", i);
+      abort();
+    }
+  }
+  if (precipitation.chance > 100) {
+    fprintf(stderr, "fuzz_msgproc: precipitation chance %d out of range\n", precipitation.chance);
+    abort();
+  }
+  prv_check_string(strings->precipitation, sizeof(strings->precipitation), "precipitation");
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  static bool s_initialized;
+  if (!s_initialized) {
+    prefs_init();
+    s_initialized = true;
+  }
+
+  MsgprocRecord record;
+  MsgprocStrings strings;
+  msgproc_record_load(&record, data, size);
+  msgproc_record_decode(&record, &strings);
+  prv_check_invariants(&strings);
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*
+    Standalone fuzz driver
+
+    Stands in for libFuzzer's main() where only gcc is available. Replays
+    every file (or every file in every directory) given on the command line
+    through LLVMFuzzerTestOneInput(), then runs random mutations of those
+    inputs. Built with SANITIZE=1 it catches the same memory errors, just
+    without coverage guidance.
+
+    Usage: fuzz_<target> [-runs=N] [-seed=S] [-max_len=N] <file|dir>...
+*/
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+#define MAX_INPUTS 4096
+#define DEFAULT_MAX_LEN 4096
+
+typedef struct Input {
+  uint8_t* data;
+  size_t size;
+} Input;
+
+static Input s_inputs[MAX_INPUTS];
+static size_t s_input_count;
+static uint64_t s_rng;
+
+static uint32_t prv_random(void) {
+  // xorshift64*: deterministic for a given -seed
+  s_rng ^= s_rng >> 12;
+  s_rng ^= s_rng << 25;
+  s_rng ^= s_rng >> 27;
+  return (uint32_t)((s_rng * 2685821657736338717ull) >> 32);
+}
+
+static void prv_load_file(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (!file || s_input_count >= MAX_INPUTS) {
+    if (file) {
+      fclose(file);
+    }
+    return;
+  }
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  Input* input = &s_inputs[s_input_count++];
+  input->size = size > 0 ? (size_t)size : 0;
+  input->data = malloc(input->size + 1);
+  input->size = fread(input->data, 1, input->size, file);
+  fclose(file);
+}
+
+static void prv_load_path(const char* path) {
+  struct stat info;
+  if (stat(path, &info) != 0) {
+    fprintf(stderr, "standalone_driver: cannot read %s\n", path);
+    return;
+  }
+  if (!S_ISDIR(info.st_mode)) {
+    prv_load_file(path);
+    return;
+  }
+  DIR* dir = opendir(path);
+  struct dirent* entry;
+  while (dir && (entry = readdir(dir))) {
+    if (entry->d_name[0] != '.') {
+      char child[1024];
+      snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+      prv_load_file(child);
+    }
+  }
+  if (dir) {
+    closedir(dir);
+  }
+}
+
+// Byte-level mutations in the spirit of libFuzzer's default mutators.
+static size_t prv_mutate(uint8_t* data, size_t size, size_t max_len) {
+  uint32_t rounds = 1 + prv_random() % 4;
+  for (uint32_t r = 0; r < rounds; r++) {
+    switch (prv_random() % 6) {
+      case 0:  // flip a bit
+        if (size) {
+          data[prv_random() % size] ^= (uint8_t)(1u << (prv_random() % 8));
+        }
+        break;
+      case 1:  // random byte
+        if (size) {
+          data[prv_random() % size] = (uint8_t)prv_random();
+        }
+        break;
+      case 2: {  // interesting value
+        static const uint8_t interesting[] = {0x00, 0x01, 0x0F, 0x10, 0x7F, 0x80, 0xF0, 0xFF};
+        if (size) {
+          data[prv_random() % size] = interesting[prv_random() % sizeof(interesting)];
+        }
+        break;
+      }
+      case 3:  // truncate
+        size = size ? prv_random() % size : 0;
+        break;
+      case 4:  // grow with random bytes
+        while (size < max_len && prv_random() % 4 != 0) {
+          data[size++] = (uint8_t)prv_random();
+        }
+        break;
+      default: {  // copy a chunk within the input
+        if (size > 1) {
+          size_t from = prv_random() % size;
+          size_t to = prv_random() % size;
+          size_t length = 1 + prv_random() % (size - (from > to ? from : to));
+          memmove(&data[to], &data[from], length);
+        }
+        break;
+      }
+    }
+  }
+  return size;
+}
+
+int main(int argc, char** argv) {
+  unsigned long runs = 0;
+  unsigned long long seed = 1;
+  size_t max_len = DEFAULT_MAX_LEN;
+
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "-runs=", 6) == 0) {
+      runs = strtoul(argv[i] + 6, NULL, 10);
+    } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+      seed = strtoull(argv[i] + 6, NULL, 10);
+    } else if (strncmp(argv[i], "-max_len=", 9) == 0) {
+      max_len = strtoul(argv[i] + 9, NULL, 10);
+    } else if (argv[i][0] == '-') {
+      // libFuzzer flags this driver does not implement are ignored.
+    } else {
+      prv_load_path(argv[i]);
+    }
+  }
+  s_rng = seed ? seed : 1;
+
+  for (size_t i = 0; i < s_input_count; i++) {
+    LLVMFuzzerTestOneInput(s_inputs[i].data, s_inputs[i].size);
+  }
+
+  uint8_t* scratch = malloc(max_len);
+  for (unsigned long run = 0; run < runs; run++) {
+    size_t size = 0;
+    if (s_input_count > 0) {
+      const Input* base = &s_inputs[prv_random() % s_input_count];
+      size = base->size < max_len ? base->size : max_len;
+      memcpy(scratch, base->data, size);
+    }
+    size = prv_mutate(scratch, size, max_len);
+    LLVMFuzzerTestOneInput(scratch, size);
+  }
+  free(scratch);
+
+  printf("standalone_driver: %zu corpus inputs, %lu mutations, seed %llu: ok\n", s_input_count, runs, seed);
+  for (size_t i = 0; i < s_input_count; i++) {
+    free(s_inputs[i].data);
+  }
+  return 0;
+}
@@ -0,0 +1,692 @@
+/*
+    Host pebble.h
+
+    A minimal stand-in for the Pebble SDK header so the C core in app/src/c can
+    be compiled and measured on a Linux box. It only declares what dribble
+    actually uses. Behaviour lives in app/host/src:
+
+    - heap.c     malloc/calloc/realloc/free counter (app and SDK buckets)
+    - clock.c    virtual clock, AppTimer and the Animation scheduler
+    - layer.c    Layer, TextLayer, StatusBarLayer, Window, window stack, clicks
+    - gdraw.c    GDrawCommand parsing of the real .pdc resources, GPath, graphics
+    - system.c   persist, dictionaries, AppMessage, fonts, trig, logging
+
+    Host-only controls (advancing the clock, injecting clicks, reading the
+    counters) are declared in pebble_host.h.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PBL_HOST_SHIM 1
+
+#define ARRAY_LENGTH(array) (sizeof((array)) / sizeof((array)[0]))
+
+// ── Platform ──────────────────────────────────────────────────────────────────
+// The Makefile passes -DPBL_PLATFORM_<NAME>; everything else is derived here the
+// same way the SDK derives it from the target platform.
+#if !defined(PBL_PLATFORM_APLITE) && !defined(PBL_PLATFORM_BASALT) && \
+    !defined(PBL_PLATFORM_CHALK) && !defined(PBL_PLATFORM_DIORITE) && \
+    !defined(PBL_PLATFORM_EMERY) && !defined(PBL_PLATFORM_FLINT) && \
+    !defined(PBL_PLATFORM_GABBRO)
+  #define PBL_PLATFORM_BASALT
+#endif
+
+#if defined(PBL_PLATFORM_APLITE) || defined(PBL_PLATFORM_DIORITE) || defined(PBL_PLATFORM_FLINT)
+  #define PBL_BW
+#else
+  #define PBL_COLOR
+#endif
+
+#if defined(PBL_PLATFORM_CHALK) || defined(PBL_PLATFORM_GABBRO)
+  #define PBL_ROUND
+#else
+  #define PBL_RECT
+#endif
+
+#if defined(PBL_PLATFORM_CHALK)
+  #define PBL_DISPLAY_WIDTH 180
+  #define PBL_DISPLAY_HEIGHT 180
+#elif defined(PBL_PLATFORM_EMERY)
+  #define PBL_DISPLAY_WIDTH 200
+  #define PBL_DISPLAY_HEIGHT 228
+#elif defined(PBL_PLATFORM_GABBRO)
+  #define PBL_DISPLAY_WIDTH 260
+  #define PBL_DISPLAY_HEIGHT 260
+#else
+  #define PBL_DISPLAY_WIDTH 144
+  #define PBL_DISPLAY_HEIGHT 168
+#endif
+
+#ifdef PBL_COLOR
+  #define PBL_IF_COLOR_ELSE(if_true, if_false) (if_true)
+  #define PBL_IF_BW_ELSE(if_true, if_false) (if_false)
+#else
+  #define PBL_IF_COLOR_ELSE(if_true, if_false) (if_false)
+  #define PBL_IF_BW_ELSE(if_true, if_false) (if_true)
+#endif
+
+#ifdef PBL_ROUND
+  #define PBL_IF_ROUND_ELSE(if_true, if_false) (if_true)
+  #define PBL_IF_RECT_ELSE(if_true, if_false) (if_false)
+#else
+  #define PBL_IF_ROUND_ELSE(if_true, if_false) (if_false)
+  #define PBL_IF_RECT_ELSE(if_true, if_false) (if_true)
+#endif
+
+// ── Heap ──────────────────────────────────────────────────────────────────────
+// Every allocation made by the app goes through the counter in heap.c.
+void* host_malloc(size_t size);
+void* host_calloc(size_t count, size_t size);
+void* host_realloc(void* ptr, size_t size);
+void host_free(void* ptr);
+
+#if defined(PBL_PLATFORM_APLITE)
+  #define HOST_APP_HEAP_LIMIT (24 * 1024)
+#elif defined(PBL_PLATFORM_EMERY) || defined(PBL_PLATFORM_GABBRO)
+  #define HOST_APP_HEAP_LIMIT (128 * 1024)
+#else
+  #define HOST_APP_HEAP_LIMIT (64 * 1024)
+#endif
+
+// The shim itself calls host_malloc() and friends explicitly, so that it can
+// still reach the C library's allocator for its own bookkeeping.
+#ifndef HOST_SHIM_INTERNAL
+  #define malloc(size) host_malloc(size)
+  #define calloc(count, size) host_calloc(count, size)
+  #define realloc(ptr, size) host_realloc(ptr, size)
+  #define free(ptr) host_free(ptr)
+#endif
+
+size_t heap_bytes_free(void);
+size_t heap_bytes_used(void);
+
+// ── Logging ───────────────────────────────────────────────────────────────────
+typedef enum {
+  APP_LOG_LEVEL_ERROR = 1,
+  APP_LOG_LEVEL_WARNING = 50,
+  APP_LOG_LEVEL_INFO = 100,
+  APP_LOG_LEVEL_DEBUG = 200,
+  APP_LOG_LEVEL_DEBUG_VERBOSE = 255,
+} AppLogLevel;
+
+void app_log(uint8_t log_level, const char* src_filename, int src_line_number, const char* fmt, ...);
+
+#define APP_LOG(level, fmt, ...) app_log(level, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
+
+// ── Geometry ──────────────────────────────────────────────────────────────────
+typedef struct GPoint {
+  int16_t x;
+  int16_t y;
+} GPoint;
+
+typedef struct GSize {
+  int16_t w;
+  int16_t h;
+} GSize;
+
+typedef struct GRect {
+  GPoint origin;
+  GSize size;
+} GRect;
+
+#define GPoint(x, y) ((GPoint){(x), (y)})
+#define GPointZero GPoint(0, 0)
+#define GSize(w, h) ((GSize){(w), (h)})
+#define GSizeZero GSize(0, 0)
+#define GRect(x, y, w, h) ((GRect){{(x), (y)}, {(w), (h)}})
+#define GRectZero GRect(0, 0, 0, 0)
+
+bool gpoint_equal(const GPoint* const point_a, const GPoint* const point_b);
+bool grect_equal(const GRect* const rect_a, const GRect* const rect_b);
+GPoint grect_center_point(const GRect* rect);
+
+typedef enum {
+  GCornerNone = 0,
+  GCornerTopLeft = 1 << 0,
+  GCornerTopRight = 1 << 1,
+  GCornerBottomLeft = 1 << 2,
+  GCornerBottomRight = 1 << 3,
+  GCornersAll = GCornerTopLeft | GCornerTopRight | GCornerBottomLeft | GCornerBottomRight,
+} GCornerMask;
+
+typedef enum {
+  GOvalScaleModeFitCircle,
+  GOvalScaleModeFillCircle,
+} GOvalScaleMode;
+
+// ── Colour ────────────────────────────────────────────────────────────────────
+typedef union GColor8 {
+  uint8_t argb;
+  struct {
+    uint8_t b:2;
+    uint8_t g:2;
+    uint8_t r:2;
+    uint8_t a:2;
+  };
+} GColor8;
+
+typedef GColor8 GColor;
+
+#define GColorFromHEX(v) ((GColor8){.argb = (uint8_t)(0xC0 | \
+    ((((v) >> 22) & 0x3) << 4) | ((((v) >> 14) & 0x3) << 2) | (((v) >> 6) & 0x3))})
+
+#define GColorClear                 ((GColor8){.argb = 0x00})
+#define GColorBlack                 ((GColor8){.argb = 0xC0})
+#define GColorWhite                 ((GColor8){.argb = 0xFF})
+#define GColorDarkGray              ((GColor8){.argb = 0xD5})
+#define GColorLightGray             ((GColor8){.argb = 0xEA})
+#define GColorBabyBlueEyes          ((GColor8){.argb = 0xEB})
+#define GColorCeleste               ((GColor8){.argb = 0xEF})
+#define GColorCyan                  ((GColor8){.argb = 0xCF})
+#define GColorIcterine              ((GColor8){.argb = 0xFD})
+#define GColorLavenderIndigo        ((GColor8){.argb = 0xE7})
+#define GColorMediumSpringGreen     ((GColor8){.argb = 0xCE})
+#define GColorPastelYellow          ((GColor8){.argb = 0xFE})
+#define GColorPictonBlue            ((GColor8){.argb = 0xDB})
+#define GColorRichBrilliantLavender ((GColor8){.argb = 0xFB})
+#define GColorSunsetOrange          ((GColor8){.argb = 0xF5})
+#define GColorVeryLightBlue         ((GColor8){.argb = 0xD7})
+#define GColorVividCerulean         ((GColor8){.argb = 0xCB})
+#define GColorYellow                ((GColor8){.argb = 0xFC})
+#define GColorRed                   ((GColor8){.argb = 0xF0})
+#define GColorGreen                 ((GColor8){.argb = 0xCC})
+#define GColorBlue                  ((GColor8){.argb = 0xC3})
+
+bool gcolor_equal(GColor8 color_a, GColor8 color_b);
+#define GColorEq(a, b) gcolor_equal((a), (b))
+
+// ── Bitmaps ───────────────────────────────────────────────────────────────────
+typedef enum GBitmapFormat {
+  GBitmapFormat1Bit = 0,
+  GBitmapFormat8Bit,
+  GBitmapFormat1BitPalette,
+  GBitmapFormat2BitPalette,
+  GBitmapFormat4BitPalette,
+  GBitmapFormat8BitCircular,
+} GBitmapFormat;
+
+typedef struct GBitmap GBitmap;
+
+GBitmap* gbitmap_create_blank(GSize size, GBitmapFormat format);
+void gbitmap_destroy(GBitmap* bitmap);
+uint8_t* gbitmap_get_data(const GBitmap* bitmap);
+uint16_t gbitmap_get_bytes_per_row(const GBitmap* bitmap);
+GBitmapFormat gbitmap_get_format(const GBitmap* bitmap);
+GRect gbitmap_get_bounds(const GBitmap* bitmap);
+
+typedef struct {
+  uint8_t* data;  // the byte holding column 0 of the row
+  int16_t min_x;  // first and last columns that exist on the display
+  int16_t max_x;
+} GBitmapDataRowInfo;
+
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap* bitmap, uint16_t y);
+
+// ── Graphics context ──────────────────────────────────────────────────────────
+typedef struct GContext GContext;
+
+typedef enum {
+  GCompOpAssign,
+  GCompOpAssignInverted,
+  GCompOpOr,
+  GCompOpAnd,
+  GCompOpClear,
+  GCompOpSet,
+} GCompOp;
+
+void graphics_context_set_stroke_color(GContext* ctx, GColor color);
+void graphics_context_set_fill_color(GContext* ctx, GColor color);
+void graphics_context_set_text_color(GContext* ctx, GColor color);
+void graphics_context_set_stroke_width(GContext* ctx, uint8_t stroke_width);
+void graphics_context_set_antialiased(GContext* ctx, bool enable);
+void graphics_context_set_compositing_mode(GContext* ctx, GCompOp mode);
+
+void graphics_draw_pixel(GContext* ctx, GPoint point);
+void graphics_draw_line(GContext* ctx, GPoint p0, GPoint p1);
+void graphics_draw_rect(GContext* ctx, GRect rect);
+void graphics_fill_rect(GContext* ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask);
+void graphics_draw_circle(GContext* ctx, GPoint p, uint16_t radius);
+void graphics_fill_circle(GContext* ctx, GPoint p, uint16_t radius);
+void graphics_draw_arc(GContext* ctx, GRect rect, GOvalScaleMode scale_mode, int32_t angle_start, int32_t angle_end);
+void graphics_fill_radial(GContext* ctx, GRect rect, GOvalScaleMode scale_mode, uint16_t inset_thickness,
+                          int32_t angle_start, int32_t angle_end);
+void graphics_draw_bitmap_in_rect(GContext* ctx, const GBitmap* bitmap, GRect rect);
+GBitmap* graphics_capture_frame_buffer(GContext* ctx);
+GBitmap* graphics_capture_frame_buffer_format(GContext* ctx, GBitmapFormat format);
+bool graphics_release_frame_buffer(GContext* ctx, GBitmap* buffer);
+GPoint gpoint_from_polar(GRect container, GOvalScaleMode scale_mode, int32_t angle);
+
+// ── Paths ─────────────────────────────────────────────────────────────────────
+typedef struct GPathInfo {
+  uint32_t num_points;
+  GPoint* points;
+} GPathInfo;
+
+typedef struct GPath {
+  uint32_t num_points;
+  GPoint* points;
+  int32_t rotation;
+  GPoint offset;
+} GPath;
+
+GPath* gpath_create(const GPathInfo* init);
+void gpath_destroy(GPath* path);
+void gpath_draw_filled(GContext* ctx, GPath* path);
+void gpath_draw_outline(GContext* ctx, GPath* path);
+void gpath_move_to(GPath* path, GPoint point);
+
+// ── Draw commands (PDC) ───────────────────────────────────────────────────────
+typedef enum {
+  GDrawCommandTypeInvalid = 0,
+  GDrawCommandTypePath,
+  GDrawCommandTypeCircle,
+  GDrawCommandTypePrecisePath,
+} GDrawCommandType;
+
+typedef struct GDrawCommand GDrawCommand;
+typedef struct GDrawCommandList GDrawCommandList;
+typedef struct GDrawCommandImage GDrawCommandImage;
+
+GDrawCommandImage* gdraw_command_image_create_with_resource(uint32_t resource_id);
+GDrawCommandImage* gdraw_command_image_clone(GDrawCommandImage* image);
+void gdraw_command_image_destroy(GDrawCommandImage* image);
+void gdraw_command_image_draw(GContext* ctx, GDrawCommandImage* image, GPoint offset);
+GSize gdraw_command_image_get_bounds_size(GDrawCommandImage* image);
+void gdraw_command_image_set_bounds_size(GDrawCommandImage* image, GSize size);
+GDrawCommandList* gdraw_command_image_get_command_list(GDrawCommandImage* image);
+
+uint32_t gdraw_command_list_get_num_commands(GDrawCommandList* command_list);
+GDrawCommand* gdraw_command_list_get_command(GDrawCommandList* command_list, uint16_t command_idx);
+void gdraw_command_list_draw(GContext* ctx, GDrawCommandList* command_list);
+
+GDrawCommandType gdraw_command_get_type(GDrawCommand* command);
+uint16_t gdraw_command_get_num_points(GDrawCommand* command);
+GPoint gdraw_command_get_point(GDrawCommand* command, uint16_t point_idx);
+void gdraw_command_set_point(GDrawCommand* command, uint16_t point_idx, GPoint point);
+uint16_t gdraw_command_get_radius(GDrawCommand* command);
+GColor gdraw_command_get_fill_color(GDrawCommand* command);
+void gdraw_command_set_fill_color(GDrawCommand* command, GColor fill_color);
+GColor gdraw_command_get_stroke_color(GDrawCommand* command);
+void gdraw_command_set_stroke_color(GDrawCommand* command, GColor stroke_color);
+uint8_t gdraw_command_get_stroke_width(GDrawCommand* command);
+void gdraw_command_set_stroke_width(GDrawCommand* command, uint8_t stroke_width);
+bool gdraw_command_get_hidden(GDrawCommand* command);
+void gdraw_command_set_hidden(GDrawCommand* command, bool hidden);
+
+// ── Fonts and text ────────────────────────────────────────────────────────────
+typedef struct HostFont* GFont;
+
+typedef enum {
+  GTextAlignmentLeft,
+  GTextAlignmentCenter,
+  GTextAlignmentRight,
+} GTextAlignment;
+
+typedef enum {
+  GTextOverflowModeWordWrap,
+  GTextOverflowModeTrailingEllipsis,
+  GTextOverflowModeFill,
+} GTextOverflowMode;
+
+#define FONT_KEY_GOTHIC_18 "RESOURCE_ID_GOTHIC_18"
+#define FONT_KEY_GOTHIC_18_BOLD "RESOURCE_ID_GOTHIC_18_BOLD"
+#define FONT_KEY_GOTHIC_24_BOLD "RESOURCE_ID_GOTHIC_24_BOLD"
+#define FONT_KEY_GOTHIC_28 "RESOURCE_ID_GOTHIC_28"
+#define FONT_KEY_LECO_20_BOLD_NUMBERS "RESOURCE_ID_LECO_20_BOLD_NUMBERS"
+#define FONT_KEY_LECO_26_BOLD_NUMBERS_AM_PM "RESOURCE_ID_LECO_26_BOLD_NUMBERS_AM_PM"
+
+GFont fonts_get_system_font(const char* font_key);
+
+// ── Layers ────────────────────────────────────────────────────────────────────
+typedef struct Layer Layer;
+typedef void (*LayerUpdateProc)(struct Layer* layer, GContext* ctx);
+
+Layer* layer_create(GRect frame);
+Layer* layer_create_with_data(GRect frame, size_t data_size);
+void layer_destroy(Layer* layer);
+void layer_mark_dirty(Layer* layer);
+void layer_set_update_proc(Layer* layer, LayerUpdateProc update_proc);
+void layer_set_frame(Layer* layer, GRect frame);
+GRect layer_get_frame(const Layer* layer);
+void layer_set_bounds(Layer* layer, GRect bounds);
+GRect layer_get_bounds(const Layer* layer);
+GRect layer_get_unobstructed_bounds(const Layer* layer);
+struct Window* layer_get_window(const Layer* layer);
+void layer_remove_from_parent(Layer* child);
+void layer_remove_child_layers(Layer* parent);
+void layer_add_child(Layer* parent, Layer* child);
+void layer_insert_below_sibling(Layer* layer_to_insert, Layer* below_sibling_layer);
+void layer_insert_above_sibling(Layer* layer_to_insert, Layer* above_sibling_layer);
+void layer_set_hidden(Layer* layer, bool hidden);
+bool layer_get_hidden(const Layer* layer);
+void layer_set_clips(Layer* layer, bool clips);
+bool layer_get_clips(const Layer* layer);
+void* layer_get_data(const Layer* layer);
+
+typedef struct TextLayer TextLayer;
+
+TextLayer* text_layer_create(GRect frame);
+void text_layer_destroy(TextLayer* text_layer);
+Layer* text_layer_get_layer(TextLayer* text_layer);
+void text_layer_set_text(TextLayer* text_layer, const char* text);
+const char* text_layer_get_text(TextLayer* text_layer);
+void text_layer_set_background_color(TextLayer* text_layer, GColor color);
+void text_layer_set_text_color(TextLayer* text_layer, GColor color);
+void text_layer_set_overflow_mode(TextLayer* text_layer, GTextOverflowMode line_mode);
+void text_layer_set_font(TextLayer* text_layer, GFont font);
+void text_layer_set_text_alignment(TextLayer* text_layer, GTextAlignment text_alignment);
+
+typedef struct StatusBarLayer StatusBarLayer;
+
+#define STATUS_BAR_LAYER_HEIGHT PBL_IF_ROUND_ELSE(24, 16)
+
+StatusBarLayer* status_bar_layer_create(void);
+void status_bar_layer_destroy(StatusBarLayer* status_bar_layer);
+Layer* status_bar_layer_get_layer(StatusBarLayer* status_bar_layer);
+void status_bar_layer_set_colors(StatusBarLayer* status_bar_layer, GColor background, GColor foreground);
+
+// ── Windows and clicks ────────────────────────────────────────────────────────
+typedef struct Window Window;
+
+typedef void (*WindowHandler)(struct Window* window);
+
+typedef struct WindowHandlers {
+  WindowHandler load;
+  WindowHandler appear;
+  WindowHandler disappear;
+  WindowHandler unload;
+} WindowHandlers;
+
+typedef enum {
+  BUTTON_ID_BACK = 0,
+  BUTTON_ID_UP,
+  BUTTON_ID_SELECT,
+  BUTTON_ID_DOWN,
+  NUM_BUTTONS
+} ButtonId;
+
+typedef void* ClickRecognizerRef;
+typedef void (*ClickHandler)(ClickRecognizerRef recognizer, void* context);
+typedef void (*ClickConfigProvider)(void* context);
+
+Window* window_create(void);
+void window_destroy(Window* window);
+void window_set_window_handlers(Window* window, WindowHandlers handlers);
+void window_set_click_config_provider(Window* window, ClickConfigProvider click_config_provider);
+void window_set_click_config_provider_with_context(Window* window, ClickConfigProvider click_config_provider,
+                                                   void* context);
+Layer* window_get_root_layer(const Window* window);
+void window_set_background_color(Window* window, GColor background_color);
+bool window_is_loaded(Window* window);
+void window_set_user_data(Window* window, void* data);
+void* window_get_user_data(const Window* window);
+
+void window_stack_push(Window* window, bool animated);
+Window* window_stack_pop(bool animated);
+bool window_stack_remove(Window* window, bool animated);
+Window* window_stack_get_top_window(void);
+bool window_stack_contains_window(Window* window);
+
+void window_single_click_subscribe(ButtonId button_id, ClickHandler handler);
+void window_single_repeating_click_subscribe(ButtonId button_id, uint16_t repeat_interval_ms, ClickHandler handler);
+void window_long_click_subscribe(ButtonId button_id, uint16_t delay_ms, ClickHandler down_handler,
+                                 ClickHandler up_handler);
+bool click_recognizer_is_repeating(ClickRecognizerRef recognizer);
+uint8_t click_number_of_clicks_counted(ClickRecognizerRef recognizer);
+
+// ── Timers ────────────────────────────────────────────────────────────────────
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void* data);
+
+AppTimer* app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void* callback_data);
+bool app_timer_reschedule(AppTimer* timer_handle, uint32_t new_timeout_ms);
+void app_timer_cancel(AppTimer* timer_handle);
+
+time_t time(time_t* tloc);
+uint16_t time_ms(time_t* tloc, uint16_t* out_ms);
+void psleep(int millis);
+
+// ── Animation ─────────────────────────────────────────────────────────────────
+typedef struct Animation Animation;
+typedef struct PropertyAnimation PropertyAnimation;
+
+typedef int32_t AnimationProgress;
+
+#define ANIMATION_NORMALIZED_MIN 0
+#define ANIMATION_NORMALIZED_MAX 65535
+#define ANIMATION_DURATION_INFINITE ((uint32_t)~0)
+#define ANIMATION_PLAY_COUNT_INFINITE ((uint32_t)~0)
+
+typedef enum {
+  AnimationCurveLinear = 0,
+  AnimationCurveEaseIn = 1,
+  AnimationCurveEaseOut = 2,
+  AnimationCurveEaseInOut = 3,
+  AnimationCurveDefault = AnimationCurveEaseInOut,
+  AnimationCurveCustomFunction = 4,
+} AnimationCurve;
+
+typedef AnimationProgress (*AnimationCurveFunction)(AnimationProgress linear_distance);
+
+typedef void (*AnimationStartedHandler)(Animation* animation, void* context);
+typedef void (*AnimationStoppedHandler)(Animation* animation, bool finished, void* context);
+
+typedef struct AnimationHandlers {
+  AnimationStartedHandler started;
+  AnimationStoppedHandler stopped;
+} AnimationHandlers;
+
+typedef void (*AnimationSetupImplementation)(Animation* animation);
+typedef void (*AnimationUpdateImplementation)(Animation* animation, const AnimationProgress progress);
+typedef void (*AnimationTeardownImplementation)(Animation* animation);
+
+typedef struct AnimationImplementation {
+  AnimationSetupImplementation setup;
+  AnimationUpdateImplementation update;
+  AnimationTeardownImplementation teardown;
+} AnimationImplementation;
+
+Animation* animation_create(void);
+bool animation_destroy(Animation* animation);
+Animation* animation_clone(Animation* from);
+Animation* animation_sequence_create_from_array(Animation** animation_array, uint32_t array_len);
+Animation* animation_spawn_create_from_array(Animation** animation_array, uint32_t array_len);
+bool animation_set_elapsed(Animation* animation, uint32_t elapsed_ms);
+bool animation_get_elapsed(Animation* animation, int32_t* elapsed_ms);
+bool animation_set_reverse(Animation* animation, bool reverse);
+bool animation_get_reverse(Animation* animation);
+bool animation_set_play_count(Animation* animation, uint32_t play_count);
+bool animation_set_duration(Animation* animation, uint32_t duration_ms);
+uint32_t animation_get_duration(Animation* animation, bool include_delay, bool include_play_count);
+bool animation_set_delay(Animation* animation, uint32_t delay_ms);
+uint32_t animation_get_delay(Animation* animation);
+bool animation_set_curve(Animation* animation, AnimationCurve curve);
+AnimationCurve animation_get_curve(Animation* animation);
+bool animation_set_custom_curve(Animation* animation, AnimationCurveFunction curve_function);
+bool animation_set_handlers(Animation* animation, AnimationHandlers callbacks, void* context);
+void* animation_get_context(Animation* animation);
+bool animation_schedule(Animation* animation);
+bool animation_unschedule(Animation* animation);
+void animation_unschedule_all(void);
+bool animation_is_scheduled(Animation* animation);
+bool animation_set_implementation(Animation* animation, const AnimationImplementation* implementation);
+const AnimationImplementation* animation_get_implementation(Animation* animation);
+
+PropertyAnimation* property_animation_create_layer_frame(struct Layer* layer, GRect* from_frame, GRect* to_frame);
+void property_animation_destroy(PropertyAnimation* property_animation);
+Animation* property_animation_get_animation(PropertyAnimation* property_animation);
+bool property_animation_get_subject(PropertyAnimation* property_animation, void** subject);
+bool property_animation_from(PropertyAnimation* property_animation, void* from, size_t size, bool set);
+bool property_animation_to(PropertyAnimation* property_animation, void* to, size_t size, bool set);
+
+// ── Trigonometry ──────────────────────────────────────────────────────────────
+#define TRIG_MAX_RATIO 0xffff
+#define TRIG_MAX_ANGLE 0x10000
+#define DEG_TO_TRIGANGLE(angle) (((angle) * TRIG_MAX_ANGLE) / 360)
+#define TRIGANGLE_TO_DEG(trig_angle) (((trig_angle) * 360) / TRIG_MAX_ANGLE)
+
+int32_t sin_lookup(int32_t angle);
+int32_t cos_lookup(int32_t angle);
+int32_t atan2_lookup(int16_t y, int16_t x);
+
+// ── Storage ───────────────────────────────────────────────────────────────────
+#define PERSIST_DATA_MAX_LENGTH 256
+#define PERSIST_STRING_MAX_LENGTH PERSIST_DATA_MAX_LENGTH
+
+typedef int32_t status_t;
+
+typedef enum {
+  S_SUCCESS = 0,
+  E_ERROR = -1,
+  E_UNKNOWN = -2,
+  E_INTERNAL = -3,
+  E_INVALID_ARGUMENT = -4,
+  E_OUT_OF_MEMORY = -5,
+  E_OUT_OF_STORAGE = -6,
+  E_OUT_OF_RESOURCES = -7,
+  E_RANGE = -8,
+  E_DOES_NOT_EXIST = -9,
+  E_INVALID_OPERATION = -10,
+  E_BUSY = -11,
+  S_TRUE = 1,
+  S_FALSE = 0,
+  S_NO_MORE_ITEMS = 2,
+  S_NO_ACTION_REQUIRED = 3,
+} StatusCode;
+
+bool persist_exists(const uint32_t key);
+int persist_get_size(const uint32_t key);
+int32_t persist_read_int(const uint32_t key);
+int persist_read_data(const uint32_t key, void* buffer, const size_t buffer_size);
+int persist_read_string(const uint32_t key, char* buffer, const size_t buffer_size);
+status_t persist_write_int(const uint32_t key, const int32_t value);
+int persist_write_data(const uint32_t key, const void* data, const size_t size);
+int persist_write_string(const uint32_t key, const char* cstring);
+status_t persist_delete(const uint32_t key);
+
+// ── Dictionaries ──────────────────────────────────────────────────────────────
+typedef enum {
+  TUPLE_BYTE_ARRAY = 0,
+  TUPLE_CSTRING = 1,
+  TUPLE_UINT = 2,
+  TUPLE_INT = 3,
+} TupleType;
+
+typedef struct __attribute__((__packed__)) Tuple {
+  uint32_t key;
+  TupleType type:8;
+  uint16_t length;
+  union {
+    uint8_t data[0];
+    char cstring[0];
+    uint8_t uint8;
+    uint16_t uint16;
+    uint32_t uint32;
+    int8_t int8;
+    int16_t int16;
+    int32_t int32;
+  } value[];
+} Tuple;
+
+typedef struct Dictionary Dictionary;
+
+typedef struct DictionaryIterator {
+  Dictionary* dictionary;
+  const void* end;
+  Tuple* cursor;
+} DictionaryIterator;
+
+typedef enum {
+  DICT_OK = 0,
+  DICT_NOT_ENOUGH_STORAGE = 1 << 1,
+  DICT_INVALID_ARGS = 1 << 2,
+  DICT_INTERNAL_INCONSISTENCY = 1 << 3,
+  DICT_MALLOC_FAILED = 1 << 4,
+} DictionaryResult;
+
+uint32_t dict_calc_buffer_size(const uint8_t tuple_count, ...);
+uint32_t dict_size(DictionaryIterator* iter);
+DictionaryResult dict_write_begin(DictionaryIterator* iter, uint8_t* const buffer, const uint16_t size);
+DictionaryResult dict_write_data(DictionaryIterator* iter, const uint32_t key, const uint8_t* const data,
+                                 const uint16_t size);
+DictionaryResult dict_write_cstring(DictionaryIterator* iter, const uint32_t key, const char* const cstring);
+DictionaryResult dict_write_int(DictionaryIterator* iter, const uint32_t key, const void* integer,
+                                const uint8_t width_bytes, const bool is_signed);
+DictionaryResult dict_write_uint8(DictionaryIterator* iter, const uint32_t key, const uint8_t value);
+DictionaryResult dict_write_uint16(DictionaryIterator* iter, const uint32_t key, const uint16_t value);
+DictionaryResult dict_write_uint32(DictionaryIterator* iter, const uint32_t key, const uint32_t value);
+DictionaryResult dict_write_int8(DictionaryIterator* iter, const uint32_t key, const int8_t value);
+DictionaryResult dict_write_int16(DictionaryIterator* iter, const uint32_t key, const int16_t value);
+DictionaryResult dict_write_int32(DictionaryIterator* iter, const uint32_t key, const int32_t value);
+uint32_t dict_write_end(DictionaryIterator* iter);
+Tuple* dict_read_begin_from_buffer(DictionaryIterator* iter, const uint8_t* const buffer, const uint16_t size);
+Tuple* dict_read_next(DictionaryIterator* iter);
+Tuple* dict_read_first(DictionaryIterator* iter);
+Tuple* dict_find(const DictionaryIterator* iter, const uint32_t key);
+
+// ── AppMessage ────────────────────────────────────────────────────────────────
+typedef enum {
+  APP_MSG_OK = 0,
+  APP_MSG_SEND_TIMEOUT = 1 << 1,
+  APP_MSG_SEND_REJECTED = 1 << 2,
+  APP_MSG_NOT_CONNECTED = 1 << 3,
+  APP_MSG_APP_NOT_RUNNING = 1 << 4,
+  APP_MSG_INVALID_ARGS = 1 << 5,
+  APP_MSG_BUSY = 1 << 6,
+  APP_MSG_BUFFER_OVERFLOW = 1 << 7,
+  APP_MSG_ALREADY_RELEASED = 1 << 9,
+  APP_MSG_CALLBACK_ALREADY_REGISTERED = 1 << 10,
+  APP_MSG_CALLBACK_NOT_REGISTERED = 1 << 11,
+  APP_MSG_OUT_OF_MEMORY = 1 << 12,
+  APP_MSG_CLOSED = 1 << 13,
+  APP_MSG_INTERNAL_ERROR = 1 << 14,
+  APP_MSG_INVALID_STATE = 1 << 15,
+} AppMessageResult;
+
+#define APP_MESSAGE_INBOX_SIZE_MINIMUM 124
+#define APP_MESSAGE_OUTBOX_SIZE_MINIMUM 636
+
+typedef void (*AppMessageInboxReceived)(DictionaryIterator* iterator, void* context);
+typedef void (*AppMessageInboxDropped)(AppMessageResult reason, void* context);
+typedef void (*AppMessageOutboxSent)(DictionaryIterator* iterator, void* context);
+typedef void (*AppMessageOutboxFailed)(DictionaryIterator* iterator, AppMessageResult reason, void* context);
+
+AppMessageResult app_message_open(const uint32_t size_inbound, const uint32_t size_outbound);
+void app_message_deregister_callbacks(void);
+void* app_message_get_context(void);
+void* app_message_set_context(void* context);
+AppMessageInboxReceived app_message_register_inbox_received(AppMessageInboxReceived received_callback);
+AppMessageInboxDropped app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback);
+AppMessageOutboxSent app_message_register_outbox_sent(AppMessageOutboxSent sent_callback);
+AppMessageOutboxFailed app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback);
+uint32_t app_message_inbox_size_maximum(void);
+uint32_t app_message_outbox_size_maximum(void);
+AppMessageResult app_message_outbox_begin(DictionaryIterator** iterator);
+AppMessageResult app_message_outbox_send(void);
+
+// ── Misc services ─────────────────────────────────────────────────────────────
+void vibes_short_pulse(void);
+void vibes_long_pulse(void);
+void vibes_double_pulse(void);
+void light_enable_interaction(void);
+void app_event_loop(void);
+
+// ── Host profiling ────────────────────────────────────────────────────────────
+// Not part of the SDK. Lets app code mark which subsystem it is running on
+// behalf of (see ANIMATION_PROFILE_SCOPE); the counters live in pebble_host.h.
+const char* host_profile_begin(const char* zone);
+const char* host_profile_begin_update(const char* zone);
+void host_profile_scope_end(const char** zone);
+const char* host_profile_current_name(void);
+
+// ── Generated resource and message key IDs ────────────────────────────────────
+#include "resource_ids.auto.h"
+#include "message_keys.auto.h"
@@ -0,0 +1,166 @@
+/*
+    Host controls
+
+    Things a benchmark or harness needs that the real SDK has no notion of:
+    driving the virtual clock, injecting button presses and AppMessages, and
+    reading back the heap, render and messaging counters.
+
+    Nothing in app/src/c includes this header.
+*/
+
+#pragma once
+
+#include <pebble.h>
+
+// ── Heap ──────────────────────────────────────────────────────────────────────
+// Allocations are split into two buckets: the app bucket is everything the
+// watchapp allocates through malloc/calloc/realloc (including SDK objects such
+// as layers and animations, which live in the app heap on the watch), the host
+// bucket is bookkeeping the shim needs that has no on-watch equivalent.
+typedef struct HostHeapStats {
+  size_t bytes_in_use;
+  size_t peak_bytes_in_use;
+  uint32_t blocks_in_use;
+  uint32_t allocs;
+  uint32_t frees;
+  uint32_t failed_allocs;
+  size_t bytes_allocated;
+} HostHeapStats;
+
+void host_heap_get_stats(HostHeapStats* stats);
+void host_heap_reset_counters(void);
+void host_heap_reset_peak(void);
+
+// Caps the app bucket; allocations beyond it fail like they would on the watch.
+// Defaults to HOST_APP_HEAP_LIMIT for the selected platform.
+void host_heap_set_limit(size_t bytes);
+size_t host_heap_get_limit(void);
+
+void* host_sdk_malloc(size_t size);
+void* host_sdk_calloc(size_t count, size_t size);
+void host_sdk_free(void* ptr);
+
+// ── Clock ─────────────────────────────────────────────────────────────────────
+// Time only moves when the harness advances it. Timers fire in deadline order
+// and scheduled animations are stepped once per frame.
+#define HOST_FRAME_INTERVAL_MS 33
+
+uint64_t host_now_ms(void);
+void host_advance(uint32_t ms);
+
+// Advances until no timer or animation is pending, or `max_ms` has elapsed.
+// Returns the number of milliseconds that were simulated.
+uint32_t host_run_until_idle(uint32_t max_ms);
+
+uint32_t host_animations_scheduled(void);
+uint32_t host_animations_alive(void);
+uint32_t host_timers_pending(void);
+
+typedef struct HostClockStats {
+  uint32_t frames;
+  uint32_t animation_updates;
+  uint32_t timers_fired;
+} HostClockStats;
+
+void host_clock_get_stats(HostClockStats* stats);
+void host_clock_reset_stats(void);
+
+// Runs `frame` once per simulated frame, after animations have been stepped
+// and before the display is rendered.
+typedef void (*HostFrameHook)(uint64_t now_ms, void* context);
+void host_set_frame_hook(HostFrameHook frame, void* context);
+
+// ── Rendering ─────────────────────────────────────────────────────────────────
+// A render pass walks the top window's layer tree and calls every visible
+// update proc, like the compositor does when something has been marked dirty.
+typedef struct HostRenderStats {
+  uint32_t renders;
+  uint32_t dirty_marks;
+  uint32_t layers_drawn;
+  uint32_t draw_ops;
+  uint32_t pdc_commands_drawn;
+  uint32_t pdc_points_drawn;
+  uint64_t render_ns;
+} HostRenderStats;
+
+void host_render_get_stats(HostRenderStats* stats);
+void host_render_reset_stats(void);
+bool host_render_if_dirty(void);
+void host_render(void);
+
+// ── Profiling zones ───────────────────────────────────────────────────────────
+// App code enters a zone with ANIMATION_PROFILE_SCOPE. Anything created while a
+// zone is active (allocations, animations, timers) stays charged to it, and so
+// is the time spent in the callbacks those animations and timers later run.
+// Zone 0 collects everything unattributed.
+#define HOST_PROFILE_MAX_ZONES 16
+
+typedef struct HostProfileZoneStats {
+  const char* name;
+  uint32_t entries;
+  uint32_t frames;           // frames in which one of its animations advanced
+  uint32_t frames_rendered;  // ... and the display was redrawn afterwards
+  uint32_t updates;          // animation update calls
+  uint64_t update_ns;        // wall time stepping its animations
+  uint64_t callback_ns;      // wall time in its timers and in the zone itself
+  uint32_t allocs;
+  uint32_t frees;
+  size_t bytes_allocated;
+  size_t live_bytes;
+  size_t peak_live_bytes;
+} HostProfileZoneStats;
+
+uint8_t host_profile_zone_count(void);
+uint8_t host_profile_zone_find(const char* name);
+void host_profile_get(uint8_t zone, HostProfileZoneStats* stats);
+void host_profile_reset(void);
+
+// ── Input ─────────────────────────────────────────────────────────────────────
+// Delivers a click to the top window. `repeating` marks it as a held-button
+// repeat, which is what click_recognizer_is_repeating() then reports.
+void host_click(ButtonId button, bool repeating);
+
+// ── AppMessage ────────────────────────────────────────────────────────────────
+// Delivers a serialized dictionary to the inbox handler, as if PebbleKit JS had
+// sent it. Returns APP_MSG_OK, or the reason it was dropped.
+AppMessageResult host_app_message_deliver(const uint8_t* buffer, uint16_t size);
+
+// Called with every dictionary the app sends, before outbox_sent fires.
+typedef void (*HostOutboxHook)(const uint8_t* buffer, uint16_t size, void* context);
+void host_app_message_set_outbox_hook(HostOutboxHook hook, void* context);
+
+// Loses every Nth send (0 for none): outbox_failed fires instead of the hook.
+void host_app_message_set_send_loss(uint32_t every);
+
+typedef struct HostMessageStats {
+  uint32_t delivered;
+  uint32_t dropped;
+  uint32_t oversized;
+  uint32_t sent;
+  uint32_t lost;
+  uint32_t bytes_in;
+  uint32_t bytes_out;
+  uint32_t inbox_size;   // as opened by the app
+  uint32_t outbox_size;
+} HostMessageStats;
+
+void host_app_message_get_stats(HostMessageStats* stats);
+
+// ── Misc ──────────────────────────────────────────────────────────────────────
+// app_event_loop() hands control to `loop` when one is set; otherwise it runs
+// the clock until idle (capped at one simulated minute).
+typedef void (*HostEventLoop)(void* context);
+void host_set_event_loop(HostEventLoop loop, void* context);
+
+// APP_LOG output is discarded unless enabled, so benchmarks stay quiet.
+void host_set_logging(bool enabled);
+
+// Releases what the system reclaims once main() returns (the AppMessage
+// buffers), so anything still allocated afterwards is a genuine leak.
+void host_app_exit(void);
+
+// Resets the persist store, window stack and app message callbacks.
+void host_reset(void);
+
+// Monotonic wall clock for timing benchmarks, in nanoseconds.
+uint64_t host_wall_ns(void);
@@ -0,0 +1,259 @@
+/**
+ * bench_e2e.js
+ *
+ * End-to-end latency from the phone's "ready" to the forecast on the
+ * watch's screen. src/pkjs/index.js runs here in replay mode on the
+ * recordings in stuff/dummy/, so the forecast goes through the real parse
+ * and pack; its AppMessages are delivered to the real app running in
+ * e2e/e2e_watch, which unpacks them and answers. WeatherKit answers after
+ * [fetch ms], and every message each way takes [bluetooth ms].
+ *
+ * Three openings of the app:
+ *   cold     nothing cached: fetch, pack, send
+ *   warm     the cache from the cold run is fresh: send it straight away
+ *   refresh  the cache is older than the refresh interval: fetch again
+ *
+ * Each run checks the watch ended up holding what the phone sent. The
+ * watch also reports its startup stages: the first hours' icons loaded,
+ * and the whole forecast in.
+ *
+ *   E2E_WATCH=build/basalt/e2e_watch node js/bench_e2e.js [fetch ms] [bluetooth ms] [runs]
+ */
+
+var childProcess = require('child_process');
+var fs = require('fs');
+var path = require('path');
+
+var runner = require('./bench_runner');
+var pkjsEnv = require('./pkjs_env');
+var standin = require('./timeline_standin');
+
+var FETCH_MS = parseInt(process.argv[2] || '300', 10);
+var BLUETOOTH_MS = parseInt(process.argv[3] || '40', 10);
+var RUNS = parseInt(process.argv[4] || '3', 10);
+
+var WATCH = process.env.E2E_WATCH || path.join(__dirname, '..', 'build', 'basalt', 'e2e_watch');
+var RECORDINGS = path.join(__dirname, '..', '..', '..', 'stuff', 'dummy');
+
+// The watch's clock is kept this close to the phone's while nothing is sent
+var TICK_MS = 20;
+var TIMEOUT_MS = 15000;
+// The app's default "Maximum data age"
+var REFRESH_INTERVAL_MINUTES = 30;
+
+runner.check(fs.existsSync(WATCH), WATCH + ' is missing (make ' + path.relative(path.join(__dirname, '..'), WATCH) + ')');
+
+var recordings = ['dummy_data.json', 'dummy_precipitation.json'].map(function (name) {
+    return JSON.parse(fs.readFileSync(path.join(RECORDINGS, name), 'utf8'));
+});
+
+function hex(bytes) {
+    return Array.prototype.map.call(bytes, function (b) { return (b < 16 ? '0' : '') + b.toString(16); }).join('');
+}
+
+function encode(payload) {
+    return Object.keys(payload).map(function (name) {
+        var value = payload[name];
+        var key = pkjsEnv.messageKeys[name];
+        return typeof value === 'number' ? key + '=i:' + value : key + '=x:' + hex(value);
+    }).join(' ');
+}
+
+function decode(pairs) {
+    var payload = {};
+    pairs.forEach(function (pair) {
+        var match = /^(\d+)=([ix]):(.*)$/.exec(pair);
+        var name = pkjsEnv.messageKeyNames[match[1]];
+        payload[name] = match[2] === 'i' ? parseInt(match[3], 10) : Buffer.from(match[3], 'hex');
+    });
+    return payload;
+}
+
+/**
+ * Opens the app once against a freshly booted watch
+ * @param {pkjsEnv.Storage} storage - The phone's localStorage going in
+ * @param {Function} done - Called with the run's numbers
+ */
+function openApp(storage, done) {
+    var watch = childProcess.spawn(WATCH, [], {stdio: ['pipe', 'pipe', 'inherit']});
+    var start = Date.now();
+    var result = {viewerMs: -1, startup: {}, messages: 0, watchMessages: 0, fetches: 0};
+    var sent = {};
+    var pendingCommands = [];
+    var buffered = '';
+    var app;
+    var ticker;
+    var finished = false;
+
+    function now() {
+        return Date.now() - start;
+    }
+
+    // One command at a time; each waits for its "done"
+    function command(text, callback) {
+        pendingCommands.push(callback || function () {});
+        watch.stdin.write(text + '\n');
+    }
+
+    function finish(error) {
+        if (finished) {
+            return;
+        }
+        finished = true;
+        clearInterval(ticker);
+        command('quit');
+        watch.stdin.end();
+        runner.check(!error, error);
+        done(result);
+    }
+
+    function onLine(line) {
+        var words = line.split(' ');
+        if (words[0] === 'done') {
+            pendingCommands.shift()(parseInt(words[2], 10));
+        } else if (words[0] === 'send') {
+            result.watchMessages++;
+            var payload = decode(words.slice(2));
+            setTimeout(function () {
+                app.emit('appmessage', {payload: payload});
+            }, BLUETOOTH_MS);
+        } else if (words[0] === 'viewer') {
+            result.viewerMs = parseInt(words[1], 10);
+        } else if (words[0] === 'startup') {
+            words.slice(1).forEach(function (word) {
+                var parts = word.split('=');
+                result.startup[parts[0]] = parseInt(parts[1], 10);
+            });
+        } else if (words[0] === 'state') {
+            result.state = {};
+            words.slice(1).forEach(function (word) {
+                var parts = word.split('=');
+                result.state[parts[0]] = parts[1];
+            });
+        }
+    }
+
+    watch.stdout.on('data', function (chunk) {
+        buffered += chunk;
+        var lines = buffered.split('\n');
+        buffered = lines.pop();
+        lines.forEach(onLine);
+    });
+
+    var transport;
+    app = pkjsEnv.loadApp({
+        storage: storage,
+        sendAppMessage: function (payload, onAck, onNack) {
+            var line = encode(payload);
+            result.messages++;
+            Object.keys(payload).forEach(function (name) { sent[name] = payload[name]; });
+            setTimeout(function () {
+                command('deliver ' + now() + ' ' + line, function (status) {
+                    setTimeout(status === 0 ? onAck : onNack, BLUETOOTH_MS);
+                });
+            }, BLUETOOTH_MS);
+        },
+        configure: function (pkjsRequire) {
+            var replay = pkjsRequire('replay.js');
+            replay.configure({responses: recordings, latencyMs: FETCH_MS});
+            var get = replay.get;
+            replay.get = function () {
+                result.fetches++;
+                return get.apply(replay, arguments);
+            };
+            pkjsRequire('timeline.js').setServer(standin.create({async: true}));
+            transport = pkjsRequire('transport.js');
+        }
+    });
+
+    ticker = setInterval(function () {
+        if (now() > TIMEOUT_MS) {
+            finish('no forecast on the watch after ' + TIMEOUT_MS + 'ms');
+            return;
+        }
+        if (pendingCommands.length > 0) {
+            return;
+        }
+        var stats = transport.getStats();
+        if (result.viewerMs >= 0 && stats.acked + stats.failed === stats.queued) {
+            command('state ' + now(), function () {
+                var expected = {
+                    hours: String(sent.FORECAST_HOURS),
+                    first_hour: hex(sent.HOUR_DATA.slice(0, 10)),
+                    precipitation_type: String(sent.PRECIPITATION_MINUTES ? sent.PRECIPITATION_MINUTES[1] : 0)
+                };
+                if (sent.PRECIPITATION_MINUTES) {
+                    // One hex digit per 4-bit step, as packed
+                    expected.minute_steps = hex(sent.PRECIPITATION_MINUTES.slice(3));
+                }
+                Object.keys(expected).forEach(function (field) {
+                    runner.check(result.state[field] === expected[field], 'watch has ' + field + '=' +
+                        result.state[field] + ', phone sent ' + expected[field]);
+                });
+                finish();
+            });
+            return;
+        }
+        command('advance ' + now());
+    }, TICK_MS);
+
+    app.emit('ready');
+}
+
+// Ages everything the app cached past the refresh interval
+function expire(storage) {
+    var aged = storage.copy();
+    ['weather_cache_data', 'precipitation_cache_data'].forEach(function (key) {
+        var cache = JSON.parse(aged.getItem(key));
+        cache.timestamp -= (REFRESH_INTERVAL_MINUTES + 1) * 60 * 1000;
+        aged.setItem(key, JSON.stringify(cache));
+    });
+    return aged;
+}
+
+function median(values) {
+    var sorted = values.slice().sort(function (a, b) { return a - b; });
+    return sorted[Math.floor(sorted.length / 2)];
+}
+
+var results = {cold: [], warm: [], refresh: []};
+
+function runScenarios(run) {
+    if (run === RUNS) {
+        report();
+        return;
+    }
+    var cold = new pkjsEnv.Storage();
+    openApp(cold, function (coldResult) {
+        results.cold.push(coldResult);
+        openApp(cold.copy(), function (warmResult) {
+            results.warm.push(warmResult);
+            openApp(expire(cold), function (refreshResult) {
+                results.refresh.push(refreshResult);
+                runScenarios(run + 1);
+            });
+        });
+    });
+}
+
+function report() {
+    console.log('WeatherKit ' + FETCH_MS + 'ms, bluetooth ' + BLUETOOTH_MS + 'ms each way, ' + RUNS + ' runs; ' +
+        'the watch held what the phone sent every time\n');
+    console.log(runner.pad('opening', -12) + runner.pad('to viewer ms', 14) + runner.pad('min', 8) + runner.pad('max', 8) +
+        runner.pad('icons ms', 10) + runner.pad('data ms', 9) + runner.pad('fetches', 10) + runner.pad('phone msgs', 12) +
+        runner.pad('watch msgs', 12));
+    Object.keys(results).forEach(function (name) {
+        var runs = results[name];
+        var viewer = runs.map(function (r) { return r.viewerMs; });
+        var icons = runs.map(function (r) { return r.startup.icons_loaded; });
+        var data = runs.map(function (r) { return r.startup.data_ready; });
+        var last = runs[runs.length - 1];
+        console.log(runner.pad(name, -12) + runner.pad(median(viewer), 14) + runner.pad(Math.min.apply(null, viewer), 8) +
+            runner.pad(Math.max.apply(null, viewer), 8) + runner.pad(median(icons), 10) + runner.pad(median(data), 9) +
+            runner.pad(last.fetches, 10) + runner.pad(last.messages, 12) + runner.pad(last.watchMessages, 12));
+    });
+    runner.check(results.warm[0].fetches === 0, 'a warm open fetched');
+    runner.check(results.refresh[0].fetches === 2, 'a refresh did not fetch availability and weather');
+}
+
+runScenarios(0);
@@ -0,0 +1,190 @@
+/**
+ * bench_pins.js
+ *
+ * Timeline pin diffing against an in-memory stand-in for the timeline
+ * server (timeline_standin.js). Checks that pinmanager.sync() resends only
+ * changed pins, deletes upcoming pins that dropped out, shares one token
+ * per batch and across concurrent syncs, and recovers from an expired
+ * token. Then counts the server requests a run of unchanged refreshes
+ * makes against the baseline, which fetched a token and PUT every pin on
+ * every refresh. The stand-in answers instantly, so the timings are the
+ * phone's own work only; what the diffing saves is the requests.
+ *
+ *   node js/bench_pins.js [scale]
+ */
+
+var runner = require('./bench_runner');
+var standin = require('./timeline_standin');
+var timeline = require('../../src/pkjs/timeline.js');
+var events = require('../../src/pkjs/events.js');
+var pinmanager = require('../../src/pkjs/pinmanager.js');
+
+var scale = parseFloat(process.argv[2] || '1');
+
+var GROUP = 'next_hour_precipitation';
+var MINUTE_MS = 60 * 1000;
+
+// The fixtures' next hours, moved to start now so their pins are upcoming
+function nextHourPins(forecastNextHour, now) {
+    var shift = now - Date.parse(forecastNextHour.summary[0].startTime);
+    function move(time) {
+        return new Date(Date.parse(time) + shift).toISOString();
+    }
+    return events.createNextHourPrecipitationPins({
+        forecastEnd: move(forecastNextHour.forecastEnd),
+        summary: forecastNextHour.summary.map(function (summary) {
+            var moved = JSON.parse(JSON.stringify(summary));
+            moved.startTime = move(summary.startTime);
+            if (summary.endTime) {
+                moved.endTime = move(summary.endTime);
+            }
+            return moved;
+        })
+    });
+}
+
+var now = Date.now();
+var pins = [];
+runner.loadFixtures('weatherkit_').forEach(function (fixture) {
+    if ('forecastNextHour' in fixture.response) {
+        pins = pins.concat(nextHourPins(fixture.response.forecastNextHour, now));
+    }
+});
+runner.check(pins.length >= 2, 'fixtures give fewer than two precipitation pins');
+// Different fixtures number their windows from the same id
+pins.forEach(function (pin, i) {
+    pin.id = GROUP + '_' + (i + 1);
+});
+var fixturePins = pins;
+
+function rebuild(list) {
+    // A fresh lastUpdated, as every refresh stamps one
+    return list.map(function (pin) {
+        var copy = JSON.parse(JSON.stringify(pin));
+        copy.layout.lastUpdated = new Date().toISOString();
+        return copy;
+    });
+}
+
+// ── Behaviour, one step after another on an async stand-in ──────────────────
+
+var server = standin.create({async: true});
+timeline.setServer(server);
+pinmanager.reset();
+
+var steps = [
+    function (next) {
+        pinmanager.sync(GROUP, rebuild(pins), function (result) {
+            runner.check(result.put === pins.length && server.puts === pins.length, 'first sync PUTs every pin');
+            runner.check(server.tokenFetches === 1, 'first sync fetches one token, got ' + server.tokenFetches);
+            next();
+        });
+    },
+    function (next) {
+        pinmanager.sync(GROUP, rebuild(pins), function (result) {
+            runner.check(result.skipped === pins.length && server.requests() === pins.length,
+                'unchanged pins are not resent');
+            runner.check(server.tokenFetches === 1, 'nothing to send fetches no token');
+            next();
+        });
+    },
+    function (next) {
+        var changed = rebuild(pins);
+        changed[0].layout.body = 'Expect a little more.';
+        pinmanager.sync(GROUP, changed, function (result) {
+            runner.check(result.put === 1 && result.skipped === pins.length - 1, 'only the changed pin is PUT');
+            runner.check(server.pins[changed[0].id].layout.body === 'Expect a little more.', 'server has the change');
+            runner.check(server.tokenFetches === 1, 'the token is reused');
+            pins = changed;
+            next();
+        });
+    },
+    function (next) {
+        // One window clears up, and one that already ended is forgotten
+        var kept = pins.slice(1);
+        var past = JSON.parse(JSON.stringify(pins[0]));
+        past.id = GROUP + '_past';
+        past.time = new Date(now - 90 * MINUTE_MS).toISOString();
+        past.duration = 30;
+        pinmanager.sync(GROUP, kept.concat([past]), function () {
+            pinmanager.sync(GROUP, kept, function (result) {
+                runner.check(!(pins[0].id in server.pins), 'the dropped upcoming pin is deleted');
+                runner.check(past.id in server.pins && result.deleted === 0, 'a past pin is left as history');
+                pins = kept;
+                next();
+            });
+        });
+    },
+    function (next) {
+        server.revokeToken();
+        var changed = rebuild(pins);
+        changed[0].duration += 5;
+        pinmanager.sync(GROUP, changed, function (result) {
+            runner.check(result.put === 1 && server.tokenFetches === 2, 'an expired token is replaced and the PUT retried');
+            pins = changed;
+            next();
+        });
+    },
+    function (next) {
+        // Two refreshes racing a token fetch share it
+        pinmanager.reset();
+        var before = server.tokenFetches;
+        var pending = 2;
+        function done() {
+            if (--pending === 0) {
+                runner.check(server.tokenFetches === before + 1, 'concurrent syncs share one token fetch');
+                next();
+            }
+        }
+        pinmanager.sync(GROUP, rebuild(pins), done);
+        pinmanager.sync(GROUP + '_other', rebuild(pins).map(function (pin) {
+            pin.id += '_other';
+            return pin;
+        }), done);
+    }
+];
+
+function runSteps(i) {
+    if (i < steps.length) {
+        steps[i](function () { runSteps(i + 1); });
+    } else {
+        console.log(fixturePins.length + ' pins: diffing, batching and token reuse behave\n');
+        pins = fixturePins;
+        bench();
+    }
+}
+
+// ── Bench, on a synchronous stand-in so every call completes in place ───────
+
+function bench() {
+    var iterations = Math.max(1, Math.round(2000 * scale));
+    var baselineServer = standin.create();
+    timeline.setServer(baselineServer);
+
+    runner.printHeader();
+    runner.run('refresh ' + pins.length + ' pins, baseline', iterations, function () {
+        rebuild(pins).forEach(function (pin) {
+            timeline.insertUserPin(pin, function () {});
+        });
+    });
+    var baselineRequests = baselineServer.requests();
+    var baselineFetches = baselineServer.tokenFetches;
+
+    var diffed = standin.create();
+    timeline.setServer(diffed);
+    pinmanager.reset();
+    runner.run('refresh ' + pins.length + ' pins, unchanged', iterations, function () {
+        pinmanager.sync(GROUP, rebuild(pins));
+    });
+    runner.run('hashPin', iterations * pins.length, function () {
+        pinmanager.hashPin(pins[0]);
+    });
+
+    var calls = iterations + Math.min(iterations, 50);
+    console.log('\nserver requests for ' + calls + ' refreshes: ' + baselineRequests + ' and ' +
+        baselineFetches + ' token fetches before, ' + diffed.requests() + ' and ' + diffed.tokenFetches + ' now');
+    runner.check(diffed.requests() === pins.length && diffed.tokenFetches === 1, 'unchanged refreshes sent requests');
+    timeline.setServer(null);
+}
+
+runSteps(0);
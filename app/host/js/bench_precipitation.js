@@ -0,0 +1,140 @@
+/**
+ * bench_precipitation.js
+ *
+ * Minute-precipitation resampling over the recorded forecastNextHour
+ * payloads in fixtures/weatherkit_*.json. The baseline is the resampler it
+ * replaced, which padded and filtered minutes one Date at a time. In
+ * "sample" mode the two must agree on every interval; "max" and "mean"
+ * are timed alongside.
+ *
+ *   node js/bench_precipitation.js [scale]
+ */
+
+var runner = require('./bench_runner');
+var weatherkit = require('../../src/pkjs/weatherkit.js');
+
+var scale = parseFloat(process.argv[2] || '1');
+
+// ── Baseline: Date-per-minute padding and filtering ─────────────────────────
+
+function baselineProcess(nextHour, precipitationMinutes, nowMs) {
+    if (nextHour !== "clear" && precipitationMinutes && precipitationMinutes.length > 10) {
+        var now = new Date(nowMs);
+        var firstPrecipMinute = new Date(precipitationMinutes[0].startTime);
+
+        if (now < firstPrecipMinute) {
+            var minutesToAdd = [];
+            var currentMinute = new Date(now);
+            currentMinute.setMinutes(now.getMinutes());
+            while (currentMinute < firstPrecipMinute) {
+                minutesToAdd.push({
+                    startTime: currentMinute.toISOString(),
+                    precipitationChance: 0,
+                    precipitationIntensity: 0
+                });
+                currentMinute.setMinutes(currentMinute.getMinutes() + 1);
+            }
+            precipitationMinutes = minutesToAdd.concat(precipitationMinutes);
+        }
+
+        precipitationMinutes = precipitationMinutes.filter(function (minute) {
+            var minuteTime = new Date(minute.startTime);
+            return minuteTime.getMinutes() % 5 === 0;
+        });
+
+        while (precipitationMinutes.length < 24) {
+            var lastEntry = precipitationMinutes[precipitationMinutes.length - 1];
+            var lastTime = new Date(lastEntry.startTime);
+            lastTime.setMinutes(lastTime.getMinutes() + 5);
+            precipitationMinutes.push({
+                startTime: lastTime.toISOString(),
+                precipitationChance: 0,
+                precipitationIntensity: 0
+            });
+        }
+
+        var isSnowLike = (nextHour === "snow" || nextHour === "sleet");
+        var scaledIntensities = precipitationMinutes.map(function (minute) {
+            var mmhr = minute.precipitationIntensity;
+            if (mmhr < 0.1) return 0;
+            if (isSnowLike) {
+                if (mmhr > 2.5) return 3;
+                if (mmhr >= 1.0) return 2;
+                return 1;
+            } else {
+                if (mmhr > 7.6) return 3;
+                if (mmhr >= 2.5) return 2;
+                return 1;
+            }
+        });
+
+        return {
+            precipitationType: weatherkit.getPrecipitationIndex(nextHour),
+            precipitationIntensities: scaledIntensities
+        };
+    }
+    return null;
+}
+
+// ── Bench ───────────────────────────────────────────────────────────────────
+
+var MINUTE_MS = 60 * 1000;
+
+// Every fixture's forecastNextHour. They are resampled as rain (or snow),
+// since a "clear" next hour is rejected before resampling.
+var payloads = runner.loadFixtures('weatherkit_').filter(function (fixture) {
+    return 'forecastNextHour' in fixture.response;
+}).map(function (fixture) {
+    var next = fixture.response.forecastNextHour;
+    return {name: fixture.name, minutes: next.minutes, readTime: Date.parse(next.metadata.readTime)};
+});
+runner.check(payloads.length > 0, 'no forecastNextHour fixtures');
+
+// Sampling must match the baseline wherever it starts: at the read time,
+// on the first minute, and a few minutes before it on and off a boundary.
+var checked = 0;
+payloads.forEach(function (payload) {
+    var first = Date.parse(payload.minutes[0].startTime);
+    [payload.readTime, first, first - 7 * MINUTE_MS, first - 10 * MINUTE_MS, first - 61 * 1000].forEach(function (now) {
+        ['rain', 'snow'].forEach(function (nextHour) {
+            var got = weatherkit.processPrecipitationMinutes(nextHour, payload.minutes, now, weatherkit.RESAMPLE_SAMPLE);
+            var want = baselineProcess(nextHour, payload.minutes, now);
+            runner.check(got.precipitationType === want.precipitationType &&
+                JSON.stringify(Array.prototype.slice.call(got.precipitationIntensities)) ===
+                JSON.stringify(want.precipitationIntensities.slice(0, 24)),
+                payload.name + ' at ' + new Date(now).toISOString() + ': ' +
+                Array.prototype.join.call(got.precipitationIntensities) + ' vs ' + want.precipitationIntensities.join());
+            checked++;
+        });
+    });
+});
+console.log(payloads.length + ' payloads, ' + checked + ' start times: sampled intervals identical to baseline');
+
+// What the modes make of the same payload
+payloads.forEach(function (payload) {
+    [weatherkit.RESAMPLE_SAMPLE, weatherkit.RESAMPLE_MAX, weatherkit.RESAMPLE_MEAN].forEach(function (mode) {
+        var levels = weatherkit.processPrecipitationMinutes('rain', payload.minutes, payload.readTime, mode);
+        console.log('  ' + payload.name + ' ' + mode + ': ' + Array.prototype.join.call(levels.precipitationIntensities, ''));
+    });
+});
+console.log('');
+
+var iterations = Math.max(1, Math.round(5000 * scale));
+var sink = 0;
+runner.printHeader();
+
+var baseline = runner.run('resample ' + payloads.length + ' payloads, baseline', iterations, function () {
+    for (var p = 0; p < payloads.length; p++) {
+        sink += baselineProcess('rain', payloads[p].minutes, payloads[p].readTime).precipitationIntensities[4];
+    }
+});
+[weatherkit.RESAMPLE_SAMPLE, weatherkit.RESAMPLE_MAX, weatherkit.RESAMPLE_MEAN].forEach(function (mode) {
+    runner.run('resample ' + payloads.length + ' payloads, ' + mode, iterations, function () {
+        for (var p = 0; p < payloads.length; p++) {
+            sink += weatherkit.processPrecipitationMinutes('rain', payloads[p].minutes, payloads[p].readTime,
+                mode).precipitationIntensities[4];
+        }
+    }, baseline);
+});
+
+runner.check(sink !== 0, 'benchmarks did no work');
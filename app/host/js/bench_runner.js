@@ -0,0 +1,70 @@
+/**
+ * bench_runner.js
+ *
+ * Node counterpart of bench/bench_runner.h: runs a function N times and
+ * prints one table row with wall time per call. Shared by the bench_*.js
+ * scripts, which exercise the PebbleKit JS modules in src/pkjs directly.
+ */
+
+var fs = require('fs');
+var path = require('path');
+
+var FIXTURE_DIR = path.join(__dirname, 'fixtures');
+
+function printHeader() {
+    console.log(pad('benchmark', -40) + pad('iters', 10) + pad('ns/op', 14) + pad('vs baseline', 14));
+}
+
+function pad(text, width) {
+    text = String(text);
+    var fill = new Array(Math.max(0, Math.abs(width) - text.length) + 1).join(' ');
+    return width < 0 ? text + fill : fill + text;
+}
+
+/**
+ * Runs fn(context) `iterations` times after a short warm-up
+ * @param {string} name - Table row label
+ * @param {number} iterations - Calls to time
+ * @param {Function} fn - The code under test
+ * @param {Object} [baseline] - An earlier result to report a speedup against
+ * @returns {Object} {name, iterations, nsPerOp}
+ */
+function run(name, iterations, fn, baseline) {
+    for (var w = 0; w < Math.min(iterations, 50); w++) {
+        fn();
+    }
+    var start = process.hrtime.bigint();
+    for (var i = 0; i < iterations; i++) {
+        fn();
+    }
+    var ns = Number(process.hrtime.bigint() - start);
+    var result = {name: name, iterations: iterations, nsPerOp: ns / iterations};
+    var speedup = baseline ? (baseline.nsPerOp / result.nsPerOp).toFixed(1) + 'x' : '';
+    console.log(pad(name, -40) + pad(iterations, 10) + pad(result.nsPerOp.toFixed(1), 14) + pad(speedup, 14));
+    return result;
+}
+
+// Recorded WeatherKit responses, by file name
+function loadFixtures(prefix) {
+    return fs.readdirSync(FIXTURE_DIR).filter(function (name) {
+        return name.indexOf(prefix) === 0 && /\.json$/.test(name);
+    }).sort().map(function (name) {
+        return {name: name, response: JSON.parse(fs.readFileSync(path.join(FIXTURE_DIR, name), 'utf8'))};
+    });
+}
+
+// Fails the run when a rewritten path disagrees with the one it replaces
+function check(condition, message) {
+    if (!condition) {
+        console.error('FAIL: ' + message);
+        process.exit(1);
+    }
+}
+
+module.exports = {
+    printHeader: printHeader,
+    pad: pad,
+    run: run,
+    loadFixtures: loadFixtures,
+    check: check
+};
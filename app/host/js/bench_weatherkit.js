@@ -0,0 +1,137 @@
+/**
+ * bench_weatherkit.js
+ *
+ * Hourly forecast parsing over recorded WeatherKit responses
+ * (fixtures/weatherkit_*.json): the condition lookup, and turning
+ * forecastHourly.hours into hour packages. Each is timed against the
+ * implementation it replaced, kept below as the baseline, and the two must
+ * produce identical bytes for every hour.
+ *
+ *   node js/bench_weatherkit.js [scale]
+ */
+
+var runner = require('./bench_runner');
+var weatherkit = require('../../src/pkjs/weatherkit.js');
+var msgproc = require('../../src/pkjs/msgproc.js');
+
+var scale = parseFloat(process.argv[2] || '1');
+
+// ── Baseline: per-call category scan, positional packHourData() ─────────────
+
+function baselineConditionKey(conditionCode) {
+    var categories = Object.keys(weatherkit.conditionCodeMapping);
+    for (var i = 0; i < categories.length; i++) {
+        if (weatherkit.conditionCodeMapping[categories[i]].indexOf(conditionCode) !== -1) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+function baselineExperientialIcon(hour) {
+    if (baselineConditionKey(hour.conditionCode) === 3 || baselineConditionKey(hour.conditionCode) === 6) {
+        return 6;
+    }
+    if (hour.temperatureApparent <= -5) {
+        return 5;
+    }
+    if (hour.temperatureApparent <= 4) {
+        return 4;
+    }
+    if (baselineConditionKey(hour.conditionCode) === 9 || hour.visibility < 2000) {
+        return 7;
+    }
+    if (hour.uvIndex >= 7) {
+        return 3;
+    }
+    if (hour.uvIndex >= 3) {
+        return 2;
+    }
+    return 0;
+}
+
+function celsiusToFahrenheit(celsius) {
+    return (celsius * 9/5) + 32;
+}
+
+function baselinePackHour(hour) {
+    var conditionKey = baselineConditionKey(hour.conditionCode);
+    if (hour.daylight === false) {
+        if (conditionKey === 0) conditionKey = 11;
+        else if (conditionKey === 2) conditionKey = 12;
+    }
+    return msgproc.packHourData(
+        new Date(hour.forecastStart).getHours(),
+        Math.round(celsiusToFahrenheit(hour.temperature)),
+        Math.round(celsiusToFahrenheit(hour.temperatureApparent)),
+        Math.round(hour.windSpeed),
+        "windGust" in hour ? Math.round(hour.windGust) : -1,
+        Math.round(hour.visibility/1000),
+        Math.round(hour.pressure),
+        "windDirection" in hour ? hour.windDirection : -1,
+        -1,
+        hour.uvIndex,
+        conditionKey,
+        baselineExperientialIcon(hour)
+    );
+}
+
+// ── Bench ───────────────────────────────────────────────────────────────────
+
+var fixtures = runner.loadFixtures('weatherkit_');
+runner.check(fixtures.length > 0, 'no weatherkit_*.json fixtures');
+
+var hours = [];
+fixtures.forEach(function (fixture) {
+    hours = hours.concat(fixture.response.forecastHourly.hours);
+});
+
+// Every WeatherKit code, including ones the fixtures happen not to use
+weatherkit.conditionCodes.concat(['NotACode']).forEach(function (code) {
+    runner.check(weatherkit.getConditionKey(code) === baselineConditionKey(code), 'condition key for ' + code);
+});
+hours.forEach(function (hour) {
+    runner.check(JSON.stringify(weatherkit.packForecastHour(hour)) === JSON.stringify(baselinePackHour(hour)),
+        'hour package for ' + hour.forecastStart);
+});
+console.log(fixtures.length + ' fixtures, ' + hours.length + ' hours: packages identical to baseline\n');
+
+var iterations = Math.max(1, Math.round(200 * scale));
+runner.printHeader();
+
+var sink = 0;
+var keysBaseline = runner.run('condition keys, ' + hours.length + ' hours, baseline', iterations, function () {
+    for (var i = 0; i < hours.length; i++) {
+        sink += baselineConditionKey(hours[i].conditionCode);
+    }
+});
+runner.run('condition keys, ' + hours.length + ' hours', iterations, function () {
+    for (var i = 0; i < hours.length; i++) {
+        sink += weatherkit.getConditionKey(hours[i].conditionCode);
+    }
+}, keysBaseline);
+
+var parseBaseline = runner.run('parse ' + hours.length + ' hours, baseline', iterations, function () {
+    for (var i = 0; i < hours.length; i++) {
+        sink += baselinePackHour(hours[i])[9];
+    }
+});
+runner.run('parse ' + hours.length + ' hours', iterations, function () {
+    for (var i = 0; i < hours.length; i++) {
+        sink += weatherkit.packForecastHour(hours[i])[9];
+    }
+}, parseBaseline);
+
+// Includes JSON.parse, which the phone pays on every fetch either way
+var text = fixtures.map(function (fixture) { return JSON.stringify(fixture.response); });
+runner.run('cold fetch: JSON.parse + parse hours', iterations, function () {
+    for (var f = 0; f < text.length; f++) {
+        var response = JSON.parse(text[f]);
+        var fetched = response.forecastHourly.hours;
+        for (var i = 0; i < fetched.length; i++) {
+            sink += weatherkit.packForecastHour(fetched[i])[9];
+        }
+    }
+});
+
+runner.check(sink !== 0, 'benchmarks did no work');
@@ -0,0 +1,117 @@
+/**
+ * pkjs_env.js
+ *
+ * Just enough of the PebbleKit JS runtime to run src/pkjs/index.js under
+ * node: a Pebble object whose AppMessages go wherever the caller says,
+ * localStorage, and the modules the SDK build provides (message_keys,
+ * Clay, the gitignored api_keys). Each load() starts the app fresh, as
+ * the phone does when the watchapp opens.
+ */
+
+var fs = require('fs');
+var path = require('path');
+var Module = require('module');
+
+var APP_DIR = path.join(__dirname, '..', '..');
+var PKJS_DIR = path.join(APP_DIR, 'src', 'pkjs');
+
+// Numbered in messageKeys order from 10000, as tools/gen_resource_ids.py
+// numbers the C side
+var MESSAGE_KEY_BASE = 10000;
+var messageKeys = {};
+var messageKeyNames = {};
+JSON.parse(fs.readFileSync(path.join(APP_DIR, 'package.json'), 'utf8')).pebble.messageKeys.forEach(function (name, i) {
+    messageKeys[name] = MESSAGE_KEY_BASE + i;
+    messageKeyNames[MESSAGE_KEY_BASE + i] = name;
+});
+
+function Clay() {}
+
+var stubs = {
+    'message_keys': messageKeys,
+    '@rebble/clay': Clay,
+    './api_keys': {API_KEY: 'replay'}
+};
+
+var load = Module._load;
+Module._load = function (request) {
+    if (Object.prototype.hasOwnProperty.call(stubs, request)) {
+        return stubs[request];
+    }
+    return load.apply(this, arguments);
+};
+
+/**
+ * An in-memory localStorage; pass the same one to several load()s to keep
+ * what the app stored between them
+ */
+function Storage(items) {
+    this.items = items || {};
+}
+Storage.prototype.getItem = function (key) {
+    return Object.prototype.hasOwnProperty.call(this.items, key) ? this.items[key] : null;
+};
+Storage.prototype.setItem = function (key, value) {
+    this.items[key] = String(value);
+};
+Storage.prototype.removeItem = function (key) {
+    delete this.items[key];
+};
+Storage.prototype.copy = function () {
+    return new Storage(JSON.parse(JSON.stringify(this.items)));
+};
+
+/**
+ * Loads src/pkjs/index.js against a fresh Pebble object
+ * @param {Object} options
+ * @param {Storage} options.storage - The phone's localStorage
+ * @param {Function} options.sendAppMessage - (payload, onAck, onNack)
+ * @param {Function} [options.configure] - Called with require() for
+ *     src/pkjs modules before index.js runs, to swap in stand-ins
+ * @returns {Object} {emit(event, e), require(name)}
+ */
+function loadApp(options) {
+    Object.keys(require.cache).forEach(function (file) {
+        if (file.indexOf(PKJS_DIR) === 0) {
+            delete require.cache[file];
+        }
+    });
+
+    var listeners = {};
+    global.localStorage = options.storage;
+    global.Pebble = {
+        addEventListener: function (event, listener) {
+            (listeners[event] = listeners[event] || []).push(listener);
+        },
+        sendAppMessage: options.sendAppMessage,
+        getActiveWatchInfo: function () {
+            return {platform: 'basalt', language: 'en_US'};
+        },
+        getTimelineToken: function (onToken) {
+            onToken('pkjs-env-token');
+        },
+        appGlanceReload: function () {}
+    };
+
+    function pkjsRequire(name) {
+        return require(path.join(PKJS_DIR, name));
+    }
+    if (options.configure) {
+        options.configure(pkjsRequire);
+    }
+    pkjsRequire('index.js');
+
+    return {
+        emit: function (event, e) {
+            (listeners[event] || []).forEach(function (listener) { listener(e || {}); });
+        },
+        require: pkjsRequire
+    };
+}
+
+module.exports = {
+    Storage: Storage,
+    loadApp: loadApp,
+    messageKeys: messageKeys,
+    messageKeyNames: messageKeyNames
+};
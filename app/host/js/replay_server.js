@@ -0,0 +1,48 @@
+/**
+ * replay_server.js
+ *
+ * Stand-in WeatherKit for replay mode on a real phone. Serves the recorded
+ * responses in a directory, merged, as /recording.json; src/pkjs/replay.js
+ * fetches that when its REPLAY_URL points here, moves the timestamps to the
+ * present and answers the app's requests from it.
+ *
+ *   node js/replay_server.js [recordings dir] [port] [latency ms]
+ *       default: stuff/dummy, 8080, 0
+ */
+
+var fs = require('fs');
+var http = require('http');
+var path = require('path');
+
+var dir = process.argv[2] || path.join(__dirname, '..', '..', '..', 'stuff', 'dummy');
+var port = parseInt(process.argv[3] || '8080', 10);
+var latencyMs = parseInt(process.argv[4] || '0', 10);
+
+function recording() {
+    var merged = {};
+    fs.readdirSync(dir).filter(function (name) {
+        return /\.json$/.test(name);
+    }).sort().forEach(function (name) {
+        var response = JSON.parse(fs.readFileSync(path.join(dir, name), 'utf8'));
+        Object.keys(response).forEach(function (dataset) {
+            merged[dataset] = response[dataset];
+        });
+    });
+    return JSON.stringify(merged);
+}
+
+http.createServer(function (request, response) {
+    if (request.url !== '/recording.json') {
+        response.writeHead(404);
+        response.end();
+        return;
+    }
+    // Read on every request, so edits to the recordings show up straight away
+    var body = recording();
+    setTimeout(function () {
+        response.writeHead(200, {'Content-Type': 'application/json'});
+        response.end(body);
+    }, latencyMs);
+}).listen(port, function () {
+    console.log('replaying ' + dir + ' on port ' + port + ' with ' + latencyMs + 'ms latency');
+});
@@ -0,0 +1,68 @@
+/**
+ * timeline_standin.js
+ *
+ * An in-memory timeline server for timeline.setServer(), so pins can be
+ * pushed and checked without a phone or a network. It hands out numbered
+ * tokens, keeps the pins PUT to it by id, and counts every request.
+ * revokeToken() makes the current token fail with 410 the way an expired
+ * one does on the real server.
+ */
+
+function create(options) {
+    options = options || {};
+    var server = {
+        pins: {},
+        tokenFetches: 0,
+        puts: 0,
+        deletes: 0,
+        revoked: {},
+        token: null
+    };
+
+    // Callbacks run on a later tick when `async` is set, as the real ones do
+    function reply(fn) {
+        if (options.async) {
+            setTimeout(fn, 0);
+        } else {
+            fn();
+        }
+    }
+
+    server.getToken = function (onToken) {
+        server.tokenFetches++;
+        server.token = 'standin-token-' + server.tokenFetches;
+        var token = server.token;
+        reply(function () { onToken(token); });
+    };
+
+    server.send = function (type, url, headers, body, callback) {
+        var token = headers['X-User-Token'];
+        var id = url.substring(url.lastIndexOf('/') + 1);
+        if (server.revoked[token] || token !== server.token) {
+            reply(function () { callback(410, 'token expired'); });
+            return;
+        }
+        if (type === 'PUT') {
+            server.puts++;
+            server.pins[id] = JSON.parse(body);
+        } else if (type === 'DELETE') {
+            server.deletes++;
+            delete server.pins[id];
+        }
+        reply(function () { callback(200, 'OK'); });
+    };
+
+    server.revokeToken = function () {
+        server.revoked[server.token] = true;
+    };
+
+    server.requests = function () {
+        return server.puts + server.deletes;
+    };
+
+    return server;
+}
+
+module.exports = {
+    create: create
+};
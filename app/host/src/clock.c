@@ -0,0 +1,886 @@
+/*
+    Virtual clock: AppTimer and the Animation scheduler
+
+    Time only moves inside host_advance(). Timers fire in deadline order (ties in
+    registration order) and every scheduled animation is stepped once per
+    HOST_FRAME_INTERVAL_MS frame, which is how the watch's animation service
+    paces itself.
+
+    Both AppTimer* and Animation* are opaque handles rather than pointers, as on
+    the watch, so cancelling a timer that already fired or destroying an
+    animation that already auto-destroyed is a harmless no-op.
+
+    Animation lifecycle follows SDK 3:
+    - animation_schedule() runs setup (for every child of a spawn/sequence)
+    - the started handler runs once the delay has elapsed
+    - on completion: the final update, stopped(finished = true), teardown, and
+      the animation is destroyed
+    - animation_unschedule(): stopped(finished = false), teardown, destroyed
+    - a spawn or sequence owns its children and destroys them with itself
+*/
+
+#include "host_internal.h"
+
+#define HOST_EPOCH_SECONDS 1700000000
+
+// ── Clock ─────────────────────────────────────────────────────────────────────
+
+static uint64_t s_now_ms;
+static uint64_t s_next_frame_ms;
+static HostClockStats s_stats;
+static HostFrameHook s_frame_hook;
+static void* s_frame_hook_context;
+
+uint64_t host_now_ms(void) {
+  return s_now_ms;
+}
+
+time_t time(time_t* tloc) {
+  time_t now = (time_t)(HOST_EPOCH_SECONDS + s_now_ms / 1000);
+  if (tloc) {
+    *tloc = now;
+  }
+  return now;
+}
+
+uint16_t time_ms(time_t* tloc, uint16_t* out_ms) {
+  uint16_t ms = (uint16_t)(s_now_ms % 1000);
+  time(tloc);
+  if (out_ms) {
+    *out_ms = ms;
+  }
+  return ms;
+}
+
+void psleep(int millis) {
+  if (millis > 0) {
+    s_now_ms += (uint64_t)millis;
+  }
+}
+
+void host_set_frame_hook(HostFrameHook frame, void* context) {
+  s_frame_hook = frame;
+  s_frame_hook_context = context;
+}
+
+void host_clock_get_stats(HostClockStats* stats) {
+  *stats = s_stats;
+}
+
+void host_clock_reset_stats(void) {
+  memset(&s_stats, 0, sizeof(s_stats));
+}
+
+// ── AppTimer ──────────────────────────────────────────────────────────────────
+
+typedef struct HostTimer {
+  uint32_t id;
+  uint8_t zone;
+  uint64_t deadline_ms;
+  AppTimerCallback callback;
+  void* data;
+  struct HostTimer* next;
+} HostTimer;
+
+static HostTimer* s_timers;
+static uint32_t s_next_timer_id = 1;
+
+static HostTimer* prv_timer_find(AppTimer* handle, HostTimer*** link_out) {
+  uint32_t id = (uint32_t)(uintptr_t)handle;
+  HostTimer** link = &s_timers;
+  while (*link) {
+    if ((*link)->id == id) {
+      if (link_out) {
+        *link_out = link;
+      }
+      return *link;
+    }
+    link = &(*link)->next;
+  }
+  return NULL;
+}
+
+// Keeps the list sorted by deadline; equal deadlines stay in registration order.
+static void prv_timer_insert(HostTimer* timer) {
+  HostTimer** link = &s_timers;
+  while (*link && (*link)->deadline_ms <= timer->deadline_ms) {
+    link = &(*link)->next;
+  }
+  timer->next = *link;
+  *link = timer;
+}
+
+AppTimer* app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void* callback_data) {
+  HostTimer* timer = host_malloc(sizeof(HostTimer));
+  if (!timer) {
+    return NULL;
+  }
+  timer->id = s_next_timer_id++;
+  timer->zone = host_profile_current();
+  timer->deadline_ms = s_now_ms + timeout_ms;
+  timer->callback = callback;
+  timer->data = callback_data;
+  prv_timer_insert(timer);
+  return (AppTimer*)(uintptr_t)timer->id;
+}
+
+bool app_timer_reschedule(AppTimer* timer_handle, uint32_t new_timeout_ms) {
+  HostTimer** link;
+  HostTimer* timer = prv_timer_find(timer_handle, &link);
+  if (!timer) {
+    return false;
+  }
+  *link = timer->next;
+  timer->deadline_ms = s_now_ms + new_timeout_ms;
+  prv_timer_insert(timer);
+  return true;
+}
+
+void app_timer_cancel(AppTimer* timer_handle) {
+  HostTimer** link;
+  HostTimer* timer = prv_timer_find(timer_handle, &link);
+  if (!timer) {
+    return;
+  }
+  *link = timer->next;
+  host_free(timer);
+}
+
+uint32_t host_timers_pending(void) {
+  uint32_t count = 0;
+  for (HostTimer* timer = s_timers; timer; timer = timer->next) {
+    count++;
+  }
+  return count;
+}
+
+static void prv_fire_first_timer(void) {
+  HostTimer* timer = s_timers;
+  s_timers = timer->next;
+  AppTimerCallback callback = timer->callback;
+  void* data = timer->data;
+  uint8_t zone = timer->zone;
+  host_free(timer);
+  s_stats.timers_fired++;
+
+  uint64_t start_ns = host_wall_ns();
+  host_profile_push(zone);
+  callback(data);
+  host_profile_pop();
+  host_profile_note_callback(zone, host_wall_ns() - start_ns);
+}
+
+// ── Animation ─────────────────────────────────────────────────────────────────
+
+typedef enum {
+  HOST_ANIMATION_PLAIN,
+  HOST_ANIMATION_PROPERTY,
+  HOST_ANIMATION_SPAWN,
+  HOST_ANIMATION_SEQUENCE,
+} HostAnimationKind;
+
+typedef struct HostAnimation {
+  uint32_t id;
+  uint8_t zone;
+  HostAnimationKind kind;
+  uint32_t duration_ms;
+  uint32_t delay_ms;
+  bool reverse;
+  AnimationCurve curve;
+  AnimationCurveFunction custom_curve;
+  AnimationHandlers handlers;
+  void* context;
+  const AnimationImplementation* implementation;
+
+  // Property animations
+  Layer* subject;
+  GRect from;
+  GRect to;
+
+  // Spawn and sequence
+  struct HostAnimation** children;
+  uint32_t num_children;
+  uint32_t offset_ms;  // start of this child relative to its parent
+  struct HostAnimation* parent;
+
+  bool scheduled;
+  bool started;
+  bool done;
+  bool in_callback;
+  bool destroy_requested;
+  uint64_t scheduled_at_ms;
+
+  struct HostAnimation* next;
+} HostAnimation;
+
+static HostAnimation* s_animations;
+static uint32_t s_next_animation_id = 1;
+
+static HostAnimation* prv_find(Animation* handle) {
+  uint32_t id = (uint32_t)(uintptr_t)handle;
+  if (id == 0) {
+    return NULL;
+  }
+  for (HostAnimation* anim = s_animations; anim; anim = anim->next) {
+    if (anim->id == id) {
+      return anim;
+    }
+  }
+  return NULL;
+}
+
+static Animation* prv_handle(HostAnimation* anim) {
+  return anim ? (Animation*)(uintptr_t)anim->id : NULL;
+}
+
+static HostAnimation* prv_create(HostAnimationKind kind) {
+  HostAnimation* anim = host_calloc(1, sizeof(HostAnimation));
+  if (!anim) {
+    return NULL;
+  }
+  anim->id = s_next_animation_id++;
+  anim->zone = host_profile_current();
+  anim->kind = kind;
+  anim->duration_ms = 250;
+  anim->curve = AnimationCurveDefault;
+  anim->next = s_animations;
+  s_animations = anim;
+  return anim;
+}
+
+static void prv_free(HostAnimation* anim) {
+  for (uint32_t i = 0; i < anim->num_children; i++) {
+    prv_free(anim->children[i]);
+  }
+  host_free(anim->children);
+
+  HostAnimation** link = &s_animations;
+  while (*link && *link != anim) {
+    link = &(*link)->next;
+  }
+  if (*link) {
+    *link = anim->next;
+  }
+  host_free(anim);
+}
+
+// Total length of an animation including its own delay.
+static uint32_t prv_span_ms(HostAnimation* anim) {
+  uint32_t body = 0;
+  if (anim->kind == HOST_ANIMATION_SPAWN || anim->kind == HOST_ANIMATION_SEQUENCE) {
+    for (uint32_t i = 0; i < anim->num_children; i++) {
+      uint32_t end = anim->children[i]->offset_ms + prv_span_ms(anim->children[i]);
+      if (end > body) {
+        body = end;
+      }
+    }
+  } else {
+    body = anim->duration_ms;
+  }
+  return anim->delay_ms + body;
+}
+
+static AnimationProgress prv_apply_curve(HostAnimation* anim, AnimationProgress t) {
+  const int64_t max = ANIMATION_NORMALIZED_MAX;
+  switch (anim->curve) {
+    case AnimationCurveLinear:
+      return t;
+    case AnimationCurveEaseIn:
+      return (AnimationProgress)((int64_t)t * t / max);
+    case AnimationCurveEaseOut: {
+      int64_t inv = max - t;
+      return (AnimationProgress)(max - inv * inv / max);
+    }
+    case AnimationCurveEaseInOut:
+      if (t < max / 2) {
+        return (AnimationProgress)(2 * (int64_t)t * t / max);
+      } else {
+        int64_t inv = max - t;
+        return (AnimationProgress)(max - 2 * inv * inv / max);
+      }
+    case AnimationCurveCustomFunction:
+      return anim->custom_curve ? anim->custom_curve(t) : t;
+  }
+  return t;
+}
+
+static void prv_update(HostAnimation* anim, AnimationProgress progress) {
+  s_stats.animation_updates++;
+  if (anim->kind == HOST_ANIMATION_PROPERTY) {
+    GRect frame;
+    frame.origin.x = anim->from.origin.x + ((anim->to.origin.x - anim->from.origin.x) * progress) / ANIMATION_NORMALIZED_MAX;
+    frame.origin.y = anim->from.origin.y + ((anim->to.origin.y - anim->from.origin.y) * progress) / ANIMATION_NORMALIZED_MAX;
+    frame.size.w = anim->from.size.w + ((anim->to.size.w - anim->from.size.w) * progress) / ANIMATION_NORMALIZED_MAX;
+    frame.size.h = anim->from.size.h + ((anim->to.size.h - anim->from.size.h) * progress) / ANIMATION_NORMALIZED_MAX;
+    layer_set_frame(anim->subject, frame);
+  } else if (anim->implementation && anim->implementation->update) {
+    anim->implementation->update(prv_handle(anim), progress);
+  }
+}
+
+static void prv_setup(HostAnimation* anim) {
+  anim->started = false;
+  anim->done = false;
+  for (uint32_t i = 0; i < anim->num_children; i++) {
+    prv_setup(anim->children[i]);
+  }
+  if (anim->implementation && anim->implementation->setup) {
+    anim->implementation->setup(prv_handle(anim));
+  }
+}
+
+static void prv_teardown(HostAnimation* anim) {
+  if (anim->implementation && anim->implementation->teardown) {
+    anim->implementation->teardown(prv_handle(anim));
+  }
+}
+
+// Runs stopped + teardown for one animation. Children of a composite that has
+// been cut short are stopped first.
+static void prv_stop(HostAnimation* anim, bool finished) {
+  anim->in_callback = true;
+  if (!finished) {
+    for (uint32_t i = 0; i < anim->num_children; i++) {
+      HostAnimation* child = anim->children[i];
+      if (!child->done) {
+        child->done = true;
+        prv_stop(child, false);
+      }
+    }
+  }
+  if (anim->handlers.stopped) {
+    anim->handlers.stopped(prv_handle(anim), finished, anim->context);
+  }
+  prv_teardown(anim);
+  anim->in_callback = false;
+}
+
+// Stops, tears down and destroys a top-level animation.
+static void prv_retire(HostAnimation* anim, bool finished) {
+  uint32_t id = anim->id;
+  anim->scheduled = false;
+  prv_stop(anim, finished);
+
+  // Handlers may have rescheduled it, which keeps it alive.
+  anim = prv_find((Animation*)(uintptr_t)id);
+  if (anim && !anim->scheduled) {
+    prv_free(anim);
+  }
+}
+
+static void prv_started(HostAnimation* anim) {
+  anim->started = true;
+  if (anim->handlers.started) {
+    anim->in_callback = true;
+    anim->handlers.started(prv_handle(anim), anim->context);
+    anim->in_callback = false;
+  }
+}
+
+// Advances `anim` to `elapsed_ms` since it was scheduled (its own delay
+// included). Returns true once it has finished. Child completions run their
+// stopped/teardown handlers here; the top-level one is left to the caller.
+static bool prv_step(HostAnimation* anim, int64_t elapsed_ms) {
+  if (elapsed_ms < anim->delay_ms) {
+    return false;
+  }
+  if (!anim->started) {
+    prv_started(anim);
+  }
+
+  int64_t local_ms = elapsed_ms - anim->delay_ms;
+
+  if (anim->kind == HOST_ANIMATION_SPAWN || anim->kind == HOST_ANIMATION_SEQUENCE) {
+    bool all_done = true;
+    for (uint32_t i = 0; i < anim->num_children; i++) {
+      HostAnimation* child = anim->children[i];
+      if (child->done) {
+        continue;
+      }
+      if (prv_step(child, local_ms - child->offset_ms)) {
+        child->done = true;
+        prv_stop(child, true);
+      } else {
+        all_done = false;
+      }
+    }
+    return all_done;
+  }
+
+  bool finished = local_ms >= anim->duration_ms;
+  AnimationProgress t = finished || anim->duration_ms == 0
+      ? ANIMATION_NORMALIZED_MAX
+      : (AnimationProgress)(local_ms * ANIMATION_NORMALIZED_MAX / anim->duration_ms);
+  if (anim->reverse) {
+    t = ANIMATION_NORMALIZED_MAX - t;
+  }
+  prv_update(anim, prv_apply_curve(anim, t));
+  return finished;
+}
+
+static uint32_t prv_count(bool scheduled_only) {
+  uint32_t count = 0;
+  for (HostAnimation* anim = s_animations; anim; anim = anim->next) {
+    if (!anim->parent && (!scheduled_only || anim->scheduled)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+uint32_t host_animations_scheduled(void) {
+  return prv_count(true);
+}
+
+uint32_t host_animations_alive(void) {
+  return prv_count(false);
+}
+
+static void prv_step_frame(void) {
+  s_stats.frames++;
+
+  // Snapshot the ids first: handlers are free to create, schedule and destroy
+  // animations while we walk them.
+  uint32_t count = prv_count(true);
+  if (count == 0) {
+    return;
+  }
+  uint32_t* ids = host_sdk_malloc(sizeof(uint32_t) * count);
+  uint32_t n = 0;
+  for (HostAnimation* anim = s_animations; anim && n < count; anim = anim->next) {
+    if (!anim->parent && anim->scheduled) {
+      ids[n++] = anim->id;
+    }
+  }
+
+  for (uint32_t i = 0; i < n; i++) {
+    HostAnimation* anim = prv_find((Animation*)(uintptr_t)ids[i]);
+    if (!anim || !anim->scheduled) {
+      continue;
+    }
+    // Destroying or unscheduling it from its own callbacks is deferred until
+    // the step is over.
+    int64_t elapsed_ms = (int64_t)(s_now_ms - anim->scheduled_at_ms);
+    uint8_t zone = anim->zone;
+    uint64_t start_ns = host_wall_ns();
+    host_profile_push(zone);
+    anim->in_callback = true;
+    bool finished = prv_step(anim, elapsed_ms);
+    anim->in_callback = false;
+    if (anim->destroy_requested) {
+      prv_retire(anim, false);
+    } else if (finished) {
+      prv_retire(anim, true);
+    }
+    host_profile_pop();
+    host_profile_note_update(zone, host_wall_ns() - start_ns);
+  }
+
+  host_sdk_free(ids);
+}
+
+// Starts the frame ticker if it is idle. A frame that is due right now is left
+// alone: pushing it back whenever a timer fires on the same tick would starve
+// animations driven by a timer that re-arms itself every frame.
+static void prv_ensure_frame(void) {
+  if (s_next_frame_ms < s_now_ms) {
+    s_next_frame_ms = s_now_ms + HOST_FRAME_INTERVAL_MS;
+  }
+}
+
+Animation* animation_create(void) {
+  return prv_handle(prv_create(HOST_ANIMATION_PLAIN));
+}
+
+bool animation_destroy(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->parent) {
+    return false;
+  }
+  if (anim->in_callback) {
+    anim->destroy_requested = true;
+    return true;
+  }
+  if (anim->scheduled) {
+    prv_retire(anim, false);
+  } else {
+    prv_free(anim);
+  }
+  return true;
+}
+
+Animation* animation_clone(Animation* from) {
+  HostAnimation* src = prv_find(from);
+  if (!src || src->kind == HOST_ANIMATION_SPAWN || src->kind == HOST_ANIMATION_SEQUENCE) {
+    return NULL;
+  }
+  HostAnimation* anim = prv_create(src->kind);
+  if (!anim) {
+    return NULL;
+  }
+  uint32_t id = anim->id;
+  HostAnimation* next = anim->next;
+  *anim = *src;
+  anim->id = id;
+  anim->next = next;
+  anim->parent = NULL;
+  anim->scheduled = false;
+  anim->started = false;
+  anim->done = false;
+  anim->in_callback = false;
+  anim->destroy_requested = false;
+  return prv_handle(anim);
+}
+
+static Animation* prv_create_composite(HostAnimationKind kind, Animation** animation_array, uint32_t array_len) {
+  if (!animation_array || array_len == 0) {
+    return NULL;
+  }
+  for (uint32_t i = 0; i < array_len; i++) {
+    HostAnimation* child = prv_find(animation_array[i]);
+    if (!child || child->parent || child->scheduled) {
+      return NULL;
+    }
+  }
+
+  HostAnimation* anim = prv_create(kind);
+  if (!anim) {
+    return NULL;
+  }
+  anim->duration_ms = 0;
+  anim->curve = AnimationCurveLinear;
+  anim->children = host_malloc(sizeof(HostAnimation*) * array_len);
+  if (!anim->children) {
+    prv_free(anim);
+    return NULL;
+  }
+  anim->num_children = array_len;
+
+  uint32_t offset_ms = 0;
+  for (uint32_t i = 0; i < array_len; i++) {
+    HostAnimation* child = prv_find(animation_array[i]);
+    child->parent = anim;
+    child->offset_ms = kind == HOST_ANIMATION_SEQUENCE ? offset_ms : 0;
+    offset_ms += prv_span_ms(child);
+    anim->children[i] = child;
+  }
+  return prv_handle(anim);
+}
+
+Animation* animation_sequence_create_from_array(Animation** animation_array, uint32_t array_len) {
+  return prv_create_composite(HOST_ANIMATION_SEQUENCE, animation_array, array_len);
+}
+
+Animation* animation_spawn_create_from_array(Animation** animation_array, uint32_t array_len) {
+  return prv_create_composite(HOST_ANIMATION_SPAWN, animation_array, array_len);
+}
+
+bool animation_set_elapsed(Animation* animation, uint32_t elapsed_ms) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || !anim->scheduled) {
+    return false;
+  }
+  anim->scheduled_at_ms = s_now_ms - elapsed_ms;
+  return true;
+}
+
+bool animation_get_elapsed(Animation* animation, int32_t* elapsed_ms) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || !anim->scheduled || !elapsed_ms) {
+    return false;
+  }
+  *elapsed_ms = (int32_t)(s_now_ms - anim->scheduled_at_ms) - (int32_t)anim->delay_ms;
+  return true;
+}
+
+bool animation_set_reverse(Animation* animation, bool reverse) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->scheduled) {
+    return false;
+  }
+  anim->reverse = reverse;
+  return true;
+}
+
+bool animation_get_reverse(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  return anim ? anim->reverse : false;
+}
+
+// Repeats are not simulated; a play count of one is the only one dribble uses.
+bool animation_set_play_count(Animation* animation, uint32_t play_count) {
+  return prv_find(animation) != NULL && play_count == 1;
+}
+
+bool animation_set_duration(Animation* animation, uint32_t duration_ms) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->scheduled || anim->kind == HOST_ANIMATION_SPAWN || anim->kind == HOST_ANIMATION_SEQUENCE) {
+    return false;
+  }
+  anim->duration_ms = duration_ms;
+  return true;
+}
+
+uint32_t animation_get_duration(Animation* animation, bool include_delay, bool include_play_count) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim) {
+    return 0;
+  }
+  uint32_t span = prv_span_ms(anim);
+  return include_delay ? span : span - anim->delay_ms;
+}
+
+bool animation_set_delay(Animation* animation, uint32_t delay_ms) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->scheduled) {
+    return false;
+  }
+  anim->delay_ms = delay_ms;
+  return true;
+}
+
+uint32_t animation_get_delay(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  return anim ? anim->delay_ms : 0;
+}
+
+bool animation_set_curve(Animation* animation, AnimationCurve curve) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->scheduled) {
+    return false;
+  }
+  anim->curve = curve;
+  return true;
+}
+
+AnimationCurve animation_get_curve(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  return anim ? anim->curve : AnimationCurveDefault;
+}
+
+bool animation_set_custom_curve(Animation* animation, AnimationCurveFunction curve_function) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->scheduled) {
+    return false;
+  }
+  anim->curve = AnimationCurveCustomFunction;
+  anim->custom_curve = curve_function;
+  return true;
+}
+
+bool animation_set_handlers(Animation* animation, AnimationHandlers callbacks, void* context) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->scheduled) {
+    return false;
+  }
+  anim->handlers = callbacks;
+  anim->context = context;
+  return true;
+}
+
+void* animation_get_context(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  return anim ? anim->context : NULL;
+}
+
+bool animation_schedule(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->parent) {
+    return false;
+  }
+  anim->scheduled = true;
+  anim->scheduled_at_ms = s_now_ms;
+  anim->destroy_requested = false;
+  prv_setup(anim);
+  prv_ensure_frame();
+  return true;
+}
+
+bool animation_unschedule(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->parent || !anim->scheduled) {
+    return false;
+  }
+  if (anim->in_callback) {
+    anim->destroy_requested = true;
+    return true;
+  }
+  prv_retire(anim, false);
+  return true;
+}
+
+void animation_unschedule_all(void) {
+  HostAnimation* anim;
+  while ((anim = s_animations) != NULL) {
+    while (anim && (anim->parent || !anim->scheduled)) {
+      anim = anim->next;
+    }
+    if (!anim) {
+      break;
+    }
+    prv_retire(anim, false);
+  }
+}
+
+bool animation_is_scheduled(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim) {
+    return false;
+  }
+  while (anim->parent) {
+    anim = anim->parent;
+  }
+  return anim->scheduled;
+}
+
+bool animation_set_implementation(Animation* animation, const AnimationImplementation* implementation) {
+  HostAnimation* anim = prv_find(animation);
+  if (!anim || anim->scheduled || anim->kind == HOST_ANIMATION_PROPERTY) {
+    return false;
+  }
+  anim->implementation = implementation;
+  return true;
+}
+
+const AnimationImplementation* animation_get_implementation(Animation* animation) {
+  HostAnimation* anim = prv_find(animation);
+  return anim ? anim->implementation : NULL;
+}
+
+// ── PropertyAnimation ─────────────────────────────────────────────────────────
+// Only the layer frame property is used by dribble. A PropertyAnimation handle
+// is the same handle as its Animation.
+
+PropertyAnimation* property_animation_create_layer_frame(Layer* layer, GRect* from_frame, GRect* to_frame) {
+  if (!layer) {
+    return NULL;
+  }
+  HostAnimation* anim = prv_create(HOST_ANIMATION_PROPERTY);
+  if (!anim) {
+    return NULL;
+  }
+  anim->subject = layer;
+  anim->from = from_frame ? *from_frame : layer_get_frame(layer);
+  anim->to = to_frame ? *to_frame : layer_get_frame(layer);
+  return (PropertyAnimation*)prv_handle(anim);
+}
+
+void property_animation_destroy(PropertyAnimation* property_animation) {
+  animation_destroy((Animation*)property_animation);
+}
+
+Animation* property_animation_get_animation(PropertyAnimation* property_animation) {
+  return (Animation*)property_animation;
+}
+
+bool property_animation_get_subject(PropertyAnimation* property_animation, void** subject) {
+  HostAnimation* anim = prv_find((Animation*)property_animation);
+  if (!anim || anim->kind != HOST_ANIMATION_PROPERTY || !subject) {
+    return false;
+  }
+  *subject = anim->subject;
+  return true;
+}
+
+bool property_animation_from(PropertyAnimation* property_animation, void* from, size_t size, bool set) {
+  HostAnimation* anim = prv_find((Animation*)property_animation);
+  if (!anim || anim->kind != HOST_ANIMATION_PROPERTY || !from || size != sizeof(GRect)) {
+    return false;
+  }
+  if (set) {
+    anim->from = *(GRect*)from;
+  } else {
+    *(GRect*)from = anim->from;
+  }
+  return true;
+}
+
+bool property_animation_to(PropertyAnimation* property_animation, void* to, size_t size, bool set) {
+  HostAnimation* anim = prv_find((Animation*)property_animation);
+  if (!anim || anim->kind != HOST_ANIMATION_PROPERTY || !to || size != sizeof(GRect)) {
+    return false;
+  }
+  if (set) {
+    anim->to = *(GRect*)to;
+  } else {
+    *(GRect*)to = anim->to;
+  }
+  return true;
+}
+
+// ── Event loop ────────────────────────────────────────────────────────────────
+
+static bool prv_next_event(uint64_t* at_ms, bool* is_frame) {
+  bool have_frame = host_animations_scheduled() > 0;
+  if (!s_timers && !have_frame) {
+    return false;
+  }
+  if (s_timers && (!have_frame || s_timers->deadline_ms <= s_next_frame_ms)) {
+    *at_ms = s_timers->deadline_ms;
+    *is_frame = false;
+  } else {
+    *at_ms = s_next_frame_ms;
+    *is_frame = true;
+  }
+  return true;
+}
+
+static void prv_run_event(bool is_frame) {
+  if (is_frame) {
+    prv_step_frame();
+    if (s_frame_hook) {
+      s_frame_hook(s_now_ms, s_frame_hook_context);
+    }
+    s_next_frame_ms = s_now_ms + HOST_FRAME_INTERVAL_MS;
+    host_profile_frame_end(host_render_if_dirty());
+  } else {
+    prv_fire_first_timer();
+    host_render_if_dirty();
+  }
+}
+
+void host_advance(uint32_t ms) {
+  uint64_t target_ms = s_now_ms + ms;
+  uint64_t at_ms;
+  bool is_frame;
+  while (prv_next_event(&at_ms, &is_frame) && at_ms <= target_ms) {
+    if (at_ms > s_now_ms) {
+      s_now_ms = at_ms;
+    }
+    prv_run_event(is_frame);
+  }
+  s_now_ms = target_ms;
+  host_render_if_dirty();
+}
+
+uint32_t host_run_until_idle(uint32_t max_ms) {
+  uint64_t start_ms = s_now_ms;
+  uint64_t limit_ms = s_now_ms + max_ms;
+  uint64_t at_ms;
+  bool is_frame;
+  while (prv_next_event(&at_ms, &is_frame) && at_ms <= limit_ms) {
+    if (at_ms > s_now_ms) {
+      s_now_ms = at_ms;
+    }
+    prv_run_event(is_frame);
+  }
+  host_render_if_dirty();
+  return (uint32_t)(s_now_ms - start_ms);
+}
+
+void host_clock_reset(void) {
+  while (s_timers) {
+    HostTimer* timer = s_timers;
+    s_timers = timer->next;
+    host_free(timer);
+  }
+  while (s_animations) {
+    HostAnimation* anim = s_animations;
+    while (anim->parent) {
+      anim = anim->parent;
+    }
+    prv_free(anim);
+  }
+  s_next_frame_ms = 0;
+  host_clock_reset_stats();
+}
@@ -0,0 +1,473 @@
+/*
+    Draw commands, paths and graphics
+
+    .pdc resources are read from app/resources (see resource_table.auto.c) and
+    kept in the same layout the firmware uses in memory: the file minus its
+    8-byte "PDCI" + size header. That keeps image sizes, clone costs and the
+    point layout that kimaybe edits identical to the watch.
+
+    Drawing does not rasterise; it counts the work a real draw would do.
+*/
+
+#include "host_internal.h"
+
+#include <math.h>
+
+extern const char* const host_resource_files[];
+extern const unsigned int host_resource_file_count;
+
+HostDrawCounters host_draw_counters;
+
+// ── Geometry ──────────────────────────────────────────────────────────────────
+
+bool gpoint_equal(const GPoint* const point_a, const GPoint* const point_b) {
+  return point_a->x == point_b->x && point_a->y == point_b->y;
+}
+
+bool grect_equal(const GRect* const rect_a, const GRect* const rect_b) {
+  return gpoint_equal(&rect_a->origin, &rect_b->origin) &&
+         rect_a->size.w == rect_b->size.w && rect_a->size.h == rect_b->size.h;
+}
+
+GPoint grect_center_point(const GRect* rect) {
+  return GPoint(rect->origin.x + rect->size.w / 2, rect->origin.y + rect->size.h / 2);
+}
+
+bool gcolor_equal(GColor8 color_a, GColor8 color_b) {
+  return color_a.argb == color_b.argb;
+}
+
+// ── PDC layout ────────────────────────────────────────────────────────────────
+
+struct __attribute__((packed)) GDrawCommand {
+  uint8_t type;
+  uint8_t hidden;
+  GColor8 stroke_color;
+  uint8_t stroke_width;
+  GColor8 fill_color;
+  union {
+    uint16_t path_open;
+    uint16_t radius;
+  };
+  uint16_t num_points;
+  GPoint points[];
+};
+
+struct __attribute__((packed)) GDrawCommandList {
+  uint16_t num_commands;
+  struct GDrawCommand commands[];
+};
+
+struct __attribute__((packed)) GDrawCommandImage {
+  uint8_t version;
+  uint8_t reserved;
+  GSize size;
+  struct GDrawCommandList command_list;
+};
+
+#define PDC_FILE_HEADER_SIZE 8
+#define PDC_IMAGE_HEADER_SIZE (sizeof(GDrawCommandImage))
+
+static size_t prv_command_size(const GDrawCommand* command) {
+  return sizeof(GDrawCommand) + command->num_points * sizeof(GPoint);
+}
+
+static GDrawCommand* prv_next_command(GDrawCommand* command) {
+  return (GDrawCommand*)((uint8_t*)command + prv_command_size(command));
+}
+
+// Walks the command list within `available` bytes; returns the list's size or 0.
+static size_t prv_validate_list(const uint8_t* data, size_t available) {
+  if (available < sizeof(GDrawCommandList)) {
+    return 0;
+  }
+  const GDrawCommandList* list = (const GDrawCommandList*)data;
+  size_t offset = sizeof(GDrawCommandList);
+  for (uint16_t i = 0; i < list->num_commands; i++) {
+    if (offset + sizeof(GDrawCommand) > available) {
+      return 0;
+    }
+    const GDrawCommand* command = (const GDrawCommand*)(data + offset);
+    if (command->type < GDrawCommandTypePath || command->type > GDrawCommandTypePrecisePath) {
+      return 0;
+    }
+    offset += prv_command_size(command);
+    if (offset > available) {
+      return 0;
+    }
+  }
+  return offset;
+}
+
+static size_t prv_image_size(GDrawCommandImage* image) {
+  GDrawCommand* command = image->command_list.commands;
+  for (uint16_t i = 0; i < image->command_list.num_commands; i++) {
+    command = prv_next_command(command);
+  }
+  return (size_t)((uint8_t*)command - (uint8_t*)image);
+}
+
+GDrawCommandImage* gdraw_command_image_create_with_resource(uint32_t resource_id) {
+  if (resource_id == 0 || resource_id >= host_resource_file_count) {
+    return NULL;
+  }
+  FILE* file = fopen(host_resource_files[resource_id], "rb");
+  if (!file) {
+    APP_LOG(APP_LOG_LEVEL_ERROR, "Missing resource %s", host_resource_files[resource_id]);
+    return NULL;
+  }
+
+  uint8_t header[PDC_FILE_HEADER_SIZE];
+  GDrawCommandImage* image = NULL;
+  if (fread(header, 1, sizeof(header), file) == sizeof(header) && memcmp(header, "PDCI", 4) == 0) {
+    uint32_t size = header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24);
+    if (size >= PDC_IMAGE_HEADER_SIZE && size < 64 * 1024) {
+      image = host_malloc(size);
+      if (image && (fread(image, 1, size, file) != size ||
+                    image->version != 1 ||
+                    prv_validate_list((uint8_t*)&image->command_list, size - offsetof(GDrawCommandImage, command_list)) == 0)) {
+        host_free(image);
+        image = NULL;
+      }
+    }
+  }
+  fclose(file);
+  return image;
+}
+
+GDrawCommandImage* gdraw_command_image_clone(GDrawCommandImage* image) {
+  if (!image) {
+    return NULL;
+  }
+  size_t size = prv_image_size(image);
+  GDrawCommandImage* clone = host_malloc(size);
+  if (clone) {
+    memcpy(clone, image, size);
+  }
+  return clone;
+}
+
+void gdraw_command_image_destroy(GDrawCommandImage* image) {
+  host_free(image);
+}
+
+void gdraw_command_image_draw(GContext* ctx, GDrawCommandImage* image, GPoint offset) {
+  if (image) {
+    gdraw_command_list_draw(ctx, &image->command_list);
+  }
+}
+
+GSize gdraw_command_image_get_bounds_size(GDrawCommandImage* image) {
+  return image ? image->size : GSizeZero;
+}
+
+void gdraw_command_image_set_bounds_size(GDrawCommandImage* image, GSize size) {
+  if (image) {
+    image->size = size;
+  }
+}
+
+GDrawCommandList* gdraw_command_image_get_command_list(GDrawCommandImage* image) {
+  return image ? &image->command_list : NULL;
+}
+
+uint32_t gdraw_command_list_get_num_commands(GDrawCommandList* command_list) {
+  return command_list ? command_list->num_commands : 0;
+}
+
+GDrawCommand* gdraw_command_list_get_command(GDrawCommandList* command_list, uint16_t command_idx) {
+  if (!command_list || command_idx >= command_list->num_commands) {
+    return NULL;
+  }
+  GDrawCommand* command = command_list->commands;
+  for (uint16_t i = 0; i < command_idx; i++) {
+    command = prv_next_command(command);
+  }
+  return command;
+}
+
+void gdraw_command_list_draw(GContext* ctx, GDrawCommandList* command_list) {
+  GDrawCommand* command = command_list->commands;
+  for (uint16_t i = 0; i < command_list->num_commands; i++) {
+    if (!command->hidden) {
+      host_draw_counters.pdc_commands_drawn++;
+      host_draw_counters.pdc_points_drawn += command->num_points;
+      host_draw_counters.draw_ops++;
+    }
+    command = prv_next_command(command);
+  }
+}
+
+GDrawCommandType gdraw_command_get_type(GDrawCommand* command) {
+  return (GDrawCommandType)command->type;
+}
+
+uint16_t gdraw_command_get_num_points(GDrawCommand* command) {
+  return command->num_points;
+}
+
+GPoint gdraw_command_get_point(GDrawCommand* command, uint16_t point_idx) {
+  if (point_idx >= command->num_points) {
+    return GPointZero;
+  }
+  return command->points[point_idx];
+}
+
+void gdraw_command_set_point(GDrawCommand* command, uint16_t point_idx, GPoint point) {
+  if (point_idx < command->num_points) {
+    command->points[point_idx] = point;
+  }
+}
+
+uint16_t gdraw_command_get_radius(GDrawCommand* command) {
+  return command->type == GDrawCommandTypeCircle ? command->radius : 0;
+}
+
+GColor gdraw_command_get_fill_color(GDrawCommand* command) {
+  return command->fill_color;
+}
+
+void gdraw_command_set_fill_color(GDrawCommand* command, GColor fill_color) {
+  command->fill_color = fill_color;
+}
+
+GColor gdraw_command_get_stroke_color(GDrawCommand* command) {
+  return command->stroke_color;
+}
+
+void gdraw_command_set_stroke_color(GDrawCommand* command, GColor stroke_color) {
+  command->stroke_color = stroke_color;
+}
+
+uint8_t gdraw_command_get_stroke_width(GDrawCommand* command) {
+  return command->stroke_width;
+}
+
+void gdraw_command_set_stroke_width(GDrawCommand* command, uint8_t stroke_width) {
+  command->stroke_width = stroke_width;
+}
+
+bool gdraw_command_get_hidden(GDrawCommand* command) {
+  return command->hidden != 0;
+}
+
+void gdraw_command_set_hidden(GDrawCommand* command, bool hidden) {
+  command->hidden = hidden;
+}
+
+// ── Graphics context ──────────────────────────────────────────────────────────
+
+struct GContext {
+  GColor stroke_color;
+  GColor fill_color;
+  GColor text_color;
+  uint8_t stroke_width;
+  bool antialiased;
+  GCompOp compositing_mode;
+};
+
+static GContext s_context = {
+  .stroke_color = {.argb = 0xC0},
+  .fill_color = {.argb = 0xC0},
+  .text_color = {.argb = 0xC0},
+  .stroke_width = 1,
+};
+
+GContext* host_graphics_context(void) {
+  return &s_context;
+}
+
+void graphics_context_set_stroke_color(GContext* ctx, GColor color) {
+  ctx->stroke_color = color;
+}
+
+void graphics_context_set_fill_color(GContext* ctx, GColor color) {
+  ctx->fill_color = color;
+}
+
+void graphics_context_set_text_color(GContext* ctx, GColor color) {
+  ctx->text_color = color;
+}
+
+void graphics_context_set_stroke_width(GContext* ctx, uint8_t stroke_width) {
+  ctx->stroke_width = stroke_width;
+}
+
+void graphics_context_set_antialiased(GContext* ctx, bool enable) {
+  ctx->antialiased = enable;
+}
+
+void graphics_context_set_compositing_mode(GContext* ctx, GCompOp mode) {
+  ctx->compositing_mode = mode;
+}
+
+void graphics_draw_pixel(GContext* ctx, GPoint point) {
+  host_draw_counters.draw_ops++;
+}
+
+void graphics_draw_line(GContext* ctx, GPoint p0, GPoint p1) {
+  host_draw_counters.draw_ops++;
+}
+
+void graphics_draw_rect(GContext* ctx, GRect rect) {
+  host_draw_counters.draw_ops++;
+}
+
+void graphics_fill_rect(GContext* ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {
+  host_draw_counters.draw_ops++;
+}
+
+void graphics_draw_circle(GContext* ctx, GPoint p, uint16_t radius) {
+  host_draw_counters.draw_ops++;
+}
+
+void graphics_fill_circle(GContext* ctx, GPoint p, uint16_t radius) {
+  host_draw_counters.draw_ops++;
+}
+
+void graphics_draw_arc(GContext* ctx, GRect rect, GOvalScaleMode scale_mode, int32_t angle_start, int32_t angle_end) {
+  host_draw_counters.draw_ops++;
+}
+
+void graphics_fill_radial(GContext* ctx, GRect rect, GOvalScaleMode scale_mode, uint16_t inset_thickness,
+                          int32_t angle_start, int32_t angle_end) {
+  host_draw_counters.draw_ops++;
+}
+
+void graphics_draw_bitmap_in_rect(GContext* ctx, const GBitmap* bitmap, GRect rect) {
+  host_draw_counters.draw_ops++;
+}
+
+GPoint gpoint_from_polar(GRect container, GOvalScaleMode scale_mode, int32_t angle) {
+  int32_t radius = (container.size.w < container.size.h ? container.size.w : container.size.h) / 2;
+  GPoint center = grect_center_point(&container);
+  return GPoint(center.x + (sin_lookup(angle) * radius) / TRIG_MAX_RATIO,
+                center.y - (cos_lookup(angle) * radius) / TRIG_MAX_RATIO);
+}
+
+// ── Bitmaps ───────────────────────────────────────────────────────────────────
+
+struct GBitmap {
+  GRect bounds;
+  GBitmapFormat format;
+  uint16_t row_size_bytes;
+  uint8_t* data;
+};
+
+static uint16_t prv_row_size(GSize size, GBitmapFormat format) {
+  switch (format) {
+    case GBitmapFormat1Bit:
+      return ((size.w + 31) / 32) * 4;
+    case GBitmapFormat1BitPalette:
+      return (size.w + 7) / 8;
+    case GBitmapFormat2BitPalette:
+      return (size.w + 3) / 4;
+    case GBitmapFormat4BitPalette:
+      return (size.w + 1) / 2;
+    default:
+      return size.w;
+  }
+}
+
+GBitmap* gbitmap_create_blank(GSize size, GBitmapFormat format) {
+  uint16_t row_size = prv_row_size(size, format);
+  GBitmap* bitmap = host_calloc(1, sizeof(GBitmap) + (size_t)row_size * size.h);
+  if (!bitmap) {
+    return NULL;
+  }
+  bitmap->bounds = GRect(0, 0, size.w, size.h);
+  bitmap->format = format;
+  bitmap->row_size_bytes = row_size;
+  bitmap->data = (uint8_t*)(bitmap + 1);
+  return bitmap;
+}
+
+void gbitmap_destroy(GBitmap* bitmap) {
+  host_free(bitmap);
+}
+
+uint8_t* gbitmap_get_data(const GBitmap* bitmap) {
+  return bitmap->data;
+}
+
+uint16_t gbitmap_get_bytes_per_row(const GBitmap* bitmap) {
+  return bitmap->row_size_bytes;
+}
+
+GBitmapFormat gbitmap_get_format(const GBitmap* bitmap) {
+  return bitmap->format;
+}
+
+GRect gbitmap_get_bounds(const GBitmap* bitmap) {
+  return bitmap->bounds;
+}
+
+// Every bitmap here is rectangular, the framebuffer on round platforms too
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap* bitmap, uint16_t y) {
+  return (GBitmapDataRowInfo){
+    .data = bitmap->data + (size_t)y * bitmap->row_size_bytes,
+    .min_x = 0,
+    .max_x = bitmap->bounds.size.w - 1,
+  };
+}
+
+// The framebuffer lives outside the app heap on the watch, and here too.
+static uint8_t s_framebuffer_data[PBL_DISPLAY_WIDTH * PBL_DISPLAY_HEIGHT];
+static GBitmap s_framebuffer = {
+  .bounds = {{0, 0}, {PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT}},
+  .format = PBL_IF_COLOR_ELSE(GBitmapFormat8Bit, GBitmapFormat1Bit),
+  .row_size_bytes = PBL_IF_COLOR_ELSE(PBL_DISPLAY_WIDTH, ((PBL_DISPLAY_WIDTH + 31) / 32) * 4),
+  .data = s_framebuffer_data,
+};
+static bool s_framebuffer_captured;
+
+GBitmap* graphics_capture_frame_buffer(GContext* ctx) {
+  if (s_framebuffer_captured) {
+    return NULL;
+  }
+  s_framebuffer_captured = true;
+  return &s_framebuffer;
+}
+
+GBitmap* graphics_capture_frame_buffer_format(GContext* ctx, GBitmapFormat format) {
+  return graphics_capture_frame_buffer(ctx);
+}
+
+bool graphics_release_frame_buffer(GContext* ctx, GBitmap* buffer) {
+  if (buffer != &s_framebuffer || !s_framebuffer_captured) {
+    return false;
+  }
+  s_framebuffer_captured = false;
+  return true;
+}
+
+// ── Paths ─────────────────────────────────────────────────────────────────────
+// As in the SDK, a GPath references the caller's points rather than copying.
+
+GPath* gpath_create(const GPathInfo* init) {
+  GPath* path = host_calloc(1, sizeof(GPath));
+  if (!path) {
+    return NULL;
+  }
+  path->num_points = init->num_points;
+  path->points = init->points;
+  return path;
+}
+
+void gpath_destroy(GPath* path) {
+  host_free(path);
+}
+
+void gpath_draw_filled(GContext* ctx, GPath* path) {
+  host_draw_counters.draw_ops++;
+  host_draw_counters.pdc_points_drawn += path->num_points;
+}
+
+void gpath_draw_outline(GContext* ctx, GPath* path) {
+  host_draw_counters.draw_ops++;
+  host_draw_counters.pdc_points_drawn += path->num_points;
+}
+
+void gpath_move_to(GPath* path, GPoint point) {
+  path->offset = point;
+}
@@ -0,0 +1,164 @@
+/*
+    Heap counter
+
+    Every block carries a small header recording its size and bucket, so frees
+    can be attributed without a side table, both to its bucket and to the
+    profiling zone that allocated it. The app bucket is capped at the
+    platform's heap size to surface out-of-memory paths on the host.
+*/
+
+#include "host_internal.h"
+
+#define HEAP_MAGIC 0xD81BB1E5u
+
+typedef enum {
+  HEAP_BUCKET_APP,
+  HEAP_BUCKET_SDK,
+} HeapBucket;
+
+typedef struct HeapHeader {
+  uint32_t magic;
+  uint16_t bucket;
+  uint16_t zone;
+  size_t size;
+} __attribute__((aligned(16))) HeapHeader;
+
+static HostHeapStats s_app_stats;
+static size_t s_sdk_bytes_in_use;
+static size_t s_limit = HOST_APP_HEAP_LIMIT;
+
+static void* prv_alloc(HeapBucket bucket, size_t size, bool zero) {
+  if (bucket == HEAP_BUCKET_APP) {
+    if (s_app_stats.bytes_in_use + size > s_limit) {
+      s_app_stats.failed_allocs++;
+      return NULL;
+    }
+  }
+
+  HeapHeader* header = zero ? calloc(1, sizeof(HeapHeader) + size) : malloc(sizeof(HeapHeader) + size);
+  if (!header) {
+    return NULL;
+  }
+  header->magic = HEAP_MAGIC;
+  header->bucket = bucket;
+  header->zone = host_profile_current();
+  header->size = size;
+
+  if (bucket == HEAP_BUCKET_APP) {
+    host_profile_note_alloc(header->zone, size);
+    s_app_stats.bytes_in_use += size;
+    s_app_stats.bytes_allocated += size;
+    s_app_stats.blocks_in_use++;
+    s_app_stats.allocs++;
+    if (s_app_stats.bytes_in_use > s_app_stats.peak_bytes_in_use) {
+      s_app_stats.peak_bytes_in_use = s_app_stats.bytes_in_use;
+    }
+  } else {
+    s_sdk_bytes_in_use += size;
+  }
+
+  return header + 1;
+}
+
+static HeapHeader* prv_header(void* ptr) {
+  HeapHeader* header = ((HeapHeader*)ptr) - 1;
+  if (header->magic != HEAP_MAGIC) {
+    fprintf(stderr, "host heap: free of a block not allocated by the shim (%p)\n", ptr);
+    abort();
+  }
+  return header;
+}
+
+static void prv_release(HeapHeader* header) {
+  if (header->bucket == HEAP_BUCKET_APP) {
+    host_profile_note_free(header->zone, header->size);
+    s_app_stats.bytes_in_use -= header->size;
+    s_app_stats.blocks_in_use--;
+    s_app_stats.frees++;
+  } else {
+    s_sdk_bytes_in_use -= header->size;
+  }
+}
+
+void* host_malloc(size_t size) {
+  return prv_alloc(HEAP_BUCKET_APP, size, false);
+}
+
+void* host_calloc(size_t count, size_t size) {
+  return prv_alloc(HEAP_BUCKET_APP, count * size, true);
+}
+
+void* host_realloc(void* ptr, size_t size) {
+  if (!ptr) {
+    return host_malloc(size);
+  }
+  if (size == 0) {
+    host_free(ptr);
+    return NULL;
+  }
+
+  HeapHeader* header = prv_header(ptr);
+  void* moved = prv_alloc(header->bucket, size, false);
+  if (!moved) {
+    return NULL;
+  }
+  memcpy(moved, ptr, header->size < size ? header->size : size);
+  prv_release(header);
+  header->magic = 0;
+  free(header);
+  return moved;
+}
+
+void host_free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  HeapHeader* header = prv_header(ptr);
+  prv_release(header);
+  header->magic = 0;
+  free(header);
+}
+
+void* host_sdk_malloc(size_t size) {
+  return prv_alloc(HEAP_BUCKET_SDK, size, false);
+}
+
+void* host_sdk_calloc(size_t count, size_t size) {
+  return prv_alloc(HEAP_BUCKET_SDK, count * size, true);
+}
+
+void host_sdk_free(void* ptr) {
+  host_free(ptr);
+}
+
+size_t heap_bytes_used(void) {
+  return s_app_stats.bytes_in_use;
+}
+
+size_t heap_bytes_free(void) {
+  return s_limit > s_app_stats.bytes_in_use ? s_limit - s_app_stats.bytes_in_use : 0;
+}
+
+void host_heap_get_stats(HostHeapStats* stats) {
+  *stats = s_app_stats;
+}
+
+void host_heap_reset_counters(void) {
+  s_app_stats.allocs = 0;
+  s_app_stats.frees = 0;
+  s_app_stats.failed_allocs = 0;
+  s_app_stats.bytes_allocated = 0;
+  s_app_stats.peak_bytes_in_use = s_app_stats.bytes_in_use;
+}
+
+void host_heap_reset_peak(void) {
+  s_app_stats.peak_bytes_in_use = s_app_stats.bytes_in_use;
+}
+
+void host_heap_set_limit(size_t bytes) {
+  s_limit = bytes;
+}
+
+size_t host_heap_get_limit(void) {
+  return s_limit;
+}
@@ -0,0 +1,39 @@
+/*
+    Shared between the shim's translation units only.
+*/
+
+#pragma once
+
+#define HOST_SHIM_INTERNAL
+#include "pebble_host.h"
+
+// clock.c
+void host_clock_reset(void);
+
+// layer.c
+void host_layer_reset(void);
+void host_layer_note_dirty(void);
+bool host_layer_is_dirty(void);
+
+// gdraw.c
+typedef struct HostDrawCounters {
+  uint32_t draw_ops;
+  uint32_t pdc_commands_drawn;
+  uint32_t pdc_points_drawn;
+} HostDrawCounters;
+
+extern HostDrawCounters host_draw_counters;
+GContext* host_graphics_context(void);
+
+// profile.c
+uint8_t host_profile_current(void);
+void host_profile_push(uint8_t zone);
+void host_profile_pop(void);
+void host_profile_note_alloc(uint8_t zone, size_t size);
+void host_profile_note_free(uint8_t zone, size_t size);
+void host_profile_note_update(uint8_t zone, uint64_t ns);
+void host_profile_note_callback(uint8_t zone, uint64_t ns);
+void host_profile_frame_end(bool rendered);
+
+// system.c
+void host_system_reset(void);
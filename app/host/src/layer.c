@@ -0,0 +1,624 @@
+/*
+    Layers, windows and clicks
+
+    Layers form the same parent/child/sibling tree as on the watch. Nothing is
+    rasterised: a render pass walks the top window's tree and calls every
+    visible update proc, which is what the cost of a frame is made of.
+*/
+
+#include "host_internal.h"
+
+typedef enum {
+  LAYER_KIND_PLAIN,
+  LAYER_KIND_TEXT,
+  LAYER_KIND_STATUS_BAR,
+  LAYER_KIND_ROOT,
+} LayerKind;
+
+struct Layer {
+  GRect frame;
+  GRect bounds;
+  bool hidden;
+  bool clips;
+  LayerKind kind;
+  LayerUpdateProc update_proc;
+  Layer* parent;
+  Layer* first_child;
+  Layer* next_sibling;
+  Window* window;
+  void* data;
+};
+
+struct TextLayer {
+  Layer layer;
+  const char* text;
+  GFont font;
+  GColor text_color;
+  GColor background_color;
+  GTextOverflowMode overflow_mode;
+  GTextAlignment text_alignment;
+};
+
+struct StatusBarLayer {
+  Layer layer;
+  GColor background_color;
+  GColor foreground_color;
+};
+
+struct Window {
+  Layer root;
+  WindowHandlers handlers;
+  ClickConfigProvider click_config_provider;
+  void* click_config_context;
+  ClickHandler single_click[NUM_BUTTONS];
+  uint16_t repeat_interval_ms[NUM_BUTTONS];
+  GColor background_color;
+  bool loaded;
+  void* user_data;
+};
+
+#define WINDOW_STACK_MAX 8
+
+static Window* s_window_stack[WINDOW_STACK_MAX];
+static uint8_t s_window_stack_count;
+static Window* s_configuring_window;
+static bool s_dirty;
+static HostRenderStats s_render_stats;
+
+// ── Layer ─────────────────────────────────────────────────────────────────────
+
+static void prv_layer_init(Layer* layer, GRect frame, LayerKind kind) {
+  layer->frame = frame;
+  layer->bounds = GRect(0, 0, frame.size.w, frame.size.h);
+  layer->clips = true;
+  layer->kind = kind;
+}
+
+void host_layer_note_dirty(void) {
+  s_dirty = true;
+  s_render_stats.dirty_marks++;
+}
+
+bool host_layer_is_dirty(void) {
+  return s_dirty;
+}
+
+Layer* layer_create(GRect frame) {
+  return layer_create_with_data(frame, 0);
+}
+
+Layer* layer_create_with_data(GRect frame, size_t data_size) {
+  Layer* layer = host_calloc(1, sizeof(Layer) + data_size);
+  if (!layer) {
+    return NULL;
+  }
+  prv_layer_init(layer, frame, LAYER_KIND_PLAIN);
+  if (data_size > 0) {
+    layer->data = layer + 1;
+  }
+  return layer;
+}
+
+void layer_destroy(Layer* layer) {
+  if (!layer) {
+    return;
+  }
+  layer_remove_from_parent(layer);
+  // Children are left orphaned, as on the watch.
+  for (Layer* child = layer->first_child; child;) {
+    Layer* next = child->next_sibling;
+    child->parent = NULL;
+    child->next_sibling = NULL;
+    child = next;
+  }
+  host_free(layer);
+}
+
+void layer_mark_dirty(Layer* layer) {
+  if (layer) {
+    host_layer_note_dirty();
+  }
+}
+
+void layer_set_update_proc(Layer* layer, LayerUpdateProc update_proc) {
+  layer->update_proc = update_proc;
+}
+
+void layer_set_frame(Layer* layer, GRect frame) {
+  if (grect_equal(&layer->frame, &frame)) {
+    return;
+  }
+  bool bounds_track_frame = layer->bounds.origin.x == 0 && layer->bounds.origin.y == 0 &&
+                            layer->bounds.size.w == layer->frame.size.w &&
+                            layer->bounds.size.h == layer->frame.size.h;
+  layer->frame = frame;
+  if (bounds_track_frame) {
+    layer->bounds.size = frame.size;
+  }
+  host_layer_note_dirty();
+}
+
+GRect layer_get_frame(const Layer* layer) {
+  return layer->frame;
+}
+
+void layer_set_bounds(Layer* layer, GRect bounds) {
+  layer->bounds = bounds;
+  host_layer_note_dirty();
+}
+
+GRect layer_get_bounds(const Layer* layer) {
+  return layer->bounds;
+}
+
+GRect layer_get_unobstructed_bounds(const Layer* layer) {
+  return layer->bounds;
+}
+
+Window* layer_get_window(const Layer* layer) {
+  while (layer->parent) {
+    layer = layer->parent;
+  }
+  return layer->window;
+}
+
+void layer_remove_from_parent(Layer* child) {
+  if (!child || !child->parent) {
+    return;
+  }
+  Layer** link = &child->parent->first_child;
+  while (*link && *link != child) {
+    link = &(*link)->next_sibling;
+  }
+  if (*link) {
+    *link = child->next_sibling;
+  }
+  child->parent = NULL;
+  child->next_sibling = NULL;
+  host_layer_note_dirty();
+}
+
+void layer_remove_child_layers(Layer* parent) {
+  while (parent->first_child) {
+    layer_remove_from_parent(parent->first_child);
+  }
+}
+
+void layer_add_child(Layer* parent, Layer* child) {
+  if (!parent || !child) {
+    return;
+  }
+  layer_remove_from_parent(child);
+  Layer** link = &parent->first_child;
+  while (*link) {
+    link = &(*link)->next_sibling;
+  }
+  *link = child;
+  child->parent = parent;
+  host_layer_note_dirty();
+}
+
+void layer_insert_below_sibling(Layer* layer_to_insert, Layer* below_sibling_layer) {
+  Layer* parent = below_sibling_layer->parent;
+  if (!parent) {
+    return;
+  }
+  layer_remove_from_parent(layer_to_insert);
+  Layer** link = &parent->first_child;
+  while (*link != below_sibling_layer) {
+    link = &(*link)->next_sibling;
+  }
+  layer_to_insert->next_sibling = below_sibling_layer;
+  layer_to_insert->parent = parent;
+  *link = layer_to_insert;
+  host_layer_note_dirty();
+}
+
+void layer_insert_above_sibling(Layer* layer_to_insert, Layer* above_sibling_layer) {
+  Layer* parent = above_sibling_layer->parent;
+  if (!parent) {
+    return;
+  }
+  layer_remove_from_parent(layer_to_insert);
+  layer_to_insert->next_sibling = above_sibling_layer->next_sibling;
+  layer_to_insert->parent = parent;
+  above_sibling_layer->next_sibling = layer_to_insert;
+  host_layer_note_dirty();
+}
+
+void layer_set_hidden(Layer* layer, bool hidden) {
+  if (layer->hidden != hidden) {
+    layer->hidden = hidden;
+    host_layer_note_dirty();
+  }
+}
+
+bool layer_get_hidden(const Layer* layer) {
+  return layer->hidden;
+}
+
+void layer_set_clips(Layer* layer, bool clips) {
+  layer->clips = clips;
+}
+
+bool layer_get_clips(const Layer* layer) {
+  return layer->clips;
+}
+
+void* layer_get_data(const Layer* layer) {
+  return layer->data;
+}
+
+// ── TextLayer ─────────────────────────────────────────────────────────────────
+
+static void prv_text_layer_update(Layer* layer, GContext* ctx) {
+  TextLayer* text_layer = (TextLayer*)layer;
+  if (text_layer->background_color.argb != GColorClear.argb) {
+    graphics_fill_rect(ctx, layer->bounds, 0, GCornerNone);
+  }
+  if (text_layer->text) {
+    // Glyph layout cost scales with the text length.
+    host_draw_counters.draw_ops += 1 + (uint32_t)strlen(text_layer->text) / 8;
+  }
+}
+
+TextLayer* text_layer_create(GRect frame) {
+  TextLayer* text_layer = host_calloc(1, sizeof(TextLayer));
+  if (!text_layer) {
+    return NULL;
+  }
+  prv_layer_init(&text_layer->layer, frame, LAYER_KIND_TEXT);
+  text_layer->layer.update_proc = prv_text_layer_update;
+  text_layer->text_color = GColorBlack;
+  text_layer->background_color = GColorWhite;
+  text_layer->font = fonts_get_system_font(FONT_KEY_GOTHIC_18);
+  return text_layer;
+}
+
+void text_layer_destroy(TextLayer* text_layer) {
+  if (text_layer) {
+    layer_destroy(&text_layer->layer);
+  }
+}
+
+Layer* text_layer_get_layer(TextLayer* text_layer) {
+  return &text_layer->layer;
+}
+
+void text_layer_set_text(TextLayer* text_layer, const char* text) {
+  text_layer->text = text;
+  host_layer_note_dirty();
+}
+
+const char* text_layer_get_text(TextLayer* text_layer) {
+  return text_layer->text;
+}
+
+void text_layer_set_background_color(TextLayer* text_layer, GColor color) {
+  text_layer->background_color = color;
+  host_layer_note_dirty();
+}
+
+void text_layer_set_text_color(TextLayer* text_layer, GColor color) {
+  text_layer->text_color = color;
+  host_layer_note_dirty();
+}
+
+void text_layer_set_overflow_mode(TextLayer* text_layer, GTextOverflowMode line_mode) {
+  text_layer->overflow_mode = line_mode;
+}
+
+void text_layer_set_font(TextLayer* text_layer, GFont font) {
+  text_layer->font = font;
+  host_layer_note_dirty();
+}
+
+void text_layer_set_text_alignment(TextLayer* text_layer, GTextAlignment text_alignment) {
+  text_layer->text_alignment = text_alignment;
+}
+
+// ── StatusBarLayer ────────────────────────────────────────────────────────────
+
+static void prv_status_bar_update(Layer* layer, GContext* ctx) {
+  graphics_fill_rect(ctx, layer->bounds, 0, GCornerNone);
+  host_draw_counters.draw_ops++;
+}
+
+StatusBarLayer* status_bar_layer_create(void) {
+  StatusBarLayer* status_bar = host_calloc(1, sizeof(StatusBarLayer));
+  if (!status_bar) {
+    return NULL;
+  }
+  prv_layer_init(&status_bar->layer, GRect(0, 0, PBL_DISPLAY_WIDTH, STATUS_BAR_LAYER_HEIGHT),
+                 LAYER_KIND_STATUS_BAR);
+  status_bar->layer.update_proc = prv_status_bar_update;
+  status_bar->background_color = GColorBlack;
+  status_bar->foreground_color = GColorWhite;
+  return status_bar;
+}
+
+void status_bar_layer_destroy(StatusBarLayer* status_bar_layer) {
+  if (status_bar_layer) {
+    layer_destroy(&status_bar_layer->layer);
+  }
+}
+
+Layer* status_bar_layer_get_layer(StatusBarLayer* status_bar_layer) {
+  return &status_bar_layer->layer;
+}
+
+void status_bar_layer_set_colors(StatusBarLayer* status_bar_layer, GColor background, GColor foreground) {
+  status_bar_layer->background_color = background;
+  status_bar_layer->foreground_color = foreground;
+  host_layer_note_dirty();
+}
+
+// ── Window ────────────────────────────────────────────────────────────────────
+
+Window* window_create(void) {
+  Window* window = host_calloc(1, sizeof(Window));
+  if (!window) {
+    return NULL;
+  }
+  prv_layer_init(&window->root, GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT), LAYER_KIND_ROOT);
+  window->root.window = window;
+  window->background_color = GColorWhite;
+  return window;
+}
+
+void window_destroy(Window* window) {
+  if (!window) {
+    return;
+  }
+  window_stack_remove(window, false);
+  if (window->loaded && window->handlers.unload) {
+    window->handlers.unload(window);
+  }
+  window->loaded = false;
+  layer_remove_child_layers(&window->root);
+  host_free(window);
+}
+
+void window_set_window_handlers(Window* window, WindowHandlers handlers) {
+  window->handlers = handlers;
+}
+
+void window_set_click_config_provider(Window* window, ClickConfigProvider click_config_provider) {
+  window_set_click_config_provider_with_context(window, click_config_provider, window);
+}
+
+void window_set_click_config_provider_with_context(Window* window, ClickConfigProvider click_config_provider,
+                                                   void* context) {
+  window->click_config_provider = click_config_provider;
+  window->click_config_context = context;
+}
+
+Layer* window_get_root_layer(const Window* window) {
+  return (Layer*)&window->root;
+}
+
+void window_set_background_color(Window* window, GColor background_color) {
+  window->background_color = background_color;
+  host_layer_note_dirty();
+}
+
+bool window_is_loaded(Window* window) {
+  return window->loaded;
+}
+
+void window_set_user_data(Window* window, void* data) {
+  window->user_data = data;
+}
+
+void* window_get_user_data(const Window* window) {
+  return window->user_data;
+}
+
+// ── Window stack ──────────────────────────────────────────────────────────────
+
+static void prv_configure_clicks(Window* window) {
+  memset(window->single_click, 0, sizeof(window->single_click));
+  memset(window->repeat_interval_ms, 0, sizeof(window->repeat_interval_ms));
+  if (window->click_config_provider) {
+    s_configuring_window = window;
+    window->click_config_provider(window->click_config_context);
+    s_configuring_window = NULL;
+  }
+}
+
+void window_stack_push(Window* window, bool animated) {
+  if (!window || s_window_stack_count >= WINDOW_STACK_MAX) {
+    return;
+  }
+  window_stack_remove(window, false);
+
+  Window* previous = window_stack_get_top_window();
+  if (previous && previous->handlers.disappear) {
+    previous->handlers.disappear(previous);
+  }
+
+  s_window_stack[s_window_stack_count++] = window;
+  if (!window->loaded) {
+    window->loaded = true;
+    if (window->handlers.load) {
+      window->handlers.load(window);
+    }
+  }
+  prv_configure_clicks(window);
+  if (window->handlers.appear) {
+    window->handlers.appear(window);
+  }
+  host_layer_note_dirty();
+}
+
+Window* window_stack_pop(bool animated) {
+  Window* top = window_stack_get_top_window();
+  if (top) {
+    window_stack_remove(top, animated);
+  }
+  return top;
+}
+
+bool window_stack_remove(Window* window, bool animated) {
+  int index = -1;
+  for (int i = 0; i < s_window_stack_count; i++) {
+    if (s_window_stack[i] == window) {
+      index = i;
+      break;
+    }
+  }
+  if (index < 0) {
+    return false;
+  }
+
+  bool was_top = index == s_window_stack_count - 1;
+  for (int i = index; i < s_window_stack_count - 1; i++) {
+    s_window_stack[i] = s_window_stack[i + 1];
+  }
+  s_window_stack_count--;
+
+  if (was_top && window->handlers.disappear) {
+    window->handlers.disappear(window);
+  }
+  if (window->loaded) {
+    window->loaded = false;
+    if (window->handlers.unload) {
+      window->handlers.unload(window);
+    }
+  }
+
+  Window* top = window_stack_get_top_window();
+  if (was_top && top) {
+    prv_configure_clicks(top);
+    if (top->handlers.appear) {
+      top->handlers.appear(top);
+    }
+  }
+  host_layer_note_dirty();
+  return true;
+}
+
+Window* window_stack_get_top_window(void) {
+  return s_window_stack_count > 0 ? s_window_stack[s_window_stack_count - 1] : NULL;
+}
+
+bool window_stack_contains_window(Window* window) {
+  for (int i = 0; i < s_window_stack_count; i++) {
+    if (s_window_stack[i] == window) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ── Clicks ────────────────────────────────────────────────────────────────────
+
+typedef struct HostClickRecognizer {
+  ButtonId button;
+  bool repeating;
+} HostClickRecognizer;
+
+void window_single_click_subscribe(ButtonId button_id, ClickHandler handler) {
+  if (s_configuring_window && button_id < NUM_BUTTONS) {
+    s_configuring_window->single_click[button_id] = handler;
+    s_configuring_window->repeat_interval_ms[button_id] = 0;
+  }
+}
+
+void window_single_repeating_click_subscribe(ButtonId button_id, uint16_t repeat_interval_ms, ClickHandler handler) {
+  if (s_configuring_window && button_id < NUM_BUTTONS) {
+    s_configuring_window->single_click[button_id] = handler;
+    s_configuring_window->repeat_interval_ms[button_id] = repeat_interval_ms;
+  }
+}
+
+void window_long_click_subscribe(ButtonId button_id, uint16_t delay_ms, ClickHandler down_handler,
+                                 ClickHandler up_handler) {
+}
+
+bool click_recognizer_is_repeating(ClickRecognizerRef recognizer) {
+  return ((HostClickRecognizer*)recognizer)->repeating;
+}
+
+uint8_t click_number_of_clicks_counted(ClickRecognizerRef recognizer) {
+  return 1;
+}
+
+void host_click(ButtonId button, bool repeating) {
+  Window* window = window_stack_get_top_window();
+  if (!window || button >= NUM_BUTTONS) {
+    return;
+  }
+  ClickHandler handler = window->single_click[button];
+  if (!handler) {
+    if (button == BUTTON_ID_BACK && !repeating) {
+      window_stack_pop(true);
+      host_render_if_dirty();
+    }
+    return;
+  }
+  // Repeats only reach handlers that subscribed with a repeat interval.
+  if (repeating && window->repeat_interval_ms[button] == 0) {
+    return;
+  }
+  HostClickRecognizer recognizer = {.button = button, .repeating = repeating};
+  handler(&recognizer, window->click_config_context);
+  host_render_if_dirty();
+}
+
+// ── Rendering ─────────────────────────────────────────────────────────────────
+
+static void prv_render_layer(Layer* layer, GContext* ctx) {
+  if (layer->hidden) {
+    return;
+  }
+  s_render_stats.layers_drawn++;
+  if (layer->update_proc) {
+    layer->update_proc(layer, ctx);
+  }
+  for (Layer* child = layer->first_child; child; child = child->next_sibling) {
+    prv_render_layer(child, ctx);
+  }
+}
+
+void host_render(void) {
+  s_dirty = false;
+  Window* window = window_stack_get_top_window();
+  if (!window) {
+    return;
+  }
+  s_render_stats.renders++;
+  uint64_t start_ns = host_wall_ns();
+  GContext* ctx = host_graphics_context();
+  graphics_context_set_fill_color(ctx, window->background_color);
+  graphics_fill_rect(ctx, window->root.bounds, 0, GCornerNone);
+  prv_render_layer(&window->root, ctx);
+  s_render_stats.render_ns += host_wall_ns() - start_ns;
+}
+
+bool host_render_if_dirty(void) {
+  if (!s_dirty) {
+    return false;
+  }
+  host_render();
+  return true;
+}
+
+void host_render_get_stats(HostRenderStats* stats) {
+  *stats = s_render_stats;
+  stats->draw_ops = host_draw_counters.draw_ops;
+  stats->pdc_commands_drawn = host_draw_counters.pdc_commands_drawn;
+  stats->pdc_points_drawn = host_draw_counters.pdc_points_drawn;
+}
+
+void host_render_reset_stats(void) {
+  memset(&s_render_stats, 0, sizeof(s_render_stats));
+  memset(&host_draw_counters, 0, sizeof(host_draw_counters));
+}
+
+void host_layer_reset(void) {
+  s_window_stack_count = 0;
+  s_configuring_window = NULL;
+  s_dirty = false;
+  host_render_reset_stats();
+}
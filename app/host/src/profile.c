@@ -0,0 +1,173 @@
+/*
+    Profiling zones
+
+    A zone is a named bucket of cost. App code enters one through
+    ANIMATION_PROFILE_SCOPE; heap.c tags each block with the zone that was
+    current when it was allocated, and clock.c remembers the zone each
+    animation and timer was created in and re-enters it whenever it runs their
+    callbacks.
+*/
+
+#include "host_internal.h"
+
+#define HOST_PROFILE_STACK_DEPTH 16
+
+typedef struct ProfileZone {
+  HostProfileZoneStats stats;
+  bool touched_this_frame;
+} ProfileZone;
+
+typedef struct ProfileFrame {
+  uint8_t zone;
+  bool timed;
+  bool update;  // charged as an animation update rather than callback time
+  uint64_t start_ns;
+} ProfileFrame;
+
+static ProfileZone s_zones[HOST_PROFILE_MAX_ZONES] = {
+  [0] = {.stats = {.name = "unattributed"}},
+};
+static uint8_t s_zone_count = 1;
+static ProfileFrame s_stack[HOST_PROFILE_STACK_DEPTH];
+static uint8_t s_depth;
+
+uint8_t host_profile_zone_find(const char* name) {
+  for (uint8_t i = 0; i < s_zone_count; i++) {
+    if (strcmp(s_zones[i].stats.name, name) == 0) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+static uint8_t prv_zone_register(const char* name) {
+  uint8_t zone = host_profile_zone_find(name);
+  if (zone != 0 || s_zone_count >= HOST_PROFILE_MAX_ZONES) {
+    return zone;
+  }
+  zone = s_zone_count++;
+  s_zones[zone].stats.name = name;
+  return zone;
+}
+
+static void prv_push(uint8_t zone, bool timed) {
+  if (s_depth >= HOST_PROFILE_STACK_DEPTH) {
+    fprintf(stderr, "host profile: zone stack overflow\n");
+    abort();
+  }
+  s_stack[s_depth++] = (ProfileFrame){.zone = zone, .timed = timed, .start_ns = timed ? host_wall_ns() : 0};
+}
+
+static void prv_pop(void) {
+  if (s_depth == 0) {
+    return;
+  }
+  ProfileFrame* frame = &s_stack[--s_depth];
+  if (frame->update) {
+    host_profile_note_update(frame->zone, host_wall_ns() - frame->start_ns);
+  } else if (frame->timed) {
+    s_zones[frame->zone].stats.callback_ns += host_wall_ns() - frame->start_ns;
+  }
+}
+
+const char* host_profile_begin(const char* zone) {
+  uint8_t id = prv_zone_register(zone);
+  s_zones[id].stats.entries++;
+  prv_push(id, true);
+  return zone;
+}
+
+// Work the frame clock steps for a zone counts as one of its animation
+// updates, as it would if the zone had scheduled an Animation of its own.
+const char* host_profile_begin_update(const char* zone) {
+  uint8_t id = zone ? prv_zone_register(zone) : 0;
+  prv_push(id, true);
+  s_stack[s_depth - 1].update = true;
+  return zone;
+}
+
+void host_profile_scope_end(const char** zone) {
+  prv_pop();
+}
+
+const char* host_profile_current_name(void) {
+  uint8_t zone = host_profile_current();
+  return zone ? s_zones[zone].stats.name : NULL;
+}
+
+uint8_t host_profile_current(void) {
+  return s_depth > 0 ? s_stack[s_depth - 1].zone : 0;
+}
+
+void host_profile_push(uint8_t zone) {
+  prv_push(zone, false);
+}
+
+void host_profile_pop(void) {
+  prv_pop();
+}
+
+void host_profile_note_alloc(uint8_t zone, size_t size) {
+  HostProfileZoneStats* stats = &s_zones[zone].stats;
+  stats->allocs++;
+  stats->bytes_allocated += size;
+  stats->live_bytes += size;
+  if (stats->live_bytes > stats->peak_live_bytes) {
+    stats->peak_live_bytes = stats->live_bytes;
+  }
+}
+
+void host_profile_note_free(uint8_t zone, size_t size) {
+  HostProfileZoneStats* stats = &s_zones[zone].stats;
+  stats->frees++;
+  stats->live_bytes -= size;
+}
+
+void host_profile_note_update(uint8_t zone, uint64_t ns) {
+  s_zones[zone].stats.updates++;
+  s_zones[zone].stats.update_ns += ns;
+  s_zones[zone].touched_this_frame = true;
+}
+
+void host_profile_note_callback(uint8_t zone, uint64_t ns) {
+  s_zones[zone].stats.callback_ns += ns;
+}
+
+void host_profile_frame_end(bool rendered) {
+  for (uint8_t i = 0; i < s_zone_count; i++) {
+    if (s_zones[i].touched_this_frame) {
+      s_zones[i].stats.frames++;
+      if (rendered) {
+        s_zones[i].stats.frames_rendered++;
+      }
+      s_zones[i].touched_this_frame = false;
+    }
+  }
+}
+
+uint8_t host_profile_zone_count(void) {
+  return s_zone_count;
+}
+
+void host_profile_get(uint8_t zone, HostProfileZoneStats* stats) {
+  if (zone < s_zone_count) {
+    *stats = s_zones[zone].stats;
+  } else {
+    memset(stats, 0, sizeof(*stats));
+  }
+}
+
+// Keeps the zones and their live byte counts, since those blocks are still
+// allocated, and clears everything else.
+void host_profile_reset(void) {
+  for (uint8_t i = 0; i < s_zone_count; i++) {
+    HostProfileZoneStats* stats = &s_zones[i].stats;
+    const char* name = stats->name;
+    size_t live_bytes = stats->live_bytes;
+    memset(stats, 0, sizeof(*stats));
+    stats->name = name;
+    stats->live_bytes = live_bytes;
+    stats->peak_live_bytes = live_bytes;
+    s_zones[i].touched_this_frame = false;
+  }
+}
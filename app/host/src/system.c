@@ -0,0 +1,576 @@
+/*
+    Persist, dictionaries, AppMessage and the remaining services
+
+    Dictionaries use the SDK's wire layout (a count byte followed by packed
+    key/type/length/value tuples), so buffers built here are byte-for-byte
+    what PebbleKit JS delivers and dict_calc_buffer_size() agrees with the
+    watch.
+*/
+
+#include "host_internal.h"
+
+#include <math.h>
+#include <stdarg.h>
+
+// ── Logging ───────────────────────────────────────────────────────────────────
+
+static int s_logging = -1;
+
+void host_set_logging(bool enabled) {
+  s_logging = enabled;
+}
+
+void app_log(uint8_t log_level, const char* src_filename, int src_line_number, const char* fmt, ...) {
+  if (s_logging < 0) {
+    const char* env = getenv("DRIBBLE_HOST_LOG");
+    s_logging = env && env[0] == '1';
+  }
+  if (!s_logging) {
+    return;
+  }
+  const char* name = strrchr(src_filename, '/');
+  fprintf(stderr, "[%3u] %s:%d ", log_level, name ? name + 1 : src_filename, src_line_number);
+  va_list args;
+  va_start(args, fmt);
+  vfprintf(stderr, fmt, args);
+  va_end(args);
+  fputc('\n', stderr);
+}
+
+uint64_t host_wall_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ── Persist ───────────────────────────────────────────────────────────────────
+
+#define PERSIST_MAX_KEYS 64
+
+typedef struct PersistEntry {
+  uint32_t key;
+  uint16_t size;
+  bool used;
+  uint8_t data[PERSIST_DATA_MAX_LENGTH];
+} PersistEntry;
+
+static PersistEntry s_persist[PERSIST_MAX_KEYS];
+
+static PersistEntry* prv_persist_find(uint32_t key) {
+  for (int i = 0; i < PERSIST_MAX_KEYS; i++) {
+    if (s_persist[i].used && s_persist[i].key == key) {
+      return &s_persist[i];
+    }
+  }
+  return NULL;
+}
+
+static PersistEntry* prv_persist_slot(uint32_t key) {
+  PersistEntry* entry = prv_persist_find(key);
+  if (entry) {
+    return entry;
+  }
+  for (int i = 0; i < PERSIST_MAX_KEYS; i++) {
+    if (!s_persist[i].used) {
+      s_persist[i].used = true;
+      s_persist[i].key = key;
+      s_persist[i].size = 0;
+      return &s_persist[i];
+    }
+  }
+  return NULL;
+}
+
+bool persist_exists(const uint32_t key) {
+  return prv_persist_find(key) != NULL;
+}
+
+int persist_get_size(const uint32_t key) {
+  PersistEntry* entry = prv_persist_find(key);
+  return entry ? entry->size : E_DOES_NOT_EXIST;
+}
+
+int32_t persist_read_int(const uint32_t key) {
+  int32_t value = 0;
+  persist_read_data(key, &value, sizeof(value));
+  return value;
+}
+
+int persist_read_data(const uint32_t key, void* buffer, const size_t buffer_size) {
+  PersistEntry* entry = prv_persist_find(key);
+  if (!entry) {
+    return E_DOES_NOT_EXIST;
+  }
+  size_t size = entry->size < buffer_size ? entry->size : buffer_size;
+  memcpy(buffer, entry->data, size);
+  return (int)size;
+}
+
+int persist_read_string(const uint32_t key, char* buffer, const size_t buffer_size) {
+  int size = persist_read_data(key, buffer, buffer_size);
+  if (size > 0) {
+    buffer[size < (int)buffer_size ? size : (int)buffer_size - 1] = '\0';
+  }
+  return size;
+}
+
+status_t persist_write_int(const uint32_t key, const int32_t value) {
+  int written = persist_write_data(key, &value, sizeof(value));
+  return written < 0 ? written : S_SUCCESS;
+}
+
+int persist_write_data(const uint32_t key, const void* data, const size_t size) {
+  if (size > PERSIST_DATA_MAX_LENGTH) {
+    return E_RANGE;
+  }
+  PersistEntry* entry = prv_persist_slot(key);
+  if (!entry) {
+    return E_OUT_OF_STORAGE;
+  }
+  memcpy(entry->data, data, size);
+  entry->size = (uint16_t)size;
+  return (int)size;
+}
+
+int persist_write_string(const uint32_t key, const char* cstring) {
+  return persist_write_data(key, cstring, strlen(cstring) + 1);
+}
+
+status_t persist_delete(const uint32_t key) {
+  PersistEntry* entry = prv_persist_find(key);
+  if (!entry) {
+    return E_DOES_NOT_EXIST;
+  }
+  entry->used = false;
+  return S_SUCCESS;
+}
+
+// ── Dictionary ────────────────────────────────────────────────────────────────
+
+struct __attribute__((packed)) Dictionary {
+  uint8_t count;
+  Tuple head[];
+};
+
+#define TUPLE_HEADER_SIZE (sizeof(Tuple))
+
+uint32_t dict_calc_buffer_size(const uint8_t tuple_count, ...) {
+  uint32_t size = sizeof(Dictionary);
+  va_list args;
+  va_start(args, tuple_count);
+  for (uint8_t i = 0; i < tuple_count; i++) {
+    size += TUPLE_HEADER_SIZE + va_arg(args, uint32_t);
+  }
+  va_end(args);
+  return size;
+}
+
+uint32_t dict_size(DictionaryIterator* iter) {
+  return (uint32_t)((const uint8_t*)iter->end - (const uint8_t*)iter->dictionary);
+}
+
+DictionaryResult dict_write_begin(DictionaryIterator* iter, uint8_t* const buffer, const uint16_t size) {
+  if (!iter || !buffer || size < sizeof(Dictionary)) {
+    return DICT_INVALID_ARGS;
+  }
+  iter->dictionary = (Dictionary*)buffer;
+  iter->dictionary->count = 0;
+  iter->cursor = iter->dictionary->head;
+  iter->end = buffer + size;
+  return DICT_OK;
+}
+
+static DictionaryResult prv_write(DictionaryIterator* iter, uint32_t key, TupleType type, const void* data,
+                                  uint16_t length) {
+  if (!iter || !iter->dictionary) {
+    return DICT_INVALID_ARGS;
+  }
+  uint8_t* cursor = (uint8_t*)iter->cursor;
+  if (cursor + TUPLE_HEADER_SIZE + length > (const uint8_t*)iter->end) {
+    return DICT_NOT_ENOUGH_STORAGE;
+  }
+  Tuple* tuple = iter->cursor;
+  tuple->key = key;
+  tuple->type = type;
+  tuple->length = length;
+  memcpy(tuple->value->data, data, length);
+  iter->cursor = (Tuple*)(cursor + TUPLE_HEADER_SIZE + length);
+  iter->dictionary->count++;
+  return DICT_OK;
+}
+
+DictionaryResult dict_write_data(DictionaryIterator* iter, const uint32_t key, const uint8_t* const data,
+                                 const uint16_t size) {
+  return prv_write(iter, key, TUPLE_BYTE_ARRAY, data, size);
+}
+
+DictionaryResult dict_write_cstring(DictionaryIterator* iter, const uint32_t key, const char* const cstring) {
+  return prv_write(iter, key, TUPLE_CSTRING, cstring, (uint16_t)(strlen(cstring) + 1));
+}
+
+DictionaryResult dict_write_int(DictionaryIterator* iter, const uint32_t key, const void* integer,
+                                const uint8_t width_bytes, const bool is_signed) {
+  if (width_bytes != 1 && width_bytes != 2 && width_bytes != 4) {
+    return DICT_INVALID_ARGS;
+  }
+  return prv_write(iter, key, is_signed ? TUPLE_INT : TUPLE_UINT, integer, width_bytes);
+}
+
+DictionaryResult dict_write_uint8(DictionaryIterator* iter, const uint32_t key, const uint8_t value) {
+  return dict_write_int(iter, key, &value, 1, false);
+}
+
+DictionaryResult dict_write_uint16(DictionaryIterator* iter, const uint32_t key, const uint16_t value) {
+  return dict_write_int(iter, key, &value, 2, false);
+}
+
+DictionaryResult dict_write_uint32(DictionaryIterator* iter, const uint32_t key, const uint32_t value) {
+  return dict_write_int(iter, key, &value, 4, false);
+}
+
+DictionaryResult dict_write_int8(DictionaryIterator* iter, const uint32_t key, const int8_t value) {
+  return dict_write_int(iter, key, &value, 1, true);
+}
+
+DictionaryResult dict_write_int16(DictionaryIterator* iter, const uint32_t key, const int16_t value) {
+  return dict_write_int(iter, key, &value, 2, true);
+}
+
+DictionaryResult dict_write_int32(DictionaryIterator* iter, const uint32_t key, const int32_t value) {
+  return dict_write_int(iter, key, &value, 4, true);
+}
+
+uint32_t dict_write_end(DictionaryIterator* iter) {
+  if (!iter || !iter->dictionary) {
+    return 0;
+  }
+  iter->end = iter->cursor;
+  iter->cursor = iter->dictionary->head;
+  return dict_size(iter);
+}
+
+Tuple* dict_read_begin_from_buffer(DictionaryIterator* iter, const uint8_t* const buffer, const uint16_t size) {
+  if (!iter || !buffer || size < sizeof(Dictionary)) {
+    return NULL;
+  }
+  iter->dictionary = (Dictionary*)buffer;
+  iter->end = buffer + size;
+  return dict_read_first(iter);
+}
+
+static bool prv_tuple_fits(const DictionaryIterator* iter, const Tuple* tuple) {
+  const uint8_t* start = (const uint8_t*)tuple;
+  return start + TUPLE_HEADER_SIZE <= (const uint8_t*)iter->end &&
+         start + TUPLE_HEADER_SIZE + tuple->length <= (const uint8_t*)iter->end;
+}
+
+Tuple* dict_read_first(DictionaryIterator* iter) {
+  iter->cursor = iter->dictionary->head;
+  if (iter->dictionary->count == 0 || !prv_tuple_fits(iter, iter->cursor)) {
+    return NULL;
+  }
+  return iter->cursor;
+}
+
+Tuple* dict_read_next(DictionaryIterator* iter) {
+  Tuple* next = (Tuple*)((uint8_t*)iter->cursor + TUPLE_HEADER_SIZE + iter->cursor->length);
+  if (!prv_tuple_fits(iter, next)) {
+    return NULL;
+  }
+  iter->cursor = next;
+  return next;
+}
+
+Tuple* dict_find(const DictionaryIterator* iter, const uint32_t key) {
+  DictionaryIterator walk = *iter;
+  Tuple* tuple = dict_read_first(&walk);
+  for (uint8_t i = 0; tuple && i < iter->dictionary->count; i++) {
+    if (tuple->key == key) {
+      return tuple;
+    }
+    tuple = dict_read_next(&walk);
+  }
+  return NULL;
+}
+
+// ── AppMessage ────────────────────────────────────────────────────────────────
+
+#define HOST_APP_MESSAGE_MAX 8200
+
+static struct {
+  bool open;
+  bool outbox_busy;
+  uint32_t inbox_size;
+  uint32_t outbox_size;
+  uint8_t* outbox;
+  DictionaryIterator outbox_iter;
+  void* context;
+  AppMessageInboxReceived received;
+  AppMessageInboxDropped dropped;
+  AppMessageOutboxSent sent;
+  AppMessageOutboxFailed failed;
+  HostOutboxHook outbox_hook;
+  void* outbox_hook_context;
+  uint32_t lose_every;
+  uint32_t send_count;
+  HostMessageStats stats;
+} s_msg;
+
+AppMessageResult app_message_open(const uint32_t size_inbound, const uint32_t size_outbound) {
+  if (s_msg.open) {
+    return APP_MSG_INVALID_STATE;
+  }
+  if (size_inbound > HOST_APP_MESSAGE_MAX || size_outbound > HOST_APP_MESSAGE_MAX) {
+    return APP_MSG_OUT_OF_MEMORY;
+  }
+  // The watch takes both buffers out of the app heap.
+  uint8_t* inbox = host_malloc(size_inbound);
+  s_msg.outbox = host_malloc(size_outbound);
+  if (!inbox || !s_msg.outbox) {
+    host_free(inbox);
+    host_free(s_msg.outbox);
+    s_msg.outbox = NULL;
+    return APP_MSG_OUT_OF_MEMORY;
+  }
+  // Inbound dictionaries are parsed in place from the caller's buffer, so only
+  // the reservation matters.
+  host_free(inbox);
+  s_msg.inbox_size = size_inbound;
+  s_msg.outbox_size = size_outbound;
+  s_msg.stats.inbox_size = size_inbound;
+  s_msg.stats.outbox_size = size_outbound;
+  s_msg.open = true;
+  return APP_MSG_OK;
+}
+
+void app_message_deregister_callbacks(void) {
+  s_msg.received = NULL;
+  s_msg.dropped = NULL;
+  s_msg.sent = NULL;
+  s_msg.failed = NULL;
+}
+
+void* app_message_get_context(void) {
+  return s_msg.context;
+}
+
+void* app_message_set_context(void* context) {
+  void* previous = s_msg.context;
+  s_msg.context = context;
+  return previous;
+}
+
+AppMessageInboxReceived app_message_register_inbox_received(AppMessageInboxReceived received_callback) {
+  AppMessageInboxReceived previous = s_msg.received;
+  s_msg.received = received_callback;
+  return previous;
+}
+
+AppMessageInboxDropped app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback) {
+  AppMessageInboxDropped previous = s_msg.dropped;
+  s_msg.dropped = dropped_callback;
+  return previous;
+}
+
+AppMessageOutboxSent app_message_register_outbox_sent(AppMessageOutboxSent sent_callback) {
+  AppMessageOutboxSent previous = s_msg.sent;
+  s_msg.sent = sent_callback;
+  return previous;
+}
+
+AppMessageOutboxFailed app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback) {
+  AppMessageOutboxFailed previous = s_msg.failed;
+  s_msg.failed = failed_callback;
+  return previous;
+}
+
+uint32_t app_message_inbox_size_maximum(void) {
+  return HOST_APP_MESSAGE_MAX;
+}
+
+uint32_t app_message_outbox_size_maximum(void) {
+  return HOST_APP_MESSAGE_MAX;
+}
+
+AppMessageResult app_message_outbox_begin(DictionaryIterator** iterator) {
+  if (!s_msg.open) {
+    return APP_MSG_INVALID_STATE;
+  }
+  if (s_msg.outbox_busy) {
+    return APP_MSG_BUSY;
+  }
+  dict_write_begin(&s_msg.outbox_iter, s_msg.outbox, (uint16_t)s_msg.outbox_size);
+  s_msg.outbox_busy = true;
+  *iterator = &s_msg.outbox_iter;
+  return APP_MSG_OK;
+}
+
+// Sending completes immediately: the hook sees the bytes, then outbox_sent runs.
+// A lost send never reaches the hook and fails with APP_MSG_SEND_TIMEOUT.
+AppMessageResult app_message_outbox_send(void) {
+  if (!s_msg.outbox_busy) {
+    return APP_MSG_INVALID_STATE;
+  }
+  uint32_t size = dict_write_end(&s_msg.outbox_iter);
+  s_msg.stats.sent++;
+  s_msg.stats.bytes_out += size;
+  s_msg.send_count++;
+  if (s_msg.lose_every && s_msg.send_count % s_msg.lose_every == 0) {
+    s_msg.stats.lost++;
+    s_msg.outbox_busy = false;
+    if (s_msg.failed) {
+      s_msg.failed(&s_msg.outbox_iter, APP_MSG_SEND_TIMEOUT, s_msg.context);
+    }
+    return APP_MSG_OK;
+  }
+  if (s_msg.outbox_hook) {
+    s_msg.outbox_hook(s_msg.outbox, (uint16_t)size, s_msg.outbox_hook_context);
+  }
+  s_msg.outbox_busy = false;
+  if (s_msg.sent) {
+    s_msg.sent(&s_msg.outbox_iter, s_msg.context);
+  }
+  return APP_MSG_OK;
+}
+
+void host_app_message_set_outbox_hook(HostOutboxHook hook, void* context) {
+  s_msg.outbox_hook = hook;
+  s_msg.outbox_hook_context = context;
+}
+
+void host_app_message_set_send_loss(uint32_t every) {
+  s_msg.lose_every = every;
+  s_msg.send_count = 0;
+}
+
+// Dictionaries larger than the opened inbox are counted as oversized but still
+// delivered, so the harness can flag sizing problems without changing what
+// the app sees.
+AppMessageResult host_app_message_deliver(const uint8_t* buffer, uint16_t size) {
+  AppMessageResult reason = APP_MSG_OK;
+  if (!s_msg.open) {
+    reason = APP_MSG_CLOSED;
+  } else if (!s_msg.received) {
+    reason = APP_MSG_CALLBACK_NOT_REGISTERED;
+  }
+  if (reason != APP_MSG_OK) {
+    s_msg.stats.dropped++;
+    if (s_msg.dropped) {
+      s_msg.dropped(reason, s_msg.context);
+    }
+    return reason;
+  }
+
+  if (size > s_msg.inbox_size) {
+    s_msg.stats.oversized++;
+  }
+  s_msg.stats.delivered++;
+  s_msg.stats.bytes_in += size;
+
+  DictionaryIterator iter;
+  if (!dict_read_begin_from_buffer(&iter, buffer, size)) {
+    iter.dictionary = (Dictionary*)buffer;
+    iter.end = buffer + size;
+    iter.cursor = NULL;
+  }
+  s_msg.received(&iter, s_msg.context);
+  host_render_if_dirty();
+  return APP_MSG_OK;
+}
+
+void host_app_message_get_stats(HostMessageStats* stats) {
+  *stats = s_msg.stats;
+}
+
+// ── Fonts ─────────────────────────────────────────────────────────────────────
+
+struct HostFont {
+  const char* key;
+};
+
+#define HOST_FONT_MAX 16
+
+static struct HostFont s_fonts[HOST_FONT_MAX];
+
+GFont fonts_get_system_font(const char* font_key) {
+  for (int i = 0; i < HOST_FONT_MAX; i++) {
+    if (!s_fonts[i].key) {
+      s_fonts[i].key = font_key;
+      return &s_fonts[i];
+    }
+    if (strcmp(s_fonts[i].key, font_key) == 0) {
+      return &s_fonts[i];
+    }
+  }
+  return &s_fonts[0];
+}
+
+// ── Trigonometry ──────────────────────────────────────────────────────────────
+
+int32_t sin_lookup(int32_t angle) {
+  return (int32_t)lround(sin((double)angle * 2.0 * M_PI / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+int32_t cos_lookup(int32_t angle) {
+  return (int32_t)lround(cos((double)angle * 2.0 * M_PI / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+int32_t atan2_lookup(int16_t y, int16_t x) {
+  double angle = atan2((double)y, (double)x);
+  if (angle < 0) {
+    angle += 2.0 * M_PI;
+  }
+  return (int32_t)(angle * TRIG_MAX_ANGLE / (2.0 * M_PI)) % TRIG_MAX_ANGLE;
+}
+
+// ── Misc ──────────────────────────────────────────────────────────────────────
+
+static uint32_t s_vibes;
+
+void vibes_short_pulse(void) {
+  s_vibes++;
+}
+
+void vibes_long_pulse(void) {
+  s_vibes++;
+}
+
+void vibes_double_pulse(void) {
+  s_vibes++;
+}
+
+void light_enable_interaction(void) {
+}
+
+static HostEventLoop s_event_loop;
+static void* s_event_loop_context;
+
+void host_set_event_loop(HostEventLoop loop, void* context) {
+  s_event_loop = loop;
+  s_event_loop_context = context;
+}
+
+void app_event_loop(void) {
+  if (s_event_loop) {
+    s_event_loop(s_event_loop_context);
+  } else {
+    host_run_until_idle(60 * 1000);
+  }
+}
+
+void host_app_exit(void) {
+  host_free(s_msg.outbox);
+  memset(&s_msg, 0, sizeof(s_msg));
+}
+
+void host_system_reset(void) {
+  memset(s_persist, 0, sizeof(s_persist));
+  host_app_exit();
+  s_vibes = 0;
+}
+
+void host_reset(void) {
+  host_clock_reset();
+  host_layer_reset();
+  host_system_reset();
+}
@@ -0,0 +1,149 @@
+// Seed corpus for the forecast decoders
+//
+// Packs forecasts with the same packHourData()/packAllHourData()/
+// packPrecipitation() the phone side uses, so the fuzzer and the throughput
+// bench start from what the watch actually receives. Each record is one
+// settings selector byte, the 120-byte HOUR_DATA blob, the 7-byte
+// PRECIPITATION_PACKAGE and, unless the record stands in for an older phone,
+// the 33-byte PRECIPITATION_MINUTES package (see bench/msgproc_record.h).
+//
+//   node tools/gen_corpus.js [out dir]     default: fuzz/corpus/msgproc
+
+var fs = require('fs');
+var path = require('path');
+var msgproc = require('../../src/pkjs/msgproc.js');
+
+var outDir = process.argv[2] || path.join(__dirname, '..', 'fuzz', 'corpus', 'msgproc');
+
+// Deterministic so regenerating the corpus does not churn the files.
+var seed = 0x5eed;
+function random() {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return seed / 0x80000000;
+}
+function randomInt(lo, hi) {
+    return lo + Math.floor(random() * (hi - lo + 1));
+}
+
+function hour(i, overrides) {
+    var h = {
+        hour: (7 + i) % 24,
+        temperature: 55 + i,
+        feelsLike: 53 + i,
+        windSpeed: 8 + i,
+        windGust: 20 + i,
+        visibility: 16,
+        pressure: 1012,
+        windDirection: i * 30,
+        airQualityIndex: 40,
+        uvIndex: i % 9,
+        condition: i % 13,
+        experientialIcon: i % 8
+    };
+    for (var key in overrides) {
+        h[key] = typeof overrides[key] === 'function' ? overrides[key](i) : overrides[key];
+    }
+    return h;
+}
+
+function pack(hours) {
+    return msgproc.packAllHourData(hours.map(function (h) {
+        return msgproc.packHourData(h.hour, h.temperature, h.feelsLike, h.windSpeed, h.windGust,
+            h.visibility, h.pressure, h.windDirection, h.airQualityIndex, h.uvIndex,
+            h.condition, h.experientialIcon);
+    }));
+}
+
+function day(overrides) {
+    var hours = [];
+    for (var i = 0; i < 12; i++) {
+        hours.push(hour(i, overrides || {}));
+    }
+    return hours;
+}
+
+function minutes(fn) {
+    var values = [];
+    for (var i = 0; i < 24; i++) {
+        values.push(fn(i));
+    }
+    return values;
+}
+
+var forecasts = {
+    typical: day(),
+    optional_fields_missing: day({windGust: -1, windDirection: -1, airQualityIndex: -1}),
+    extremes_hot: day({temperature: 127, feelsLike: 127, windSpeed: 255, windGust: 255, visibility: 255,
+        pressure: 1127, uvIndex: 15, airQualityIndex: 750}),
+    extremes_cold: day({temperature: -128, feelsLike: -128, windSpeed: 0, windGust: 0, visibility: 0,
+        pressure: 872, uvIndex: 0, airQualityIndex: 0}),
+    wind_bands: day({windSpeed: function (i) { return [0, 19, 20, 38, 39, 120][i % 6]; },
+        windDirection: function (i) { return i * 22.5 + 11; }}),
+    midnight_noon: day({hour: function (i) { return [0, 11, 12, 13, 23][i % 5]; }}),
+    short_forecast: day().slice(0, 5),
+    random: day({
+        temperature: function () { return randomInt(-40, 110); },
+        feelsLike: function () { return randomInt(-50, 120); },
+        windSpeed: function () { return randomInt(0, 90); },
+        windGust: function () { return random() < 0.3 ? -1 : randomInt(0, 130); },
+        windDirection: function () { return random() < 0.2 ? -1 : randomInt(0, 359); },
+        airQualityIndex: function () { return random() < 0.2 ? -1 : randomInt(0, 500); },
+        pressure: function () { return randomInt(960, 1050); },
+        condition: function () { return randomInt(0, 12); },
+        experientialIcon: function () { return randomInt(0, 7); }
+    })
+};
+
+var precipitations = {
+    none: msgproc.packPrecipitation(0, minutes(function () { return 0; })),
+    starting_later: msgproc.packPrecipitation(3, minutes(function (i) { return i >= 7 ? 2 : 0; })),
+    ending_soon: msgproc.packPrecipitation(4, minutes(function (i) { return i < 4 ? 3 : 0; })),
+    all_two_hours: msgproc.packPrecipitation(6, minutes(function () { return 1; })),
+    stepped: msgproc.packPrecipitation(5, minutes(function (i) { return Math.floor(i / 3) % 4; }))
+};
+
+// Minute steps run 0-15; "none" is left out, as an older phone sends it
+function steps(fn) {
+    var values = [];
+    for (var i = 0; i < 60; i++) {
+        values.push(fn(i));
+    }
+    return values;
+}
+
+var precipitationMinutes = {
+    none: [],
+    starting_later: msgproc.packPrecipitationMinutes(3, 70, steps(function (i) { return i >= 35 ? Math.min(10, i - 34) : 0; })),
+    ending_soon: msgproc.packPrecipitationMinutes(4, 100, steps(function (i) { return i < 20 ? 15 - Math.floor(i / 2) : 0; })),
+    all_two_hours: msgproc.packPrecipitationMinutes(6, 40, steps(function () { return 3; })),
+    stepped: msgproc.packPrecipitationMinutes(5, 90, steps(function (i) { return i % 16; }))
+};
+
+// Selector bits: 0 C, 1-2 velocity, 3 km, 4 inHg, 5 vane origin, 6 precipitation first
+var selectors = {
+    imperial: 0x00,
+    metric: 0x01 | 0x02 | 0x08,
+    metric_ms_inhg: 0x01 | 0x04 | 0x08 | 0x10,
+    vane_origin: 0x20,
+    precipitation_first: 0x40
+};
+
+fs.mkdirSync(outDir, {recursive: true});
+var written = 0;
+function write(name, selector, hourData, precipitationData, minutesData) {
+    var record = [selector].concat(hourData, precipitationData, minutesData);
+    fs.writeFileSync(path.join(outDir, name + '.bin'), Buffer.from(record));
+    written++;
+}
+
+var precipitationNames = Object.keys(precipitations);
+Object.keys(forecasts).forEach(function (forecastName, f) {
+    Object.keys(selectors).forEach(function (selectorName, s) {
+        var precipitationName = precipitationNames[(f + s) % precipitationNames.length];
+        write(forecastName + '-' + selectorName + '-' + precipitationName, selectors[selectorName],
+            pack(forecasts[forecastName]), precipitations[precipitationName],
+            precipitationMinutes[precipitationName]);
+    });
+});
+
+console.log('wrote ' + written + ' records to ' + outDir);
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+Generate the SDK's auto headers for the host build.
+
+Reads app/package.json and writes, into the output directory:
+
+  resource_ids.auto.h     RESOURCE_ID_* in media order, starting at 1
+  message_keys.auto.h     MESSAGE_KEY_* in messageKeys order, starting at 10000
+  resource_table.auto.c   resource id -> file path, used by the PDC loader
+
+Numbering matches what pbl_build produces, so code that relies on contiguous
+IDs (the wind speed arrows) behaves the same on the host.
+"""
+
+import json
+import os
+import sys
+
+MESSAGE_KEY_BASE = 10000
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write("usage: gen_resource_ids.py <app dir> <out dir>\n")
+        return 1
+
+    app_dir = os.path.abspath(sys.argv[1])
+    out_dir = sys.argv[2]
+    os.makedirs(out_dir, exist_ok=True)
+
+    with open(os.path.join(app_dir, "package.json")) as f:
+        pebble = json.load(f)["pebble"]
+
+    media = pebble["resources"]["media"]
+    keys = pebble.get("messageKeys", [])
+
+    with open(os.path.join(out_dir, "resource_ids.auto.h"), "w") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Generated by app/host/tools/gen_resource_ids.py, do not edit\n\n")
+        f.write("#define RESOURCE_ID_INVALID 0\n")
+        for idx, entry in enumerate(media, start=1):
+            f.write("#define RESOURCE_ID_{} {}\n".format(entry["name"], idx))
+        f.write("\n#define HOST_RESOURCE_COUNT {}\n".format(len(media)))
+
+    with open(os.path.join(out_dir, "message_keys.auto.h"), "w") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Generated by app/host/tools/gen_resource_ids.py, do not edit\n\n")
+        for idx, key in enumerate(keys):
+            f.write("#define MESSAGE_KEY_{} {}\n".format(key, MESSAGE_KEY_BASE + idx))
+
+    with open(os.path.join(out_dir, "resource_table.auto.c"), "w") as f:
+        f.write("// Generated by app/host/tools/gen_resource_ids.py, do not edit\n\n")
+        f.write("#include <stddef.h>\n\n")
+        f.write("const char* const host_resource_files[] = {\n")
+        f.write("  NULL,\n")
+        for entry in media:
+            path = os.path.join(app_dir, "resources", entry["file"])
+            f.write("  \"{}\",\n".format(path))
+        f.write("};\n\n")
+        f.write("const unsigned int host_resource_file_count = {};\n".format(len(media) + 1))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,58 +3,22 @@
 #include "image_animation.h"
 #include "transition.h"
 #include "background_animation.h"
+#include "easing.h"
 
 // Global animation system state
 static bool s_animation_system_initialized = false;
 
-// Custom animation curve for back out with overshoot effect
-AnimationProgress animation_back_out_overshoot_curve(AnimationProgress linear_distance) {
-    // Convert to float for calculations
-    float t = (float)linear_distance / ANIMATION_NORMALIZED_MAX;
-    
-    // Back out curve with natural overshoot
-    // Uses a modified back-out easing with increased overshoot parameter
-    float s = 1.5f; // Overshoot parameter (higher = more overshoot)
-    
-    // Standard back-out formula: (t-1)^3 * (1+s) + (t-1)^2 * s + 1
-    // This naturally creates an overshoot and settle-back behavior
-    t = t - 1.0f;
-    float result = t * t * t * (1.0f + s) + t * t * s + 1.0f;
-    
-    // Clamp result to prevent extreme values
-    if (result < 0.0f) result = 0.0f;
-    if (result > 1.2f) result = 1.2f; // Allow slight overshoot
-    
-    // Convert back to integer
-    return (AnimationProgress)(result * ANIMATION_NORMALIZED_MAX);
-}
+// Back out with overshoot: (t-1)^3 * (1+s) + (t-1)^2 * s + 1, s = 1.5, which
+// overshoots and settles back; clamped to allow a slight overshoot only
+#define BACK_OUT_OVERSHOOT(t) \
+    EASING_CLAMP(((t) - 1.0) * ((t) - 1.0) * ((t) - 1.0) * 2.5 + ((t) - 1.0) * ((t) - 1.0) * 1.5 + 1.0, 0.0, 1.2)
+EASING_CURVE(animation_back_out_overshoot_curve, BACK_OUT_OVERSHOOT)
 
-// Custom animation curve for transition (goes out and back)
-AnimationProgress animation_transition_out_and_back_curve(AnimationProgress linear_distance) {
-    // Convert to float for calculations
-    float t = (float)linear_distance / ANIMATION_NORMALIZED_MAX;
-    
-    // Create a curve that goes out to 1.0 at 50% progress, then back to 0.0
-    // This creates a "hop out and back" effect
-    float result;
-    if (t < 0.5f) {
-        // First half: go out (0.0 to 1.0)
-        result = t * 2.0f; // Linear from 0 to 1
-    } else {
-        // Second half: come back (1.0 to 0.0)
-        result = 1.0f - ((t - 0.5f) * 2.0f); // Linear from 1 to 0
-    }
-    
-    // Apply easing to make it smoother
-    result = result * result * (3.0f - 2.0f * result); // Smoothstep
-    
-    // Clamp result
-    if (result < 0.0f) result = 0.0f;
-    if (result > 1.0f) result = 1.0f;
-    
-    // Convert back to integer
-    return (AnimationProgress)(result * ANIMATION_NORMALIZED_MAX);
-}
+// Hop out and back: linearly out to 1.0 at half way and back to 0.0,
+// smoothstepped to soften both ends
+#define OUT_AND_BACK_LINEAR(t) ((t) < 0.5 ? (t) * 2.0 : 1.0 - ((t) - 0.5) * 2.0)
+#define OUT_AND_BACK(t) (OUT_AND_BACK_LINEAR(t) * OUT_AND_BACK_LINEAR(t) * (3.0 - 2.0 * OUT_AND_BACK_LINEAR(t)))
+EASING_CURVE(animation_transition_out_and_back_curve, OUT_AND_BACK)
 
 void animation_system_init(void) {
     if (s_animation_system_initialized) {
@@ -90,12 +54,12 @@ bool animation_system_is_any_active(void) {
 }
 
 bool animation_is_busy(void) {
-#ifdef PBL_PLATFORM_APLITE
-    return false;
-#else
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
     return animation_system_is_any_active()
         || transition_animation_is_active()
         || background_animation_is_active();
+#else
+    return transition_animation_is_active();
 #endif
 }
 
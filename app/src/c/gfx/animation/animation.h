@@ -11,6 +11,38 @@
   #define ANIMATION_LOG(level, fmt, ...)
 #endif
 
+// Charges everything a subsystem does from here to the end of the enclosing
+// block (allocations, animations, timers and their callbacks) to `zone`.
+// Only the host build (app/host) records anything; on the watch it is empty.
+// ANIMATION_PROFILE_UPDATE_SCOPE counts the block as one of the zone's
+// animation updates instead, for work stepped on its behalf by the frame
+// clock; ANIMATION_PROFILE_CURRENT names the zone in effect (NULL for none).
+#ifdef PBL_HOST_SHIM
+  #define ANIMATION_PROFILE_SCOPE(zone) \
+    const char* _profile_scope __attribute__((cleanup(host_profile_scope_end), unused)) = host_profile_begin(zone)
+  #define ANIMATION_PROFILE_UPDATE_SCOPE(zone) \
+    const char* _profile_scope __attribute__((cleanup(host_profile_scope_end), unused)) = host_profile_begin_update(zone)
+  #define ANIMATION_PROFILE_CURRENT() host_profile_current_name()
+#else
+  #define ANIMATION_PROFILE_SCOPE(zone)
+  #define ANIMATION_PROFILE_UPDATE_SCOPE(zone)
+  #define ANIMATION_PROFILE_CURRENT() NULL
+#endif
+
+// Animation tiers, chosen at compile time by what the platform can afford.
+// The lite tier only moves existing layers' frames on the frame clock: the
+// text layers, and the images layer while it blits cached icons. It has no
+// KiMaybe slices, no background sweep or precipitation rise, and allocates
+// nothing beyond the clock's driver. The full tier runs everything.
+#define ANIMATION_TIER_LITE 1
+#define ANIMATION_TIER_FULL 2
+
+#if defined(PBL_PLATFORM_APLITE)
+  #define ANIMATION_TIER ANIMATION_TIER_LITE
+#else
+  #define ANIMATION_TIER ANIMATION_TIER_FULL
+#endif
+
 // Common animation states
 typedef enum {
     ANIMATION_STATE_IDLE,
@@ -1,4 +1,6 @@
 #include "background_animation.h"
+#include "easing.h"
+#include "frame_clock.h"
 
 // Background animation context
 typedef struct {
@@ -13,9 +15,8 @@ typedef struct {
     Layer* animation_layer;
     GRect rect_bounds;
 
-    // Active animation (plain Animation + custom update; no PropertyAnimation
-    // needed since the custom update fully computes each frame)
-    Animation* rect_animation;
+    // Steps the wipe; each frame is computed from the elapsed time alone
+    FrameClockClient clock;
     
     // Completion callback
     void (*on_complete)(void);
@@ -32,30 +33,14 @@ typedef struct {
 
 static BackgroundAnimationContext s_context = {0};
 
-// Custom animation curve with pronounced ease in/out
-// Uses a cubic curve that starts and ends slowly with rapid acceleration in the middle
-static AnimationProgress custom_pronounced_ease_curve(AnimationProgress linear_progress) {
-    // Convert to normalized float between 0 and 1
-    float t = (float)linear_progress / ANIMATION_NORMALIZED_MAX;
-    
-    // Cubic ease-in-out curve with extra pronounced effect
-    // Formula: t < 0.5 ? 4 * t^3 : 1 - 4 * (1 - t)^3
-    float result;
-    if (t < 0.5f) {
-        // Ease in: slow start with cubic acceleration
-        result = 4.0f * t * t * t;
-    } else {
-        // Ease out: fast middle with cubic deceleration
-        float f = 1.0f - t;
-        result = 1.0f - 4.0f * f * f * f;
-    }
-    
-    // Convert back to AnimationProgress
-    return (AnimationProgress)(result * ANIMATION_NORMALIZED_MAX);
-}
+// Custom animation curve with pronounced ease in/out: cubic, starting and
+// ending slowly with rapid acceleration in the middle
+#define PRONOUNCED_EASE(t) ((t) < 0.5 ? 4.0 * (t) * (t) * (t) : 1.0 - 4.0 * (1.0 - (t)) * (1.0 - (t)) * (1.0 - (t)))
+static AnimationProgress custom_pronounced_ease_curve(AnimationProgress linear_progress);
+EASING_CURVE(custom_pronounced_ease_curve, PRONOUNCED_EASE)
 
-// Animation update callback
-static void background_animation_update(struct Animation *animation, const AnimationProgress progress) {
+// Draw the wipe at a given (eased) progress
+static void background_animation_update(const AnimationProgress progress) {
 #ifdef PBL_ROUND
     // On round screens: interpolate circle center from edge start to display center,
     // and radius from 0 to the full display radius.
@@ -72,23 +57,23 @@ static void background_animation_update(struct Animation *animation, const Anima
     GRect layer_bounds = layer_get_bounds(s_context.animation_layer);
     switch (s_context.direction) {
         case BACKGROUND_ANIMATION_FROM_LEFT: {
-            int width = (int)((float)layer_bounds.size.w * progress / ANIMATION_NORMALIZED_MAX);
+            int width = (int)(layer_bounds.size.w * progress / ANIMATION_NORMALIZED_MAX);
             s_context.rect_bounds = GRect(0, 0, width, layer_bounds.size.h);
             break;
         }
         case BACKGROUND_ANIMATION_FROM_RIGHT: {
-            int width = (int)((float)layer_bounds.size.w * progress / ANIMATION_NORMALIZED_MAX);
+            int width = (int)(layer_bounds.size.w * progress / ANIMATION_NORMALIZED_MAX);
             s_context.rect_bounds = GRect(
                 layer_bounds.size.w - width, 0, width, layer_bounds.size.h);
             break;
         }
         case BACKGROUND_ANIMATION_FROM_TOP: {
-            int height = (int)((float)layer_bounds.size.h * progress / ANIMATION_NORMALIZED_MAX);
+            int height = (int)(layer_bounds.size.h * progress / ANIMATION_NORMALIZED_MAX);
             s_context.rect_bounds = GRect(0, 0, layer_bounds.size.w, height);
             break;
         }
         case BACKGROUND_ANIMATION_FROM_BOTTOM: {
-            int height = (int)((float)layer_bounds.size.h * progress / ANIMATION_NORMALIZED_MAX);
+            int height = (int)(layer_bounds.size.h * progress / ANIMATION_NORMALIZED_MAX);
             s_context.rect_bounds = GRect(
                 0, layer_bounds.size.h - height, layer_bounds.size.w, height);
             break;
@@ -96,30 +81,39 @@ static void background_animation_update(struct Animation *animation, const Anima
     }
 #endif
 
-    layer_mark_dirty(s_context.animation_layer);
+    frame_clock_invalidate(s_context.animation_layer);
 }
 
-// Animation completion callback
-static void background_animation_complete(struct Animation *animation, bool finished, void *context) {
-    if (finished) {
-        ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Background animation completed");
-        
-        // Change window background color
-        if (s_context.window) {
-            window_set_background_color(s_context.window, s_context.animation_color);
-        }
-        
-        // Hide the animation layer
-        layer_set_hidden(s_context.animation_layer, true);
-        
-        // Reset state
-        s_context.state = ANIMATION_STATE_IDLE;
-        
-        // Call completion callback
-        if (s_context.on_complete) {
-            s_context.on_complete();
-        }
+// Animation completion
+static void background_animation_complete(void) {
+    ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Background animation completed");
+    
+    // Change window background color
+    if (s_context.window) {
+        window_set_background_color(s_context.window, s_context.animation_color);
     }
+    
+    // Hide the animation layer
+    layer_set_hidden(s_context.animation_layer, true);
+    
+    // Reset state
+    s_context.state = ANIMATION_STATE_IDLE;
+    
+    // Call completion callback
+    if (s_context.on_complete) {
+        s_context.on_complete();
+    }
+}
+
+static void background_animation_tick(FrameClockClient* client, uint32_t elapsed_ms) {
+    if (elapsed_ms >= ANIMATION_DURATION_MS) {
+        background_animation_update(ANIMATION_NORMALIZED_MAX);
+        frame_clock_stop(client);
+        background_animation_complete();
+        return;
+    }
+    background_animation_update(custom_pronounced_ease_curve(
+        (AnimationProgress)(elapsed_ms * ANIMATION_NORMALIZED_MAX / ANIMATION_DURATION_MS)));
 }
 
 // Layer update procedure to draw the expanding shape
@@ -143,8 +137,13 @@ static void background_animation_layer_update(Layer* layer, GContext* ctx) {
 // Public API implementation
 void background_animation_init_system(void) {
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Initializing background animation subsystem");
+    frame_clock_stop(&s_context.clock);
     memset(&s_context, 0, sizeof(BackgroundAnimationContext));
     s_context.state = ANIMATION_STATE_IDLE;
+    s_context.clock = (FrameClockClient) {
+        .name = "background_animation",
+        .tick = background_animation_tick,
+    };
 }
 
 void background_animation_init(Layer* parent_layer, Window* window) {
@@ -186,6 +185,7 @@ void background_animation_deinit_system(void) {
 void background_animation_start(BackgroundAnimationDirection direction, 
                                GColor color, 
                                void (*on_complete)(void)) {
+    ANIMATION_PROFILE_SCOPE("background_animation");
     // Don't start if already animating
     if (s_context.state == ANIMATION_STATE_ANIMATING) {
         ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Background animation already active");
@@ -236,22 +236,7 @@ void background_animation_start(BackgroundAnimationDirection direction,
     // Show the animation layer
     layer_set_hidden(s_context.animation_layer, false);
 
-    // Create a plain Animation (no PropertyAnimation needed: our custom
-    // .update callback computes the frame directly from s_context state).
-    s_context.rect_animation = animation_create();
-    animation_set_duration(s_context.rect_animation, ANIMATION_DURATION_MS);
-    animation_set_custom_curve(s_context.rect_animation, custom_pronounced_ease_curve);
-
-    static const AnimationImplementation animation_implementation = {
-        .update = background_animation_update,
-    };
-    animation_set_implementation(s_context.rect_animation, &animation_implementation);
-
-    animation_set_handlers(s_context.rect_animation, (AnimationHandlers) {
-        .stopped = background_animation_complete,
-    }, NULL);
-
-    animation_schedule(s_context.rect_animation);
+    frame_clock_start(&s_context.clock);
 }
 
 bool background_animation_is_active(void) {
@@ -262,11 +247,7 @@ void background_animation_stop(void) {
     if (s_context.state == ANIMATION_STATE_ANIMATING) {
         ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Stopping background animation");
         
-        if (s_context.rect_animation) {
-            animation_unschedule(s_context.rect_animation);
-            animation_destroy(s_context.rect_animation);
-            s_context.rect_animation = NULL;
-        }
+        frame_clock_stop(&s_context.clock);
         
         // Hide the animation layer
         if (s_context.animation_layer) {
@@ -0,0 +1,69 @@
+#include "easing.h"
+
+_Static_assert(EASING_SEGMENTS == 64, "EASING_SAMPLES expands exactly 65 samples");
+_Static_assert(EASING_MAX_REGISTERED == 4, "one EASING_SLOT per registered curve");
+
+#define EASING_SEGMENT_SPAN (65536 / EASING_SEGMENTS)
+
+AnimationProgress easing_evaluate(const int32_t* samples, AnimationProgress linear_distance) {
+    if (linear_distance <= 0) {
+        return samples[0];
+    }
+    if (linear_distance >= ANIMATION_NORMALIZED_MAX) {
+        return samples[EASING_SEGMENTS];
+    }
+
+    // Stretched onto 0-65536 so segments are EASING_SEGMENT_SPAN apart and
+    // nothing needs dividing by 65535
+    int32_t position = linear_distance + (linear_distance >> 15);
+    int32_t segment = position / EASING_SEGMENT_SPAN;
+    int32_t within = position % EASING_SEGMENT_SPAN;
+    int32_t from = samples[segment];
+    return from + (samples[segment + 1] - from) * within / EASING_SEGMENT_SPAN;
+}
+
+// Registered curves: each slot's function evaluates whatever table is in it
+static const int32_t* s_registered[EASING_MAX_REGISTERED];
+
+#define EASING_SLOT(i)                                                               \
+    static AnimationProgress prv_registered_##i(AnimationProgress linear_distance) { \
+        return easing_evaluate(s_registered[i], linear_distance);                    \
+    }
+
+EASING_SLOT(0)
+EASING_SLOT(1)
+EASING_SLOT(2)
+EASING_SLOT(3)
+
+static const AnimationCurveFunction s_slot_curves[EASING_MAX_REGISTERED] = {
+    prv_registered_0, prv_registered_1, prv_registered_2, prv_registered_3,
+};
+
+AnimationCurveFunction easing_register_curve(const int32_t* samples) {
+    if (!samples) {
+        return NULL;
+    }
+    int free_slot = -1;
+    for (int i = 0; i < EASING_MAX_REGISTERED; i++) {
+        if (s_registered[i] == samples) {
+            return s_slot_curves[i];
+        }
+        if (!s_registered[i] && free_slot < 0) {
+            free_slot = i;
+        }
+    }
+    if (free_slot < 0) {
+        return NULL;
+    }
+    s_registered[free_slot] = samples;
+    return s_slot_curves[free_slot];
+}
+
+void easing_unregister_curve(AnimationCurveFunction curve) {
+    for (int i = 0; i < EASING_MAX_REGISTERED; i++) {
+        if (s_slot_curves[i] == curve) {
+            s_registered[i] = NULL;
+            return;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <pebble.h>
+
+// Easing curves baked into tables at compile time. A curve is written once
+// as an expression of t (0.0 to 1.0); EASING_CURVE samples it at
+// EASING_SEGMENTS + 1 evenly spaced points, in AnimationProgress units, and
+// defines an AnimationCurveFunction that interpolates linearly between
+// them. The float maths is folded by the compiler, so a frame costs one
+// lookup and one multiply instead of soft-float polynomials.
+//
+//   #define MY_CURVE(t) ((t) * (t))
+//   EASING_CURVE(my_curve, MY_CURVE)
+//   animation_set_custom_curve(animation, my_curve);
+//
+// The function has external linkage; declare it static first to keep it
+// private to a file.
+//
+// A curve can also be plain data: bake or load the samples, then register
+// them to get an AnimationCurveFunction without writing one.
+//
+//   EASING_TABLE(s_my_samples, MY_CURVE)
+//   AnimationCurveFunction curve = easing_register_curve(s_my_samples);
+//
+// AnimationCurveFunction has no context, so registered curves share
+// EASING_MAX_REGISTERED fixed slots.
+
+#define EASING_SEGMENTS 64
+#define EASING_MAX_REGISTERED 4
+
+/**
+ * Evaluate a baked curve
+ * @param samples EASING_SEGMENTS + 1 samples of the curve
+ * @param linear_distance Progress through the animation, 0 to ANIMATION_NORMALIZED_MAX
+ * @return The curve's value there
+ */
+AnimationProgress easing_evaluate(const int32_t* samples, AnimationProgress linear_distance);
+
+/**
+ * Register a table of samples as a curve
+ * @param samples EASING_SEGMENTS + 1 samples; kept, not copied, so they must outlive the curve
+ * @return The curve, the same one again for samples already registered, or NULL when every slot is taken
+ */
+AnimationCurveFunction easing_register_curve(const int32_t* samples);
+
+/**
+ * Free a registered curve's slot
+ * @param curve A curve easing_register_curve() returned; anything else is ignored
+ */
+void easing_unregister_curve(AnimationCurveFunction curve);
+
+// Rounded to the nearest AnimationProgress, either side of zero
+#define EASING_ROUND(x) ((int32_t)((x) < 0 ? (x) - 0.5 : (x) + 0.5))
+#define EASING_SAMPLE(curve, i) EASING_ROUND((curve((double)(i) / EASING_SEGMENTS)) * ANIMATION_NORMALIZED_MAX)
+#define EASING_ROW(curve, i) EASING_SAMPLE(curve, i), EASING_SAMPLE(curve, i + 1), EASING_SAMPLE(curve, i + 2), \
+                             EASING_SAMPLE(curve, i + 3), EASING_SAMPLE(curve, i + 4), EASING_SAMPLE(curve, i + 5), \
+                             EASING_SAMPLE(curve, i + 6), EASING_SAMPLE(curve, i + 7)
+#define EASING_SAMPLES(curve) EASING_ROW(curve, 0), EASING_ROW(curve, 8), EASING_ROW(curve, 16), \
+                              EASING_ROW(curve, 24), EASING_ROW(curve, 32), EASING_ROW(curve, 40), \
+                              EASING_ROW(curve, 48), EASING_ROW(curve, 56), EASING_SAMPLE(curve, 64)
+
+#define EASING_CLAMP(x, lo, hi) ((x) < (lo) ? (lo) : (x) > (hi) ? (hi) : (x))
+
+#define EASING_TABLE(name, curve) static const int32_t name[EASING_SEGMENTS + 1] = {EASING_SAMPLES(curve)};
+
+#define EASING_CURVE(name, curve)                                                   \
+    EASING_TABLE(name##_samples, curve)                                             \
+    AnimationProgress name(AnimationProgress linear_distance) {                     \
+        return easing_evaluate(name##_samples, linear_distance);                    \
+    }
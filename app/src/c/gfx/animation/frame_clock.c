@@ -0,0 +1,180 @@
+#include "frame_clock.h"
+
+static FrameClockClient* s_clients;
+static Animation* s_driver;
+static FrameClockStats s_stats;
+
+// The tick in progress: the client being ticked, whether it was stopped
+// meanwhile (its memory may be gone) and the one to tick after it
+static bool s_ticking;
+static FrameClockClient* s_current;
+static bool s_current_stopped;
+static FrameClockClient* s_next;
+
+static Layer* s_dirty[FRAME_CLOCK_MAX_DIRTY];
+static uint8_t s_dirty_count;
+
+static uint32_t prv_now_ms(void) {
+    time_t seconds;
+    uint16_t ms = time_ms(&seconds, NULL);
+    return (uint32_t)seconds * 1000 + ms;
+}
+
+static void prv_unlink(FrameClockClient* client) {
+    for (FrameClockClient** link = &s_clients; *link; link = &(*link)->next) {
+        if (*link == client) {
+            *link = client->next;
+            break;
+        }
+    }
+    if (client == s_next) {
+        s_next = client->next;
+    }
+    if (client == s_current) {
+        s_current_stopped = true;
+    }
+    client->next = NULL;
+    client->running = false;
+}
+
+static void prv_flush_dirty(void) {
+    for (uint8_t i = 0; i < s_dirty_count; i++) {
+        layer_mark_dirty(s_dirty[i]);
+    }
+    s_stats.marks += s_dirty_count;
+    s_dirty_count = 0;
+}
+
+static void prv_tick_client(FrameClockClient* client, uint32_t now_ms) {
+#ifdef PBL_HOST_SHIM
+    ANIMATION_PROFILE_UPDATE_SCOPE(client->profile_zone);
+#endif
+    s_current = client;
+    s_current_stopped = false;
+    client->tick(client, now_ms - client->start_ms);
+
+    uint32_t spent_ms = prv_now_ms() - now_ms;
+    if (s_current_stopped) {
+        return;
+    }
+    uint16_t budget_ms = client->budget_ms ? client->budget_ms : FRAME_CLOCK_DEFAULT_BUDGET_MS;
+    client->stats.ticks++;
+    if (spent_ms > client->stats.worst_ms) {
+        client->stats.worst_ms = (uint16_t)spent_ms;
+    }
+    if (spent_ms > budget_ms) {
+        client->stats.over_budget++;
+        ANIMATION_LOG(APP_LOG_LEVEL_WARNING, "Frame clock: %s took %lums (budget %u)",
+                      client->name, (unsigned long)spent_ms, budget_ms);
+    }
+}
+
+static void prv_update(Animation* animation, const AnimationProgress progress) {
+    uint32_t now_ms = prv_now_ms();
+
+    s_ticking = true;
+    if (s_clients) {
+        s_stats.frames++;
+    }
+    for (FrameClockClient* client = s_clients; client; client = s_next) {
+        s_next = client->next;
+        prv_tick_client(client, now_ms);
+    }
+    s_current = NULL;
+    s_next = NULL;
+    s_ticking = false;
+
+    prv_flush_dirty();
+
+    // Nothing left to drive; the SDK destroys the driver once unscheduled.
+    // Retiring it here rather than in frame_clock_stop() lets a client that
+    // is stopped and restarted straight away keep the same driver.
+    if (!s_clients && s_driver == animation) {
+        s_driver = NULL;
+        animation_unschedule(animation);
+    }
+}
+
+static const AnimationImplementation s_implementation = {
+    .update = prv_update,
+};
+
+static void prv_stopped(Animation* animation, bool finished, void* context) {
+    if (s_driver == animation) {
+        s_driver = NULL;
+    }
+}
+
+static void prv_ensure_driver(void) {
+    if (s_driver) {
+        return;
+    }
+    ANIMATION_PROFILE_SCOPE("frame_clock");
+    s_driver = animation_create();
+    if (!s_driver) {
+        return;
+    }
+    animation_set_duration(s_driver, ANIMATION_DURATION_INFINITE);
+    animation_set_curve(s_driver, AnimationCurveLinear);
+    animation_set_implementation(s_driver, &s_implementation);
+    animation_set_handlers(s_driver, (AnimationHandlers) {
+        .stopped = prv_stopped,
+    }, NULL);
+    animation_schedule(s_driver);
+    s_stats.drivers++;
+}
+
+void frame_clock_start(FrameClockClient* client) {
+    if (!client || !client->tick) {
+        return;
+    }
+    if (client->running) {
+        prv_unlink(client);
+    }
+    client->start_ms = prv_now_ms();
+    client->running = true;
+#ifdef PBL_HOST_SHIM
+    client->profile_zone = ANIMATION_PROFILE_CURRENT();
+#endif
+    // At the head, so a client started mid-tick waits for the next frame
+    client->next = s_clients;
+    s_clients = client;
+    prv_ensure_driver();
+}
+
+void frame_clock_stop(FrameClockClient* client) {
+    if (!client || !client->running) {
+        return;
+    }
+    prv_unlink(client);
+}
+
+bool frame_clock_is_running(const FrameClockClient* client) {
+    return client && client->running;
+}
+
+void frame_clock_invalidate(Layer* layer) {
+    if (!layer) {
+        return;
+    }
+    if (!s_ticking) {
+        layer_mark_dirty(layer);
+        return;
+    }
+    s_stats.invalidations++;
+    for (uint8_t i = 0; i < s_dirty_count; i++) {
+        if (s_dirty[i] == layer) {
+            return;
+        }
+    }
+    if (s_dirty_count < FRAME_CLOCK_MAX_DIRTY) {
+        s_dirty[s_dirty_count++] = layer;
+    } else {
+        layer_mark_dirty(layer);
+        s_stats.marks++;
+    }
+}
+
+const FrameClockStats* frame_clock_get_stats(void) {
+    return &s_stats;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <pebble.h>
+#include "animation.h"
+
+// One clock for every animation subsystem
+//
+// Subsystems register a FrameClockClient instead of scheduling Animations
+// of their own. A single driver Animation runs while any client is
+// registered; each frame it reads the time once, ticks every client with
+// the milliseconds since that client started, and then marks each layer
+// the clients invalidated exactly once. Clients live in their owners'
+// contexts, so registering allocates nothing; the driver is the one
+// Animation made per burst of activity.
+//
+// A client is finished when it says so: it calls frame_clock_stop() on
+// itself from its tick, then runs any completion callback. Clients may be
+// started and stopped (and their memory released) from inside any tick.
+
+// Default per-tick budget: a quarter of a 30 fps frame
+#define FRAME_CLOCK_DEFAULT_BUDGET_MS 8
+
+// Distinct layers one tick can coalesce; past that they are marked directly
+#define FRAME_CLOCK_MAX_DIRTY 8
+
+typedef struct FrameClockClient FrameClockClient;
+
+/**
+ * Advance a client
+ * @param elapsed_ms Milliseconds since frame_clock_start()
+ */
+typedef void (*FrameClockTick)(FrameClockClient* client, uint32_t elapsed_ms);
+
+typedef struct {
+    uint32_t ticks;
+    uint32_t over_budget;       // Ticks that took longer than budget_ms
+    uint16_t worst_ms;          // Longest tick
+} FrameClockClientStats;
+
+struct FrameClockClient {
+    const char* name;           // For logs
+    FrameClockTick tick;
+    void* context;
+    uint16_t budget_ms;         // 0 for FRAME_CLOCK_DEFAULT_BUDGET_MS
+    FrameClockClientStats stats;
+    // Owned by the clock
+    uint32_t start_ms;
+    FrameClockClient* next;
+    bool running;
+#ifdef PBL_HOST_SHIM
+    const char* profile_zone;   // Zone it was started in; its ticks are charged there
+#endif
+};
+
+typedef struct {
+    uint32_t frames;            // Driver updates that ticked at least one client
+    uint32_t invalidations;     // frame_clock_invalidate() calls during ticks
+    uint32_t marks;             // layer_mark_dirty() calls they turned into
+    uint32_t drivers;           // Driver Animations created
+} FrameClockStats;
+
+/**
+ * Register a client, or restart it if it is already running; its next
+ * tick comes with the next frame
+ */
+void frame_clock_start(FrameClockClient* client);
+
+/**
+ * Unregister a client; safe from any tick, including its own
+ */
+void frame_clock_stop(FrameClockClient* client);
+
+bool frame_clock_is_running(const FrameClockClient* client);
+
+/**
+ * Request a redraw of a layer. During a tick the request is held and
+ * merged with the other clients'; outside one the layer is marked at once.
+ */
+void frame_clock_invalidate(Layer* layer);
+
+const FrameClockStats* frame_clock_get_stats(void);
@@ -0,0 +1,95 @@
+#include "frame_tween.h"
+
+static int16_t prv_lerp(int16_t from, int16_t to, AnimationProgress progress) {
+    return from + (int16_t)((int32_t)(to - from) * progress / ANIMATION_NORMALIZED_MAX);
+}
+
+static void prv_tick(FrameClockClient* client, uint32_t elapsed_ms) {
+    FrameTween* tween = client->context;
+    if (elapsed_ms > tween->total_ms) {
+        elapsed_ms = tween->total_ms;
+    }
+
+    for (uint8_t i = 0; i < tween->track_count; i++) {
+        FrameTweenTrack* track = &tween->tracks[i];
+        // Untouched until its delay is up, as a delayed PropertyAnimation would be
+        if (elapsed_ms < track->delay_ms) {
+            continue;
+        }
+        uint32_t track_ms = elapsed_ms - track->delay_ms;
+        AnimationProgress t = track_ms >= track->duration_ms
+            ? ANIMATION_NORMALIZED_MAX
+            : (AnimationProgress)(track_ms * ANIMATION_NORMALIZED_MAX / track->duration_ms);
+        if (track->curve) {
+            t = track->curve(t);
+        }
+        layer_set_frame(track->layer, GRect(prv_lerp(track->from.origin.x, track->to.origin.x, t),
+                                            prv_lerp(track->from.origin.y, track->to.origin.y, t),
+                                            prv_lerp(track->from.size.w, track->to.size.w, t),
+                                            prv_lerp(track->from.size.h, track->to.size.h, t)));
+    }
+
+    if (elapsed_ms < tween->total_ms) {
+        return;
+    }
+    frame_clock_stop(client);
+    if (tween->on_finished) {
+        void (*on_finished)(void) = tween->on_finished;
+        tween->on_finished = NULL;
+        on_finished();
+    }
+}
+
+void frame_tween_init(FrameTween* tween, const char* name) {
+    frame_clock_stop(&tween->clock);
+    frame_tween_clear(tween);
+    tween->clock = (FrameClockClient) {
+        .name = name,
+        .tick = prv_tick,
+        .context = tween,
+    };
+    tween->on_finished = NULL;
+}
+
+void frame_tween_clear(FrameTween* tween) {
+    tween->track_count = 0;
+    tween->total_ms = 0;
+}
+
+bool frame_tween_add(FrameTween* tween, Layer* layer, GRect from, GRect to,
+                     uint16_t delay_ms, uint16_t duration_ms, AnimationCurveFunction curve) {
+    if (!layer || tween->track_count >= FRAME_TWEEN_MAX_TRACKS) {
+        return false;
+    }
+    tween->tracks[tween->track_count++] = (FrameTweenTrack) {
+        .layer = layer,
+        .from = from,
+        .to = to,
+        .delay_ms = delay_ms,
+        .duration_ms = duration_ms ? duration_ms : 1,
+        .curve = curve,
+    };
+    if ((uint32_t)delay_ms + duration_ms > tween->total_ms) {
+        tween->total_ms = (uint32_t)delay_ms + duration_ms;
+    }
+    return true;
+}
+
+bool frame_tween_start(FrameTween* tween, void (*on_finished)(void)) {
+    frame_tween_stop(tween);
+    if (tween->track_count == 0) {
+        return false;
+    }
+    tween->on_finished = on_finished;
+    frame_clock_start(&tween->clock);
+    return true;
+}
+
+void frame_tween_stop(FrameTween* tween) {
+    tween->on_finished = NULL;
+    frame_clock_stop(&tween->clock);
+}
+
+bool frame_tween_is_running(const FrameTween* tween) {
+    return frame_clock_is_running(&tween->clock);
+}
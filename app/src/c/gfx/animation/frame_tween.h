@@ -0,0 +1,62 @@
+#pragma once
+#include <pebble.h>
+#include "animation.h"
+#include "frame_clock.h"
+
+// Layer frame tweens on the frame clock
+//
+// A FrameTween holds a fixed set of tracks, each moving one layer's frame
+// from one rect to another with its own delay, duration and curve. The
+// tracks live in the owner's context and are refilled for every run, and
+// the tween steps all of them as one frame clock client. That replaces a
+// PropertyAnimation per layer, the spawn around them and any AppTimer used
+// to stagger them; a run allocates nothing.
+
+#define FRAME_TWEEN_MAX_TRACKS 5
+
+typedef struct {
+    Layer* layer;
+    GRect from;
+    GRect to;
+    uint16_t delay_ms;
+    uint16_t duration_ms;
+    AnimationCurveFunction curve;
+} FrameTweenTrack;
+
+typedef struct {
+    FrameTweenTrack tracks[FRAME_TWEEN_MAX_TRACKS];
+    uint8_t track_count;
+    uint32_t total_ms;          // Longest delay + duration of the current run
+    FrameClockClient clock;
+    void (*on_finished)(void);
+} FrameTween;
+
+/**
+ * Name the tween for the frame clock's logs and stats; call once
+ */
+void frame_tween_init(FrameTween* tween, const char* name);
+
+/**
+ * Drop every track, ready to fill for the next run
+ */
+void frame_tween_clear(FrameTween* tween);
+
+/**
+ * Add a track to the next run
+ * @return false if all FRAME_TWEEN_MAX_TRACKS are in use
+ */
+bool frame_tween_add(FrameTween* tween, Layer* layer, GRect from, GRect to,
+                     uint16_t delay_ms, uint16_t duration_ms, AnimationCurveFunction curve);
+
+/**
+ * Start the tracks; on_finished runs once every track has reached its end
+ * @return false if there was nothing to run
+ */
+bool frame_tween_start(FrameTween* tween, void (*on_finished)(void));
+
+/**
+ * Stop a run early, leaving the layers where they are; on_finished is not called
+ */
+void frame_tween_stop(FrameTween* tween);
+
+bool frame_tween_is_running(const FrameTween* tween);
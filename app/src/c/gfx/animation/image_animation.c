@@ -1,7 +1,7 @@
 #include "image_animation.h"
 #include "../layout.h"
 #include "../pages/experiential.h"
-#include "../../utils/weather.h" // for forecast_hours
+#include "../../utils/forecast.h" // for forecast_data
 
 // Experiential image offset definitions. Internal to this translation unit
 // and immutable; see image_animation.h header comment for semantics.
@@ -115,19 +115,6 @@ static void km_animation_2_complete(void) {
     }
 }
 
-// Timer callback for delayed KM animation start. Both UP and DOWN start
-// animation 1 the same way; the endpoints differ but were decided at
-// setup time and baked into km_animation_1.
-static void km_animation_delay_timer_callback(void* context) {
-    s_image_animation_context.km_animation_delay_timer = NULL;
-
-    if (s_image_animation_context.km_animation_1) {
-        ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Starting delayed KM animation 1 (%s)",
-                s_image_animation_context.direction == ANIMATION_DIRECTION_UP ? "UP" : "DOWN");
-        km_start_kmanimation(s_image_animation_context.km_animation_1, km_animation_1_complete);
-    }
-}
-
 // Function to store current images before view update (for animation purposes)
 static void store_current_images_for_animation(void) {
     if (s_image_animation_context.prev_image_ref && 
@@ -198,13 +185,6 @@ static void show_original_images(void) {
 
 // Function to clean up KM animations
 static void cleanup_km_animations(void) {
-    // Cancel delay timer if active
-    if (s_image_animation_context.km_animation_delay_timer) {
-        app_timer_cancel(s_image_animation_context.km_animation_delay_timer);
-        s_image_animation_context.km_animation_delay_timer = NULL;
-        ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Cancelled KM animation delay timer");
-    }
-    
     // Dispose of KM animations
     if (s_image_animation_context.km_animation_1) {
         ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Disposing of KM animation 1");
@@ -227,6 +207,9 @@ static void cleanup_km_animations(void) {
         s_image_animation_context.km_temp_image_2 = NULL;
     }
     
+    // Everything the transition allocated is disposed; rewind for the next one
+    arena_reset(&s_image_animation_context.km_arena);
+    
     s_image_animation_context.km_animations_completed = 0;
     s_image_animation_context.km_animations_expected = 0;
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "KM animations cleaned up");
@@ -336,9 +319,6 @@ void image_animation_init_system(void) {
     s_image_animation_context.stored_current_image = NULL;
     s_image_animation_context.stored_next_image = NULL;
     
-    // Initialize timer
-    s_image_animation_context.km_animation_delay_timer = NULL;
-    
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Image animation subsystem initialized");
 }
 
@@ -358,6 +338,10 @@ void image_animation_init(Layer* parent_layer) {
     layer_set_update_proc(s_image_animation_context.km_animation_layer_2, km_animation_layer_2_update_proc);
     layer_add_child(parent_layer, s_image_animation_context.km_animation_layer_2);
     
+    // Without the block, KMAnimations fall back to the heap
+    arena_init(&s_image_animation_context.km_arena, KM_ARENA_SIZE);
+    km_set_arena(&s_image_animation_context.km_arena);
+    
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Image animation initialized");
 }
 
@@ -394,6 +378,9 @@ void image_animation_deinit(void) {
         s_image_animation_context.km_animation_layer_2 = NULL;
     }
     
+    km_set_arena(NULL);
+    arena_deinit(&s_image_animation_context.km_arena);
+    
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Image animation deinitialized");
 }
 
@@ -407,6 +394,7 @@ void image_animation_set_current_page(uint8_t page) {
 }
 
 void image_animation_start(AnimationDirection direction, uint8_t hour, uint8_t page, void (*on_complete)(void)) {
+    ANIMATION_PROFILE_SCOPE("image_animation");
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "=== IMAGE_ANIMATION_START CALLED ===");
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Direction: %s, Hour: %d, Page: %d", 
             direction == ANIMATION_DIRECTION_UP ? "UP" : "DOWN", hour, page);
@@ -451,20 +439,24 @@ void image_animation_start(AnimationDirection direction, uint8_t hour, uint8_t p
     bool is_experiential_page = (page == 2); // VIEW_PAGE_EXPERIENTIAL
     int offset_idx_1 = 0, offset_idx_2 = 0;
     if (is_experiential_page) {
-        // Defensive: clamp hour to 0-11
-        int h = (hour > 11 ? 11 : hour);
-        int prev_h = (h > 0) ? h - 1 : 0;
-        int next_h = (h < 11) ? h + 1 : 11;
+        // Defensive: clamp to the forecast, and to neighbours that are loaded
+        int last = forecast_length() - 1;
+        int h = (hour > last ? last : hour);
+        int prev_h = (h > 0 && forecast_has_hour(h - 1)) ? h - 1 : h;
+        int next_h = forecast_has_hour(h + 1) ? h + 1 : h;
+        h = forecast_slot(h);
+        prev_h = forecast_slot(prev_h);
+        next_h = forecast_slot(next_h);
         if (direction == ANIMATION_DIRECTION_UP) {
             // prev (25px) → current (50px): use current hour's icon
             // current (50px) → next (25px): use next hour's icon
-            offset_idx_1 = forecast_hours[h].experiential_icon > 0 ? forecast_hours[h].experiential_icon - 1 : 0;
-            offset_idx_2 = forecast_hours[next_h].experiential_icon > 0 ? forecast_hours[next_h].experiential_icon - 1 : 0;
+            offset_idx_1 = hour_experiential_icon(forecast_data, h) > 0 ? hour_experiential_icon(forecast_data, h) - 1 : 0;
+            offset_idx_2 = hour_experiential_icon(forecast_data, next_h) > 0 ? hour_experiential_icon(forecast_data, next_h) - 1 : 0;
         } else {
             // next (25px) → current (50px): use current hour's icon
             // current (50px) → prev (25px): use previous hour's icon
-            offset_idx_1 = forecast_hours[h].experiential_icon > 0 ? forecast_hours[h].experiential_icon - 1 : 0;
-            offset_idx_2 = forecast_hours[prev_h].experiential_icon > 0 ? forecast_hours[prev_h].experiential_icon - 1 : 0;
+            offset_idx_1 = hour_experiential_icon(forecast_data, h) > 0 ? hour_experiential_icon(forecast_data, h) - 1 : 0;
+            offset_idx_2 = hour_experiential_icon(forecast_data, prev_h) > 0 ? hour_experiential_icon(forecast_data, prev_h) - 1 : 0;
         }
     }
     
@@ -700,11 +692,8 @@ void image_animation_start(AnimationDirection direction, uint8_t hour, uint8_t p
         }
         if (s_image_animation_context.km_animation_1) {
             ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Scheduling delayed KM animation 1 (prev→current, UP direction) with %dms offset", ANIMATION_DELAY_MS);
-            s_image_animation_context.km_animation_delay_timer = app_timer_register(
-                ANIMATION_DELAY_MS, 
-                km_animation_delay_timer_callback, 
-                NULL
-            );
+            km_start_kmanimation_after(s_image_animation_context.km_animation_1, ANIMATION_DELAY_MS,
+                                       km_animation_1_complete);
         }
     } else {
         // DOWN: Start animation 2 immediately (current→prev), delay animation 1 (next→current)
@@ -714,11 +703,8 @@ void image_animation_start(AnimationDirection direction, uint8_t hour, uint8_t p
         }
         if (s_image_animation_context.km_animation_1) {
             ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Scheduling delayed KM animation 1 (next→current, DOWN direction) with %dms offset", ANIMATION_DELAY_MS);
-            s_image_animation_context.km_animation_delay_timer = app_timer_register(
-                ANIMATION_DELAY_MS, 
-                km_animation_delay_timer_callback, 
-                NULL
-            );
+            km_start_kmanimation_after(s_image_animation_context.km_animation_1, ANIMATION_DELAY_MS,
+                                       km_animation_1_complete);
         }
     }
     
@@ -22,7 +22,7 @@ typedef struct {
     
     // Current page and hour tracking
     uint8_t current_page;                   // Current page (0=conditions, 1=airflow, 2=experiential)
-    uint8_t current_hour;                   // Current hour (0-11)
+    uint8_t current_hour;                   // Current forecast hour
     
     // Image layer references
     Layer* images_layer;                    // Reference to the images layer for hiding during animation
@@ -51,12 +51,19 @@ typedef struct {
     bool images_hidden;                     // Flag to track if original images are hidden
     int km_animations_completed;            // Counter for completed KM animations
     int km_animations_expected;             // Expected number of animations to complete
-    AppTimer* km_animation_delay_timer;     // Timer for staggered animation start
+    Arena km_arena;                         // KMAnimations and their points; rewound per transition
     
     // Completion callback
     void (*on_complete)(void);
 } ImageAnimationContext;
 
+// Room in the transition arena for both KMAnimations and this many points
+// between them. The host's make conformance checks that the two largest
+// icons together fit (91 points today); past this the points go to the heap.
+#define KM_ARENA_POINTS 96
+#define KM_ARENA_SIZE (2 * (sizeof(KMAnimation) + KM_LINEAR_SLICES * sizeof(KMAnimationPoint*)) + \
+                       KM_ARENA_POINTS * sizeof(KMAnimationPoint))
+
 /**
  * Initialize the image animation subsystem
  */
@@ -93,7 +100,7 @@ void image_animation_deinit_system(void);
 /**
  * Start an image animation
  * @param direction The direction of animation (up or down)
- * @param hour The current hour index (0-11)
+ * @param hour The current forecast hour index
  * @param page The current page (0=conditions, 1=airflow, 2=experiential)
  * @param on_complete Callback function to call when animation completes
  */
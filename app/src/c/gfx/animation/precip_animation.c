@@ -1,9 +1,10 @@
 #include "precip_animation.h"
+#include "animation.h"
 
-#ifndef PBL_PLATFORM_APLITE
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
 
 #define PRECIP_ANIM_DURATION_MS  450
-#define PRECIP_MAX_DATA_POINTS   13
+#define PRECIP_MAX_DATA_POINTS   31  // conditions.c: a point every 2 minutes
 
 static Animation*         s_animation       = NULL;
 static Layer*             s_layer           = NULL;
@@ -51,6 +52,7 @@ static const AnimationImplementation s_implementation = {
 
 void precip_animation_start(Layer* layer, GPathInfo* path_info,
                              int num_data_points, int16_t bottom_y) {
+    ANIMATION_PROFILE_SCOPE("precip_animation");
     precip_animation_stop();
 
     s_layer      = layer;
@@ -101,4 +103,4 @@ AnimationProgress precip_animation_get_progress(void) {
     return s_progress;
 }
 
-#endif // PBL_PLATFORM_APLITE
+#endif // ANIMATION_TIER_FULL
@@ -1,16 +1,17 @@
 #pragma once
 
 #include <pebble.h>
+#include "animation.h"
 
 /**
  * Animates the Y coordinates of a GPathInfo's data points from a common
  * bottom value (the axis baseline) up to their pre-baked target values.
  * Call this immediately after baking the final Y values into the path.
  *
- * Only available on non-Aplite platforms.
+ * Only available in the full animation tier.
  */
 
-#ifndef PBL_PLATFORM_APLITE
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
 
 /**
  * Start the precipitation graph rise animation.
@@ -49,4 +50,4 @@ bool precip_animation_is_active(void);
  */
 AnimationProgress precip_animation_get_progress(void);
 
-#endif // PBL_PLATFORM_APLITE
+#endif // ANIMATION_TIER_FULL
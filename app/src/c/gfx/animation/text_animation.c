@@ -2,10 +2,17 @@
 #include "image_animation.h"
 #include "../layout.h"
 #include "../../utils/weather.h"
+#include "../../utils/forecast.h"
 
 // Global text animation context
 static TextAnimationContext s_text_animation_context = {0};
 
+// Every text track shares the duration and the overshoot curve
+static void add_text_track(Layer* layer, GRect from, GRect to) {
+    frame_tween_add(&s_text_animation_context.tween, layer, from, to, 0, ANIMATION_DURATION_MS,
+                    animation_back_out_overshoot_curve);
+}
+
 // Animation completion callback
 static void text_animation_complete_callback(void) {
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Text animation completion callback called");
@@ -37,18 +44,7 @@ static void text_animation_complete_callback(void) {
         layer_set_hidden(text_layer_get_layer(s_text_animation_context.next_time_layer), false);
     }
     
-    // Clean up spawn animation (this automatically cleans up all component animations)
-    if (s_text_animation_context.spawn_animation) {
-        animation_destroy(s_text_animation_context.spawn_animation);
-        s_text_animation_context.spawn_animation = NULL;
-    }
-    
-    // Reset individual animation pointers to NULL (don't destroy them - spawn owns them)
-    s_text_animation_context.incoming_time_animation = NULL;
-    s_text_animation_context.prev_time_animation = NULL;
-    s_text_animation_context.current_time_animation = NULL;
-    s_text_animation_context.next_time_animation = NULL;
-    s_text_animation_context.current_text_animation = NULL;
+    frame_tween_stop(&s_text_animation_context.tween);
     
     // Update state
     s_text_animation_context.state = ANIMATION_STATE_IDLE;
@@ -62,24 +58,12 @@ static void text_animation_complete_callback(void) {
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Text animation completion callback finished");
 }
 
-// Animation stopped handler
-static void text_animation_stopped_handler(Animation* animation, bool finished, void* context) {
-    if (finished && animation == s_text_animation_context.spawn_animation) {
-        text_animation_complete_callback();
-    }
-}
-
 void text_animation_init_system(void) {
     // Note: image_animation_init_system() is handled by animation_system_init()
     // to avoid double-initialization.
 
     s_text_animation_context.state = ANIMATION_STATE_IDLE;
-    s_text_animation_context.spawn_animation = NULL;
-    s_text_animation_context.incoming_time_animation = NULL;
-    s_text_animation_context.prev_time_animation = NULL;
-    s_text_animation_context.current_time_animation = NULL;
-    s_text_animation_context.next_time_animation = NULL;
-    s_text_animation_context.current_text_animation = NULL;
+    frame_tween_init(&s_text_animation_context.tween, "text_animation");
     s_text_animation_context.on_complete = NULL;
     
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Text animation subsystem initialized");
@@ -156,6 +140,7 @@ void text_animation_deinit_system(void) {
 }
 
 void text_animation_start(AnimationDirection direction, uint8_t target_hour, const char* time_text, const char* content_text, void (*on_complete)(void)) {
+    ANIMATION_PROFILE_SCOPE("text_animation");
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "=== TEXT_ANIMATION_START CALLED ===");
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Direction: %s, Target hour: %d", 
             direction == ANIMATION_DIRECTION_UP ? "UP" : "DOWN", target_hour);
@@ -201,24 +186,24 @@ void text_animation_start(AnimationDirection direction, uint8_t target_hour, con
     if (direction == ANIMATION_DIRECTION_UP) {
         // For UP: incoming time shows hour (target_hour - 1)
         int incoming_hour_index = target_hour - 1;
-        show_incoming_time = (incoming_hour_index >= 0);
+        show_incoming_time = (incoming_hour_index >= 0 && forecast_has_hour(incoming_hour_index));
         ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "UP animation to hour %d, incoming hour index: %d, show_incoming_time: %s", 
                 target_hour, incoming_hour_index, show_incoming_time ? "YES" : "NO");
         if (show_incoming_time) {
-            // Set incoming time text from forecast hours array
+            // Set incoming time text from the forecast
             text_layer_set_text(s_text_animation_context.temp_incoming_time_layer, 
-                               forecast_hours[incoming_hour_index].hour_string);
+                               hour_label(forecast_data, forecast_slot(incoming_hour_index)));
         }
     } else {
         // For DOWN: incoming time shows hour (target_hour + 1)  
         int incoming_hour_index = target_hour + 1;
-        show_incoming_time = (incoming_hour_index <= 11);
+        show_incoming_time = forecast_has_hour(incoming_hour_index);
         ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "DOWN animation to hour %d, incoming hour index: %d, show_incoming_time: %s", 
                 target_hour, incoming_hour_index, show_incoming_time ? "YES" : "NO");
         if (show_incoming_time) {
-            // Set incoming time text from forecast hours array
+            // Set incoming time text from the forecast
             text_layer_set_text(s_text_animation_context.temp_incoming_time_layer, 
-                               forecast_hours[incoming_hour_index].hour_string);
+                               hour_label(forecast_data, forecast_slot(incoming_hour_index)));
         }
     }
     
@@ -227,7 +212,6 @@ void text_animation_start(AnimationDirection direction, uint8_t target_hour, con
         layer_set_hidden(text_layer_get_layer(s_text_animation_context.temp_incoming_time_layer), false);
     }
     
-    // Snapshot layout bounds as locals (needed for pointer passing to property_animation_create_layer_frame)
     GRect prev_time_bounds = LAYOUT_PREV_TIME_BOUNDS;
     GRect cur_time_bounds  = LAYOUT_CUR_TIME_BOUNDS;
     GRect cur_text_bounds  = LAYOUT_CUR_TEXT_BOUNDS;
@@ -262,134 +246,51 @@ void text_animation_start(AnimationDirection direction, uint8_t target_hour, con
             cur_time_bounds.origin.x, cur_time_bounds.origin.y,
             next_time_bounds.origin.x, next_time_bounds.origin.y);
 
-    // Create individual animations based on direction
+    Layer* incoming_layer = text_layer_get_layer(s_text_animation_context.temp_incoming_time_layer);
+    Layer* prev_layer = text_layer_get_layer(s_text_animation_context.prev_time_layer);
+    Layer* current_layer = text_layer_get_layer(s_text_animation_context.main_time_layer);
+    Layer* next_layer = text_layer_get_layer(s_text_animation_context.next_time_layer);
+    Layer* text_layer = text_layer_get_layer(s_text_animation_context.main_text_layer);
+
+    FrameTween* tween = &s_text_animation_context.tween;
+    frame_tween_clear(tween);
+
     if (direction == ANIMATION_DIRECTION_UP) {
         // UP: New time comes from top, moves to prev position (only if we have incoming time)
         if (show_incoming_time) {
-            s_text_animation_context.incoming_time_animation = property_animation_create_layer_frame(
-                text_layer_get_layer(s_text_animation_context.temp_incoming_time_layer),
-                &off_screen_top, &prev_time_bounds
-            );
+            add_text_track(incoming_layer, off_screen_top, prev_time_bounds);
         }
-
-        // Prev time moves to current position
-        s_text_animation_context.prev_time_animation = property_animation_create_layer_frame(
-            text_layer_get_layer(s_text_animation_context.prev_time_layer),
-            &prev_time_bounds, &cur_time_bounds
-        );
-
-        // Current time moves to next position
-        s_text_animation_context.current_time_animation = property_animation_create_layer_frame(
-            text_layer_get_layer(s_text_animation_context.main_time_layer),
-            &cur_time_bounds, &next_time_bounds
-        );
-
-        // Next time moves off screen bottom
-        s_text_animation_context.next_time_animation = property_animation_create_layer_frame(
-            text_layer_get_layer(s_text_animation_context.next_time_layer),
-            &next_time_bounds, &off_screen_bottom
-        );
-
+        // Prev time moves to current, current to next, next off screen bottom
+        add_text_track(prev_layer, prev_time_bounds, cur_time_bounds);
+        add_text_track(current_layer, cur_time_bounds, next_time_bounds);
+        add_text_track(next_layer, next_time_bounds, off_screen_bottom);
         // Current text hops down (up button press makes text hop down)
-        s_text_animation_context.current_text_animation = property_animation_create_layer_frame(
-            text_layer_get_layer(s_text_animation_context.main_text_layer),
-            &text_hop_up, &cur_text_bounds
-        );
-
+        add_text_track(text_layer, text_hop_up, cur_text_bounds);
     } else {
         // DOWN: New time comes from bottom, moves to next position (only if we have incoming time)
         if (show_incoming_time) {
-            s_text_animation_context.incoming_time_animation = property_animation_create_layer_frame(
-                text_layer_get_layer(s_text_animation_context.temp_incoming_time_layer),
-                &off_screen_bottom, &next_time_bounds
-            );
+            add_text_track(incoming_layer, off_screen_bottom, next_time_bounds);
         }
-
-        // Next time moves to current position
-        s_text_animation_context.next_time_animation = property_animation_create_layer_frame(
-            text_layer_get_layer(s_text_animation_context.next_time_layer),
-            &next_time_bounds, &cur_time_bounds
-        );
-
-        // Current time moves to prev position
-        s_text_animation_context.current_time_animation = property_animation_create_layer_frame(
-            text_layer_get_layer(s_text_animation_context.main_time_layer),
-            &cur_time_bounds, &prev_time_bounds
-        );
-
-        // Prev time moves off screen top
-        s_text_animation_context.prev_time_animation = property_animation_create_layer_frame(
-            text_layer_get_layer(s_text_animation_context.prev_time_layer),
-            &prev_time_bounds, &off_screen_top
-        );
-
+        // Next time moves to current, current to prev, prev off screen top
+        add_text_track(next_layer, next_time_bounds, cur_time_bounds);
+        add_text_track(current_layer, cur_time_bounds, prev_time_bounds);
+        add_text_track(prev_layer, prev_time_bounds, off_screen_top);
         // Current text hops up (down button press makes text hop up)
-        s_text_animation_context.current_text_animation = property_animation_create_layer_frame(
-            text_layer_get_layer(s_text_animation_context.main_text_layer),
-            &text_hop_down, &cur_text_bounds
-        );
-    }
-    
-    // Build array of valid animations
-    Animation* animations[5];
-    int anim_count = 0;
-    
-    if (s_text_animation_context.incoming_time_animation) {
-        animations[anim_count++] = property_animation_get_animation(s_text_animation_context.incoming_time_animation);
+        add_text_track(text_layer, text_hop_down, cur_text_bounds);
     }
-    if (s_text_animation_context.prev_time_animation) {
-        animations[anim_count++] = property_animation_get_animation(s_text_animation_context.prev_time_animation);
-    }
-    if (s_text_animation_context.current_time_animation) {
-        animations[anim_count++] = property_animation_get_animation(s_text_animation_context.current_time_animation);
-    }
-    if (s_text_animation_context.next_time_animation) {
-        animations[anim_count++] = property_animation_get_animation(s_text_animation_context.next_time_animation);
-    }
-    if (s_text_animation_context.current_text_animation) {
-        animations[anim_count++] = property_animation_get_animation(s_text_animation_context.current_text_animation);
-    }
-    
-    // Verify we have animations to spawn
-    if (anim_count == 0) {
-        ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "No valid animations created for spawn");
+
+    // Store context
+    s_text_animation_context.state = ANIMATION_STATE_ANIMATING;
+    s_text_animation_context.direction = direction;
+    s_text_animation_context.on_complete = on_complete;
+
+    if (!frame_tween_start(tween, text_animation_complete_callback)) {
+        ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "Failed to start text animation");
         text_animation_complete_callback();
         return;
     }
-    
-    // Configure all animations with common curve
-    for (int i = 0; i < anim_count; i++) {
-        if (animations[i]) {
-            animation_set_duration(animations[i], ANIMATION_DURATION_MS);
-            animation_set_custom_curve(animations[i], animation_back_out_overshoot_curve);
-        }
-    }
-    
-    // Start image animation in parallel
-    
-    // Create and start spawn animation
-    s_text_animation_context.spawn_animation = animation_spawn_create_from_array(animations, anim_count);
-    
-    if (s_text_animation_context.spawn_animation) {
-        // Set completion handler on spawn animation
-        animation_set_handlers(s_text_animation_context.spawn_animation, (AnimationHandlers) {
-            .stopped = text_animation_stopped_handler,
-        }, NULL);
-        
-        // Store context
-        s_text_animation_context.state = ANIMATION_STATE_ANIMATING;
-        s_text_animation_context.direction = direction;
-        s_text_animation_context.on_complete = on_complete;
-        
-        // Schedule spawn animation
-        animation_schedule(s_text_animation_context.spawn_animation);
-        
-        ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "TEXT ANIMATION STARTED - direction: %d, animations: %d", direction, anim_count);
-    } else {
-        // Clean up on failure
-        ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "Failed to create spawn animation");
-        text_animation_complete_callback();
-    }
+
+    ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "TEXT ANIMATION STARTED - direction: %d, tracks: %d", direction, tween->track_count);
 }
 
 bool text_animation_is_active(void) {
@@ -398,10 +299,7 @@ bool text_animation_is_active(void) {
 
 void text_animation_stop(void) {
     if (s_text_animation_context.state == ANIMATION_STATE_ANIMATING) {
-        // Stop spawn animation
-        if (s_text_animation_context.spawn_animation) {
-            animation_unschedule(s_text_animation_context.spawn_animation);
-        }
+        frame_tween_stop(&s_text_animation_context.tween);
         
         // Stop image animation
         image_animation_stop();
@@ -1,6 +1,7 @@
 #pragma once
 #include <pebble.h>
 #include "animation.h"
+#include "frame_tween.h"
 
 typedef struct {
     AnimationState state;
@@ -16,13 +17,9 @@ typedef struct {
     Layer* animation_layer;
     TextLayer* temp_incoming_time_layer;
     
-    // Animation objects
-    Animation* spawn_animation;
-    PropertyAnimation* incoming_time_animation;
-    PropertyAnimation* prev_time_animation;
-    PropertyAnimation* current_time_animation;
-    PropertyAnimation* next_time_animation;
-    PropertyAnimation* current_text_animation;
+    // Frames of the incoming, prev, current and next time layers and the
+    // current text layer, refilled for every hour step
+    FrameTween tween;
     
     // Completion callback
     void (*on_complete)(void);
@@ -78,7 +75,7 @@ void text_animation_deinit_system(void);
 /**
  * Start a text animation
  * @param direction The direction of animation (up or down)
- * @param target_hour The target hour index (0-11) after animation completes
+ * @param target_hour The target forecast hour index after animation completes
  * @param time_text The new time text to display
  * @param content_text The new content text to display
  * @param on_complete Callback function to call when animation completes
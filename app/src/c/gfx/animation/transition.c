@@ -7,10 +7,6 @@
 // Global transition animation context
 static TransitionAnimationContext s_transition_animation_context = {0};
 
-// Forward declarations
-static void transition_animation_stopped_handler(Animation* animation, bool finished, void* context);
-static void transition_animation_complete_callback(void);
-
 // Animation completion callback
 static void transition_animation_complete_callback(void) {
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Transition animation completion callback called");
@@ -29,37 +25,13 @@ static void transition_animation_complete_callback(void) {
         layer_set_frame(text_layer_get_layer(s_transition_animation_context.next_time_layer), LAYOUT_NEXT_TIME_BOUNDS);
     }
     
-    // Mark images layer as dirty to redraw with normal positions
+    // Put the images layer back too, in case the run was cut short
     if (s_transition_animation_context.images_layer) {
+        layer_set_frame(s_transition_animation_context.images_layer, GRect(0, 0, LAYOUT_W, LAYOUT_H));
         layer_mark_dirty(s_transition_animation_context.images_layer);
     }
     
-    // Clean up spawn animation (this automatically cleans up all component animations)
-    if (s_transition_animation_context.spawn_animation) {
-        animation_destroy(s_transition_animation_context.spawn_animation);
-        s_transition_animation_context.spawn_animation = NULL;
-    }
-    
-    // Reset individual animation pointers to NULL (don't destroy them - spawn owns them)
-    s_transition_animation_context.current_time_animation = NULL;
-    s_transition_animation_context.current_text_animation = NULL;
-    s_transition_animation_context.prev_time_animation = NULL;
-    s_transition_animation_context.next_time_animation = NULL;
-    s_transition_animation_context.image_progress_animation = NULL;
-    
-    // Clean up image layer animation
-    if (s_transition_animation_context.image_progress_animation) {
-        property_animation_destroy(s_transition_animation_context.image_progress_animation);
-        s_transition_animation_context.image_progress_animation = NULL;
-    }
-    
-    // Cancel text animation delay timer
-    if (s_transition_animation_context.text_animation_delay_timer) {
-        app_timer_cancel(s_transition_animation_context.text_animation_delay_timer);
-        s_transition_animation_context.text_animation_delay_timer = NULL;
-    }
-    
-
+    frame_tween_stop(&s_transition_animation_context.tween);
     
     // Update state
     s_transition_animation_context.state = ANIMATION_STATE_IDLE;
@@ -73,86 +45,15 @@ static void transition_animation_complete_callback(void) {
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Transition animation completion callback finished");
 }
 
-// Timer callback for text animation delay
-static void text_animation_delay_callback(void* context) {
-    s_transition_animation_context.text_animation_delay_timer = NULL;
-    
-    // Start the text animations now
-    ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Starting text animations after delay");
-    
-    // Build array of text animations
-    Animation* text_animations[4];
-    int text_anim_count = 0;
-    
-    if (s_transition_animation_context.current_time_animation) {
-        text_animations[text_anim_count++] = property_animation_get_animation(s_transition_animation_context.current_time_animation);
-    }
-    if (s_transition_animation_context.current_text_animation) {
-        text_animations[text_anim_count++] = property_animation_get_animation(s_transition_animation_context.current_text_animation);
-    }
-    if (s_transition_animation_context.prev_time_animation) {
-        text_animations[text_anim_count++] = property_animation_get_animation(s_transition_animation_context.prev_time_animation);
-    }
-    if (s_transition_animation_context.next_time_animation) {
-        text_animations[text_anim_count++] = property_animation_get_animation(s_transition_animation_context.next_time_animation);
-    }
-    
-    // Configure text animations with out-and-back curve
-    for (int i = 0; i < text_anim_count; i++) {
-        if (text_animations[i]) {
-            animation_set_duration(text_animations[i], TRANSITION_ANIMATION_DURATION_MS);
-            animation_set_custom_curve(text_animations[i], animation_transition_out_and_back_curve);
-        }
-    }
-    
-    // Create and start text spawn animation
-    s_transition_animation_context.spawn_animation = animation_spawn_create_from_array(text_animations, text_anim_count);
-    
-    if (s_transition_animation_context.spawn_animation) {
-        // Set completion handler on spawn animation
-        animation_set_handlers(s_transition_animation_context.spawn_animation, (AnimationHandlers) {
-            .stopped = transition_animation_stopped_handler,
-        }, NULL);
-        
-        // Schedule spawn animation
-        animation_schedule(s_transition_animation_context.spawn_animation);
-        
-        ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "TEXT ANIMATIONS STARTED after delay");
-    } else {
-        // Clean up on failure
-        ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "Failed to create text spawn animation");
-        transition_animation_complete_callback();
-    }
-}
-
-
-
-
-
-// Animation stopped handler
-static void transition_animation_stopped_handler(Animation* animation, bool finished, void* context) {
-    if (finished && animation == s_transition_animation_context.spawn_animation) {
-        transition_animation_complete_callback();
-    }
-}
-
 void transition_animation_init_system(void) {
     // Initialize state
     s_transition_animation_context.state = ANIMATION_STATE_IDLE;
-    s_transition_animation_context.spawn_animation = NULL;
-    s_transition_animation_context.current_time_animation = NULL;
-    s_transition_animation_context.current_text_animation = NULL;
-    s_transition_animation_context.prev_time_animation = NULL;
-    s_transition_animation_context.next_time_animation = NULL;
-    s_transition_animation_context.image_progress_animation = NULL;
+    frame_tween_init(&s_transition_animation_context.tween, "transition");
     s_transition_animation_context.on_complete = NULL;
     
     // Initialize image layer reference
     s_transition_animation_context.images_layer = NULL;
     
-    // Initialize timers
-    s_transition_animation_context.text_animation_delay_timer = NULL;
-    
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Transition animation subsystem initialized");
 }
 
@@ -195,34 +96,49 @@ void transition_animation_deinit_system(void) {
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Transition animation subsystem deinitialized");
 }
 
-void transition_animation_start(void (*on_complete)(void)) {
-    ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "=== TRANSITION_ANIMATION_START CALLED ===");
-    
-    // Don't start if already animating
-    if (s_transition_animation_context.state == ANIMATION_STATE_ANIMATING) {
-        ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Already animating, returning");
-        return;
-    }
-    
-    // Validate that we have the necessary layers
+// Validate that we have the necessary layers
+static bool has_text_layers(void) {
     if (!s_transition_animation_context.current_time_layer) {
         ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "current_time_layer not set for transition animation");
-        return;
+        return false;
     }
     if (!s_transition_animation_context.current_text_layer) {
         ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "current_text_layer not set for transition animation");
-        return;
+        return false;
     }
     if (!s_transition_animation_context.prev_time_layer) {
         ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "prev_time_layer not set for transition animation");
-        return;
+        return false;
     }
     if (!s_transition_animation_context.next_time_layer) {
         ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "next_time_layer not set for transition animation");
+        return false;
+    }
+    return true;
+}
+
+// Moves a layer dy pixels off its resting frame and tweens it back
+static void add_slide_in(FrameTween* tween, Layer* layer, GRect rest, int16_t dy, uint16_t delay_ms) {
+    GRect from = GRect(rest.origin.x, rest.origin.y + dy, rest.size.w, rest.size.h);
+    layer_set_frame(layer, from);
+    frame_tween_add(tween, layer, from, rest, delay_ms, TRANSITION_HOUR_ANIMATION_DURATION_MS,
+                    animation_back_out_overshoot_curve);
+}
+
+void transition_animation_start(void (*on_complete)(void)) {
+    ANIMATION_PROFILE_SCOPE("transition");
+    ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "=== TRANSITION_ANIMATION_START CALLED ===");
+    
+    // Don't start if already animating
+    if (s_transition_animation_context.state == ANIMATION_STATE_ANIMATING) {
+        ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Already animating, returning");
+        return;
+    }
+    
+    if (!has_text_layers()) {
         return;
     }
     
-    // Snapshot layout bounds as locals (needed for pointer passing to property_animation_create_layer_frame)
     GRect cur_time_bounds  = LAYOUT_CUR_TIME_BOUNDS;
     GRect cur_text_bounds  = LAYOUT_CUR_TEXT_BOUNDS;
     GRect prev_time_bounds = LAYOUT_PREV_TIME_BOUNDS;
@@ -251,31 +167,11 @@ void transition_animation_start(void (*on_complete)(void)) {
 
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Creating transition animations - hop left by 10 pixels");
 
-    // Create text animations: move from original position to hop position and back
-    // The custom curve will handle the "back" part automatically
-    s_transition_animation_context.current_time_animation = property_animation_create_layer_frame(
-        text_layer_get_layer(s_transition_animation_context.current_time_layer),
-        &cur_time_bounds, &time_hop_left
-    );
-
-    s_transition_animation_context.current_text_animation = property_animation_create_layer_frame(
-        text_layer_get_layer(s_transition_animation_context.current_text_layer),
-        &cur_text_bounds, &text_hop_left
-    );
-
-    s_transition_animation_context.prev_time_animation = property_animation_create_layer_frame(
-        text_layer_get_layer(s_transition_animation_context.prev_time_layer),
-        &prev_time_bounds, &prev_hop_left
-    );
-
-    s_transition_animation_context.next_time_animation = property_animation_create_layer_frame(
-        text_layer_get_layer(s_transition_animation_context.next_time_layer),
-        &next_time_bounds, &next_hop_left
-    );
-
-    // Set up image animation - animate the entire images layer
+    FrameTween* tween = &s_transition_animation_context.tween;
+    frame_tween_clear(tween);
+
+    // Image layer slides in from off-screen right to its normal position, at once
     if (s_transition_animation_context.images_layer) {
-        // Calculate the layer's current frame and target frame
         GRect current_frame = layer_get_frame(s_transition_animation_context.images_layer);
         GRect start_frame = GRect(current_frame.origin.x + (LAYOUT_W + 20), 
                                  current_frame.origin.y,
@@ -285,66 +181,83 @@ void transition_animation_start(void (*on_complete)(void)) {
         // Immediately move the layer off-screen to prevent flash of new images
         layer_set_frame(s_transition_animation_context.images_layer, start_frame);
         
-        // Create property animation for the layer frame - from off-screen right to normal position
-        s_transition_animation_context.image_progress_animation = property_animation_create_layer_frame(
-            s_transition_animation_context.images_layer,
-            &start_frame, &current_frame
-        );
-        
-        if (s_transition_animation_context.image_progress_animation) {
-            // Configure the animation
-            Animation* image_anim = property_animation_get_animation(s_transition_animation_context.image_progress_animation);
-            animation_set_duration(image_anim, TRANSITION_IMAGE_ANIMATION_DURATION_MS);
-            animation_set_custom_curve(image_anim, animation_back_out_overshoot_curve);
-            
-            // Schedule the animation
-            animation_schedule(image_anim);
-            
-            ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Image layer animation started");
-        } else {
-            ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "Failed to create image layer animation");
-        }
+        frame_tween_add(tween, s_transition_animation_context.images_layer, start_frame, current_frame,
+                        0, TRANSITION_IMAGE_ANIMATION_DURATION_MS, animation_back_out_overshoot_curve);
     }
+
+    // Text layers hop left and back once the images are under way; the
+    // out-and-back curve handles the "back" part
+    frame_tween_add(tween, text_layer_get_layer(s_transition_animation_context.current_time_layer),
+                    cur_time_bounds, time_hop_left, TRANSITION_IMAGE_TEXT_DELAY_MS,
+                    TRANSITION_ANIMATION_DURATION_MS, animation_transition_out_and_back_curve);
+    frame_tween_add(tween, text_layer_get_layer(s_transition_animation_context.current_text_layer),
+                    cur_text_bounds, text_hop_left, TRANSITION_IMAGE_TEXT_DELAY_MS,
+                    TRANSITION_ANIMATION_DURATION_MS, animation_transition_out_and_back_curve);
+    frame_tween_add(tween, text_layer_get_layer(s_transition_animation_context.prev_time_layer),
+                    prev_time_bounds, prev_hop_left, TRANSITION_IMAGE_TEXT_DELAY_MS,
+                    TRANSITION_ANIMATION_DURATION_MS, animation_transition_out_and_back_curve);
+    frame_tween_add(tween, text_layer_get_layer(s_transition_animation_context.next_time_layer),
+                    next_time_bounds, next_hop_left, TRANSITION_IMAGE_TEXT_DELAY_MS,
+                    TRANSITION_ANIMATION_DURATION_MS, animation_transition_out_and_back_curve);
     
     // Store context and completion callback
     s_transition_animation_context.state = ANIMATION_STATE_ANIMATING;
     s_transition_animation_context.on_complete = on_complete;
     
-    // Start image animation immediately
-    ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Starting image animation immediately");
-    
-    // Schedule text animation delay timer
-    s_transition_animation_context.text_animation_delay_timer = app_timer_register(
-        TRANSITION_IMAGE_TEXT_DELAY_MS,
-        text_animation_delay_callback,
-        NULL
-    );
+    if (!frame_tween_start(tween, transition_animation_complete_callback)) {
+        ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "Failed to start transition animation");
+        transition_animation_complete_callback();
+        return;
+    }
     
     ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "TRANSITION ANIMATION STARTED - images immediately, text after %dms delay", TRANSITION_IMAGE_TEXT_DELAY_MS);
 }
 
+void transition_animation_start_hour(AnimationDirection direction, void (*on_complete)(void)) {
+    ANIMATION_PROFILE_SCOPE("transition");
+
+    if (s_transition_animation_context.state == ANIMATION_STATE_ANIMATING || !has_text_layers()) {
+        return;
+    }
+
+    // A later hour comes up from below, an earlier one down from above
+    int16_t dy = direction == ANIMATION_DIRECTION_DOWN ? LAYOUT_SCALE(10) : -LAYOUT_SCALE(10);
+
+    FrameTween* tween = &s_transition_animation_context.tween;
+    frame_tween_clear(tween);
+
+    if (s_transition_animation_context.images_layer) {
+        Layer* images_layer = s_transition_animation_context.images_layer;
+        add_slide_in(tween, images_layer, layer_get_frame(images_layer), dy, 0);
+    }
+    add_slide_in(tween, text_layer_get_layer(s_transition_animation_context.current_time_layer),
+                 LAYOUT_CUR_TIME_BOUNDS, dy, TRANSITION_HOUR_TEXT_DELAY_MS);
+    add_slide_in(tween, text_layer_get_layer(s_transition_animation_context.current_text_layer),
+                 LAYOUT_CUR_TEXT_BOUNDS, dy, TRANSITION_HOUR_TEXT_DELAY_MS);
+    add_slide_in(tween, text_layer_get_layer(s_transition_animation_context.prev_time_layer),
+                 LAYOUT_PREV_TIME_BOUNDS, dy, TRANSITION_HOUR_TEXT_DELAY_MS);
+    add_slide_in(tween, text_layer_get_layer(s_transition_animation_context.next_time_layer),
+                 LAYOUT_NEXT_TIME_BOUNDS, dy, TRANSITION_HOUR_TEXT_DELAY_MS);
+
+    s_transition_animation_context.state = ANIMATION_STATE_ANIMATING;
+    s_transition_animation_context.on_complete = on_complete;
+
+    if (!frame_tween_start(tween, transition_animation_complete_callback)) {
+        ANIMATION_LOG(APP_LOG_LEVEL_ERROR, "Failed to start hour slide");
+        transition_animation_complete_callback();
+        return;
+    }
+
+    ANIMATION_LOG(APP_LOG_LEVEL_DEBUG, "Hour slide started, %d pixels", dy);
+}
+
 bool transition_animation_is_active(void) {
     return s_transition_animation_context.state == ANIMATION_STATE_ANIMATING;
 }
 
 void transition_animation_stop(void) {
     if (s_transition_animation_context.state == ANIMATION_STATE_ANIMATING) {
-        // Stop spawn animation
-        if (s_transition_animation_context.spawn_animation) {
-            animation_unschedule(s_transition_animation_context.spawn_animation);
-        }
-        
-        // Stop image layer animation
-        if (s_transition_animation_context.image_progress_animation) {
-            property_animation_destroy(s_transition_animation_context.image_progress_animation);
-            s_transition_animation_context.image_progress_animation = NULL;
-        }
-        
-        // Cancel text animation delay timer
-        if (s_transition_animation_context.text_animation_delay_timer) {
-            app_timer_cancel(s_transition_animation_context.text_animation_delay_timer);
-            s_transition_animation_context.text_animation_delay_timer = NULL;
-        }
+        frame_tween_stop(&s_transition_animation_context.tween);
         
         // Force completion callback
         transition_animation_complete_callback();
@@ -1,6 +1,7 @@
 #pragma once
 #include <pebble.h>
 #include "animation.h"
+#include "frame_tween.h"
 
 // Logging is now controlled by ANIMATION_LOGGING in animation.h
 // Uncomment ANIMATION_LOGGING in animation.h to enable animation debug logging
@@ -10,6 +11,10 @@
 #define TRANSITION_IMAGE_ANIMATION_DURATION_MS 200
 #define TRANSITION_IMAGE_TEXT_DELAY_MS 100
 
+// Hour slide timing, for tiers without the full hour animation
+#define TRANSITION_HOUR_ANIMATION_DURATION_MS 200
+#define TRANSITION_HOUR_TEXT_DELAY_MS 50
+
 typedef struct {
     AnimationState state;
     
@@ -22,16 +27,9 @@ typedef struct {
     // Image layer reference (not owned by transition system)
     Layer* images_layer;
     
-    // Animation objects
-    Animation* spawn_animation;
-    PropertyAnimation* current_time_animation;
-    PropertyAnimation* current_text_animation;
-    PropertyAnimation* prev_time_animation;
-    PropertyAnimation* next_time_animation;
-    PropertyAnimation* image_progress_animation;
-    
-    // Timers for animation coordination
-    AppTimer* text_animation_delay_timer;
+    // The images layer slides in at once; the text layers hop after
+    // TRANSITION_IMAGE_TEXT_DELAY_MS on the same clock
+    FrameTween tween;
     
     // Completion callback
     void (*on_complete)(void);
@@ -82,6 +80,15 @@ void transition_animation_deinit_system(void);
  */
 void transition_animation_start(void (*on_complete)(void));
 
+/**
+ * Start an hour slide: the images and text layers, already showing the new
+ * hour, slide the last few pixels into place from the side they scrolled in
+ * from. Only layer frames move, so it suits every animation tier.
+ * @param direction ANIMATION_DIRECTION_DOWN when moving to a later hour
+ * @param on_complete Callback function to call when animation completes
+ */
+void transition_animation_start_hour(AnimationDirection direction, void (*on_complete)(void));
+
 /**
  * Check if a transition animation is currently active
  * @return true if animation is active, false otherwise
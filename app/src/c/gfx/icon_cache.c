@@ -0,0 +1,307 @@
+#include "icon_cache.h"
+
+#ifdef PBL_BW
+  // White source pixels leave the destination alone, so the key is white
+  #define ICON_CACHE_FORMAT GBitmapFormat1Bit
+  #define ICON_CACHE_COMP_OP GCompOpAnd
+#else
+  #define ICON_CACHE_FORMAT GBitmapFormat8Bit
+  #define ICON_CACHE_COMP_OP GCompOpSet
+#endif
+
+typedef enum {
+    TRANSFER_SAVE,              // Framebuffer into the bitmap, as is
+    TRANSFER_TAKE,              // Framebuffer into the bitmap, keyed
+    TRANSFER_SWAP,              // Keyed framebuffer into the bitmap, bitmap back into the framebuffer
+} Transfer;
+
+static Layer* s_capture_layer;
+static GRect s_window_bounds;
+static IconCacheEntry* s_pending[ICON_CACHE_MAX_PENDING];
+static uint8_t s_pending_count;
+static IconCacheStats s_stats;
+
+// Current slot first: it is the largest icon and the one the eye follows
+static const uint8_t s_slot_order[ICON_CACHE_SLOTS] = {1, 0, 2};
+
+static size_t prv_bytes_for(GSize size) {
+#ifdef PBL_BW
+    return (size_t)((size.w + 31) / 32) * 4 * size.h;
+#else
+    return (size_t)size.w * size.h;
+#endif
+}
+
+static GSize prv_bitmap_size(const IconCacheEntry* entry) {
+    return gbitmap_get_bounds(entry->bitmap).size;
+}
+
+static uint8_t prv_get(const uint8_t* row, int16_t x) {
+#ifdef PBL_BW
+    return (row[x >> 3] >> (x & 7)) & 1;
+#else
+    return row[x];
+#endif
+}
+
+static void prv_set(uint8_t* row, int16_t x, uint8_t value) {
+#ifdef PBL_BW
+    if (value) {
+        row[x >> 3] |= 1 << (x & 7);
+    } else {
+        row[x >> 3] &= ~(1 << (x & 7));
+    }
+#else
+    row[x] = value;
+#endif
+}
+
+static uint8_t prv_keyed(uint8_t value, GColor key) {
+#ifdef PBL_BW
+    return value;
+#else
+    return value == key.argb ? GColorClear.argb : value;
+#endif
+}
+
+// The pending entry with the largest bitmap; the capture layer takes its size
+static IconCacheEntry* prv_holder(void) {
+    IconCacheEntry* holder = NULL;
+    int32_t holder_area = 0;
+    for (uint8_t i = 0; i < s_pending_count; i++) {
+        GSize size = prv_bitmap_size(s_pending[i]);
+        if ((int32_t)size.w * size.h > holder_area) {
+            holder = s_pending[i];
+            holder_area = (int32_t)size.w * size.h;
+        }
+    }
+    return holder;
+}
+
+// Centred, where every display has pixels, round ones included, and the
+// size of the largest icon waiting
+static void prv_place(void) {
+    IconCacheEntry* holder = prv_holder();
+    if (!holder) {
+        return;
+    }
+    GSize size = prv_bitmap_size(holder);
+    layer_set_frame(s_capture_layer, GRect((s_window_bounds.size.w - size.w) / 2,
+                                           (s_window_bounds.size.h - size.h) / 2, size.w, size.h));
+}
+
+static void prv_unqueue(IconCacheEntry* entry) {
+    for (uint8_t i = 0; i < s_pending_count; i++) {
+        if (s_pending[i] == entry) {
+            s_pending[i] = s_pending[--s_pending_count];
+            prv_place();
+            return;
+        }
+    }
+}
+
+static void prv_release(IconCacheEntry* entry) {
+    prv_unqueue(entry);
+    if (entry->bitmap) {
+        s_stats.bytes -= prv_bytes_for(prv_bitmap_size(entry));
+        gbitmap_destroy(entry->bitmap);
+        entry->bitmap = NULL;
+    }
+    entry->image = NULL;
+    entry->ready = false;
+}
+
+static void prv_queue(IconCacheEntry* entry) {
+    if (!s_capture_layer) {
+        return;
+    }
+    for (uint8_t i = 0; i < s_pending_count; i++) {
+        if (s_pending[i] == entry) {
+            return;
+        }
+    }
+    if (s_pending_count >= ICON_CACHE_MAX_PENDING) {
+        return;
+    }
+    s_pending[s_pending_count++] = entry;
+    prv_place();
+    layer_mark_dirty(s_capture_layer);
+}
+
+// Moves pixels between the framebuffer at `at` and an entry's bitmap
+static bool prv_transfer(GContext* ctx, GPoint at, IconCacheEntry* entry, Transfer transfer) {
+    GBitmap* framebuffer = graphics_capture_frame_buffer(ctx);
+    if (!framebuffer) {
+        return false;
+    }
+    GSize size = prv_bitmap_size(entry);
+    uint8_t* data = gbitmap_get_data(entry->bitmap);
+    uint16_t stride = gbitmap_get_bytes_per_row(entry->bitmap);
+    uint8_t clear = prv_keyed(entry->key.argb, entry->key);
+
+    for (int16_t y = 0; y < size.h; y++) {
+        GBitmapDataRowInfo screen = gbitmap_get_data_row_info(framebuffer, at.y + y);
+        uint8_t* row = data + y * stride;
+        for (int16_t x = 0; x < size.w; x++) {
+            int16_t screen_x = at.x + x;
+            if (screen_x < screen.min_x || screen_x > screen.max_x) {
+                if (transfer != TRANSFER_SAVE) {
+                    prv_set(row, x, clear);
+                }
+                continue;
+            }
+            uint8_t value = prv_get(screen.data, screen_x);
+            if (transfer == TRANSFER_SAVE) {
+                prv_set(row, x, value);
+                continue;
+            }
+            if (transfer == TRANSFER_SWAP) {
+                prv_set(screen.data, screen_x, prv_get(row, x));
+            }
+            prv_set(row, x, prv_keyed(value, entry->key));
+        }
+    }
+    graphics_release_frame_buffer(ctx, framebuffer);
+    return true;
+}
+
+static void prv_draw_over_key(GContext* ctx, IconCacheEntry* entry, GSize area) {
+    graphics_context_set_fill_color(ctx, PBL_IF_COLOR_ELSE(entry->key, GColorWhite));
+    graphics_fill_rect(ctx, GRect(0, 0, area.w, area.h), 0, GCornerNone);
+    gdraw_command_image_draw(ctx, entry->image, GPointZero);
+}
+
+static void prv_captured(IconCacheEntry* entry) {
+    entry->ready = true;
+    s_stats.captures++;
+}
+
+// The holder's bitmap keeps what was under the layer while the others are
+// drawn over it, and takes its own icon as it gives those pixels back
+static void prv_capture(Layer* layer, GContext* ctx) {
+    IconCacheEntry* holder = prv_holder();
+    if (!holder) {
+        return;
+    }
+    // The window's root layer sits at the screen origin
+    GPoint at = layer_get_frame(layer).origin;
+    GSize area = prv_bitmap_size(holder);
+    if (!prv_transfer(ctx, at, holder, TRANSFER_SAVE)) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < s_pending_count; i++) {
+        IconCacheEntry* entry = s_pending[i];
+        GSize size = prv_bitmap_size(entry);
+        if (entry == holder || size.w > area.w || size.h > area.h) {
+            continue;
+        }
+        prv_draw_over_key(ctx, entry, area);
+        if (prv_transfer(ctx, at, entry, TRANSFER_TAKE)) {
+            prv_captured(entry);
+        }
+    }
+    prv_draw_over_key(ctx, holder, area);
+    if (prv_transfer(ctx, at, holder, TRANSFER_SWAP)) {
+        prv_captured(holder);
+    }
+    // Any that did not fit are queued again with their row
+    s_pending_count = 0;
+}
+
+void icon_cache_init(Layer* window_layer) {
+    s_window_bounds = layer_get_bounds(window_layer);
+    s_capture_layer = layer_create(GRect(0, 0, 0, 0));
+    if (!s_capture_layer) {
+        return;
+    }
+    layer_set_update_proc(s_capture_layer, prv_capture);
+    layer_add_child(window_layer, s_capture_layer);
+}
+
+void icon_cache_deinit(void) {
+    s_pending_count = 0;
+    if (s_capture_layer) {
+        layer_remove_from_parent(s_capture_layer);
+        layer_destroy(s_capture_layer);
+        s_capture_layer = NULL;
+    }
+}
+
+uint8_t icon_cache_fill_slots(IconCacheEntry entries[ICON_CACHE_SLOTS],
+                              GDrawCommandImage* const images[ICON_CACHE_SLOTS], GColor key) {
+    // Keep each bitmap that is already the right size
+    size_t used = 0;
+    for (uint8_t i = 0; i < ICON_CACHE_SLOTS; i++) {
+        IconCacheEntry* entry = &entries[i];
+        GSize size = images[i] ? gdraw_command_image_get_bounds_size(images[i]) : GSizeZero;
+        if (entry->bitmap) {
+            GSize held = prv_bitmap_size(entry);
+            if (held.w != size.w || held.h != size.h) {
+                prv_release(entry);
+            } else {
+                used += prv_bytes_for(held);
+            }
+        }
+        if (entry->image != images[i] || !gcolor_equal(entry->key, key)) {
+            entry->ready = false;
+        }
+    }
+
+    // Then fill the rest in slot order while they fit
+    uint8_t missed = 0;
+    for (uint8_t n = 0; n < ICON_CACHE_SLOTS; n++) {
+        IconCacheEntry* entry = &entries[s_slot_order[n]];
+        GDrawCommandImage* image = images[s_slot_order[n]];
+        if (!image) {
+            entry->image = NULL;
+            continue;
+        }
+        if (!entry->bitmap) {
+            GSize size = gdraw_command_image_get_bounds_size(image);
+            size_t bytes = prv_bytes_for(size);
+            if (size.w <= 0 || size.h <= 0 || used + bytes > ICON_CACHE_SET_CAP) {
+                entry->image = NULL;
+                missed++;
+                continue;
+            }
+            entry->bitmap = gbitmap_create_blank(size, ICON_CACHE_FORMAT);
+            if (!entry->bitmap) {
+                entry->image = NULL;
+                missed++;
+                continue;
+            }
+            used += bytes;
+            s_stats.bytes += bytes;
+        }
+        entry->image = image;
+        entry->key = key;
+        if (!entry->ready) {
+            prv_queue(entry);
+        }
+    }
+    return missed;
+}
+
+void icon_cache_release_slots(IconCacheEntry entries[ICON_CACHE_SLOTS]) {
+    for (uint8_t i = 0; i < ICON_CACHE_SLOTS; i++) {
+        prv_release(&entries[i]);
+    }
+}
+
+bool icon_cache_draw(GContext* ctx, const IconCacheEntry* entry, GDrawCommandImage* image, GColor key,
+                     GPoint origin) {
+    if (!image || !entry->ready || entry->image != image || !gcolor_equal(entry->key, key)) {
+        return false;
+    }
+    GSize size = prv_bitmap_size(entry);
+    graphics_context_set_compositing_mode(ctx, ICON_CACHE_COMP_OP);
+    graphics_draw_bitmap_in_rect(ctx, entry->bitmap, GRect(origin.x, origin.y, size.w, size.h));
+    graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+    s_stats.blits++;
+    return true;
+}
+
+const IconCacheStats* icon_cache_get_stats(void) {
+    return &s_stats;
+}
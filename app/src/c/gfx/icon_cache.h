@@ -0,0 +1,80 @@
+#pragma once
+
+#include <pebble.h>
+
+// Raster copies of PDC icons, drawn once and blitted after
+//
+// An entry holds one icon as a bitmap in the display's own format: 1-bit
+// on black and white platforms, 8-bit elsewhere. Capturing happens on the
+// next redraw, in a layer at the bottom of the window sized to the largest
+// icon waiting: it saves the framebuffer pixels under it, draws each icon
+// over the colour it will be shown on, reads it back with that colour made
+// transparent, and puts the saved pixels back before any other layer draws.
+// The SDK has no offscreen GContext, so the framebuffer stands in for one.
+//
+// Icons are drawn within their bounds; a stroke past them is clipped from
+// the copy.
+
+// Slots in a page's icon row: prev, current and next
+#define ICON_CACHE_SLOTS 3
+
+// Bitmap bytes one row of slots may hold. A 50px and two 25px icons come
+// to 600 at 1 bit and 3750 at 8 bits.
+#if defined(PBL_BW)
+  #define ICON_CACHE_SET_CAP 1024
+#elif defined(PBL_PLATFORM_EMERY) || defined(PBL_PLATFORM_GABBRO)
+  #define ICON_CACHE_SET_CAP 8192
+#else
+  #define ICON_CACHE_SET_CAP 4096
+#endif
+
+// Icons one redraw can capture
+#define ICON_CACHE_MAX_PENDING 6
+
+typedef struct {
+    GDrawCommandImage* image;   // What the bitmap holds; NULL for none
+    GBitmap* bitmap;
+    GColor key;                 // The colour the icon is shown on
+    bool ready;                 // Captured since image or key last changed
+} IconCacheEntry;
+
+typedef struct {
+    uint32_t captures;          // Icons captured
+    uint32_t blits;             // Icons drawn from a capture
+    size_t bytes;               // Bitmap bytes held now
+} IconCacheStats;
+
+/**
+ * Add the capture layer; call before any layer that draws over the
+ * window background
+ */
+void icon_cache_init(Layer* window_layer);
+
+/**
+ * Remove the capture layer; entries are released by their owners
+ */
+void icon_cache_deinit(void);
+
+/**
+ * Point a row of entries at a row of images shown on a key colour, and
+ * capture the ones that changed on the next redraw. A bitmap of the right
+ * size is kept; the rest are made current slot first while they fit
+ * under ICON_CACHE_SET_CAP.
+ * @return Images left without a bitmap
+ */
+uint8_t icon_cache_fill_slots(IconCacheEntry entries[ICON_CACHE_SLOTS],
+                              GDrawCommandImage* const images[ICON_CACHE_SLOTS], GColor key);
+
+/**
+ * Free a row of entries' bitmaps and forget their images
+ */
+void icon_cache_release_slots(IconCacheEntry entries[ICON_CACHE_SLOTS]);
+
+/**
+ * Blit an entry at origin, if it holds a capture of image on key
+ * @return false if the caller has to draw the image itself
+ */
+bool icon_cache_draw(GContext* ctx, const IconCacheEntry* entry, GDrawCommandImage* image, GColor key,
+                     GPoint origin);
+
+const IconCacheStats* icon_cache_get_stats(void);
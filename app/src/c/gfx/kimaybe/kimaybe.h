@@ -3,6 +3,8 @@
 //put all funny animation stuff here - it should be really easy to make PDC images do silly things
 
 #include <pebble.h>
+#include "../../utils/arena.h"
+#include "../animation/frame_clock.h"
 
 #define KM_LINEAR_SLICES 4
 #define KM_RADIAL_SLICES 8
@@ -42,6 +44,13 @@ typedef struct {
     Layer* draw_layer;
     GDrawCommandImage* draw_command_image;
     KMAnimationPoint** slices;
-    Animation** slice_animations;
+    // The slices are stepped by one frame clock client; slice i runs for
+    // slice_duration_ms from delay_ms + i * slice_delay_ms
+    FrameClockClient clock;
+    uint32_t delay_ms;
+    uint16_t slice_duration_ms;
+    uint16_t slice_delay_ms;
+    uint8_t slices_done; // bit per slice that has reached its end
     void (*finished_callback)(void);
+    Arena* arena; // where the animation and its points were allocated
 } KMAnimation;
@@ -2,6 +2,7 @@
 
 #include "kimaybe.h"
 #include "transform.h"
+#include "../animation/easing.h"
 
 // Conditional logging for transform module
 // Uncomment the line below to enable transform debug logging
@@ -18,83 +19,39 @@
 //lower to make more uniform, and higher to make it more stretchy
 #define KM_DURATION_DELAY_RATIO 0.15f
 
-// Check if a GDrawCommandImage uses precise coordinates by inspecting
-// the Type field of each draw command per the PDC format spec (type 3 = Precise path)
-static bool is_draw_command_image_precise(GDrawCommandImage* draw_command_image) {
-    GDrawCommandList* cmd_list = gdraw_command_image_get_command_list(draw_command_image);
-    size_t num_commands = gdraw_command_list_get_num_commands(cmd_list);
-    for (size_t i = 0; i < num_commands; i++) {
-        GDrawCommand* cmd = gdraw_command_list_get_command(cmd_list, i);
-        if (gdraw_command_get_type(cmd) == GDrawCommandTypePrecisePath) {
-            return true;
-        }
-    }
-    return false;
-}
+static Arena* s_arena;
 
-static void add_point_to_slice(KMAnimationPoint* point, int slice_index, KMAnimation* kmanim) {
-    if (!point || !kmanim || slice_index < 0 || slice_index >= KM_LINEAR_SLICES) {
-        return;
-    }
-    point->next = kmanim->slices[slice_index];
-    kmanim->slices[slice_index] = point;
+void km_set_arena(Arena* arena) {
+  s_arena = arena;
 }
 
-// Improved slice index lookup with better validation
-int kmanim_get_animation_slice_index(KMAnimation* kmanim, Animation* animation){
-    if (!kmanim || !animation || !kmanim->slice_animations) {
-        return -1;
-    }
-    
-    for (int i = 0; i < KM_LINEAR_SLICES; i++){
-        if (kmanim->slice_animations[i] == animation){
-            return i;
-        }
-    }
-    return -1;
+// Precise path points are 13.3 fixed point; path and circle points are whole
+// pixels. An export can mix them, so the scale is taken per command.
+static int32_t command_scale(GDrawCommand* command) {
+    return gdraw_command_get_type(command) == GDrawCommandTypePrecisePath ? 8 : 1;
 }
 
-static void implementation_setup(Animation* animation) {
-    // Get the KMAnimation context from the animation
-    KMAnimation* kmanim = (KMAnimation*)animation_get_context(animation);
-    if (kmanim == NULL) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_WARNING, "KMAnimation setup: null context for animation %p", (void*)animation);
-        return;
-    }
-    
-    // Validate that this animation actually belongs to this KMAnimation
-    int slice_index = kmanim_get_animation_slice_index(kmanim, animation);
-    if (slice_index < 0) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_WARNING, "KMAnimation setup: animation %p not found in context %p", (void*)animation, (void*)kmanim);
-        return;
-    }
-    
-    if (slice_index == 0) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_INFO, "KMAnimation %p started!", (void*)kmanim);
-    }
-}
+// Image points are scaled by from/to width over the image width, in 16.16
+#define KM_SCALE_SHIFT 16
 
-static void implementation_update(Animation* animation, const AnimationProgress progress) {
-    // Get the KMAnimation context from the animation
-    KMAnimation* kmanim = (KMAnimation*)animation_get_context(animation);
-    if (kmanim == NULL) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_WARNING, "KMAnimation update: null context for animation %p", (void*)animation);
-        return;
-    }
+static int16_t scale_coordinate(int16_t value, int32_t scale, int16_t origin) {
+    return (int16_t)(origin + (((int64_t)value * scale) >> KM_SCALE_SHIFT));
+}
 
-    // Validate that this animation actually belongs to this KMAnimation
-    int slice_index = kmanim_get_animation_slice_index(kmanim, animation);
-    if (slice_index < 0) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_WARNING, "KMAnimation update: animation %p not found in context %p", (void*)animation, (void*)kmanim);
+static void add_point_to_slice(KMAnimationPoint* point, int slice_index, KMAnimation* kmanim) {
+    if (!point || !kmanim || slice_index < 0 || slice_index >= KM_LINEAR_SLICES) {
         return;
     }
+    point->next = kmanim->slices[slice_index];
+    kmanim->slices[slice_index] = point;
+}
 
-    // Additional validation
-    if (!kmanim->slices || slice_index >= KM_LINEAR_SLICES) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_WARNING, "KMAnimation update: invalid slice_index %d for context %p", slice_index, (void*)kmanim);
-        return;
-    }
+// The SDK's default ease-in-out, which the slices ran with as Animations
+#define KM_EASE_IN_OUT(t) ((t) < 0.5 ? 2.0 * (t) * (t) : 1.0 - 2.0 * (1.0 - (t)) * (1.0 - (t)))
+static AnimationProgress km_ease_in_out_curve(AnimationProgress linear_distance);
+EASING_CURVE(km_ease_in_out_curve, KM_EASE_IN_OUT)
 
+static void update_slice(KMAnimation* kmanim, int slice_index, const AnimationProgress progress) {
     KMAnimationPoint* current_km_point = kmanim->slices[slice_index];
 
     while (current_km_point != NULL) {
@@ -106,8 +63,10 @@ static void implementation_update(Animation* animation, const AnimationProgress
         }
 
         // Calculate current point position based on progress
-        int16_t curr_x = current_km_point->start.x + ((current_km_point->end.x - current_km_point->start.x) * progress) / ANIMATION_NORMALIZED_MAX;
-        int16_t curr_y = current_km_point->start.y + ((current_km_point->end.y - current_km_point->start.y) * progress) / ANIMATION_NORMALIZED_MAX;
+        // In 64 bits: points can start or end far off screen, and delta * progress
+        // then passes 32 bits
+        int16_t curr_x = current_km_point->start.x + (int32_t)((int64_t)(current_km_point->end.x - current_km_point->start.x) * progress / ANIMATION_NORMALIZED_MAX);
+        int16_t curr_y = current_km_point->start.y + (int32_t)((int64_t)(current_km_point->end.y - current_km_point->start.y) * progress / ANIMATION_NORMALIZED_MAX);
         current_km_point->current = GPoint(curr_x, curr_y);
 
         // Safely update the draw command point
@@ -116,46 +75,54 @@ static void implementation_update(Animation* animation, const AnimationProgress
 
         //TODO: update line width 
     }
-
-    // Safely mark layer dirty
-    if (kmanim->draw_layer) {
-        layer_mark_dirty(kmanim->draw_layer);
-    }
 }
 
-static void implementation_teardown(Animation* animation) {
-    // Get the KMAnimation context from the animation
-    KMAnimation* kmanim = (KMAnimation*)animation_get_context(animation);
-    if (kmanim == NULL) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_WARNING, "KMAnimation teardown: null context for animation %p", (void*)animation);
+#define KM_ALL_SLICES_DONE ((1 << KM_LINEAR_SLICES) - 1)
+
+static void km_tick(FrameClockClient* client, uint32_t elapsed_ms) {
+    KMAnimation* kmanim = (KMAnimation*)client->context;
+    if (!kmanim->slices) {
+        frame_clock_stop(client);
         return;
     }
-    
-    // Validate that this animation actually belongs to this KMAnimation
-    int slice_index = kmanim_get_animation_slice_index(kmanim, animation);
-    if (slice_index < 0) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_WARNING, "KMAnimation teardown: animation %p not found in context %p", (void*)animation, (void*)kmanim);
-        return;
+
+    bool updated = false;
+    bool finished = false;
+    for (int i = 0; i < KM_LINEAR_SLICES; i++) {
+        uint32_t slice_start = kmanim->delay_ms + (uint32_t)kmanim->slice_delay_ms * i;
+        if (elapsed_ms < slice_start || (kmanim->slices_done & (1 << i))) {
+            continue;
+        }
+
+        uint32_t slice_ms = elapsed_ms - slice_start;
+        AnimationProgress progress = ANIMATION_NORMALIZED_MAX;
+        if (slice_ms < kmanim->slice_duration_ms) {
+            progress = km_ease_in_out_curve((AnimationProgress)(slice_ms * ANIMATION_NORMALIZED_MAX / kmanim->slice_duration_ms));
+        } else {
+            kmanim->slices_done |= 1 << i;
+            // The middle slice landing is what the caller waits for
+            finished |= (i == KM_LINEAR_SLICES / 2);
+        }
+        update_slice(kmanim, i, progress);
+        updated = true;
     }
-    
-    if (slice_index == KM_LINEAR_SLICES /2) {
+
+    if (updated) {
+        frame_clock_invalidate(kmanim->draw_layer);
+    }
+    if (kmanim->slices_done == KM_ALL_SLICES_DONE) {
+        frame_clock_stop(client);
+    }
+
+    // Last: the callback may dispose of kmanim
+    if (finished && kmanim->finished_callback != NULL) {
         TRANSFORM_LOG(APP_LOG_LEVEL_INFO, "KMAnimation %p finished!", (void*)kmanim);
-        
-        // Safely call the finished callback
-        if (kmanim->finished_callback != NULL) {
-            void (*callback)(void) = kmanim->finished_callback;
-            kmanim->finished_callback = NULL;  // Clear it first to prevent double-calls
-            callback();
-        }
+        void (*callback)(void) = kmanim->finished_callback;
+        kmanim->finished_callback = NULL;  // Clear it first to prevent double-calls
+        callback();
     }
 }
 
-static const AnimationImplementation implementation = {
-  .setup = implementation_setup,
-  .update = implementation_update,
-  .teardown = implementation_teardown
-};
-
 //get all the init info from the km animation and populate its slices
 static KMAnimationPoint** prep_slices(KMAnimation* kmanim, GRect from, GRect to, SweepDirection direction, TransformationType type){
   if (!kmanim) {
@@ -172,11 +139,8 @@ static KMAnimationPoint** prep_slices(KMAnimation* kmanim, GRect from, GRect to,
     return NULL;
   }
 
-  //use this from DCIM
-  bool precise_points = is_draw_command_image_precise(kmanim->draw_command_image);
-
   //initialize linked list of points for every slice
-  kmanim->slices = calloc(KM_LINEAR_SLICES, sizeof(KMAnimationPoint*));
+  kmanim->slices = arena_calloc(kmanim->arena, KM_LINEAR_SLICES, sizeof(KMAnimationPoint*));
   if (!kmanim->slices) {
     TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "prep_slices: failed to allocate slices for kmanim %p", (void*)kmanim);
     return NULL;
@@ -184,22 +148,6 @@ static KMAnimationPoint** prep_slices(KMAnimation* kmanim, GRect from, GRect to,
   
   GSize bounds = gdraw_command_image_get_bounds_size(kmanim->draw_command_image);
 
-  float start_scale = (float)from.size.w / (float)bounds.w;
-  float end_scale = (float)to.size.w / (float)bounds.w;
-
-  if (precise_points){
-    //shift from and to left 3 bits, to make them 13.3 fixed point
-    from.origin.x = from.origin.x << 3;
-    from.origin.y = from.origin.y << 3;
-    from.size.w = from.size.w << 3;
-    from.size.h = from.size.h << 3;
-
-    to.origin.x = to.origin.x << 3;
-    to.origin.y = to.origin.y << 3;
-    to.size.w = to.size.w << 3;
-    to.size.h = to.size.h << 3;
-  }
-
   //this might matter, maybe
   uint16_t slice_size;
   if (direction == KM_SWEEP_LEFT || direction == KM_SWEEP_RIGHT){
@@ -208,13 +156,16 @@ static KMAnimationPoint** prep_slices(KMAnimation* kmanim, GRect from, GRect to,
     slice_size = bounds.h / KM_LINEAR_SLICES;
   }
 
-  if (slice_size == 0) {
+  if (slice_size == 0 || bounds.w == 0) {
     TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "prep_slices: slice_size is 0, bounds: %dx%d", bounds.w, bounds.h);
-    free(kmanim->slices);
+    arena_free(kmanim->arena, kmanim->slices, KM_LINEAR_SLICES * sizeof(KMAnimationPoint*));
     kmanim->slices = NULL;
     return NULL;
   }
 
+  int32_t start_scale = ((int32_t)from.size.w << KM_SCALE_SHIFT) / bounds.w;
+  int32_t end_scale = ((int32_t)to.size.w << KM_SCALE_SHIFT) / bounds.w;
+
   //also pretend points are relative to origin
   //^ actually i think they are already
 
@@ -223,7 +174,7 @@ static KMAnimationPoint** prep_slices(KMAnimation* kmanim, GRect from, GRect to,
   GDrawCommandList* commands = gdraw_command_image_get_command_list(kmanim->draw_command_image);
   if (!commands) {
     TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "prep_slices: null command list for kmanim %p", (void*)kmanim);
-    free(kmanim->slices);
+    arena_free(kmanim->arena, kmanim->slices, KM_LINEAR_SLICES * sizeof(KMAnimationPoint*));
     kmanim->slices = NULL;
     return NULL;
   }
@@ -242,11 +193,16 @@ static KMAnimationPoint** prep_slices(KMAnimation* kmanim, GRect from, GRect to,
 
     uint32_t num_points = gdraw_command_get_num_points(command);
 
+    //from and to origins in this command's units
+    int32_t units = command_scale(command);
+    GPoint from_origin = GPoint(from.origin.x * units, from.origin.y * units);
+    GPoint to_origin = GPoint(to.origin.x * units, to.origin.y * units);
+
     for (uint32_t j = 0; j < num_points; j++) {
       GPoint point = gdraw_command_get_point(command, j);
 
       //now, to make a KMAnimationPoint
-      KMAnimationPoint* anim_point = malloc(sizeof(KMAnimationPoint));
+      KMAnimationPoint* anim_point = arena_alloc(kmanim->arena, sizeof(KMAnimationPoint));
       if (!anim_point) {
         TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "prep_slices: failed to allocate animation point");
         // Continue with other points rather than failing completely
@@ -255,19 +211,18 @@ static KMAnimationPoint** prep_slices(KMAnimation* kmanim, GRect from, GRect to,
 
       anim_point->draw_command = command;
       anim_point->point_index = j;
-      anim_point->start = GPoint(point.x * start_scale + from.origin.x, point.y * start_scale + from.origin.y);
-      anim_point->end = GPoint(point.x * end_scale + to.origin.x, point.y * end_scale + to.origin.y);
+      anim_point->start = GPoint(scale_coordinate(point.x, start_scale, from_origin.x),
+                                 scale_coordinate(point.y, start_scale, from_origin.y));
+      anim_point->end = GPoint(scale_coordinate(point.x, end_scale, to_origin.x),
+                               scale_coordinate(point.y, end_scale, to_origin.y));
       anim_point->current = anim_point->start;
       anim_point->next = NULL;
 
       gdraw_command_set_point(command, j, anim_point->start);
 
-      if (precise_points){
-        //shift right by 3 bits to move the point to the nearest integer
-        //so it can be indexed
-        point.x = point.x >> 3;
-        point.y = point.y >> 3;
-      }
+      //to whole pixels, so it can be indexed
+      point.x /= units;
+      point.y /= units;
 
       //divide value of interest by slice size to get slice index
       int slice_index = 0;
@@ -315,7 +270,7 @@ KMAnimation* km_make_transformation_kmanimation(Layer* layer, GDrawCommandImage*
       return NULL;
     }
 
-    KMAnimation* kmanim = malloc(sizeof(KMAnimation));
+    KMAnimation* kmanim = arena_alloc(s_arena, sizeof(KMAnimation));
     if (!kmanim) {
       TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "km_make_transformation_kmanimation: failed to allocate KMAnimation");
       return NULL;
@@ -325,53 +280,24 @@ KMAnimation* km_make_transformation_kmanimation(Layer* layer, GDrawCommandImage*
     kmanim->draw_command_image = draw_command_image;
     kmanim->slices = NULL;
     kmanim->finished_callback = NULL;
+    kmanim->arena = s_arena;
     
-    kmanim->slice_animations = malloc(sizeof(Animation*) * KM_LINEAR_SLICES);
-    if (!kmanim->slice_animations) {
-      TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "km_make_transformation_kmanimation: failed to allocate slice_animations");
-      free(kmanim);
-      return NULL;
-    }
-
-    // Initialize all pointers to NULL first
-    for (int i = 0; i < KM_LINEAR_SLICES; i++) {
-      kmanim->slice_animations[i] = NULL;
-    }
-
     // Calculate slice duration based on total duration
     int slice_duration = duration / KM_LINEAR_SLICES;
     if (slice_duration <= 0) {
       slice_duration = 1; // Minimum duration
     }
-    
-    // Calculate delay based on duration ratio
-    int slice_delay = (int)(duration * KM_DURATION_DELAY_RATIO);
+    kmanim->slice_duration_ms = slice_duration;
 
-    for (int i = 0; i < KM_LINEAR_SLICES; i++){
-      kmanim->slice_animations[i] = animation_create();
-      if (!kmanim->slice_animations[i]) {
-        TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "km_make_transformation_kmanimation: failed to create animation %d", i);
-        // Clean up previously created animations
-        for (int j = 0; j < i; j++) {
-          if (kmanim->slice_animations[j]) {
-            animation_destroy(kmanim->slice_animations[j]);
-          }
-        }
-        free(kmanim->slice_animations);
-        free(kmanim);
-        return NULL;
-      }
-
-      animation_set_implementation(kmanim->slice_animations[i], &implementation);
-      animation_set_duration(kmanim->slice_animations[i], slice_duration);
-      animation_set_delay(kmanim->slice_animations[i], slice_delay * i);
-      
-      // Set the KMAnimation as the context for this slice animation
-      animation_set_handlers(kmanim->slice_animations[i], (AnimationHandlers) {
-        .started = NULL,
-        .stopped = NULL
-      }, kmanim);
-    }
+    // Calculate delay based on duration ratio
+    kmanim->slice_delay_ms = (int)(duration * KM_DURATION_DELAY_RATIO);
+    kmanim->delay_ms = 0;
+    kmanim->slices_done = 0;
+    kmanim->clock = (FrameClockClient) {
+      .name = "kimaybe",
+      .tick = km_tick,
+      .context = kmanim,
+    };
 
     if (!prep_slices(kmanim, from, to, direction, type)) {
       TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "km_make_transformation_kmanimation: prep_slices failed");
@@ -384,29 +310,23 @@ KMAnimation* km_make_transformation_kmanimation(Layer* layer, GDrawCommandImage*
 }
 
 void km_start_kmanimation(KMAnimation* kmanim, void (*callback)(void)){
+  km_start_kmanimation_after(kmanim, 0, callback);
+}
+
+void km_start_kmanimation_after(KMAnimation* kmanim, uint32_t delay_ms, void (*callback)(void)){
 
   if (!kmanim) {
     TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "km_start_kmanimation: null kmanim");
     return;
   }
 
-  if (!kmanim->slice_animations) {
-    TRANSFORM_LOG(APP_LOG_LEVEL_ERROR, "km_start_kmanimation: null slice_animations in kmanim %p", (void*)kmanim);
-    return;
-  }
-
   // Store the callback
   kmanim->finished_callback = callback;
-  
-  TRANSFORM_LOG(APP_LOG_LEVEL_DEBUG, "Starting KMAnimation %p with %d slice animations", (void*)kmanim, KM_LINEAR_SLICES);
-  
-  for (int i = 0; i < KM_LINEAR_SLICES; i++){
-    if (kmanim->slice_animations[i]) {
-      animation_schedule(kmanim->slice_animations[i]);
-    } else {
-      TRANSFORM_LOG(APP_LOG_LEVEL_WARNING, "km_start_kmanimation: null slice animation at index %d", i);
-    }
-  }
+  kmanim->delay_ms = delay_ms;
+  kmanim->slices_done = 0;
+
+  TRANSFORM_LOG(APP_LOG_LEVEL_DEBUG, "Starting KMAnimation %p with %d slices", (void*)kmanim, KM_LINEAR_SLICES);
+  frame_clock_start(&kmanim->clock);
 }
 
 void km_dispose_kmanimation(KMAnimation* kmanim){
@@ -420,6 +340,7 @@ void km_dispose_kmanimation(KMAnimation* kmanim){
 
   // Clear the callback to prevent it from being called during cleanup
   kmanim->finished_callback = NULL;
+  frame_clock_stop(&kmanim->clock);
 
   //free slices and their points
   if (kmanim->slices) {
@@ -427,34 +348,16 @@ void km_dispose_kmanimation(KMAnimation* kmanim){
       KMAnimationPoint* current_point = kmanim->slices[i];
       while (current_point != NULL){
         KMAnimationPoint* next_point = current_point->next;
-        free(current_point);
+        arena_free(kmanim->arena, current_point, sizeof(KMAnimationPoint));
         current_point = next_point;
       }
     }
 
     //free slices
-    free(kmanim->slices);
+    arena_free(kmanim->arena, kmanim->slices, KM_LINEAR_SLICES * sizeof(KMAnimationPoint*));
     kmanim->slices = NULL;
   }
 
-  //free animations - need to be careful here as they might still be running or nonexistent
-  //something about this makes app mad
-  if (kmanim->slice_animations) {
-    for (int i = 0; i < KM_LINEAR_SLICES; i++){
-      if (kmanim->slice_animations[i]) {
-        // Unschedule the animation before destroying it
-        TRANSFORM_LOG(APP_LOG_LEVEL_DEBUG, "Unscheduling animation %d", i);
-        if(animation_is_scheduled(kmanim->slice_animations[i])){
-          animation_unschedule(kmanim->slice_animations[i]);
-          animation_destroy(kmanim->slice_animations[i]);
-        }
-        kmanim->slice_animations[i] = NULL;
-      }
-    }
-    free(kmanim->slice_animations);
-    kmanim->slice_animations = NULL;
-  }
-
   //free animation
-  free(kmanim);
+  arena_free(kmanim->arena, kmanim, sizeof(KMAnimation));
 }
@@ -6,4 +6,11 @@ KMAnimation* km_make_transformation_kmanimation(Layer* layer, GDrawCommandImage*
 
 void km_start_kmanimation(KMAnimation* kmanim, void (*callback)(void));
 
+// As km_start_kmanimation, with every slice held back a further delay_ms
+void km_start_kmanimation_after(KMAnimation* kmanim, uint32_t delay_ms, void (*callback)(void));
+
 void km_dispose_kmanimation(KMAnimation* kmanim);
+
+// Animations made after this allocate from `arena` (NULL for the heap); each
+// is disposed into the arena it came from
+void km_set_arena(Arena* arena);
@@ -0,0 +1,48 @@
+#include "page_snapshot.h"
+#include "animation/animation.h"
+
+static PageSnapshotStats s_stats;
+
+static IconCacheEntry s_slots[ICON_CACHE_SLOTS];
+static uint8_t s_hour;
+static uint8_t s_page;
+static bool s_valid;            // The slots belong to s_hour and s_page
+
+void page_snapshot_deinit(void) {
+    page_snapshot_clear();
+}
+
+void page_snapshot_request(uint8_t hour, uint8_t page, GDrawCommandImage* const images[ICON_CACHE_SLOTS],
+                           GColor key) {
+    ANIMATION_PROFILE_SCOPE("page_snapshot");
+    bool same_page = s_valid && s_hour == hour && s_page == page;
+    uint8_t missed = icon_cache_fill_slots(s_slots, images, key);
+    if (!same_page) {
+        s_stats.fallbacks += missed;
+    }
+    s_hour = hour;
+    s_page = page;
+    s_valid = true;
+}
+
+bool page_snapshot_draw(GContext* ctx, uint8_t hour, uint8_t page, uint8_t slot,
+                        GDrawCommandImage* image, GPoint origin) {
+    if (slot >= ICON_CACHE_SLOTS || !s_valid || hour != s_hour || page != s_page) {
+        return false;
+    }
+    const IconCacheEntry* entry = &s_slots[slot];
+    if (!icon_cache_draw(ctx, entry, image, entry->key, origin)) {
+        return false;
+    }
+    s_stats.blits++;
+    return true;
+}
+
+void page_snapshot_clear(void) {
+    icon_cache_release_slots(s_slots);
+    s_valid = false;
+}
+
+const PageSnapshotStats* page_snapshot_get_stats(void) {
+    return &s_stats;
+}
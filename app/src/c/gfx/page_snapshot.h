@@ -0,0 +1,44 @@
+#pragma once
+
+#include <pebble.h>
+#include "icon_cache.h"
+
+// Offscreen snapshots of a page's icons, for instant page switches
+//
+// While the viewer is idle it asks for the page that select will switch to
+// next, and the icon cache captures that page's icons over the page's
+// background colour on the following redraw. The page switch then blits
+// them while the images slide in, and hands back to the vector icons once
+// it has settled. Any icon past the cache's cap stays live.
+
+typedef struct {
+    uint32_t blits;         // Icons drawn from a snapshot
+    uint32_t fallbacks;     // Icons that would not fit under the cap
+} PageSnapshotStats;
+
+/**
+ * Free the snapshots; for window unload
+ */
+void page_snapshot_deinit(void);
+
+/**
+ * Snapshot a page's slot images on the next redraw
+ * @param images The images the page will show in its prev, current and next slots
+ * @param key The page's background colour
+ */
+void page_snapshot_request(uint8_t hour, uint8_t page, GDrawCommandImage* const images[ICON_CACHE_SLOTS],
+                           GColor key);
+
+/**
+ * Draw a slot from the snapshot of (hour, page), if there is one for that image
+ * @return false if the caller has to draw the image itself
+ */
+bool page_snapshot_draw(GContext* ctx, uint8_t hour, uint8_t page, uint8_t slot,
+                        GDrawCommandImage* image, GPoint origin);
+
+/**
+ * Forget every snapshot; for when the images they were taken from change
+ */
+void page_snapshot_clear(void);
+
+const PageSnapshotStats* page_snapshot_get_stats(void);
@@ -1,7 +1,7 @@
 #include "airflow.h"
 #include "../layout.h"
 #include "../resources.h"
-#include "../../utils/weather.h"
+#include "../../utils/forecast.h"
 
 #define HIGH_WIND_SPEED 75
 #define ANEMOMETER_TIMEOUT_MS (60 * 1000)  // 1 minute in milliseconds
@@ -34,26 +34,18 @@ static GDrawCommandImage** current_image_ref;
 static GDrawCommandImage** next_image_ref;
 
 // Wind vane and wind speed configuration
-static GDrawCommandImage** wind_vane_images;      // Array of 8 directional wind vanes
-static GDrawCommandImage** wind_speed_images;     // Array of 24 wind speed images (3 speeds × 8 directions)
+static GDrawCommandImage** wind_vane_images;      // One wind vane per direction
+static GDrawCommandImage** wind_speed_images;     // Wind speed icons by speed level, then direction
 
 static void frame_update(void* data);
 static void update_icons(void);
 
-// Helper function to get wind speed image index from resource ID
-static int get_wind_speed_image_index(uint32_t resource_id) {
-    if (resource_id == 0) return -1;
-    
-    // Calculate index from resource ID
-    if (resource_id >= RESOURCE_ID_WIND_SPEED_SLOW_N && resource_id <= RESOURCE_ID_WIND_SPEED_SLOW_NW) {
-        return resource_id - RESOURCE_ID_WIND_SPEED_SLOW_N;
-    } else if (resource_id >= RESOURCE_ID_WIND_SPEED_MED_N && resource_id <= RESOURCE_ID_WIND_SPEED_MED_NW) {
-        return 8 + (resource_id - RESOURCE_ID_WIND_SPEED_MED_N);
-    } else if (resource_id >= RESOURCE_ID_WIND_SPEED_FAST_N && resource_id <= RESOURCE_ID_WIND_SPEED_FAST_NW) {
-        return 16 + (resource_id - RESOURCE_ID_WIND_SPEED_FAST_N);
-    }
-    
-    return -1;
+// Wind speed icon for an hour, or NULL when it has no wind direction
+static GDrawCommandImage* wind_speed_image(int hour) {
+    uint8_t slot = forecast_slot(hour);
+    int8_t dir = hour_wind_direction(forecast_data, slot);
+    if (dir < 0) return NULL;
+    return wind_speed_images[hour_wind_speed_level(forecast_data, slot) * WIND_DIRECTIONS + dir];
 }
 
 // Timeout functions for if view doesn't change for a while
@@ -61,6 +53,26 @@ static int get_wind_speed_image_index(uint32_t resource_id) {
 static void timeout_callback(void* data);
 static void reset_timeout(void);
 
+void airflow_get_images(int hour, GDrawCommandImage** prev, GDrawCommandImage** current, GDrawCommandImage** next) {
+    // Previous hour wind-speed icon, if any.
+    if (hour > 0 && forecast_has_hour(hour - 1)) {
+        *prev = wind_speed_image(hour - 1);
+    } else {
+        *prev = NULL;
+    }
+
+    // Current image is the wind vane for this hour's direction.
+    int8_t vane_dir = hour_wind_direction(forecast_data, forecast_slot(hour));
+    *current = (vane_dir >= 0) ? wind_vane_images[vane_dir] : NULL;
+
+    // Next hour wind-speed icon, if any.
+    if (forecast_has_hour(hour + 1)) {
+        *next = wind_speed_image(hour + 1);
+    } else {
+        *next = NULL;
+    }
+}
+
 void set_airflow_view(int hour) {
     is_active = (hour >= 0);
     selected_hour = hour;
@@ -70,27 +82,7 @@ void set_airflow_view(int hour) {
     // Update image references (viewer pre-clears slots on page switch; we only
     // need to populate them when active).
     if (is_active) {
-        // Previous hour wind-speed icon, if any.
-        if (hour > 0) {
-            uint32_t prev_resource_id = forecast_hours[hour-1].wind_speed_resource_id;
-            int prev_index = get_wind_speed_image_index(prev_resource_id);
-            *prev_image_ref = (prev_index >= 0) ? wind_speed_images[prev_index] : NULL;
-        } else {
-            *prev_image_ref = NULL;
-        }
-
-        // Current image is the wind vane for this hour's direction.
-        int8_t vane_dir = forecast_hours[hour].wind_direction;
-        *current_image_ref = (vane_dir >= 0 && vane_dir < 8) ? wind_vane_images[vane_dir] : NULL;
-
-        // Next hour wind-speed icon, if any.
-        if (hour < 11) {
-            uint32_t next_resource_id = forecast_hours[hour+1].wind_speed_resource_id;
-            int next_index = get_wind_speed_image_index(next_resource_id);
-            *next_image_ref = (next_index >= 0) ? wind_speed_images[next_index] : NULL;
-        } else {
-            *next_image_ref = NULL;
-        }
+        airflow_get_images(hour, prev_image_ref, current_image_ref, next_image_ref);
     }
 
     if (is_active && !frame_timer) {
@@ -114,7 +106,7 @@ static void update_icons(void) {
     }
 
     // Calculate proportional anemometer speed, but clamp to min/max.
-    int wind_speed = forecast_hours[selected_hour].wind_speed;
+    int wind_speed = hour_wind_speed(forecast_data, forecast_slot(selected_hour));
     int range = ANEMOMETER_SPEED_MAX - ANEMOMETER_SPEED_MIN;
     int speed = (wind_speed * range) / HIGH_WIND_SPEED + ANEMOMETER_SPEED_MIN;
     if (speed > ANEMOMETER_SPEED_MAX) speed = ANEMOMETER_SPEED_MAX;
@@ -191,6 +183,16 @@ Layer* init_airflow_layers(Layer* window_layer, GDrawCommandImage** prev_image,
     return airflow_layer;
 }
 
+void update_airflow_images(void) {
+    update_wind_vane_images(wind_vane_images);
+    update_wind_speed_images(wind_speed_images);
+}
+
+void trim_airflow_images(void) {
+    trim_wind_vane_images(wind_vane_images);
+    trim_wind_speed_images(wind_speed_images);
+}
+
 void deinit_airflow_layers(void) {
     // Clean up wind vane images
     if (wind_vane_images) {
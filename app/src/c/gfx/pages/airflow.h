@@ -4,15 +4,32 @@
 
 Layer* init_airflow_layers(Layer* window_layer, GDrawCommandImage** prev_image, GDrawCommandImage** current_image, GDrawCommandImage** next_image);
 void deinit_airflow_layers(void);
+
+// Loads wind icons used by newly arrived forecast hours
+void update_airflow_images(void);
+
+// Frees wind icons no loaded hour uses any more, e.g. after its block was
+// evicted or the wind vane setting turned every direction around. The
+// caller makes sure nothing still points at them.
+void trim_airflow_images(void);
+
 void draw_airflow(Layer* layer, GContext* ctx);
 
 /**
  * @brief Activates/deactivates the airflow page and binds it to a forecast hour.
  *
- * @param hour Hour index (0-11) to display, or a negative value to disable the view.
+ * @param hour Forecast hour index to display, or a negative value to disable the view.
  */
 void set_airflow_view(int hour);
 
+/**
+ * @brief Looks up the images the airflow page shows for an hour, without
+ *        activating it; set_airflow_view() fills the viewer's slots the same way.
+ *
+ * @param hour Forecast hour index
+ */
+void airflow_get_images(int hour, GDrawCommandImage** prev, GDrawCommandImage** current, GDrawCommandImage** next);
+
 /**
  * @brief Resets the anemometer timeout timer.
  *
@@ -2,7 +2,7 @@
 #include "../layout.h"
 #include "../resources.h"
 #include "../animation/precip_animation.h"
-#include "../../utils/weather.h"
+#include "../../utils/forecast.h"
 
 static Layer* conditions_layer;
 static bool is_active = false;
@@ -33,40 +33,52 @@ static GPath* precipitation_graph;
 static const int GRIDLINE_COUNT = 3;
 
 // The precipitation graph
-// 13 points for 0-60 minutes, in 5 minute intervals
+// GRAPH_DATA_POINTS points for 0-60 minutes, one every 2 minutes
 // +2 bottom points to make it a closed path
-// sized by layout.h
+// X positions are spread over the layout.h width at init
+#define GRAPH_DATA_POINTS 31
+static GPoint precipitation_graph_points[GRAPH_DATA_POINTS + 2];
 static GPathInfo precipitation_graph_info = {
-  .num_points = 15,
-  .points = (GPoint[]){
-    {1, 0},
-    {7, 0},
-    {14, 0},
-    {21, 0},
-    {28, 0},
-    {35, 0},
-    {42, 0},
-    {49, 0},
-    {56, 0},
-    {63, 0},
-    {70, 0},
-    {77, 0},
-    {83, 0},
-    {83, 0},
-    {1, 0},
-  }
+  .num_points = GRAPH_DATA_POINTS + 2,
+  .points = precipitation_graph_points,
 };
 
-// Bake the 13 data-point Y coordinates from current precipitation data.
-// Sets graph_points_dirty to false; the two closing-path points are also set.
+// Graph point each forecast minute is drawn at, built once at init
+static uint8_t minute_to_point[PRECIPITATION_MINUTES];
+
+static void init_graph_points(void) {
+    const int last = GRAPH_DATA_POINTS - 1;
+    for (int i = 0; i < GRAPH_DATA_POINTS; i++) {
+        precipitation_graph_points[i].x = 1 + (i * (LAYOUT_PRECIP_W - 2) + last / 2) / last;
+    }
+    precipitation_graph_points[GRAPH_DATA_POINTS].x = precipitation_graph_points[last].x;
+    precipitation_graph_points[GRAPH_DATA_POINTS + 1].x = 1;
+
+    // Each minute goes to its nearest point
+    for (int minute = 0; minute < PRECIPITATION_MINUTES; minute++) {
+        minute_to_point[minute] = (minute * last + PRECIPITATION_MINUTES / 2) / PRECIPITATION_MINUTES;
+    }
+}
+
+// Bake the data-point Y coordinates from current precipitation data, each
+// point taking the wettest of its minutes. Sets graph_points_dirty to false;
+// the two closing-path points are also set.
 static void bake_graph_points(void) {
-    const int step = LAYOUT_PRECIP_H / 4;
-    for (int i = 0; i < 13; i++) {
-        precipitation_graph_info.points[i].y =
-            LAYOUT_PRECIP_H - (precipitation.precipitation_intensity[i] * step);
+    uint8_t steps[GRAPH_DATA_POINTS] = {0};
+    for (int minute = 0; minute < PRECIPITATION_MINUTES; minute++) {
+        uint8_t* point = &steps[minute_to_point[minute]];
+        if (precipitation.minute_steps[minute] > *point) {
+            *point = precipitation.minute_steps[minute];
+        }
     }
-    precipitation_graph_info.points[13].y = LAYOUT_PRECIP_H;
-    precipitation_graph_info.points[14].y = LAYOUT_PRECIP_H;
+
+    // A full level is a quarter of the graph, as the gridlines show
+    const int full_scale = 4 * PRECIPITATION_LEVEL_STEPS;
+    for (int i = 0; i < GRAPH_DATA_POINTS; i++) {
+        precipitation_graph_info.points[i].y = LAYOUT_PRECIP_H - (steps[i] * LAYOUT_PRECIP_H / full_scale);
+    }
+    precipitation_graph_info.points[GRAPH_DATA_POINTS].y = LAYOUT_PRECIP_H;
+    precipitation_graph_info.points[GRAPH_DATA_POINTS + 1].y = LAYOUT_PRECIP_H;
     graph_points_dirty = false;
 }
 
@@ -77,10 +89,10 @@ static void graph_draw_timer_callback(void* context) {
 
     bake_graph_points();
 
-#ifndef PBL_PLATFORM_APLITE
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
     if (conditions_layer) {
         precip_animation_start(conditions_layer, &precipitation_graph_info,
-                               13, LAYOUT_PRECIP_H);
+                               GRAPH_DATA_POINTS, LAYOUT_PRECIP_H);
     }
 #endif
 
@@ -89,6 +101,35 @@ static void graph_draw_timer_callback(void* context) {
     }
 }
 
+void conditions_get_images(int hour, GDrawCommandImage** prev, GDrawCommandImage** current, GDrawCommandImage** next) {
+    // Previous hour condition icon. For hour 1 following a precipitation
+    // hour 0, show the small axis image instead of a weather icon.
+    if (hour > 0 && forecast_has_hour(hour - 1)) {
+        if (hour == 1 && precipitation.precipitation_type > 0) {
+            *prev = axis_small_image;
+        } else {
+            *prev = condition_images_25px[hour_conditions_icon(forecast_data, forecast_slot(hour - 1))];
+        }
+    } else {
+        *prev = NULL;
+    }
+
+    // Current hour condition icon. On hour 0 with precipitation we show the
+    // large axis beneath the graph instead of a weather icon.
+    if (hour == 0 && precipitation.precipitation_type > 0) {
+        *current = axis_large_image;
+    } else {
+        *current = condition_images_50px[hour_conditions_icon(forecast_data, forecast_slot(hour))];
+    }
+
+    // Next hour condition icon.
+    if (forecast_has_hour(hour + 1)) {
+        *next = condition_images_25px[hour_conditions_icon(forecast_data, forecast_slot(hour + 1))];
+    } else {
+        *next = NULL;
+    }
+}
+
 void set_conditions_view(int hour) {
     is_active = (hour >= 0);
     selected_hour = hour;
@@ -99,7 +140,7 @@ void set_conditions_view(int hour) {
     }
     show_graph = false;
 
-#ifndef PBL_PLATFORM_APLITE
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
     precip_animation_stop();
 #endif
 
@@ -109,32 +150,7 @@ void set_conditions_view(int hour) {
     graph_points_dirty = true;
 
     if (is_active) {
-        // Previous hour condition icon. For hour 1 following a precipitation
-        // hour 0, show the small axis image instead of a weather icon.
-        if (hour > 0) {
-            if (hour == 1 && precipitation.precipitation_type > 0) {
-                *prev_image_ref = axis_small_image;
-            } else {
-                *prev_image_ref = condition_images_25px[forecast_hours[hour-1].conditions_icon];
-            }
-        } else {
-            *prev_image_ref = NULL;
-        }
-
-        // Current hour condition icon. On hour 0 with precipitation we show the
-        // large axis beneath the graph instead of a weather icon.
-        if (hour == 0 && precipitation.precipitation_type > 0) {
-            *current_image_ref = axis_large_image;
-        } else {
-            *current_image_ref = condition_images_50px[forecast_hours[hour].conditions_icon];
-        }
-
-        // Next hour condition icon.
-        if (hour < 11) {
-            *next_image_ref = condition_images_25px[forecast_hours[hour+1].conditions_icon];
-        } else {
-            *next_image_ref = NULL;
-        }
+        conditions_get_images(hour, prev_image_ref, current_image_ref, next_image_ref);
 
         if (hour == 0 && precipitation.precipitation_type > 0) {
             graph_draw_timer = app_timer_register(300, graph_draw_timer_callback, NULL);
@@ -154,6 +170,11 @@ GDrawCommandImage* conditions_get_axis_large_image(void) {
     return axis_large_image;
 }
 
+void update_conditions_images(void) {
+    update_25px_condition_images(condition_images_25px);
+    update_50px_condition_images(condition_images_50px);
+}
+
 Layer* init_conditions_layers(Layer* window_layer, GDrawCommandImage** prev_image, GDrawCommandImage** current_image, GDrawCommandImage** next_image) {
     conditions_layer = layer_create(layer_get_bounds(window_layer));
     layer_set_update_proc(conditions_layer, draw_conditions);
@@ -173,6 +194,7 @@ Layer* init_conditions_layers(Layer* window_layer, GDrawCommandImage** prev_imag
     axis_large_image = init_axis_large_image();
 
     // Initialize precipitation graph
+    init_graph_points();
     precipitation_graph = gpath_create(&precipitation_graph_info);
     precipitation_graph->offset = LAYOUT_PRECIP_POS;
 
@@ -204,12 +226,12 @@ void draw_conditions(Layer* layer, GContext* ctx) {
     const int x0 = LAYOUT_PRECIP_X;
     const int x1 = x0 + LAYOUT_PRECIP_W;
     const int bottom_y = LAYOUT_PRECIP_Y + LAYOUT_PRECIP_H;
-#ifndef PBL_PLATFORM_APLITE
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
     AnimationProgress anim_progress = precip_animation_get_progress();
 #endif
     for (int i = 1; i <= GRIDLINE_COUNT; i++) {
         int target_y = LAYOUT_PRECIP_Y + (i * step);
-#ifndef PBL_PLATFORM_APLITE
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
         int y = bottom_y + (int)((int32_t)(target_y - bottom_y) * anim_progress / ANIMATION_NORMALIZED_MAX);
 #else
         int y = target_y;
@@ -232,7 +254,7 @@ void deinit_conditions_layers(void) {
         graph_draw_timer = NULL;
     }
 
-#ifndef PBL_PLATFORM_APLITE
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
     precip_animation_deinit();
 #endif
     
@@ -8,15 +8,28 @@ void draw_conditions(Layer* layer, GContext* ctx);
 /**
  * @brief Sets the conditions view for the specified hour
  *
- * @param hour Hour index (0-11) to display, or a negative value to disable the view.
+ * @param hour Forecast hour index to display, or a negative value to disable the view.
  */
 void set_conditions_view(int hour);
 
+/**
+ * @brief Looks up the images the conditions page shows for an hour, without
+ *        activating it; set_conditions_view() fills the viewer's slots the same way.
+ *
+ * @param hour Forecast hour index
+ */
+void conditions_get_images(int hour, GDrawCommandImage** prev, GDrawCommandImage** current, GDrawCommandImage** next);
+
 /**
  * @brief Deinitializes the conditions layers and frees resources.
  */
 void deinit_conditions_layers(void);
 
+/**
+ * @brief Loads condition icons used by newly arrived forecast hours.
+ */
+void update_conditions_images(void);
+
 /**
  * @brief Accessors for the axis images used in the precipitation view.
  *
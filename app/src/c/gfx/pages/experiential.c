@@ -1,7 +1,7 @@
 #include "experiential.h"
 #include "../layout.h"
 #include "../resources.h"
-#include "../../utils/weather.h"
+#include "../../utils/forecast.h"
 
 static Layer* experiential_layer;
 static bool is_active = false;
@@ -20,38 +20,42 @@ static GDrawCommandImage* emoji_image;
 
 static void update_icons();
 
-void set_experiential_view(int hour) {
-    is_active = (hour >= 0);
-    selected_hour = hour;
-
-    if (!is_active) {
-        return;
-    }
-
-    update_icons();
-
-    uint8_t current_experiential_icon = forecast_hours[hour].experiential_icon;
+void experiential_get_images(int hour, GDrawCommandImage** prev, GDrawCommandImage** current, GDrawCommandImage** next) {
+    uint8_t current_experiential_icon = hour_experiential_icon(forecast_data, forecast_slot(hour));
 
     // Previous hour experiential icon.
-    if (hour > 0) {
-        uint8_t prev = forecast_hours[hour - 1].experiential_icon;
-        *prev_image_ref = (prev == 0) ? NULL : experiential_images_25px[prev - 1];
+    if (hour > 0 && forecast_has_hour(hour - 1)) {
+        uint8_t prev_icon = hour_experiential_icon(forecast_data, forecast_slot(hour - 1));
+        *prev = (prev_icon == 0) ? NULL : experiential_images_25px[prev_icon - 1];
     } else {
-        *prev_image_ref = NULL;
+        *prev = NULL;
     }
 
     // Current hour experiential icon.
-    *current_image_ref = (current_experiential_icon == 0)
+    *current = (current_experiential_icon == 0)
         ? NULL
         : experiential_images_50px[current_experiential_icon - 1];
 
     // Next hour experiential icon.
-    if (hour < 11) {
-        uint8_t next = forecast_hours[hour + 1].experiential_icon;
-        *next_image_ref = (next == 0) ? NULL : experiential_images_25px[next - 1];
+    if (forecast_has_hour(hour + 1)) {
+        uint8_t next_icon = hour_experiential_icon(forecast_data, forecast_slot(hour + 1));
+        *next = (next_icon == 0) ? NULL : experiential_images_25px[next_icon - 1];
     } else {
-        *next_image_ref = NULL;
+        *next = NULL;
+    }
+}
+
+void set_experiential_view(int hour) {
+    is_active = (hour >= 0);
+    selected_hour = hour;
+
+    if (!is_active) {
+        return;
     }
+
+    update_icons();
+
+    experiential_get_images(hour, prev_image_ref, current_image_ref, next_image_ref);
 }
 
 GDrawCommandImage* get_experiential_emoji(void) {
@@ -67,6 +71,11 @@ void update_icons() {
     }
 }
 
+void update_experiential_images(void) {
+    update_25px_experiential_images(experiential_images_25px);
+    update_50px_experiential_images(experiential_images_50px);
+}
+
 Layer* init_experiential_layers(Layer* window_layer, GDrawCommandImage** prev_image, GDrawCommandImage** current_image, GDrawCommandImage** next_image) {
     experiential_layer = layer_create(layer_get_bounds(window_layer));
     layer_set_update_proc(experiential_layer, draw_experiential);
@@ -6,15 +6,27 @@
 
 Layer* init_experiential_layers(Layer* window_layer, GDrawCommandImage** prev_image, GDrawCommandImage** current_image, GDrawCommandImage** next_image);
 void deinit_experiential_layers(void);
+
+// Loads experiential icons used by newly arrived forecast hours
+void update_experiential_images(void);
+
 void draw_experiential(Layer* layer, GContext* ctx);
 
 /**
  * @brief Sets the experiential view for the specified hour
  * 
- * @param hour Hour index (0-11) to display, or-1o disable the view
+ * @param hour Forecast hour index to display, or-1o disable the view
  */
 void set_experiential_view(int hour);
 
+/**
+ * @brief Looks up the images the experiential page shows for an hour, without
+ *        activating it; set_experiential_view() fills the viewer's slots the same way.
+ *
+ * @param hour Forecast hour index
+ */
+void experiential_get_images(int hour, GDrawCommandImage** prev, GDrawCommandImage** current, GDrawCommandImage** next);
+
 /**
  * @brief Gets the emoji image for the current experiential view
  * 
@@ -1,9 +1,10 @@
 #include <pebble.h>
 #include "resources.h"
-#include "../utils/weather.h"
+#include "rotated_pdc.h"
+#include "../utils/forecast.h"
 
 // Number of experiential resources
-#define NUM_EXPERIENTIAL_RESOURCES 7
+#define NUM_EXPERIENTIAL_RESOURCES NUM_EXPERIENTIAL_ICONS
 
 // Color functions for conditions, airflow, and experiential states
 
@@ -124,29 +125,52 @@ static void decide_moon(void) {
     }
 }
 
-GDrawCommandImage** init_25px_condition_images() {
-    decide_moon();
-    
-    GDrawCommandImage** images = malloc(sizeof(GDrawCommandImage*) * NUM_WEATHER_CONDITIONS);
+// Each init_*_images() allocates an array with a slot per icon and loads the
+// icons the loaded forecast hours use; update_*_images() loads any icon that
+// newly arrived hours need, leaving the ones already loaded in place (pages
+// may be pointing at them). The wind rotations, up to 64 of them, are also
+// freed by trim_wind_*_images() once no loaded hour uses them.
+
+// Scan the forecast to find which condition icons are actually used
+static void scan_used_conditions(bool used[NUM_WEATHER_CONDITIONS]) {
+    for (int slot = 0; slot < FORECAST_RING_HOURS; ++slot) {
+        if (forecast_slot_loaded(slot)) {
+            used[hour_conditions_icon(forecast_data, slot)] = true;
+        }
+    }
+}
+
+static Arena* s_arena;
+
+void resources_set_arena(Arena* arena) {
+    s_arena = arena;
+}
+
+static GDrawCommandImage** alloc_images(int count) {
+    GDrawCommandImage** images = arena_alloc(s_arena, sizeof(GDrawCommandImage*) * count);
     if (!images) return NULL;
-    
+
     // Initialize all entries to NULL
-    for (int i = 0; i < NUM_WEATHER_CONDITIONS; ++i) {
+    for (int i = 0; i < count; ++i) {
         images[i] = NULL;
     }
-    
-    // Scan forecast_hours to find which condition icons are actually used
+    return images;
+}
+
+static void free_images(GDrawCommandImage** images, int count) {
+    arena_free(s_arena, images, sizeof(GDrawCommandImage*) * count);
+}
+
+void update_25px_condition_images(GDrawCommandImage** images) {
+    if (!images) return;
+    decide_moon();
+
     bool used[NUM_WEATHER_CONDITIONS] = {false};
-    for (int hour = 0; hour < 12; ++hour) {
-        uint8_t icon = forecast_hours[hour].conditions_icon;
-        if (icon < NUM_WEATHER_CONDITIONS) {
-            used[icon] = true;
-        }
-    }
-    
+    scan_used_conditions(used);
+
     // Only load images for IDs that are actually used
     for (int i = 0; i < NUM_WEATHER_CONDITIONS; ++i) {
-        if (used[i]) {
+        if (used[i] && !images[i]) {
             uint32_t resource_id = CONDITION_RESOURCE_IDS_25PX[i];
             if (i == 11 && use_sleepy_moon) {  // CLEAR NIGHT condition
                 resource_id = RESOURCE_ID_SLEEPY_MOON_25PX;
@@ -154,32 +178,18 @@ GDrawCommandImage** init_25px_condition_images() {
             images[i] = gdraw_command_image_create_with_resource(resource_id);
         }
     }
-    return images;
 }
 
-GDrawCommandImage** init_50px_condition_images() {
+void update_50px_condition_images(GDrawCommandImage** images) {
+    if (!images) return;
     decide_moon();
-    
-    GDrawCommandImage** images = malloc(sizeof(GDrawCommandImage*) * NUM_WEATHER_CONDITIONS);
-    if (!images) return NULL;
-    
-    // Initialize all entries to NULL
-    for (int i = 0; i < NUM_WEATHER_CONDITIONS; ++i) {
-        images[i] = NULL;
-    }
-    
-    // Scan forecast_hours to find which condition icons are actually used
+
     bool used[NUM_WEATHER_CONDITIONS] = {false};
-    for (int hour = 0; hour < 12; ++hour) {
-        uint8_t icon = forecast_hours[hour].conditions_icon;
-        if (icon < NUM_WEATHER_CONDITIONS) {
-            used[icon] = true;
-        }
-    }
-    
+    scan_used_conditions(used);
+
     // Only load images for IDs that are actually used
     for (int i = 0; i < NUM_WEATHER_CONDITIONS; ++i) {
-        if (used[i]) {
+        if (used[i] && !images[i]) {
             uint32_t resource_id = CONDITION_RESOURCE_IDS_50PX[i];
             if (i == 11 && use_sleepy_moon) {  // CLEAR NIGHT condition
                 resource_id = RESOURCE_ID_SLEEPY_MOON_50PX;
@@ -187,6 +197,17 @@ GDrawCommandImage** init_50px_condition_images() {
             images[i] = gdraw_command_image_create_with_resource(resource_id);
         }
     }
+}
+
+GDrawCommandImage** init_25px_condition_images() {
+    GDrawCommandImage** images = alloc_images(NUM_WEATHER_CONDITIONS);
+    update_25px_condition_images(images);
+    return images;
+}
+
+GDrawCommandImage** init_50px_condition_images() {
+    GDrawCommandImage** images = alloc_images(NUM_WEATHER_CONDITIONS);
+    update_50px_condition_images(images);
     return images;
 }
 
@@ -197,7 +218,7 @@ void deinit_25px_condition_images(GDrawCommandImage** condition_images_25px) {
             gdraw_command_image_destroy(condition_images_25px[i]);
         }
     }
-    free(condition_images_25px);
+    free_images(condition_images_25px, NUM_WEATHER_CONDITIONS);
 }
 
 void deinit_50px_condition_images(GDrawCommandImage** condition_images_50px) {
@@ -207,7 +228,7 @@ void deinit_50px_condition_images(GDrawCommandImage** condition_images_50px) {
             gdraw_command_image_destroy(condition_images_50px[i]);
         }
     }
-    free(condition_images_50px);
+    free_images(condition_images_50px, NUM_WEATHER_CONDITIONS);
 }
 
 // Axis image functions
@@ -226,175 +247,182 @@ void deinit_axis_image(GDrawCommandImage* axis_image) {
 }
 
 // Airflow image functions
-GDrawCommandImage** init_wind_vane_images() {
-    // Allocate array for 8 directional wind vanes (N, NE, E, SE, S, SW, W, NW)
-    GDrawCommandImage** images = malloc(sizeof(GDrawCommandImage*) * 8);
-    if (!images) return NULL;
-    
-    // Initialize all entries to NULL
-    for (int i = 0; i < 8; ++i) {
-        images[i] = NULL;
-    }
-    
-    // Scan forecast_hours to find which wind directions are actually used
-    bool used[8] = {false};
-    for (int hour = 0; hour < 12; ++hour) {
-        int8_t dir = forecast_hours[hour].wind_direction;
-        if (dir >= 0 && dir < 8) {
-            used[dir] = true;
+// One master drawing per icon, pointing north; each direction a loaded hour
+// uses is rotated from it once. trim_wind_*_images() frees the directions
+// no loaded hour uses any more. A wind vane setting change reloads the
+// icons the same way: the new directions are rotated, then the old trimmed.
+static void load_rotated(GDrawCommandImage** images, uint32_t master_id, const bool* used) {
+    GDrawCommandImage* master = NULL;
+    for (int dir = 0; dir < WIND_DIRECTIONS; ++dir) {
+        if (!used[dir] || images[dir]) {
+            continue;
         }
+        if (!master) {
+            master = gdraw_command_image_create_with_resource(master_id);
+            if (!master) return;
+        }
+        images[dir] = rotated_pdc_create(master, dir * TRIG_MAX_ANGLE / WIND_DIRECTIONS);
     }
-    
-    // Resource IDs for wind vane directions (N, NE, E, SE, S, SW, W, NW)
-    const uint32_t WIND_VANE_RESOURCE_IDS[] = {
-        RESOURCE_ID_WIND_VANE_N,
-        RESOURCE_ID_WIND_VANE_NE,
-        RESOURCE_ID_WIND_VANE_E,
-        RESOURCE_ID_WIND_VANE_SE,
-        RESOURCE_ID_WIND_VANE_S,
-        RESOURCE_ID_WIND_VANE_SW,
-        RESOURCE_ID_WIND_VANE_W,
-        RESOURCE_ID_WIND_VANE_NW
-    };
-    
-    // Only load images for directions that are actually used
-    for (int i = 0; i < 8; ++i) {
-        if (used[i]) {
-            images[i] = gdraw_command_image_create_with_resource(WIND_VANE_RESOURCE_IDS[i]);
+    if (master) {
+        gdraw_command_image_destroy(master);
+    }
+}
+
+// Frees the rotations no loaded hour uses any more
+static void free_unused(GDrawCommandImage** images, const bool* used, int count) {
+    for (int i = 0; i < count; ++i) {
+        if (!used[i] && images[i]) {
+            gdraw_command_image_destroy(images[i]);
+            images[i] = NULL;
         }
     }
-    
-    return images;
 }
 
-GDrawCommandImage** init_wind_speed_images() {
-    // Allocate array for 24 wind speed images (3 speeds × 8 directions)
-    GDrawCommandImage** images = malloc(sizeof(GDrawCommandImage*) * 24);
-    if (!images) return NULL;
-    
-    // Initialize all entries to NULL
-    for (int i = 0; i < 24; ++i) {
-        images[i] = NULL;
+// Scan the forecast to find which wind directions are actually used
+static void scan_used_wind_vanes(bool used[WIND_DIRECTIONS]) {
+    for (int slot = 0; slot < FORECAST_RING_HOURS; ++slot) {
+        int8_t dir = forecast_slot_loaded(slot) ? hour_wind_direction(forecast_data, slot) : -1;
+        if (dir >= 0) {
+            used[dir] = true;
+        }
     }
-    
-    // Scan forecast_hours to find which wind speed resource IDs are actually used
-    bool used[24] = {false};
-    for (int hour = 0; hour < 12; ++hour) {
-        uint32_t resource_id = forecast_hours[hour].wind_speed_resource_id;
-        if (resource_id != 0) {
-            // Calculate index from resource ID
-            // Slow = 0-7, Med = 8-15, Fast = 16-23
-            int index = -1;
-            if (resource_id >= RESOURCE_ID_WIND_SPEED_SLOW_N && resource_id <= RESOURCE_ID_WIND_SPEED_SLOW_NW) {
-                index = resource_id - RESOURCE_ID_WIND_SPEED_SLOW_N;
-            } else if (resource_id >= RESOURCE_ID_WIND_SPEED_MED_N && resource_id <= RESOURCE_ID_WIND_SPEED_MED_NW) {
-                index = 8 + (resource_id - RESOURCE_ID_WIND_SPEED_MED_N);
-            } else if (resource_id >= RESOURCE_ID_WIND_SPEED_FAST_N && resource_id <= RESOURCE_ID_WIND_SPEED_FAST_NW) {
-                index = 16 + (resource_id - RESOURCE_ID_WIND_SPEED_FAST_N);
-            }
-            
-            if (index >= 0 && index < 24) {
-                used[index] = true;
-            }
+}
+
+// Scan the forecast to find which speed and direction pairs are actually used
+static void scan_used_wind_speeds(bool used[WIND_SPEED_LEVELS][WIND_DIRECTIONS]) {
+    for (int slot = 0; slot < FORECAST_RING_HOURS; ++slot) {
+        int8_t dir = forecast_slot_loaded(slot) ? hour_wind_direction(forecast_data, slot) : -1;
+        if (dir >= 0) {
+            used[hour_wind_speed_level(forecast_data, slot)][dir] = true;
         }
     }
-    
-    // Resource ID base for each speed level
-    const uint32_t base_ids[] = {
-        RESOURCE_ID_WIND_SPEED_SLOW_N,
-        RESOURCE_ID_WIND_SPEED_MED_N,
-        RESOURCE_ID_WIND_SPEED_FAST_N
+}
+
+void update_wind_vane_images(GDrawCommandImage** images) {
+    if (!images) return;
+
+    bool used[WIND_DIRECTIONS] = {false};
+    scan_used_wind_vanes(used);
+    load_rotated(images, RESOURCE_ID_WIND_VANE, used);
+}
+
+void trim_wind_vane_images(GDrawCommandImage** images) {
+    if (!images) return;
+
+    bool used[WIND_DIRECTIONS] = {false};
+    scan_used_wind_vanes(used);
+    free_unused(images, used, WIND_DIRECTIONS);
+}
+
+void trim_wind_speed_images(GDrawCommandImage** images) {
+    if (!images) return;
+
+    bool used[WIND_SPEED_LEVELS][WIND_DIRECTIONS] = {{false}};
+    scan_used_wind_speeds(used);
+    free_unused(images, &used[0][0], WIND_SPEED_LEVELS * WIND_DIRECTIONS);
+}
+
+void update_wind_speed_images(GDrawCommandImage** images) {
+    if (!images) return;
+
+    bool used[WIND_SPEED_LEVELS][WIND_DIRECTIONS] = {{false}};
+    scan_used_wind_speeds(used);
+
+    // Master resource for each speed level
+    const uint32_t master_ids[WIND_SPEED_LEVELS] = {
+        RESOURCE_ID_WIND_SPEED_SLOW,
+        RESOURCE_ID_WIND_SPEED_MED,
+        RESOURCE_ID_WIND_SPEED_FAST
     };
-    
-    // Only load images that are actually used
-    for (int speed = 0; speed < 3; ++speed) {
-        for (int dir = 0; dir < 8; ++dir) {
-            int index = speed * 8 + dir;
-            if (used[index]) {
-                images[index] = gdraw_command_image_create_with_resource(base_ids[speed] + dir);
-            }
-        }
+    for (int speed = 0; speed < WIND_SPEED_LEVELS; ++speed) {
+        load_rotated(&images[speed * WIND_DIRECTIONS], master_ids[speed], used[speed]);
     }
-    
+}
+
+GDrawCommandImage** init_wind_vane_images() {
+    GDrawCommandImage** images = alloc_images(WIND_DIRECTIONS);
+    update_wind_vane_images(images);
+    return images;
+}
+
+GDrawCommandImage** init_wind_speed_images() {
+    GDrawCommandImage** images = alloc_images(WIND_SPEED_LEVELS * WIND_DIRECTIONS);
+    update_wind_speed_images(images);
     return images;
 }
 
 void deinit_wind_vane_images(GDrawCommandImage** wind_vane_images) {
     if (!wind_vane_images) return;
     
-    for (int i = 0; i < 8; ++i) {
+    for (int i = 0; i < WIND_DIRECTIONS; ++i) {
         if (wind_vane_images[i]) {
             gdraw_command_image_destroy(wind_vane_images[i]);
         }
     }
-    free(wind_vane_images);
+    free_images(wind_vane_images, WIND_DIRECTIONS);
 }
 
 void deinit_wind_speed_images(GDrawCommandImage** wind_speed_images) {
     if (!wind_speed_images) return;
     
-    for (int i = 0; i < 24; ++i) {
+    for (int i = 0; i < WIND_SPEED_LEVELS * WIND_DIRECTIONS; ++i) {
         if (wind_speed_images[i]) {
             gdraw_command_image_destroy(wind_speed_images[i]);
         }
     }
-    free(wind_speed_images);
+    free_images(wind_speed_images, WIND_SPEED_LEVELS * WIND_DIRECTIONS);
 }
 
 // Experiential image functions
-GDrawCommandImage** init_25px_experiential_images() {
-    GDrawCommandImage** images = malloc(sizeof(GDrawCommandImage*) * NUM_EXPERIENTIAL_RESOURCES);
-    if (!images) return NULL;
-    
-    // Initialize all entries to NULL
-    for (int i = 0; i < NUM_EXPERIENTIAL_RESOURCES; ++i) {
-        images[i] = NULL;
-    }
-    
-    // Scan forecast_hours to find which experiential icons are actually used
-    // Note: experiential_icon values are 1-7 (0 means none), but arrays are 0-indexed
-    bool used[NUM_EXPERIENTIAL_RESOURCES] = {false};
-    for (int hour = 0; hour < 12; ++hour) {
-        uint8_t icon = forecast_hours[hour].experiential_icon;
-        if (icon > 0 && icon <= NUM_EXPERIENTIAL_RESOURCES) {
+
+// Scan the forecast to find which experiential icons are actually used
+// Note: experiential_icon values are 1-7 (0 means none), but arrays are 0-indexed
+static void scan_used_experiential(bool used[NUM_EXPERIENTIAL_RESOURCES]) {
+    for (int slot = 0; slot < FORECAST_RING_HOURS; ++slot) {
+        uint8_t icon = forecast_slot_loaded(slot) ? hour_experiential_icon(forecast_data, slot) : 0;
+        if (icon > 0) {
             used[icon - 1] = true;  // Convert 1-based icon to 0-based array index
         }
     }
-    
+}
+
+void update_25px_experiential_images(GDrawCommandImage** images) {
+    if (!images) return;
+
+    bool used[NUM_EXPERIENTIAL_RESOURCES] = {false};
+    scan_used_experiential(used);
+
     // Only load images for IDs that are actually used
     for (int i = 0; i < NUM_EXPERIENTIAL_RESOURCES; ++i) {
-        if (used[i]) {
+        if (used[i] && !images[i]) {
             images[i] = gdraw_command_image_create_with_resource(EXPERIENTIAL_RESOURCE_IDS_25PX[i]);
         }
     }
-    return images;
 }
 
-GDrawCommandImage** init_50px_experiential_images() {
-    GDrawCommandImage** images = malloc(sizeof(GDrawCommandImage*) * NUM_EXPERIENTIAL_RESOURCES);
-    if (!images) return NULL;
-    
-    // Initialize all entries to NULL
-    for (int i = 0; i < NUM_EXPERIENTIAL_RESOURCES; ++i) {
-        images[i] = NULL;
-    }
-    
-    // Scan forecast_hours to find which experiential icons are actually used
-    // Note: experiential_icon values are 1-7 (0 means none), but arrays are 0-indexed
+void update_50px_experiential_images(GDrawCommandImage** images) {
+    if (!images) return;
+
     bool used[NUM_EXPERIENTIAL_RESOURCES] = {false};
-    for (int hour = 0; hour < 12; ++hour) {
-        uint8_t icon = forecast_hours[hour].experiential_icon;
-        if (icon > 0 && icon <= NUM_EXPERIENTIAL_RESOURCES) {
-            used[icon - 1] = true;  // Convert 1-based icon to 0-based array index
-        }
-    }
-    
+    scan_used_experiential(used);
+
     // Only load images for IDs that are actually used
     for (int i = 0; i < NUM_EXPERIENTIAL_RESOURCES; ++i) {
-        if (used[i]) {
+        if (used[i] && !images[i]) {
             images[i] = gdraw_command_image_create_with_resource(EXPERIENTIAL_RESOURCE_IDS_50PX[i]);
         }
     }
+}
+
+GDrawCommandImage** init_25px_experiential_images() {
+    GDrawCommandImage** images = alloc_images(NUM_EXPERIENTIAL_RESOURCES);
+    update_25px_experiential_images(images);
+    return images;
+}
+
+GDrawCommandImage** init_50px_experiential_images() {
+    GDrawCommandImage** images = alloc_images(NUM_EXPERIENTIAL_RESOURCES);
+    update_50px_experiential_images(images);
     return images;
 }
 
@@ -405,7 +433,7 @@ void deinit_25px_experiential_images(GDrawCommandImage** experiential_images_25p
             gdraw_command_image_destroy(experiential_images_25px[i]);
         }
     }
-    free(experiential_images_25px);
+    free_images(experiential_images_25px, NUM_EXPERIENTIAL_RESOURCES);
 }
 
 void deinit_50px_experiential_images(GDrawCommandImage** experiential_images_50px) {
@@ -415,5 +443,5 @@ void deinit_50px_experiential_images(GDrawCommandImage** experiential_images_50p
             gdraw_command_image_destroy(experiential_images_50px[i]);
         }
     }
-    free(experiential_images_50px);
+    free_images(experiential_images_50px, NUM_EXPERIENTIAL_RESOURCES);
 }
@@ -1,14 +1,29 @@
 #pragma once
 
 #include <pebble.h>
+#include "../utils/forecast.h"
+#include "../utils/arena.h"
 
 // Color functions for weather conditions, airflow, and experiential states
 GColor get_condition_color(int condition_code);
 GColor get_airflow_color(int airflow_intensity);
 GColor get_experiential_color(int experiential_index);
 
+// The image set arrays are allocated from `arena` (NULL for the heap) while it
+// is set; the viewer sets its window arena for as long as the window is loaded
+void resources_set_arena(Arena* arena);
+
+// Bytes of arrays every page's image sets take together
+#define RESOURCES_ARENA_SIZE (sizeof(GDrawCommandImage*) * (2 * NUM_WEATHER_CONDITIONS + \
+                              WIND_DIRECTIONS + WIND_SPEED_LEVELS * WIND_DIRECTIONS + 2 * NUM_EXPERIENTIAL_ICONS))
+
+// Image sets are loaded for the icons the loaded forecast hours use; call the
+// update_* functions after new hours arrive to load any they add.
+
 GDrawCommandImage** init_25px_condition_images();
 GDrawCommandImage** init_50px_condition_images();
+void update_25px_condition_images(GDrawCommandImage** condition_images_25px);
+void update_50px_condition_images(GDrawCommandImage** condition_images_50px);
 void deinit_25px_condition_images(GDrawCommandImage** condition_images_25px);
 void deinit_50px_condition_images(GDrawCommandImage** condition_images_50px);
 
@@ -18,13 +33,22 @@ GDrawCommandImage* init_axis_large_image();
 void deinit_axis_image(GDrawCommandImage* axis_image);
 
 // Airflow image functions
-GDrawCommandImage** init_wind_vane_images();  // Returns array of 8 directional wind vanes
-GDrawCommandImage** init_wind_speed_images();  // Returns array of 24 images: 3 speeds × 8 directions
+// Rotated at load from one north-pointing master each (see rotated_pdc.h)
+GDrawCommandImage** init_wind_vane_images();  // Returns array of WIND_DIRECTIONS vanes
+GDrawCommandImage** init_wind_speed_images();  // Returns WIND_SPEED_LEVELS × WIND_DIRECTIONS, by level then direction
+void update_wind_vane_images(GDrawCommandImage** wind_vane_images);
+void update_wind_speed_images(GDrawCommandImage** wind_speed_images);
+// The rotations are kept only while a loaded hour uses them. Trim once nothing
+// draws from the images any more; an animation may still hold the old ones.
+void trim_wind_vane_images(GDrawCommandImage** wind_vane_images);
+void trim_wind_speed_images(GDrawCommandImage** wind_speed_images);
 void deinit_wind_vane_images(GDrawCommandImage** wind_vane_images);
 void deinit_wind_speed_images(GDrawCommandImage** wind_speed_images);
 
 // Experiential image functions
 GDrawCommandImage** init_25px_experiential_images();
 GDrawCommandImage** init_50px_experiential_images();
+void update_25px_experiential_images(GDrawCommandImage** experiential_images_25px);
+void update_50px_experiential_images(GDrawCommandImage** experiential_images_50px);
 void deinit_25px_experiential_images(GDrawCommandImage** experiential_images_25px);
 void deinit_50px_experiential_images(GDrawCommandImage** experiential_images_50px);
\ No newline at end of file
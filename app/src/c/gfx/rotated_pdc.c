@@ -0,0 +1,39 @@
+#include "rotated_pdc.h"
+
+// Rounded to the nearest whole unit either side of zero
+static int32_t prv_round_ratio(int32_t value) {
+    return value >= 0 ? (value + TRIG_MAX_RATIO / 2) / TRIG_MAX_RATIO
+                      : -((-value + TRIG_MAX_RATIO / 2) / TRIG_MAX_RATIO);
+}
+
+GDrawCommandImage* rotated_pdc_create(GDrawCommandImage* master, int32_t angle) {
+    GDrawCommandImage* image = gdraw_command_image_clone(master);
+    if (!image) {
+        return NULL;
+    }
+
+    int32_t sine = sin_lookup(angle);
+    int32_t cosine = cos_lookup(angle);
+    GSize size = gdraw_command_image_get_bounds_size(image);
+    GDrawCommandList* list = gdraw_command_image_get_command_list(image);
+    uint32_t commands = gdraw_command_list_get_num_commands(list);
+
+    for (uint32_t c = 0; c < commands; c++) {
+        GDrawCommand* command = gdraw_command_list_get_command(list, c);
+        // Precise path points are 13.3 fixed point; the rest are whole pixels
+        int32_t scale = gdraw_command_get_type(command) == GDrawCommandTypePrecisePath ? 8 : 1;
+        int32_t cx = size.w * scale / 2;
+        int32_t cy = size.h * scale / 2;
+
+        uint16_t points = gdraw_command_get_num_points(command);
+        for (uint16_t p = 0; p < points; p++) {
+            GPoint point = gdraw_command_get_point(command, p);
+            int32_t dx = point.x - cx;
+            int32_t dy = point.y - cy;
+            // Clockwise on screen, where y grows downwards
+            gdraw_command_set_point(command, p, GPoint(cx + prv_round_ratio(dx * cosine - dy * sine),
+                                                       cy + prv_round_ratio(dx * sine + dy * cosine)));
+        }
+    }
+    return image;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <pebble.h>
+
+/**
+ * Copy a PDC image turned clockwise about the centre of its bounds, so one
+ * master drawing can stand in for every direction. Points are rotated with
+ * sin_lookup/cos_lookup and rounded once, into the copy; drawing it costs
+ * nothing extra. Precise paths keep their 1/8 px resolution.
+ * @param master The image to copy; left untouched
+ * @param angle Clockwise turn, TRIG_MAX_ANGLE being a full turn
+ * @return A new image the caller destroys, or NULL if out of memory
+ */
+GDrawCommandImage* rotated_pdc_create(GDrawCommandImage* master, int32_t angle);
@@ -3,8 +3,10 @@
 #include "../../utils/utils_common.h"
 #include "../../utils/weather.h"
 #include "../../utils/msgproc.h"
+#include "../../utils/forecast.h"
 #include "../../utils/demo.h"
 #include "../../utils/prefs.h"
+#include "../../utils/transport.h"
 
 // Window and UI elements (window itself is owned by main.c)
 static Layer* image_layer;
@@ -16,13 +18,67 @@ static char status_text[64] = "Loading...";
 
 // Loading state
 static bool loading_in_progress = false;
+static bool hours_received = false;
+static bool precipitation_received = false;
+
+// Sync watchdog: if the forecast has not fully arrived after SYNC_TIMEOUT_MS,
+// ask the phone to send it again, doubling the wait each time
+#define SYNC_TIMEOUT_MS 15000
+#define SYNC_MAX_ATTEMPTS 3
+static AppTimer* sync_timer = NULL;
+static uint8_t sync_attempts = 0;
 
 // Callbacks
 static SplashCompletionCallback completion_callback = NULL;
+static SplashHoursCallback hours_callback = NULL;
 
 // Forward declarations
 static void handle_data_response(DictionaryIterator *iter);
 
+static void cancel_sync_timer(void) {
+    if (sync_timer) {
+        app_timer_cancel(sync_timer);
+        sync_timer = NULL;
+    }
+}
+
+/**
+ * @brief Re-requests the forecast when it stalls, e.g. after a lost message
+ */
+static void sync_timer_callback(void* context) {
+    sync_timer = NULL;
+    if (sync_attempts >= SYNC_MAX_ATTEMPTS) {
+        UTIL_LOG(APP_LOG_LEVEL_ERROR, "No forecast after %d requests", sync_attempts);
+        // Keep listening; the phone may still get through
+        splash_set_status_text("No connection");
+        return;
+    }
+    sync_attempts++;
+    UTIL_LOG(APP_LOG_LEVEL_DEBUG, "Forecast stalled, requesting it again (%d)", sync_attempts);
+    splash_set_status_text("Retrying...");
+    transport_send(MESSAGE_KEY_REQUEST_DATA, 1);
+    sync_timer = app_timer_register(SYNC_TIMEOUT_MS << sync_attempts, sync_timer_callback, NULL);
+}
+
+/**
+ * @brief Finishes loading once both the first hours and precipitation are in
+ */
+static void complete_if_loaded(void) {
+    if (!hours_received || !precipitation_received) {
+        return;
+    }
+    cancel_sync_timer();
+    transport_mark_synced();
+    splash_set_status_text("Loaded!");
+    loading_in_progress = false;
+
+    // The viewer was built while waiting, so hand over straight away. Last,
+    // as the handover removes this window.
+    if (completion_callback) {
+        completion_callback(true);
+    }
+}
+
 /**
  * @brief Draws the splash image if available
  */
@@ -63,6 +119,7 @@ static void handle_data_response(DictionaryIterator *iter) {
             UTIL_LOG(APP_LOG_LEVEL_ERROR, "Location error - unable to get current location");
             splash_set_status_text("Location error");
             loading_in_progress = false;
+            cancel_sync_timer();
 
             if (completion_callback) {
                 completion_callback(false);
@@ -71,6 +128,7 @@ static void handle_data_response(DictionaryIterator *iter) {
             UTIL_LOG(APP_LOG_LEVEL_ERROR, "Weather data fetch failed");
             splash_set_status_text("Data error");
             loading_in_progress = false;
+            cancel_sync_timer();
 
             if (completion_callback) {
                 completion_callback(false);
@@ -79,28 +137,25 @@ static void handle_data_response(DictionaryIterator *iter) {
         return; // Don't process other data in this message
     }
 
-    // Handle all hourly data in a single 120-byte message
-    Tuple* hour_data_tuple = dict_find(iter, MESSAGE_KEY_HOUR_DATA);
-    if (hour_data_tuple) {
-        // Unpack all 12 hours from the 120-byte binary blob
-        unpack_all_hours((uint8_t*)hour_data_tuple->value->data, forecast_hours);
-
+    // Handle the first block of hourly data (12 hours in a 120-byte message)
+    if (forecast_receive(iter)) {
+        hours_received = true;
         splash_set_status_text("Loading...");
-        UTIL_LOG(APP_LOG_LEVEL_DEBUG, "All hourly data received (120 bytes), waiting for precipitation data");
+        UTIL_LOG(APP_LOG_LEVEL_DEBUG, "Hourly data received (%d hours)", forecast_length());
+
+        // Their icons can load while precipitation is still on its way
+        if (hours_callback) {
+            hours_callback();
+        }
     }
 
     // Handle precipitation data
-    Tuple* precipitation_package_tuple = dict_find(iter, MESSAGE_KEY_PRECIPITATION_PACKAGE);
-    if (precipitation_package_tuple) {
-        unpack_precipitation((PrecipitationPackage)precipitation_package_tuple->value->data, &precipitation);
-
-        // Now we have all data (hourly + precipitation), complete the loading
-        splash_set_status_text("Loaded!");
-        loading_in_progress = false;
-
-        // Call completion callback with success after a brief delay
-        app_timer_register(500, (AppTimerCallback)completion_callback, (void*)true);
+    if (precipitation_receive(iter)) {
+        precipitation_received = true;
     }
+
+    // The phone pipelines the two, so they can arrive in either order
+    complete_if_loaded();
 }
 
 /**
@@ -109,15 +164,18 @@ static void handle_data_response(DictionaryIterator *iter) {
 static void start_demo_data(void) {
     if (DEMO_MODE) {
         splash_set_status_text("Loading demo data...");
-        demo_populate_forecast_hours();
+        demo_populate_forecast_data();
+        if (hours_callback) {
+            hours_callback();
+        }
         demo_populate_precipitation();
 
-        // Simulate loading delay
         splash_set_status_text("Loaded!");
         loading_in_progress = false;
 
-        // Call completion callback
-        app_timer_register(1000, (AppTimerCallback)completion_callback, (void*)true);
+        if (completion_callback) {
+            completion_callback(true);
+        }
     }
 }
 
@@ -142,6 +200,8 @@ static void splash_window_load(Window *window) {
 }
 
 static void splash_window_unload(Window *window) {
+    cancel_sync_timer();
+
     // Clean up layers
     if (image_layer) {
         layer_destroy(image_layer);
@@ -201,6 +261,10 @@ void splash_set_completion_callback(SplashCompletionCallback callback) {
     completion_callback = callback;
 }
 
+void splash_set_hours_callback(SplashHoursCallback callback) {
+    hours_callback = callback;
+}
+
 void splash_start_loading(void) {
     if (loading_in_progress) {
         return;
@@ -214,6 +278,8 @@ void splash_start_loading(void) {
     } else {
         // In normal mode, PebbleKit JS will automatically send data on ready event
         splash_set_status_text("Connecting...");
+        sync_attempts = 0;
+        sync_timer = app_timer_register(SYNC_TIMEOUT_MS, sync_timer_callback, NULL);
     }
 }
 
@@ -52,6 +52,21 @@ typedef void (*SplashCompletionCallback)(bool success);
  */
 void splash_set_completion_callback(SplashCompletionCallback callback);
 
+/**
+ * @brief Callback function type for the first hours arriving
+ * 
+ * Called each time hourly data arrives during loading, before precipitation
+ * may have, so work that needs only the hours can start early.
+ */
+typedef void (*SplashHoursCallback)(void);
+
+/**
+ * @brief Sets the callback for hourly data arriving during loading
+ * 
+ * @param callback Function to call when hours arrive
+ */
+void splash_set_hours_callback(SplashHoursCallback callback);
+
 /**
  * @brief Starts the weather data loading process
  * 
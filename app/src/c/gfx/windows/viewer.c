@@ -1,6 +1,7 @@
 #include "viewer.h"
 #include "../layout.h"
 #include "../resources.h"
+#include "../page_snapshot.h"
 #include "../pages/airflow.h"
 #include "../pages/conditions.h"
 #include "../pages/experiential.h"
@@ -10,6 +11,8 @@
 #include "../animation/transition.h"
 #include "../animation/background_animation.h"
 #include "../../utils/weather.h"
+#include "../../utils/forecast.h"
+#include "../../utils/msgproc.h"
 #include "../../utils/prefs.h"
 
 // Conditional logging for viewer module
@@ -24,6 +27,12 @@
 
 #define FIN_IMAGE_TOP_OFFSET 15
 
+// How long the view has to stay put before the next page is snapshotted
+#define PAGE_SNAPSHOT_IDLE_MS 250
+
+// How often freeing unused images checks whether an animation has ended
+#define IMAGE_TRIM_RETRY_MS 250
+
 enum {
   VIEW_PAGE_CONDITIONS,
   VIEW_PAGE_AIRFLOW,
@@ -34,6 +43,7 @@ enum {
 
 // Window and UI elements
 static Window* s_viewer_window;
+static bool s_prepared;                // Layers built, ahead of the push or on load
 static TextLayer* prev_time_layer;
 static TextLayer* current_time_layer;
 static TextLayer* next_time_layer;
@@ -41,7 +51,7 @@ static TextLayer* current_text_layer;
 
 // Hour-boundary overlays
 static StatusBarLayer* s_status_bar;   // Visible only on hour 0
-static Layer* s_fin_layer;             // Visible only on hour 11
+static Layer* s_fin_layer;             // Visible only on the last hour
 static GDrawCommandImage* s_fin_image;
 
 // Image references for the three positions. Each active page populates these
@@ -53,6 +63,22 @@ static GDrawCommandImage* next_image;
 // Layer for drawing the images
 static Layer* images_layer;
 
+// Holds the pages' image set arrays from window load to unload
+static Arena s_window_arena;
+
+// Fires once the view has settled, to snapshot the page select goes to next
+static AppTimer* s_snapshot_timer;
+
+// Fires once no animation holds the page images, to free the unused ones
+static AppTimer* s_trim_timer;
+
+// Raster copies of the images on screen, blitted in place of the vectors
+static IconCacheEntry s_slot_cache[ICON_CACHE_SLOTS];
+
+// The main text layer keeps a pointer to its text, so the one page/hour on
+// screen is formatted here rather than keeping strings for every hour.
+static char s_content_text[MAX_STRING_LENGTH];
+
 // View state
 static uint8_t hour_view = 0;
 static uint8_t page_view = VIEW_PAGE_CONDITIONS;
@@ -60,18 +86,26 @@ static uint8_t active_page_view = VIEW_PAGE_NONE;  // Tracks which page's set_*_
 
 // Forward declarations
 static void update_view(uint8_t hour, uint8_t page);
+
+static uint8_t last_hour(void) {
+  return forecast_length() - 1;
+}
+
+static bool has_prev_hour(uint8_t hour) {
+  return hour > 0 && forecast_has_hour(hour - 1);
+}
+
+static bool has_next_hour(uint8_t hour) {
+  return forecast_has_hour(hour + 1);
+}
 static void apply_page_content(uint8_t hour, uint8_t page);
 static GColor get_background_color_for_forecast(uint8_t hour, uint8_t page);
 static void draw_page_images(Layer* layer, GContext* ctx);
 
 // Helper function to check if animations are enabled
 static bool animations_enabled(void) {
-#ifdef PBL_PLATFORM_APLITE
-    return false;
-#else
     ClaySettings* settings = prefs_get_settings();
     return settings->animate;
-#endif
 }
 
 // Returns the resting draw position for an image occupying the given slot,
@@ -108,22 +142,26 @@ static void deactivate_current_page(void) {
 // update_view (static swap) and update_images_and_content_for_animation
 // (mid-flight swap that should skip time-layer updates).
 static void apply_page_content(uint8_t hour, uint8_t page) {
-    const char* content_text = "";
+    s_content_text[0] = '\0';
     switch (page) {
         case VIEW_PAGE_CONDITIONS:
-            content_text = (hour == 0 && precipitation.precipitation_type > 0)
-                ? precipitation.precipitation_string
-                : forecast_hours[hour].conditions_string;
+            if (hour == 0 && precipitation.precipitation_type > 0) {
+                char temp_line[MAX_STRING_LENGTH];
+                format_hour_temperature(forecast_data, forecast_slot(0), temp_line);
+                format_precipitation_string(&precipitation, temp_line, s_content_text);
+            } else {
+                format_hour_conditions(forecast_data, forecast_slot(hour), s_content_text);
+            }
             break;
         case VIEW_PAGE_AIRFLOW:
-            content_text = forecast_hours[hour].airflow_string;
+            format_hour_airflow(forecast_data, forecast_slot(hour), s_content_text);
             break;
         case VIEW_PAGE_EXPERIENTIAL:
-            content_text = forecast_hours[hour].experiential_string;
+            format_hour_experiential(forecast_data, forecast_slot(hour), s_content_text);
             break;
         default: break;
     }
-    text_layer_set_text(current_text_layer, content_text);
+    text_layer_set_text(current_text_layer, s_content_text);
 
     // Only touch other pages when actually switching pages. Re-activating the
     // same page (hour change) just has it repopulate its slots.
@@ -140,12 +178,15 @@ static void apply_page_content(uint8_t hour, uint8_t page) {
     active_page_view = page;
 
     layer_mark_dirty(images_layer);
+
+    // Ask for the next block of hours before the user scrolls into it
+    forecast_prefetch(hour);
 }
 
 // Helper function to update only images and content text for animation,
 // without touching the time text (the animation system owns that).
 static void update_images_and_content_for_animation(uint8_t hour, uint8_t page) {
-    if (hour > 11 || page > 2) {
+    if (!forecast_has_hour(hour) || page > 2) {
         return;
     }
     apply_page_content(hour, page);
@@ -189,13 +230,27 @@ static void draw_fin_image(Layer* layer, GContext* ctx) {
     }
 }
 
+// Draws one slot, from the page snapshot while a page switch is sliding it
+// in, and otherwise from the slot cache once it holds the image
+static void draw_slot_image(GContext* ctx, uint8_t slot, GDrawCommandImage* image, GPoint pos,
+                            bool from_snapshot, GColor background) {
+    GPoint origin = resolve_image_pos(image, pos);
+    if (from_snapshot && page_snapshot_draw(ctx, hour_view, page_view, slot, image, origin)) {
+        return;
+    }
+    if (icon_cache_draw(ctx, &s_slot_cache[slot], image, background, origin)) {
+        return;
+    }
+    gdraw_command_image_draw(ctx, image, origin);
+}
+
 /**
  * @brief Draws the three images (prev, current, next) at their respective positions.
  */
 static void draw_page_images(Layer* layer, GContext* ctx) {
     const bool anim = animations_enabled();
 
-#ifndef PBL_PLATFORM_APLITE
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
     // Don't draw static images while the image animation system is progressively
     // revealing them; it composites them itself during that window.
     if (anim && image_animation_are_images_hidden()) {
@@ -203,32 +258,110 @@ static void draw_page_images(Layer* layer, GContext* ctx) {
     }
 #endif
 
+    bool from_snapshot = false;
     GPoint prev_pos, current_pos, next_pos;
     if (anim) {
-#ifndef PBL_PLATFORM_APLITE
-        transition_animation_get_image_positions(&prev_pos, &current_pos, &next_pos);
-#else
-        prev_pos = LAYOUT_PREV_ICON_POS;
-        current_pos = LAYOUT_CUR_ICON_POS;
-        next_pos = LAYOUT_NEXT_ICON_POS;
-#endif
+        from_snapshot = transition_animation_get_image_positions(&prev_pos, &current_pos, &next_pos);
     } else {
         prev_pos = LAYOUT_PREV_ICON_POS;
         current_pos = LAYOUT_CUR_ICON_POS;
         next_pos = LAYOUT_NEXT_ICON_POS;
     }
 
+    GColor background = get_background_color_for_forecast(hour_view, page_view);
     if (prev_image) {
-        gdraw_command_image_draw(ctx, prev_image, resolve_image_pos(prev_image, prev_pos));
+        draw_slot_image(ctx, 0, prev_image, prev_pos, from_snapshot, background);
     }
     if (current_image) {
-        gdraw_command_image_draw(ctx, current_image, resolve_image_pos(current_image, current_pos));
+        draw_slot_image(ctx, 1, current_image, current_pos, from_snapshot, background);
     }
     if (next_image) {
-        gdraw_command_image_draw(ctx, next_image, resolve_image_pos(next_image, next_pos));
+        draw_slot_image(ctx, 2, next_image, next_pos, from_snapshot, background);
     }
 }
 
+// The images a page shows for an hour, without activating the page
+static void get_page_images(uint8_t hour, uint8_t page, GDrawCommandImage* images[ICON_CACHE_SLOTS]) {
+    switch (page) {
+        case VIEW_PAGE_CONDITIONS:   conditions_get_images(hour, &images[0], &images[1], &images[2]);   break;
+        case VIEW_PAGE_AIRFLOW:      airflow_get_images(hour, &images[0], &images[1], &images[2]);      break;
+        case VIEW_PAGE_EXPERIENTIAL: experiential_get_images(hour, &images[0], &images[1], &images[2]); break;
+        default:
+            images[0] = images[1] = images[2] = NULL;
+            break;
+    }
+}
+
+static void schedule_page_snapshot(void);
+
+static void snapshot_timer_callback(void* data) {
+    s_snapshot_timer = NULL;
+    if (animation_is_busy()) {
+        schedule_page_snapshot();
+        return;
+    }
+
+    // Select only ever moves on to the next page
+    uint8_t page = page_view >= 2 ? 0 : page_view + 1;
+    GDrawCommandImage* images[ICON_CACHE_SLOTS];
+    get_page_images(hour_view, page, images);
+    page_snapshot_request(hour_view, page, images, get_background_color_for_forecast(hour_view, page));
+}
+
+static void schedule_page_snapshot(void) {
+    if (!animations_enabled()) {
+        return;
+    }
+    ANIMATION_PROFILE_SCOPE("page_snapshot");
+    if (!s_snapshot_timer || !app_timer_reschedule(s_snapshot_timer, PAGE_SNAPSHOT_IDLE_MS)) {
+        s_snapshot_timer = app_timer_register(PAGE_SNAPSHOT_IDLE_MS, snapshot_timer_callback, NULL);
+    }
+}
+
+// Steps one hour up or down, animated as far as the tier allows
+static void step_hour_animated(AnimationDirection direction) {
+  const bool up = direction == ANIMATION_DIRECTION_UP;
+  const uint8_t hour = up ? hour_view - 1 : hour_view + 1;
+
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
+  // Hide any overlay that won't be visible at the destination hour before
+  // animations start so it doesn't linger through the transition.
+  if (up && hour_view == last_hour() && s_fin_layer) {
+    layer_set_hidden(s_fin_layer, true);
+  }
+  if (!up && hour_view == 0 && s_status_bar) {
+    layer_set_hidden(status_bar_layer_get_layer(s_status_bar), true);
+  }
+
+  // Hour transition: background slides in from the side the hour comes
+  // from, images/text cross-fade.
+  GColor animation_color = get_background_color_for_forecast(hour, page_view);
+  background_animation_start(up ? BACKGROUND_ANIMATION_FROM_TOP : BACKGROUND_ANIMATION_FROM_BOTTOM,
+                             animation_color, background_animation_complete_hour);
+
+  image_animation_store_current_images();
+
+  hour_view = hour;
+  update_images_and_content_for_animation(hour_view, page_view);
+
+  const char* time_text = hour_label(forecast_data, forecast_slot(hour_view));
+  const char* content_text = text_layer_get_text(current_text_layer);
+
+  VIEWER_LOG(APP_LOG_LEVEL_DEBUG, "Starting %s animation - hour: %d, time: %s", up ? "up" : "down",
+             hour_view, time_text);
+  text_animation_start(direction, hour_view, time_text, content_text,
+                       up ? animation_complete_up : animation_complete_down);
+  image_animation_start(direction, hour_view, page_view,
+                        up ? image_animation_complete_up : image_animation_complete_down);
+#else
+  // The new hour goes in at once and its layers slide the last few pixels
+  hour_view = hour;
+  update_view(hour_view, page_view);
+  window_set_background_color(s_viewer_window, get_background_color_for_forecast(hour_view, page_view));
+  transition_animation_start_hour(direction, NULL);
+#endif
+}
+
 // Click handlers for navigation
 static void prv_up_click_handler(ClickRecognizerRef recognizer, void *context) {
   // Repeating presses: fast scroll without animation and without wrapping.
@@ -236,7 +369,7 @@ static void prv_up_click_handler(ClickRecognizerRef recognizer, void *context) {
     if (animations_enabled() && animation_is_busy()) {
       return;
     }
-    if (hour_view > 0) {
+    if (has_prev_hour(hour_view)) {
       hour_view--;
       update_view(hour_view, page_view);
       window_set_background_color(s_viewer_window, get_background_color_for_forecast(hour_view, page_view));
@@ -249,31 +382,9 @@ static void prv_up_click_handler(ClickRecognizerRef recognizer, void *context) {
     return;
   }
 
-  if(hour_view > 0) {
+  if(has_prev_hour(hour_view)) {
     if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-      // Hide any overlay that won't be visible at the destination hour before
-      // animations start so it doesn't linger through the transition.
-      if (hour_view == 11 && s_fin_layer) {
-        layer_set_hidden(s_fin_layer, true);
-      }
-
-      // Hour transition: background slides from top, images/text cross-fade.
-      GColor animation_color = get_background_color_for_forecast(hour_view - 1, page_view);
-      background_animation_start(BACKGROUND_ANIMATION_FROM_TOP, animation_color, background_animation_complete_hour);
-
-      image_animation_store_current_images();
-
-      hour_view--;
-      update_images_and_content_for_animation(hour_view, page_view);
-
-      const char* time_text = forecast_hours[hour_view].hour_string;
-      const char* content_text = text_layer_get_text(current_text_layer);
-
-      VIEWER_LOG(APP_LOG_LEVEL_DEBUG, "Starting up animation - hour: %d, time: %s", hour_view, time_text);
-      text_animation_start(ANIMATION_DIRECTION_UP, hour_view, time_text, content_text, animation_complete_up);
-      image_animation_start(ANIMATION_DIRECTION_UP, hour_view, page_view, image_animation_complete_up);
-#endif
+      step_hour_animated(ANIMATION_DIRECTION_UP);
     } else {
       hour_view--;
       update_view(hour_view, page_view);
@@ -282,10 +393,14 @@ static void prv_up_click_handler(ClickRecognizerRef recognizer, void *context) {
     return;
   }
 
-  // Wrap: UP at hour 0 jumps straight to hour 11 without animation. The jump is
-  // intentionally un-animated because scrolling 11 hours in the "up" direction
-  // would be disorienting; prefer a snap.
-  hour_view = 11;
+  // Wrap: UP at hour 0 jumps straight to the last hour without animation. The
+  // jump is intentionally un-animated because scrolling the whole forecast in
+  // the "up" direction would be disorienting; prefer a snap. Only possible
+  // when the last hour is loaded, i.e. the forecast fits in the ring.
+  if (hour_view != 0 || !forecast_has_hour(last_hour())) {
+    return;
+  }
+  hour_view = last_hour();
   update_view(hour_view, page_view);
   window_set_background_color(s_viewer_window, get_background_color_for_forecast(hour_view, page_view));
 }
@@ -302,16 +417,21 @@ static void prv_select_click_handler(ClickRecognizerRef recognizer, void *contex
   }
 
   if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-    // Page transition: background slides from the right, images animate out/in.
+    // Page transition: images slide in from the right and the text hops;
+    // the full tier sweeps the background in behind them.
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
     GColor animation_color = get_background_color_for_forecast(hour_view, page_view);
     background_animation_start(BACKGROUND_ANIMATION_FROM_RIGHT, animation_color, background_animation_complete_page);
+#else
+    window_set_background_color(s_viewer_window, get_background_color_for_forecast(hour_view, page_view));
+#endif
 
     transition_animation_start(transition_animation_complete);
 
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
     image_animation_set_current_page(page_view);
-    update_view(hour_view, page_view);
 #endif
+    update_view(hour_view, page_view);
   } else {
     update_view(hour_view, page_view);
     window_set_background_color(s_viewer_window, get_background_color_for_forecast(hour_view, page_view));
@@ -324,7 +444,7 @@ static void prv_down_click_handler(ClickRecognizerRef recognizer, void *context)
     if (animations_enabled() && animation_is_busy()) {
       return;
     }
-    if (hour_view < 11) {
+    if (has_next_hour(hour_view)) {
       hour_view++;
       update_view(hour_view, page_view);
       window_set_background_color(s_viewer_window, get_background_color_for_forecast(hour_view, page_view));
@@ -337,30 +457,9 @@ static void prv_down_click_handler(ClickRecognizerRef recognizer, void *context)
     return;
   }
 
-  if(hour_view < 11) {
+  if(has_next_hour(hour_view)) {
     if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-      // Hide any overlay that won't be visible at the destination hour before
-      // animations start so it doesn't linger through the transition.
-      if (hour_view == 0 && s_status_bar) {
-        layer_set_hidden(status_bar_layer_get_layer(s_status_bar), true);
-      }
-
-      GColor animation_color = get_background_color_for_forecast(hour_view + 1, page_view);
-      background_animation_start(BACKGROUND_ANIMATION_FROM_BOTTOM, animation_color, background_animation_complete_hour);
-
-      image_animation_store_current_images();
-
-      hour_view++;
-      update_images_and_content_for_animation(hour_view, page_view);
-
-      const char* time_text = forecast_hours[hour_view].hour_string;
-      const char* content_text = text_layer_get_text(current_text_layer);
-
-      VIEWER_LOG(APP_LOG_LEVEL_DEBUG, "Starting down animation - hour: %d, time: %s", hour_view, time_text);
-      text_animation_start(ANIMATION_DIRECTION_DOWN, hour_view, time_text, content_text, animation_complete_down);
-      image_animation_start(ANIMATION_DIRECTION_DOWN, hour_view, page_view, image_animation_complete_down);
-#endif
+      step_hour_animated(ANIMATION_DIRECTION_DOWN);
     } else {
       hour_view++;
       update_view(hour_view, page_view);
@@ -369,7 +468,11 @@ static void prv_down_click_handler(ClickRecognizerRef recognizer, void *context)
     return;
   }
 
-  // Wrap: DOWN at hour 11 jumps to hour 0 without animation (see up-wrap comment).
+  // Wrap: DOWN at the last hour jumps to hour 0 without animation (see up-wrap
+  // comment).
+  if (hour_view != last_hour() || !forecast_has_hour(0)) {
+    return;
+  }
   hour_view = 0;
   update_view(hour_view, page_view);
   window_set_background_color(s_viewer_window, get_background_color_for_forecast(hour_view, page_view));
@@ -379,7 +482,7 @@ static void prv_click_config_provider(void *context) {
   window_single_click_subscribe(BUTTON_ID_SELECT, prv_select_click_handler);
   // Up/down use repeating subscriptions so a held button fast-scrolls without
   // animation after the first animated step. repeat_interval_ms of 150 feels
-  // responsive without being too rapid across only 12 hours.
+  // responsive without being too rapid across a 12-48 hour forecast.
   window_single_repeating_click_subscribe(BUTTON_ID_UP, 150, prv_up_click_handler);
   window_single_repeating_click_subscribe(BUTTON_ID_DOWN, 150, prv_down_click_handler);
 }
@@ -406,13 +509,13 @@ static void init_layers(Layer* window_layer) {
   text_layer_set_background_color(next_time_layer, GColorClear);
   text_layer_set_font(next_time_layer, fonts_get_system_font(LAYOUT_TIME_FONT));
   VIEWER_LOG(APP_LOG_LEVEL_DEBUG, "Time layers initialized");
-  if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-    text_animation_set_main_layers(current_time_layer, current_text_layer);
-    text_animation_set_secondary_layers(prev_time_layer, next_time_layer);
-    transition_animation_set_layers(current_time_layer, current_text_layer, prev_time_layer, next_time_layer);
+  // The animations are set up whatever the setting says, so turning them on
+  // from the phone later finds them ready; only playback checks it.
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
+  text_animation_set_main_layers(current_time_layer, current_text_layer);
+  text_animation_set_secondary_layers(prev_time_layer, next_time_layer);
 #endif
-  }
+  transition_animation_set_layers(current_time_layer, current_text_layer, prev_time_layer, next_time_layer);
 
   layer_add_child(window_layer, text_layer_get_layer(prev_time_layer));
   layer_add_child(window_layer, text_layer_get_layer(current_time_layer));
@@ -438,16 +541,14 @@ static void init_layers(Layer* window_layer) {
   layer_add_child(window_layer, images_layer);
   VIEWER_LOG(APP_LOG_LEVEL_DEBUG, "Images layer added to window layer");
 
-  if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-    text_animation_set_image_layers(images_layer, &prev_image, &current_image, &next_image);
-    transition_animation_set_image_layer(images_layer);
+  transition_animation_set_image_layer(images_layer);
+  transition_animation_init(window_layer);
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
+  text_animation_set_image_layers(images_layer, &prev_image, &current_image, &next_image);
 
-    animation_system_init();
-    text_animation_init(window_layer);
-    transition_animation_init(window_layer);
+  animation_system_init();
+  text_animation_init(window_layer);
 #endif
-  }
 
   // Status bar overlay – shown only on hour 0
   s_status_bar = status_bar_layer_create();
@@ -455,7 +556,7 @@ static void init_layers(Layer* window_layer) {
   layer_set_hidden(status_bar_layer_get_layer(s_status_bar), hour_view != 0);
   layer_add_child(window_layer, status_bar_layer_get_layer(s_status_bar));
 
-  // Fin banner overlay – shown only on hour 11. Bottom edge flush with text
+  // Fin banner overlay – shown only on the last hour. Bottom edge flush with text
   // (same LAYOUT_PAD_B margin used by LAYOUT_NEXT_TIME_BOUNDS).
   s_fin_image = gdraw_command_image_create_with_resource(RESOURCE_ID_FIN_50PX);
   if (s_fin_image) {
@@ -464,7 +565,7 @@ static void init_layers(Layer* window_layer) {
     int16_t fin_y = LAYOUT_H - LAYOUT_PAD_B - fin_size.h + FIN_IMAGE_TOP_OFFSET;
     s_fin_layer = layer_create(GRect(fin_x, fin_y, fin_size.w, fin_size.h));
     layer_set_update_proc(s_fin_layer, draw_fin_image);
-    layer_set_hidden(s_fin_layer, hour_view != 11);
+    layer_set_hidden(s_fin_layer, hour_view != last_hour());
     layer_add_child(window_layer, s_fin_layer);
   }
 
@@ -477,7 +578,7 @@ static GColor get_background_color_for_forecast(uint8_t hour, uint8_t page) {
   return GColorWhite;
   #endif
 
-  if (hour > 11) {
+  if (!forecast_has_hour(hour)) {
     return GColorWhite;
   }
 
@@ -491,74 +592,96 @@ static GColor get_background_color_for_forecast(uint8_t hour, uint8_t page) {
         }
         return get_condition_color(3);
       }
-      return get_condition_color(forecast_hours[hour].conditions_icon);
+      return get_condition_color(hour_conditions_icon(forecast_data, forecast_slot(hour)));
 
     case VIEW_PAGE_AIRFLOW: {
-      uint32_t resource_id = forecast_hours[hour].wind_speed_resource_id;
-      int speed_level = 0;
-      if (resource_id >= RESOURCE_ID_WIND_SPEED_MED_N && resource_id <= RESOURCE_ID_WIND_SPEED_MED_NW) {
-        speed_level = 1;
-      } else if (resource_id >= RESOURCE_ID_WIND_SPEED_FAST_N && resource_id <= RESOURCE_ID_WIND_SPEED_FAST_NW) {
-        speed_level = 2;
-      }
-      return get_airflow_color(speed_level);
+      return get_airflow_color(hour_wind_speed_level(forecast_data, forecast_slot(hour)));
     }
 
     case VIEW_PAGE_EXPERIENTIAL:
-      return get_experiential_color(forecast_hours[hour].experiential_icon);
+      return get_experiential_color(hour_experiential_icon(forecast_data, forecast_slot(hour)));
 
     default:
       return GColorWhite;
   }
 }
 
-// Updates the view for the given hour (0-11) and page.
+// Captures the images now in the slots; until then they draw as vectors
+static void refresh_slot_cache(uint8_t hour, uint8_t page) {
+  ANIMATION_PROFILE_SCOPE("icon_cache");
+  GDrawCommandImage* const images[ICON_CACHE_SLOTS] = {prev_image, current_image, next_image};
+  icon_cache_fill_slots(s_slot_cache, images, get_background_color_for_forecast(hour, page));
+}
+
+// Updates the view for the given forecast hour and page.
 static void update_view(uint8_t hour, uint8_t page) {
-  if (hour > 11 || page > 2) {
+  if (!forecast_has_hour(hour) || page > 2 || !current_text_layer) {
     return;
   }
 
   // Time layers: identical behaviour for animated and non-animated modes.
-  // Prev is blanked at the first hour, next is blanked at the last hour.
-  text_layer_set_text(prev_time_layer, (hour == 0)  ? "" : forecast_hours[hour - 1].hour_string);
-  text_layer_set_text(current_time_layer, forecast_hours[hour].hour_string);
-  text_layer_set_text(next_time_layer, (hour == 11) ? "" : forecast_hours[hour + 1].hour_string);
+  // Prev/next are blanked past either end of the forecast, and while the
+  // block holding them is still on its way.
+  text_layer_set_text(prev_time_layer, has_prev_hour(hour) ? hour_label(forecast_data, forecast_slot(hour - 1)) : "");
+  text_layer_set_text(current_time_layer, hour_label(forecast_data, forecast_slot(hour)));
+  text_layer_set_text(next_time_layer, has_next_hour(hour) ? hour_label(forecast_data, forecast_slot(hour + 1)) : "");
 
   if (s_status_bar) {
     layer_set_hidden(status_bar_layer_get_layer(s_status_bar), hour != 0);
   }
   if (s_fin_layer) {
-    layer_set_hidden(s_fin_layer, hour != 11);
+    layer_set_hidden(s_fin_layer, hour != last_hour());
   }
 
   apply_page_content(hour, page);
+  refresh_slot_cache(hour, page);
+  schedule_page_snapshot();
 }
 
-static void prv_window_load(Window *window) {
+// Builds everything that does not need the forecast. The page image arrays
+// start empty when no hours are in yet; viewer_load_forecast_images() fills them.
+static void prepare_window(Window *window) {
+  if (s_prepared) {
+    return;
+  }
   Layer *window_layer = window_get_root_layer(window);
 
-  GColor initial_color = get_background_color_for_forecast(hour_view, page_view);
-  window_set_background_color(window, initial_color);
-
-  if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-    background_animation_init(window_layer, window);
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
+  background_animation_init(window_layer, window);
 #endif
-  }
+  icon_cache_init(window_layer);
 
+  arena_init(&s_window_arena, RESOURCES_ARENA_SIZE);
+  resources_set_arena(&s_window_arena);
   init_layers(window_layer);
+  s_prepared = true;
+}
+
+static void prv_window_load(Window *window) {
+  GColor initial_color = get_background_color_for_forecast(hour_view, page_view);
+  window_set_background_color(window, initial_color);
+
+  prepare_window(window);
 }
 
 static void prv_window_unload(Window *window) {
-  if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-    background_animation_deinit();
-    text_animation_deinit();
-    transition_animation_deinit();
-    animation_system_deinit();
-#endif
+  if (s_snapshot_timer) {
+    app_timer_cancel(s_snapshot_timer);
+    s_snapshot_timer = NULL;
+  }
+  if (s_trim_timer) {
+    app_timer_cancel(s_trim_timer);
+    s_trim_timer = NULL;
   }
 
+  page_snapshot_deinit();
+  transition_animation_deinit();
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
+  background_animation_deinit();
+  text_animation_deinit();
+  animation_system_deinit();
+#endif
+
   // Image pointers alias into per-page image arrays owned by the page modules.
   // The arrays are freed by each page's deinit_*_layers(); just null the shared
   // slots here so nothing dangles.
@@ -566,6 +689,8 @@ static void prv_window_unload(Window *window) {
   current_image = NULL;
   next_image = NULL;
   active_page_view = VIEW_PAGE_NONE;
+  icon_cache_release_slots(s_slot_cache);
+  icon_cache_deinit();
 
   if (images_layer) {
     layer_destroy(images_layer);
@@ -605,6 +730,10 @@ static void prv_window_unload(Window *window) {
     gdraw_command_image_destroy(s_fin_image);
     s_fin_image = NULL;
   }
+
+  resources_set_arena(NULL);
+  arena_deinit(&s_window_arena);
+  s_prepared = false;
 }
 
 // Public API implementation
@@ -614,13 +743,11 @@ Window* viewer_window_create(void) {
   next_image = NULL;
   active_page_view = VIEW_PAGE_NONE;
 
-  if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-    text_animation_init_system();
-    transition_animation_init_system();
-    background_animation_init_system();
+  transition_animation_init_system();
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
+  text_animation_init_system();
+  background_animation_init_system();
 #endif
-  }
 
   s_viewer_window = window_create();
   window_set_click_config_provider(s_viewer_window, prv_click_config_provider);
@@ -632,15 +759,23 @@ Window* viewer_window_create(void) {
   return s_viewer_window;
 }
 
+void viewer_window_prepare(Window* window) {
+  if (window && window == s_viewer_window) {
+    prepare_window(window);
+  }
+}
+
 void viewer_window_destroy(Window* window) {
   if (window && window == s_viewer_window) {
-    if(animations_enabled()) {
-#ifndef PBL_PLATFORM_APLITE
-      background_animation_deinit_system();
-      text_animation_deinit_system();
-      transition_animation_deinit_system();
-#endif
+    // Prepared but never pushed, so the system will not unload it
+    if (s_prepared && !window_is_loaded(window)) {
+      prv_window_unload(window);
     }
+    transition_animation_deinit_system();
+#if ANIMATION_TIER == ANIMATION_TIER_FULL
+    background_animation_deinit_system();
+    text_animation_deinit_system();
+#endif
 
     window_destroy(window);
     s_viewer_window = NULL;
@@ -666,3 +801,55 @@ void viewer_set_current_view(uint8_t hour, uint8_t page) {
   page_view = page;
   update_view(hour, page);
 }
+
+void viewer_load_forecast_images(void) {
+  update_conditions_images();
+  update_airflow_images();
+  update_experiential_images();
+  // The images may have been reloaded at addresses the caches still name
+  page_snapshot_clear();
+  icon_cache_release_slots(s_slot_cache);
+}
+
+static void trim_images_when_idle(void);
+
+static void trim_timer_callback(void* data) {
+  s_trim_timer = NULL;
+  trim_images_when_idle();
+}
+
+// Frees the images no loaded hour uses any more and redraws the view from
+// what is left. A running animation may still hold the images it started
+// with, so this waits for it to end.
+static void trim_images_when_idle(void) {
+  if (animation_is_busy()) {
+    if (!s_trim_timer) {
+      s_trim_timer = app_timer_register(IMAGE_TRIM_RETRY_MS, trim_timer_callback, NULL);
+    }
+    return;
+  }
+  if (s_trim_timer) {
+    app_timer_cancel(s_trim_timer);
+    s_trim_timer = NULL;
+  }
+
+  // Nothing may keep naming a freed image, not even the caches' entries
+  deactivate_current_page();
+  page_snapshot_clear();
+  icon_cache_release_slots(s_slot_cache);
+  trim_airflow_images();
+  update_view(hour_view, page_view);
+}
+
+void viewer_forecast_updated(void) {
+  viewer_load_forecast_images();
+
+  // Mid-animation, the completion callback's update_view picks the new hours
+  // up, and the unused images are freed once it is over
+  trim_images_when_idle();
+}
+
+void viewer_settings_changed(void) {
+  // The icons the hours use may have changed just as they do with new hours
+  viewer_forecast_updated();
+}
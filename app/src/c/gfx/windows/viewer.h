@@ -15,6 +15,17 @@
  */
 Window* viewer_window_create(void);
 
+/**
+ * @brief Builds the viewer's layers ahead of pushing it
+ * 
+ * Creates the layers and the images that do not depend on the forecast
+ * (axes, fin, status bar), so this can run while the splash waits on the
+ * phone. A viewer pushed without it is built when it loads.
+ * 
+ * @param window The viewer window from viewer_window_create()
+ */
+void viewer_window_prepare(Window* window);
+
 /**
  * @brief Destroys the viewer window and cleans up resources
  * 
@@ -29,7 +40,7 @@ void viewer_window_destroy(Window* window);
  * or when navigation occurs. It updates both the displayed content and images
  * based on the current hour and page selection.
  * 
- * @param hour Hour index (0-11) to display
+ * @param hour Forecast hour index to display
  * @param page Page type (0=conditions, 1=airflow, 2=experiential)
  */
 void viewer_update_view(uint8_t hour, uint8_t page);
@@ -37,7 +48,7 @@ void viewer_update_view(uint8_t hour, uint8_t page);
 /**
  * @brief Gets the current hour being viewed
  * 
- * @return uint8_t Current hour index (0-11)
+ * @return uint8_t Current forecast hour index
  */
 uint8_t viewer_get_current_hour(void);
 
@@ -53,7 +64,32 @@ uint8_t viewer_get_current_page(void);
  * 
  * This function updates the internal state and refreshes the display
  * 
- * @param hour Hour index (0-11) to set
+ * @param hour Forecast hour index to set
  * @param page Page type to set (0=conditions, 1=airflow, 2=experiential)
  */
 void viewer_set_current_view(uint8_t hour, uint8_t page);
+
+/**
+ * @brief Loads the icons the forecast hours received so far use
+ *
+ * Needs a prepared or loaded viewer; does not redraw. Called as soon as the
+ * first hours arrive so the icons are in before the viewer is shown.
+ */
+void viewer_load_forecast_images(void);
+
+/**
+ * @brief Picks up forecast hours that arrived while the viewer is open
+ *
+ * Loads any icons the new hours use and redraws the current view so hours
+ * that just became available appear as neighbours. Icons the loaded hours
+ * no longer use are freed once no animation is running.
+ */
+void viewer_forecast_updated(void);
+
+/**
+ * @brief Picks up settings that change which icons the hours use
+ *
+ * Turning the wind vane direction around points every hour's wind icons the
+ * other way; the ones now needed are loaded and the rest freed.
+ */
+void viewer_settings_changed(void);
@@ -2,35 +2,59 @@
 #include "utils/utils_common.h"
 #include "utils/weather.h"
 #include "utils/msgproc.h"
+#include "utils/forecast.h"
 #include "utils/prefs.h"
+#include "utils/transport.h"
+#include "utils/startup.h"
 #include "gfx/windows/viewer.h"
 #include "gfx/windows/splash.h"
 
-#define APP_MESSAGE_INBOX_SIZE 1024
 #define MAX_STRING_LENGTH 40
 
 static Window* s_splash_window;
 static Window* s_viewer_window;
 
+// The first hours are in; load their icons while precipitation is on its way
+static void splash_hours_handler(void) {
+  viewer_load_forecast_images();
+  startup_mark(STARTUP_STAGE_ICONS_LOADED);
+}
+
 // Splash completion handler
 static void splash_completion_handler(bool success) {
   if (success) {
     UTIL_LOG(APP_LOG_LEVEL_DEBUG, "Splash loading successful, transitioning to viewer");
+    startup_mark(STARTUP_STAGE_DATA_READY);
 
-    s_viewer_window = viewer_window_create();
     window_stack_push(s_viewer_window, true);
     vibes_short_pulse();
 
     viewer_update_view(0, 0);  // Start at hour 0, conditions page
 
-    // Remove splash window after transition
-    app_timer_register(500, (AppTimerCallback)window_stack_remove, s_splash_window);
+    // The viewer covers the splash; take it off the stack so back exits the
+    // app and later messages go to the viewer
+    window_stack_remove(s_splash_window, false);
+    startup_mark(STARTUP_STAGE_VIEWER_SHOWN);
   } else {
     UTIL_LOG(APP_LOG_LEVEL_ERROR, "Splash loading failed");
     // Splash window stays visible with error message; user restarts the app to retry
   }
 }
 
+// Settings values arrive as integers or, from some config pages, as strings
+static int32_t prv_tuple_int(const Tuple* tuple) {
+  if (tuple->type == TUPLE_CSTRING) {
+    return atoi(tuple->value->cstring);
+  }
+  if (tuple->length == 1) {
+    return tuple->type == TUPLE_INT ? tuple->value->int8 : tuple->value->uint8;
+  }
+  if (tuple->length == 2) {
+    return tuple->type == TUPLE_INT ? tuple->value->int16 : tuple->value->uint16;
+  }
+  return tuple->value->int32;
+}
+
 static void inbox_received_callback(DictionaryIterator *iter, void *context) {
   
   // If splash window is active, let it handle the message
@@ -62,10 +86,13 @@ static void inbox_received_callback(DictionaryIterator *iter, void *context) {
     return; // Don't process other data in this message
   }
 
+  // Handle hour blocks the viewer asked for as the user scrolled
+  if (forecast_receive(iter)) {
+    viewer_forecast_updated();
+  }
+
   // Handle precipitation data
-  Tuple* precipitation_package_tuple = dict_find(iter, MESSAGE_KEY_PRECIPITATION_PACKAGE);
-  if(precipitation_package_tuple) {
-    unpack_precipitation((PrecipitationPackage)precipitation_package_tuple->value->data, &precipitation);
+  if (precipitation_receive(iter)) {
     viewer_update_view(viewer_get_current_hour(), viewer_get_current_page());
   }
 
@@ -75,6 +102,7 @@ static void inbox_received_callback(DictionaryIterator *iter, void *context) {
   Tuple* velocity_units_tuple = dict_find(iter, MESSAGE_KEY_CFG_VELOCITY_UNITS);
   Tuple* distance_units_tuple = dict_find(iter, MESSAGE_KEY_CFG_DISTANCE_UNITS);
   Tuple* pressure_units_tuple = dict_find(iter, MESSAGE_KEY_CFG_PRESSURE_UNITS);
+  Tuple* precipitation_units_tuple = dict_find(iter, MESSAGE_KEY_CFG_PRECIPITATION_UNITS);
   Tuple* refresh_interval_tuple = dict_find(iter, MESSAGE_KEY_CFG_REFRESH_INTERVAL);
   Tuple* self_refresh_tuple = dict_find(iter, MESSAGE_KEY_CFG_SELF_REFRESH);
   Tuple* display_interval_tuple = dict_find(iter, MESSAGE_KEY_CFG_DISPLAY_INTERVAL);
@@ -84,88 +112,83 @@ static void inbox_received_callback(DictionaryIterator *iter, void *context) {
   ClaySettings* settings = prefs_get_settings();
 
   if(temperature_units_tuple) {
-    strcpy(settings->temperature_units, temperature_units_tuple->value->cstring);
+    settings->temperature_units = prefs_parse_temperature_units(temperature_units_tuple->value->cstring);
   }
 
   if(velocity_units_tuple) {
-    strcpy(settings->velocity_units, velocity_units_tuple->value->cstring);
+    settings->velocity_units = prefs_parse_velocity_units(velocity_units_tuple->value->cstring);
   }
 
   if(distance_units_tuple) {
-    strcpy(settings->distance_units, distance_units_tuple->value->cstring);
+    settings->distance_units = prefs_parse_distance_units(distance_units_tuple->value->cstring);
   }
 
   if(pressure_units_tuple) {
-    strcpy(settings->pressure_units, pressure_units_tuple->value->cstring);
+    settings->pressure_units = prefs_parse_pressure_units(pressure_units_tuple->value->cstring);
+  }
+
+  if(precipitation_units_tuple) {
+    settings->precipitation_units = prefs_parse_precipitation_units(precipitation_units_tuple->value->cstring);
   }
 
   if(refresh_interval_tuple) {
-    settings->refresh_interval = refresh_interval_tuple->value->int32;
+    settings->refresh_interval = prv_tuple_int(refresh_interval_tuple);
   }
 
   if(self_refresh_tuple) {
-    settings->self_refresh = self_refresh_tuple->value->int16 != 0;
+    settings->self_refresh = prv_tuple_int(self_refresh_tuple) != 0;
   }
 
   if(display_interval_tuple) {
-    settings->display_interval = display_interval_tuple->value->int32;
+    settings->display_interval = prv_tuple_int(display_interval_tuple) == 1 ? 1 : 2;
   }
 
   if(animate_tuple) {
-    settings->animate = animate_tuple->value->int16 != 0;
+    settings->animate = prv_tuple_int(animate_tuple) != 0;
   }
 
   if(wind_vane_direction_tuple) {
-    // Handle both string and integer values for backward compatibility
-    if(wind_vane_direction_tuple->type == TUPLE_CSTRING) {
-      settings->wind_vane_direction = atoi(wind_vane_direction_tuple->value->cstring);
-    } else {
-      settings->wind_vane_direction = wind_vane_direction_tuple->value->int16;
+    bool wind_vane_direction = prv_tuple_int(wind_vane_direction_tuple) != 0;
+    if (wind_vane_direction != settings->wind_vane_direction) {
+      settings->wind_vane_direction = wind_vane_direction;
+      // Every hour's wind icons point the other way now
+      viewer_settings_changed();
     }
   }
 
-
   prefs_save();
 }
 
-static void inbox_dropped_callback(AppMessageResult reason, void *context) {
-  // A message was received, but had to be dropped
-  UTIL_LOG(APP_LOG_LEVEL_ERROR, "Message dropped. Reason: %d", (int)reason);
-}
-
-static void outbox_sent_callback(DictionaryIterator *iter, void *context) {
-  // The message just sent has been successfully delivered
-
-}
-
-static void outbox_failed_callback(DictionaryIterator *iter,
-                                      AppMessageResult reason, void *context) {
-  // The message just sent failed to be delivered
-  UTIL_LOG(APP_LOG_LEVEL_ERROR, "Message send failed. Reason: %d", (int)reason);
+static void send_failed_callback(uint32_t key, int32_t value) {
+  // The transport already retried; let the next hour change ask again
+  if (key == MESSAGE_KEY_REQUEST_HOUR) {
+    forecast_request_failed();
+  }
 }
 
 
 static void prv_init(void) {
+  startup_begin();
   prefs_load();
 
   // Create and show the splash window first
   s_splash_window = splash_window_create();
   splash_set_completion_callback(splash_completion_handler);
+  splash_set_hours_callback(splash_hours_handler);
   splash_set_status_text("Starting up...");
   
   const bool animated = true;
   window_stack_push(s_splash_window, animated);
+  startup_mark(STARTUP_STAGE_SPLASH_SHOWN);
 
-  // Register to be notified about inbox received events
-  app_message_register_inbox_received(inbox_received_callback);
-  app_message_register_inbox_dropped(inbox_dropped_callback);
-  app_message_register_outbox_sent(outbox_sent_callback);
-  app_message_register_outbox_failed(outbox_failed_callback);
+  // Opens AppMessage; retries, repeats and inbox negotiation happen inside
+  transport_init(inbox_received_callback, send_failed_callback);
 
-  app_message_open(APP_MESSAGE_INBOX_SIZE_MINIMUM, APP_MESSAGE_INBOX_SIZE);
+  // Build the viewer while the phone fetches the forecast
+  s_viewer_window = viewer_window_create();
+  viewer_window_prepare(s_viewer_window);
+  startup_mark(STARTUP_STAGE_VIEWER_BUILT);
 
-  UTIL_LOG(APP_LOG_LEVEL_DEBUG, "inbox size: %lu", (uint32_t)app_message_inbox_size_maximum());
-  
   // Start loading weather data
   splash_start_loading();
 }
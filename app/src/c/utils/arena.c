@@ -0,0 +1,85 @@
+#include "arena.h"
+
+// Enough for the pointers and 32-bit fields the callers store
+#define ARENA_ALIGN sizeof(void*)
+
+static size_t prv_align(size_t size) {
+    return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+static bool prv_owns(const Arena* arena, const void* ptr) {
+    const uint8_t* p = ptr;
+    return arena && arena->base && p >= arena->base && p < arena->base + arena->stats.capacity;
+}
+
+bool arena_init(Arena* arena, size_t capacity) {
+    *arena = (Arena){0};
+    capacity = prv_align(capacity);
+    arena->base = capacity ? malloc(capacity) : NULL;
+    if (arena->base) {
+        arena->stats.capacity = capacity;
+    }
+    return arena->base != NULL;
+}
+
+void arena_deinit(Arena* arena) {
+    free(arena->base);
+    *arena = (Arena){0};
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    if (!arena) {
+        return malloc(size);
+    }
+    size_t aligned = prv_align(size);
+    ArenaStats* stats = &arena->stats;
+    if (!arena->base || aligned > stats->capacity - stats->used) {
+        stats->overflows++;
+        return malloc(size);
+    }
+
+    void* ptr = arena->base + stats->used;
+    stats->used += aligned;
+    stats->allocs++;
+    if (stats->used > stats->peak) {
+        stats->peak = stats->used;
+    }
+    return ptr;
+}
+
+void* arena_calloc(Arena* arena, size_t count, size_t size) {
+    void* ptr = arena_alloc(arena, count * size);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+void arena_free(Arena* arena, void* ptr, size_t size) {
+    if (!ptr) {
+        return;
+    }
+    if (!prv_owns(arena, ptr)) {
+        free(ptr);
+        return;
+    }
+
+    // The most recent allocation can be popped; anything under it waits
+    size_t aligned = prv_align(size);
+    ArenaStats* stats = &arena->stats;
+    if ((uint8_t*)ptr + aligned == arena->base + stats->used) {
+        stats->used -= aligned;
+    } else {
+        stats->stranded += aligned;
+    }
+}
+
+void arena_reset(Arena* arena) {
+    arena->stats.used = 0;
+    arena->stats.stranded = 0;
+    arena->stats.resets++;
+}
+
+ArenaStats arena_get_stats(const Arena* arena) {
+    return arena->stats;
+}
@@ -0,0 +1,57 @@
+/*
+    Arena allocator
+
+    A bump allocator over one heap block, for memory that is released all
+    at once: an allocation is a pointer bump, and a reset hands everything
+    back without walking it. Owners reset at the end of a known lifetime,
+    e.g. the viewer window unloading or a page transition completing, so a
+    long session never leaves holes in the app heap.
+
+    Freeing a single allocation only reclaims its space when it was the
+    most recent one; otherwise the bytes stay held until the next reset and
+    are counted in `stranded`. When the block is full, or an arena has no
+    block (never initialised, or arena_init() could not get one), requests
+    fall back to the heap and are freed individually, so an undersized
+    arena costs heap churn but never correctness. A NULL arena means the
+    heap.
+*/
+
+#pragma once
+
+#include <pebble.h>
+
+typedef struct ArenaStats {
+    size_t capacity;    // bytes in the block
+    size_t used;        // bytes handed out and not yet reclaimed
+    size_t peak;        // most bytes in use since arena_init()
+    size_t stranded;    // freed bytes held until the next reset
+    uint32_t allocs;    // allocations served from the block
+    uint32_t overflows; // allocations that fell back to the heap
+    uint32_t resets;
+} ArenaStats;
+
+typedef struct Arena {
+    uint8_t* base;
+    ArenaStats stats;
+} Arena;
+
+/**
+ * Take a block of `capacity` bytes from the heap
+ * @return false if the heap could not give one; the arena then serves
+ *         every request from the heap
+ */
+bool arena_init(Arena* arena, size_t capacity);
+
+// Return the block to the heap; nothing allocated from it may be used after
+void arena_deinit(Arena* arena);
+
+void* arena_alloc(Arena* arena, size_t size);
+void* arena_calloc(Arena* arena, size_t count, size_t size);
+
+// `size` is what was asked for; heap fallbacks are freed at once
+void arena_free(Arena* arena, void* ptr, size_t size);
+
+// Release everything allocated from the block at once
+void arena_reset(Arena* arena);
+
+ArenaStats arena_get_stats(const Arena* arena);
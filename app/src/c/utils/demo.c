@@ -1,97 +1,57 @@
 #include "demo.h"
-#include "msgproc.h"
-#include <string.h>
+#include "forecast.h"
 
-// Preset data structure for each forecast hour
+// Preset data for each forecast hour, in the units of the HOUR_DATA wire format
 typedef struct {
-    const char* hour_string;
-    int temp;
-    int wind_speed;
-    int wind_gust;
-    int wind_dir;  // 0-15 for 16 directions
-    int pressure;
+    uint8_t hour;
+    int8_t temp;        // degrees F
+    int8_t feels_like;  // degrees F
+    uint8_t wind_speed; // kph
+    uint8_t wind_gust;  // kph
+    uint8_t visibility; // km
+    int pressure;       // mb
+    uint8_t wind_dir;   // 0-15 for 16 directions
+    uint8_t uv_index;
     uint8_t conditions_icon;
     uint8_t experiential_icon;
-    const char* experiential_string;
 } PresetHourData;
 
-// Customize these preset values for each hour (starting at 8AM, 2-hour intervals)
+// Customize these preset values for each hour (starting at 12PM, 2-hour intervals)
 static const PresetHourData preset_hours[12] = {
-    // hour_string, temp, wind_speed, wind_gust, wind_dir, pressure, conditions_icon, experiential_icon, experiential_string
-    {"12PM", 76, 12, 18, 6, 1011, WEATHER_CONDITION_CLEAR, 3, "Feels 76°\nUVI 9\nVis. 20mi"},
-    {"2PM", 80, 14, 21, 7, 1010, WEATHER_CONDITION_CLEAR, 3, "Feels 80°\nUVI 10\nVis. 20mi"},
-    {"4PM", 84, 15, 22, 0, 1009, WEATHER_CONDITION_PARTLY_CLOUDY, 3, "Feels 82°\nUVI 8\nVis. 18mi"},
-    {"6PM", 78, 16, 24, 1, 1008, WEATHER_CONDITION_PARTLY_CLOUDY, 2, "Feels 76°\nUVI 4\nVis. 16mi"},
-    {"8PM", 72, 14, 20, 2, 1007, WEATHER_CONDITION_PARTLY_CLOUDY, 0, "Feels 70°\nUVI 1\nVis. 15mi"},
-    {"10PM", 68, 12, 17, 3, 1006, WEATHER_CONDITION_CLOUDY, 0, "Feels 66°\nUVI 0\nVis. 12mi"},
-    {"12AM", 64, 10, 15, 4, 1005, WEATHER_CONDITION_CLOUDY, 0, "Feels 62°\nUVI 0\nVis. 10mi"},
-    {"2AM", 62, 8, 12, 5, 1004, WEATHER_CONDITION_CLOUDY, 0, "Feels 60°\nUVI 0\nVis. 8mi"},
-    {"4AM", 60, 6, 9, 6, 1003, WEATHER_CONDITION_PARTLY_CLOUDY_NIGHT, 0, "Feels 58°\nUVI 0\nVis. 10mi"},
-    {"6AM", 62, 7, 11, 7, 1004, WEATHER_CONDITION_PARTLY_CLOUDY_NIGHT, 0, "Feels 60°\nUVI 0\nVis. 12mi"},
-    {"8AM", 68, 8, 12, 4, 1013, WEATHER_CONDITION_PARTLY_CLOUDY, 2, "Feels 66°\nUVI 4\nVis. 18mi"},
-    {"10AM", 74, 10, 15, 5, 1012, WEATHER_CONDITION_CLEAR, 2, "Feels 72°\nUVI 6\nVis. 20mi"},
+    // hour, temp, feels_like, wind_speed, wind_gust, visibility, pressure, wind_dir, uv_index, conditions_icon, experiential_icon
+    {12, 76, 76, 19, 29, 32, 1011, 6, 9, WEATHER_CONDITION_CLEAR, 3},
+    {14, 80, 80, 23, 34, 32, 1010, 7, 10, WEATHER_CONDITION_CLEAR, 3},
+    {16, 84, 82, 24, 35, 29, 1009, 0, 8, WEATHER_CONDITION_PARTLY_CLOUDY, 3},
+    {18, 78, 76, 26, 39, 26, 1008, 1, 4, WEATHER_CONDITION_PARTLY_CLOUDY, 2},
+    {20, 72, 70, 23, 32, 24, 1007, 2, 1, WEATHER_CONDITION_PARTLY_CLOUDY, 0},
+    {22, 68, 66, 19, 27, 19, 1006, 3, 0, WEATHER_CONDITION_CLOUDY, 0},
+    {0, 64, 62, 16, 24, 16, 1005, 4, 0, WEATHER_CONDITION_CLOUDY, 0},
+    {2, 62, 60, 13, 19, 13, 1004, 5, 0, WEATHER_CONDITION_CLOUDY, 0},
+    {4, 60, 58, 10, 14, 16, 1003, 6, 0, WEATHER_CONDITION_PARTLY_CLOUDY_NIGHT, 0},
+    {6, 62, 60, 11, 18, 19, 1004, 7, 0, WEATHER_CONDITION_PARTLY_CLOUDY_NIGHT, 0},
+    {8, 68, 66, 13, 19, 29, 1013, 4, 4, WEATHER_CONDITION_PARTLY_CLOUDY, 2},
+    {10, 74, 72, 16, 24, 32, 1012, 5, 6, WEATHER_CONDITION_CLEAR, 2},
 };
 
-// Populate the global forecast_hours array with preset data
-void demo_populate_forecast_hours(void) {
+// Pack the preset hours into forecast_data, exactly as PebbleKit JS would
+void demo_populate_forecast_data(void) {
+    uint8_t data[HOUR_DATA_SIZE];
     for (int i = 0; i < 12; i++) {
         const PresetHourData* preset = &preset_hours[i];
-        
-        // Set hour string
-        strncpy(forecast_hours[i].hour_string, preset->hour_string, 4);
-        forecast_hours[i].hour_string[4] = '\0';
-        
-        // Set wind data
-        forecast_hours[i].wind_speed = preset->wind_speed;
-        forecast_hours[i].wind_direction = preset->wind_dir / 2;  // Convert to 0-7 range
-        
-        // For demo mode, assume default wind vane direction (wind heading, not origin)
-        // The incoming wind direction represents where wind is coming FROM (meteorological convention)
-        // Since default is wind heading (where wind is blowing TO), rotate 180 degrees (add 4)
-        forecast_hours[i].wind_direction = (forecast_hours[i].wind_direction + 4) % 8;
-        
-        // Calculate wind speed level and resource ID based on wind speed
-        uint8_t wind_speed_level;
-        if (preset->wind_speed <= 16) {
-            wind_speed_level = 0;  // Slow
-        } else if (preset->wind_speed <= 32) {
-            wind_speed_level = 1;  // Med
-        } else {
-            wind_speed_level = 2;  // Fast
-        }
-        
-        // Base resource IDs for each speed level (first in each group)
-        const uint32_t speed_base_ids[] = {
-            RESOURCE_ID_WIND_SPEED_SLOW_N,   // 0: Slow
-            RESOURCE_ID_WIND_SPEED_MED_N,    // 1: Med
-            RESOURCE_ID_WIND_SPEED_FAST_N    // 2: Fast
-        };
-        
-        // Calculate resource ID: base + direction offset
-        forecast_hours[i].wind_speed_resource_id = speed_base_ids[wind_speed_level] + forecast_hours[i].wind_direction;
-        
-        // Set condition and experiential icons
-        forecast_hours[i].conditions_icon = preset->conditions_icon;
-        forecast_hours[i].experiential_icon = preset->experiential_icon;
-        
-        // Format conditions string
-        snprintf(forecast_hours[i].conditions_string, MAX_STRING_LENGTH - 1,
-                "%d°F\n%s",
-                preset->temp,
-                get_weather_condition_string(preset->conditions_icon));
-        
-        // Format airflow string
-        snprintf(forecast_hours[i].airflow_string, MAX_STRING_LENGTH - 1,
-                "%d mph %s\n%d mph gusts\n%d mb",
-                preset->wind_speed,
-                get_wind_direction_string(preset->wind_dir),
-                preset->wind_gust,
-                preset->pressure);
-        
-        // Use preset experiential string
-        strncpy(forecast_hours[i].experiential_string, preset->experiential_string, MAX_STRING_LENGTH - 1);
-        forecast_hours[i].experiential_string[MAX_STRING_LENGTH - 1] = '\0';
+        uint8_t* package = &data[i * HOUR_PACKAGE_SIZE];
+
+        package[0] = preset->hour;
+        package[1] = (uint8_t)preset->temp;
+        package[2] = (uint8_t)preset->feels_like;
+        package[3] = preset->wind_speed;
+        package[4] = preset->wind_gust;
+        package[5] = preset->visibility;
+        package[6] = (uint8_t)(int8_t)(preset->pressure - 1000);
+        package[7] = preset->wind_dir << 4;  // no air quality
+        package[8] = (preset->uv_index << 4) | HOUR_FLAG_WIND_GUST | HOUR_FLAG_WIND_DIR;
+        package[9] = (preset->conditions_icon << 4) | preset->experiential_icon;
     }
+    forecast_set_hour_data(data);
 }
 
 // Populate the global precipitation variable with preset rain data
@@ -115,12 +75,6 @@ void demo_populate_precipitation(void) {
             precipitation.precipitation_intensity[i] = 3;
         }
     }
-    
-    // Get the temperature from the first forecast hour
-    char temp_line[MAX_STRING_LENGTH];
-    strncpy(temp_line, forecast_hours[0].conditions_string,
-            strchr(forecast_hours[0].conditions_string, '\n') - forecast_hours[0].conditions_string);
-    temp_line[strchr(forecast_hours[0].conditions_string, '\n') - forecast_hours[0].conditions_string] = '\0';
-
-    format_precipitation_string(&precipitation, temp_line);
+    precipitation.chance = 80;
+    interpolate_precipitation_minutes(&precipitation);
 } 
\ No newline at end of file
@@ -2,10 +2,12 @@
 
 #include "weather.h"
 
+// Hand-written data in place of the phone. To run real recorded forecasts
+// through the phone and the AppMessage path instead, see src/pkjs/replay.js.
 #define DEMO_MODE 0
 
-// Populate the global forecast_hours array with mock data
-void demo_populate_forecast_hours(void);
+// Fill forecast_data with mock hour packages
+void demo_populate_forecast_data(void);
 
 // Populate the global precipitation variable with mock data
 void demo_populate_precipitation(void); 
\ No newline at end of file
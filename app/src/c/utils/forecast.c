@@ -0,0 +1,283 @@
+#include "forecast.h"
+#include "utils_common.h"
+#include "prefs.h"
+#include "transport.h"
+#include <string.h>
+
+uint8_t forecast_data[FORECAST_RING_HOURS * HOUR_PACKAGE_SIZE];
+
+#define NO_BLOCK 0xFF
+
+// A REQUEST_HOUR the phone never answers is given up on after this long, so
+// a lost request or reply cannot hold off every later one
+#define REQUEST_TIMEOUT_MS 10000
+
+static uint8_t s_length;
+// Block index held by each ring position
+static uint8_t s_ring_blocks[FORECAST_RING_BLOCKS] = {NO_BLOCK, NO_BLOCK};
+// Block asked for with REQUEST_HOUR and not received yet
+static uint8_t s_requested_block = NO_BLOCK;
+static AppTimer* s_request_timer;
+
+static const char* const HOUR_LABELS[24] = {
+    "12AM", "1AM", "2AM", "3AM", "4AM", "5AM", "6AM", "7AM", "8AM", "9AM", "10AM", "11AM",
+    "12PM", "1PM", "2PM", "3PM", "4PM", "5PM", "6PM", "7PM", "8PM", "9PM", "10PM", "11PM"
+};
+
+static void prv_clear_request(void) {
+    s_requested_block = NO_BLOCK;
+    if (s_request_timer) {
+        app_timer_cancel(s_request_timer);
+        s_request_timer = NULL;
+    }
+}
+
+static void prv_request_timeout(void* context) {
+    s_request_timer = NULL;
+    UTIL_LOG(APP_LOG_LEVEL_WARNING, "No answer for hours from %d", s_requested_block * FORECAST_BLOCK_HOURS);
+    s_requested_block = NO_BLOCK;
+}
+
+void forecast_reset(uint8_t length) {
+    s_length = length < FORECAST_MAX_HOURS ? length : FORECAST_MAX_HOURS;
+    for (int i = 0; i < FORECAST_RING_BLOCKS; i++) {
+        s_ring_blocks[i] = NO_BLOCK;
+    }
+    prv_clear_request();
+}
+
+void forecast_store_block(uint8_t first_hour, const uint8_t* data) {
+    uint8_t block = first_hour / FORECAST_BLOCK_HOURS;
+    uint8_t position = block % FORECAST_RING_BLOCKS;
+    memcpy(&forecast_data[position * HOUR_DATA_SIZE], data, HOUR_DATA_SIZE);
+    s_ring_blocks[position] = block;
+    if (s_requested_block == block) {
+        prv_clear_request();
+    }
+}
+
+void forecast_set_hour_data(const uint8_t* data) {
+    forecast_reset(FORECAST_BLOCK_HOURS);
+    forecast_store_block(0, data);
+}
+
+bool forecast_receive(DictionaryIterator* iter) {
+    Tuple* hour_data_tuple = dict_find(iter, MESSAGE_KEY_HOUR_DATA);
+    if (!hour_data_tuple) {
+        // HOUR_BLOCK on its own: the phone has no such block, so the request
+        // is over and the next prefetch may ask again
+        Tuple* block_tuple = dict_find(iter, MESSAGE_KEY_HOUR_BLOCK);
+        if (block_tuple && s_requested_block != NO_BLOCK &&
+            block_tuple->value->uint8 == s_requested_block * FORECAST_BLOCK_HOURS) {
+            UTIL_LOG(APP_LOG_LEVEL_DEBUG, "No hours from %d on the phone", block_tuple->value->uint8);
+            prv_clear_request();
+        }
+        return false;
+    }
+    if (hour_data_tuple->length < HOUR_DATA_SIZE) {
+        UTIL_LOG(APP_LOG_LEVEL_ERROR, "Hour data too short: %d bytes", (int)hour_data_tuple->length);
+        return false;
+    }
+    // The phone packs as many blocks as the negotiated inbox size allows;
+    // only a ring's worth can be kept
+    uint8_t blocks = hour_data_tuple->length / HOUR_DATA_SIZE;
+    if (blocks > FORECAST_RING_BLOCKS) {
+        blocks = FORECAST_RING_BLOCKS;
+    }
+
+    // Without the companion keys this is a plain 12-hour forecast
+    Tuple* block_tuple = dict_find(iter, MESSAGE_KEY_HOUR_BLOCK);
+    Tuple* length_tuple = dict_find(iter, MESSAGE_KEY_FORECAST_HOURS);
+    uint8_t first_hour = block_tuple ? block_tuple->value->uint8 : 0;
+    uint8_t length = length_tuple ? length_tuple->value->uint8 : FORECAST_BLOCK_HOURS;
+    if (first_hour % FORECAST_BLOCK_HOURS != 0 || first_hour >= FORECAST_MAX_HOURS) {
+        UTIL_LOG(APP_LOG_LEVEL_ERROR, "Bad hour block: %d", first_hour);
+        return false;
+    }
+
+    // An unrequested first block is a fresh forecast; anything loaded before
+    // it belongs to the old one
+    if (first_hour == 0 && s_requested_block != 0) {
+        forecast_reset(length);
+    } else if (length != s_length) {
+        UTIL_LOG(APP_LOG_LEVEL_ERROR, "Block for a %d-hour forecast, expected %d", length, s_length);
+        return false;
+    }
+    for (uint8_t b = 0; b < blocks && first_hour + b * FORECAST_BLOCK_HOURS < s_length; b++) {
+        forecast_store_block(first_hour + b * FORECAST_BLOCK_HOURS, hour_data_tuple->value->data + b * HOUR_DATA_SIZE);
+    }
+    return true;
+}
+
+uint8_t forecast_length(void) {
+    return s_length;
+}
+
+bool forecast_slot_loaded(uint8_t slot) {
+    uint8_t block = s_ring_blocks[slot / FORECAST_BLOCK_HOURS];
+    return block != NO_BLOCK && block * FORECAST_BLOCK_HOURS + slot % FORECAST_BLOCK_HOURS < s_length;
+}
+
+bool forecast_has_hour(uint8_t hour) {
+    return hour < s_length && s_ring_blocks[forecast_slot(hour) / FORECAST_BLOCK_HOURS] == hour / FORECAST_BLOCK_HOURS;
+}
+
+void forecast_prefetch(uint8_t hour) {
+    if (hour >= s_length || s_requested_block != NO_BLOCK) {
+        return;
+    }
+
+    // Keep the viewed block plus the neighbour on the side of the block the
+    // user is closer to, so both prev/next hours are loaded at block edges
+    uint8_t block = hour / FORECAST_BLOCK_HOURS;
+    uint8_t last_block = (s_length - 1) / FORECAST_BLOCK_HOURS;
+    int neighbour = (hour % FORECAST_BLOCK_HOURS < FORECAST_BLOCK_HOURS / 2) ? block - 1 : block + 1;
+
+    uint8_t wanted = NO_BLOCK;
+    if (s_ring_blocks[block % FORECAST_RING_BLOCKS] != block) {
+        wanted = block;
+    } else if (neighbour >= 0 && neighbour <= last_block &&
+               s_ring_blocks[neighbour % FORECAST_RING_BLOCKS] != neighbour) {
+        wanted = neighbour;
+    }
+    if (wanted == NO_BLOCK) {
+        return;
+    }
+
+    // A full queue is left for the next hour change to try again
+    if (transport_send(MESSAGE_KEY_REQUEST_HOUR, wanted * FORECAST_BLOCK_HOURS)) {
+        s_requested_block = wanted;
+        s_request_timer = app_timer_register(REQUEST_TIMEOUT_MS, prv_request_timeout, NULL);
+        UTIL_LOG(APP_LOG_LEVEL_DEBUG, "Requested hours from %d", wanted * FORECAST_BLOCK_HOURS);
+    }
+}
+
+void forecast_request_failed(void) {
+    prv_clear_request();
+}
+
+const char* hour_label(const uint8_t* pkg, uint8_t i) {
+    return HOUR_LABELS[hour_of_day(pkg, i)];
+}
+
+int8_t hour_wind_direction(const uint8_t* pkg, uint8_t i) {
+    if (!hour_has(pkg, i, HOUR_FLAG_WIND_DIR)) {
+        return -1;
+    }
+
+    // The incoming wind direction represents where wind is coming FROM (meteorological convention)
+    // If wind_vane_direction == 0 (wind heading), we need to show where wind is blowing TO
+    // So we rotate 180 degrees (add 8 of the 16 directions)
+    int8_t direction = hour_wind_dir16(pkg, i);
+    if (prefs_get_settings()->wind_vane_direction == 0) {
+        direction = (direction + WIND_DIRECTIONS / 2) % WIND_DIRECTIONS;
+    }
+    return direction;
+}
+
+uint8_t hour_wind_speed_level(const uint8_t* pkg, uint8_t i) {
+    uint8_t wind_speed = hour_wind_speed(pkg, i);
+    if (wind_speed <= 19) {
+        //beaufort 3 and below
+        return WIND_SPEED_SLOW;
+    } else if (wind_speed <= 38) {
+        //beaufort 5 and below
+        return WIND_SPEED_MED;
+    }
+    //beaufort 6 and above
+    return WIND_SPEED_FAST;
+}
+
+// snprintf() returns the length it wanted, which would push later writes past
+// the buffer once a field is truncated; clamp to what actually fits.
+static int advance(int written, int appended) {
+    written += appended;
+    return written < MAX_STRING_LENGTH - 1 ? written : MAX_STRING_LENGTH - 1;
+}
+
+// Unit suffixes, indexed by the settings' unit enums
+static const char* const TEMPERATURE_SUFFIXES[] = {"F", "C"};
+static const char* const VELOCITY_SUFFIXES[] = {"mph", "kph", "m/s"};
+static const char* const DISTANCE_SUFFIXES[] = {"mi", "km"};
+static const char* const PRESSURE_SUFFIXES[] = {"mb", "in"};
+
+static int temperature_in_units(int8_t fahrenheit, const ClaySettings* settings) {
+    return settings->temperature_units == TEMPERATURE_CELSIUS ? fahrenheit_to_celsius(fahrenheit) : fahrenheit;
+}
+
+static int speed_in_units(uint8_t kph, const ClaySettings* settings) {
+    switch (settings->velocity_units) {
+        case VELOCITY_MPH:
+            return kph_to_mph(kph);
+        case VELOCITY_MPS:
+            return kph_to_mps(kph);
+        default:
+            return kph;
+    }
+}
+
+void format_hour_temperature(const uint8_t* pkg, uint8_t i, char* out) {
+    const ClaySettings* settings = prefs_get_settings();
+    snprintf(out, MAX_STRING_LENGTH, "%d°%s", temperature_in_units(hour_temp(pkg, i), settings),
+             TEMPERATURE_SUFFIXES[settings->temperature_units]);
+}
+
+void format_hour_conditions(const uint8_t* pkg, uint8_t i, char* out) {
+    format_hour_temperature(pkg, i, out);
+    int written = strlen(out);
+    snprintf(out + written, MAX_STRING_LENGTH - written, "\n%s",
+             get_weather_condition_string(hour_conditions_icon(pkg, i)));
+}
+
+void format_hour_airflow(const uint8_t* pkg, uint8_t i, char* out) {
+    const ClaySettings* settings = prefs_get_settings();
+
+    // Wind speed (always available), then direction and gusts if available
+    int written = advance(0, snprintf(out, MAX_STRING_LENGTH, "%d%s",
+                                      speed_in_units(hour_wind_speed(pkg, i), settings),
+                                      VELOCITY_SUFFIXES[settings->velocity_units]));
+    if (hour_has(pkg, i, HOUR_FLAG_WIND_DIR)) {
+        written = advance(written, snprintf(out + written, MAX_STRING_LENGTH - written, " %s",
+                                            get_wind_direction_string(hour_wind_dir16(pkg, i))));
+    }
+    if (hour_has(pkg, i, HOUR_FLAG_WIND_GUST)) {
+        written = advance(written, snprintf(out + written, MAX_STRING_LENGTH - written, "\n%d%s gusts",
+                                            speed_in_units(hour_wind_gust(pkg, i), settings),
+                                            VELOCITY_SUFFIXES[settings->velocity_units]));
+    }
+
+    // Pressure (always available)
+    int pressure_mb = hour_pressure_mb(pkg, i);
+    if (settings->pressure_units == PRESSURE_INCHES) {
+        // For inHg, use the x100 function to get value multiplied by 100
+        uint16_t pressure_x100 = mb_to_inHg_x100(pressure_mb);
+        snprintf(out + written, MAX_STRING_LENGTH - written, "\n%d.%02d%s",
+                 pressure_x100 / 100, pressure_x100 % 100, PRESSURE_SUFFIXES[settings->pressure_units]);
+    } else {
+        snprintf(out + written, MAX_STRING_LENGTH - written, "\n%d%s", pressure_mb,
+                 PRESSURE_SUFFIXES[settings->pressure_units]);
+    }
+}
+
+void format_hour_experiential(const uint8_t* pkg, uint8_t i, char* out) {
+    const ClaySettings* settings = prefs_get_settings();
+
+    // Feels like temperature, UV index (and air quality if available), visibility
+    int written = advance(0, snprintf(out, MAX_STRING_LENGTH, "Feels %d°%s",
+                                      temperature_in_units(hour_feels_like(pkg, i), settings),
+                                      TEMPERATURE_SUFFIXES[settings->temperature_units]));
+    if (hour_has(pkg, i, HOUR_FLAG_AIR_QUALITY)) {
+        written = advance(written, snprintf(out + written, MAX_STRING_LENGTH - written, "\nUVI %d AQI %d",
+                                            hour_uv_index(pkg, i), hour_aqi(pkg, i)));
+    } else {
+        written = advance(written, snprintf(out + written, MAX_STRING_LENGTH - written, "\nUVI %d",
+                                            hour_uv_index(pkg, i)));
+    }
+
+    int visibility = hour_visibility(pkg, i);
+    if (settings->distance_units == DISTANCE_MILES) {
+        visibility = km_to_miles(visibility);
+    }
+    snprintf(out + written, MAX_STRING_LENGTH - written, "\nVis. %d%s", visibility,
+             DISTANCE_SUFFIXES[settings->distance_units]);
+}
@@ -0,0 +1,104 @@
+/*
+    Forecast View
+
+    Read-only accessors over the HOUR_DATA wire format (the field layout is
+    app/schema/wire_format.json). The 120 bytes PebbleKit JS sends are kept as they arrived
+    in `forecast_data`; pages read fields straight out of it and only format
+    the strings that are actually on screen, into buffers they own.
+
+    Every accessor takes a packed buffer and an hour index into it, so the
+    same functions work on the retained ring and on a single HOUR_DATA blob.
+    Values that index into image arrays are clamped to their valid range here.
+
+    Forecasts can run past the 12 hours one HOUR_DATA message holds. The
+    phone sends them in blocks of 12 (HOUR_BLOCK gives the first hour of the
+    block, FORECAST_HOURS the length of the whole forecast) and the watch
+    keeps the two blocks around the viewed hour in a ring, asking for the
+    next one with REQUEST_HOUR as the user scrolls toward it. Memory stays
+    at FORECAST_RING_HOURS packages however long the forecast is. Read an
+    absolute hour with e.g. hour_temp(forecast_data, forecast_slot(hour)).
+*/
+
+#pragma once
+
+#include <pebble.h>
+#include "weather.h"
+#include "msgproc.h"
+
+#define FORECAST_BLOCK_HOURS 12
+#define FORECAST_RING_BLOCKS 2
+#define FORECAST_RING_HOURS (FORECAST_RING_BLOCKS * FORECAST_BLOCK_HOURS)
+#define FORECAST_MAX_HOURS 48
+
+// The loaded blocks, as received: FORECAST_RING_HOURS 10-byte hour packages
+extern uint8_t forecast_data[FORECAST_RING_HOURS * HOUR_PACKAGE_SIZE];
+
+// Ring slot an absolute forecast hour (0 to forecast_length() - 1) lives in
+static inline uint8_t forecast_slot(uint8_t hour) {
+    return hour % FORECAST_RING_HOURS;
+}
+
+// Starts a new forecast of `length` hours (clamped to FORECAST_MAX_HOURS)
+// with nothing loaded
+void forecast_reset(uint8_t length);
+
+// Stores a HOUR_DATA blob holding hours first_hour..first_hour + 11, evicting
+// whichever block shared its ring position
+void forecast_store_block(uint8_t first_hour, const uint8_t* data);
+
+// Replaces the forecast with a single 12-hour HOUR_DATA blob
+void forecast_set_hour_data(const uint8_t* data);
+
+// Handles HOUR_DATA (and its HOUR_BLOCK / FORECAST_HOURS companions) in an
+// inbox message. HOUR_DATA may hold several consecutive blocks. Returns true
+// if a block was stored. HOUR_BLOCK without HOUR_DATA is the phone saying it
+// has no such block, which ends the request for it.
+bool forecast_receive(DictionaryIterator* iter);
+
+uint8_t forecast_length(void);
+bool forecast_has_hour(uint8_t hour);
+bool forecast_slot_loaded(uint8_t slot);
+
+// Asks the phone for the block the viewer will need next from `hour`, if it
+// is missing and not already on its way. A request left unanswered times out
+// so a later prefetch can send it again.
+void forecast_prefetch(uint8_t hour);
+
+// Forgets an outstanding REQUEST_HOUR so the next prefetch sends it again
+void forecast_request_failed(void);
+
+// Field accessors (hour_temp() and friends) are generated into
+// wire_format.auto.h from the schema
+
+static inline bool hour_has(const uint8_t* pkg, uint8_t i, uint8_t flag) {
+    return (hour_flags(pkg, i) & flag) != 0;
+}
+
+// Wind vane direction (0-15 in 22.5 degree steps, N clockwise), following the
+// user's wind vane preference; -1 when the hour has no wind direction
+#define WIND_DIRECTIONS 16
+int8_t hour_wind_direction(const uint8_t* pkg, uint8_t i);
+
+// Wind speed band, for the wind speed icon and the airflow page's colour
+#define WIND_SPEED_SLOW 0
+#define WIND_SPEED_MED 1
+#define WIND_SPEED_FAST 2
+#define WIND_SPEED_LEVELS 3
+uint8_t hour_wind_speed_level(const uint8_t* pkg, uint8_t i);
+
+// "12PM"-style label for an hour of day; points at a constant string
+const char* hour_label(const uint8_t* pkg, uint8_t i);
+
+/*
+    String formatters, in the user's units. `out` must hold at least
+    MAX_STRING_LENGTH bytes.
+
+    temperature:  "72°F"
+    conditions:   "72°F\nPartly\nCloudy"
+    airflow:      "12mph SW\n18mph gusts\n1004mb"
+    experiential: "Feels 64°F\nUVI 2\nVis. 20mi"
+*/
+void format_hour_temperature(const uint8_t* pkg, uint8_t i, char* out);
+void format_hour_conditions(const uint8_t* pkg, uint8_t i, char* out);
+void format_hour_airflow(const uint8_t* pkg, uint8_t i, char* out);
+void format_hour_experiential(const uint8_t* pkg, uint8_t i, char* out);
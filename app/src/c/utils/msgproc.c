@@ -1,226 +1,8 @@
 #include "msgproc.h"
 #include "utils_common.h"
 #include "weather.h"
-#include "prefs.h"
-#include <string.h>
 
-// Unpack all 12 hour packages from a single 120-byte binary blob
-void unpack_all_hours(uint8_t* data, ForecastHour* forecast_hours_array) {
-    for (int i = 0; i < 12; i++) {
-        // Each hour package is 10 bytes, starting at offset i * 10
-        unpack_hour_package(&data[i * 10], &forecast_hours_array[i]);
-    }
-}
-
-// TODO: build wind icons here
-void unpack_hour_package(HourPackage weather_data, ForecastHour* forecast_hour) {
-    // Hour (uint8)
-    int hour = weather_data[0];
-
-    // Temperature (int8)
-    int temp = (int8_t)weather_data[1];
-
-    // Feels like temperature (int8)
-    int feels_like = (int8_t)weather_data[2];
-
-    // Wind speed (uint8)
-    int wind_speed = weather_data[3];
-
-    forecast_hour->wind_speed = wind_speed;
-
-
-    // Set wind speed icon based on wind speed thresholds
-    uint8_t wind_speed_level;  // 0 = slow, 1 = med, 2 = fast
-    if (wind_speed <= 19) { 
-        //beaufort 3 and below
-        wind_speed_level = 0;  // Slow
-    } else if (wind_speed <= 38) { 
-        //beaufort 5 and below
-        wind_speed_level = 1;  // Med
-    } else { 
-        //beaufort 6 and above
-        wind_speed_level = 2;  // Fast
-    }
-
-    // Wind gust speed (uint8) and data flags
-    int wind_gust = weather_data[4];
-    
-    // Visibility (uint8)
-    int visibility = weather_data[5];
-
-    // Pressure (int8, difference from 1000mb)
-    int pressure_mb = ((int8_t)weather_data[6]) + 1000;
-
-    // Wind direction (4 bits) and air quality (4 bits)
-    uint8_t wind_dir4 = weather_data[7] >> 4;
-    uint8_t aqi4 = weather_data[7] & 0x0F;
-
-    // UV index (4 bits) and data flags (4 bits)
-    uint8_t uv_index = weather_data[8] >> 4;
-    uint8_t data_flags = weather_data[8] & 0x0F;
-
-    // Extract data availability flags
-    bool has_wind_gust = (data_flags & 0x4) != 0;
-    bool has_wind_dir = (data_flags & 0x2) != 0;
-    bool has_air_quality = (data_flags & 0x1) != 0;
-
-    // Condition and experiential icons (uint4 each)
-    forecast_hour->conditions_icon = weather_data[9] >> 4;
-    forecast_hour->experiential_icon = weather_data[9] & 0x0F;
-
-    // Get user preferences
-    ClaySettings* settings = prefs_get_settings();
-
-    // Format hour string (e.g., "12PM")
-    if (hour == 0) {
-        strcpy(forecast_hour->hour_string, "12AM");
-    } else if (hour < 12) {
-        snprintf(forecast_hour->hour_string, 5, "%dAM", hour);
-    } else if (hour == 12) {
-        strcpy(forecast_hour->hour_string, "12PM");
-    } else {
-        snprintf(forecast_hour->hour_string, 5, "%dPM", hour - 12);
-    }
-
-    // Convert temperature if needed
-    if (strcmp(settings->temperature_units, "C") == 0) {
-        temp = fahrenheit_to_celsius(temp);
-        feels_like = fahrenheit_to_celsius(feels_like);
-    }
-
-    // Format conditions string (e.g., "72°\nMostly\nCloudy")
-    snprintf(forecast_hour->conditions_string, MAX_STRING_LENGTH - 1,
-             "%d°%s\n%s",
-             temp,
-             settings->temperature_units,
-             get_weather_condition_string(forecast_hour->conditions_icon));
-    forecast_hour->conditions_string[MAX_STRING_LENGTH - 1] = '\0';
-
-    // Convert wind speed if needed
-    if (strcmp(settings->velocity_units, "mph") == 0) {
-        wind_speed = kph_to_mph(wind_speed);
-        if (has_wind_gust) wind_gust = kph_to_mph(wind_gust);
-    } else if (strcmp(settings->velocity_units, "m/s") == 0) {
-        wind_speed = kph_to_mps(wind_speed);
-        if (has_wind_gust) wind_gust = kph_to_mps(wind_gust);
-    }
-
-    // Convert visibility if needed
-    if (strcmp(settings->distance_units, "mi") == 0) {
-        visibility = km_to_miles(visibility);
-    }
-
-
-
-    // Format airflow string with appropriate units, including only available data
-    char airflow_buffer[MAX_STRING_LENGTH];
-    int written = 0;
-
-    // Start with wind speed (always available)
-    written += snprintf(airflow_buffer + written, MAX_STRING_LENGTH - written,
-                       "%d%s", wind_speed, settings->velocity_units);
-
-    // Add wind direction if available
-    if (has_wind_dir) {
-        written += snprintf(airflow_buffer + written, MAX_STRING_LENGTH - written,
-                          " %s", get_wind_direction_string(wind_dir4));
-        // Map 16 directions to 8 directions:
-        // Cardinals (0,4,8,12) map to (0,2,4,6)
-        // All others map to diagonals (1,3,5,7)
-        //theres gotta be a better mathy moduly way to do this
-        if (wind_dir4 == 0) {
-            forecast_hour->wind_direction = 0;  // N
-        } else if (wind_dir4 == 4) {
-            forecast_hour->wind_direction = 2;  // E  
-        } else if (wind_dir4 == 8) {
-            forecast_hour->wind_direction = 4;  // S
-        } else if (wind_dir4 == 12) {
-            forecast_hour->wind_direction = 6;  // W
-        } else if (wind_dir4 >= 1 && wind_dir4 <= 3) {
-            forecast_hour->wind_direction = 1;  // NE quadrant
-        } else if (wind_dir4 >= 5 && wind_dir4 <= 7) {
-            forecast_hour->wind_direction = 3;  // SE quadrant
-        } else if (wind_dir4 >= 9 && wind_dir4 <= 11) {
-            forecast_hour->wind_direction = 5;  // SW quadrant
-        } else { // wind_dir4 >= 13 && wind_dir4 <= 15
-            forecast_hour->wind_direction = 7;  // NW quadrant
-        }
-
-        UTIL_LOG(APP_LOG_LEVEL_DEBUG, "wind vane direction: %d", settings->wind_vane_direction);
-
-        // The incoming wind direction represents where wind is coming FROM (meteorological convention)
-        // If wind_vane_direction == 0 (wind heading), we need to show where wind is blowing TO
-        // So we rotate 180 degrees (add 4 in our 8-direction system)
-        if(settings->wind_vane_direction == 0) {
-            forecast_hour->wind_direction = (forecast_hour->wind_direction + 4) % 8;
-        }
-
-        // Compute the wind speed resource ID based on speed level and direction
-        // Resource IDs are defined in package.json as:
-        // WIND_SPEED_SLOW_N, WIND_SPEED_SLOW_NE, WIND_SPEED_SLOW_E, etc.
-        // WIND_SPEED_MED_N, WIND_SPEED_MED_NE, WIND_SPEED_MED_E, etc.
-        // WIND_SPEED_FAST_N, WIND_SPEED_FAST_NE, WIND_SPEED_FAST_E, etc.
-        
-        // Base resource IDs for each speed level (first in each group)
-        const uint32_t speed_base_ids[] = {
-            RESOURCE_ID_WIND_SPEED_SLOW_N,   // 0: Slow
-            RESOURCE_ID_WIND_SPEED_MED_N,    // 1: Med
-            RESOURCE_ID_WIND_SPEED_FAST_N    // 2: Fast
-        };
-        
-        // Calculate resource ID: base + direction offset
-        forecast_hour->wind_speed_resource_id = speed_base_ids[wind_speed_level] + forecast_hour->wind_direction;
-    } else {
-        // No wind direction available, set resource ID to 0 (will not be used)
-        forecast_hour->wind_speed_resource_id = 0;
-    }
-
-    // Add wind gust if available
-    if (has_wind_gust) {
-        written += snprintf(airflow_buffer + written, MAX_STRING_LENGTH - written,
-                          "\n%d%s gusts", wind_gust, settings->velocity_units);
-    }
-
-    // Add pressure (always available)
-    if (strcmp(settings->pressure_units, "in") == 0) {
-        // For inHg, use the x100 function to get value multiplied by 100
-        uint16_t pressure_x100 = mb_to_inHg_x100(pressure_mb);
-        written += snprintf(airflow_buffer + written, MAX_STRING_LENGTH - written,
-                           "\n%d.%02d%s", pressure_x100 / 100, pressure_x100 % 100, settings->pressure_units);
-    } else {
-        written += snprintf(airflow_buffer + written, MAX_STRING_LENGTH - written,
-                           "\n%d%s", pressure_mb, settings->pressure_units);
-    }
-
-    strncpy(forecast_hour->airflow_string, airflow_buffer, MAX_STRING_LENGTH - 1);
-    forecast_hour->airflow_string[MAX_STRING_LENGTH - 1] = '\0';
-
-    // Format experiential string with appropriate units
-    written = 0;
-    char experiential_buffer[MAX_STRING_LENGTH];
-
-    // Start with feels like temperature (always available)
-    written += snprintf(experiential_buffer + written, MAX_STRING_LENGTH - written,
-                       "Feels %d°%s", feels_like, settings->temperature_units);
-
-    // Add UV index (and air quality if available)
-    if (has_air_quality) {
-        written += snprintf(experiential_buffer + written, MAX_STRING_LENGTH - written,
-                          "\nUVI %d AQI %d", uv_index, aqi4 * 50);
-    } else {
-        written += snprintf(experiential_buffer + written, MAX_STRING_LENGTH - written,
-                          "\nUVI %d", uv_index);
-    }
-
-    // Add visibility (always available)
-    written += snprintf(experiential_buffer + written, MAX_STRING_LENGTH - written,
-                       "\nVis. %d%s", visibility, settings->distance_units);
-
-    strncpy(forecast_hour->experiential_string, experiential_buffer, MAX_STRING_LENGTH - 1);
-    forecast_hour->experiential_string[MAX_STRING_LENGTH - 1] = '\0';
-}
-
-void format_precipitation_string(Precipitation* precipitation, const char* temp_line) {
+void format_precipitation_string(const Precipitation* precipitation, const char* temp_line, char* out) {
     const uint8_t type = precipitation->precipitation_type;
     const uint8_t* intensity = precipitation->precipitation_intensity;
 
@@ -233,10 +15,10 @@ void format_precipitation_string(Precipitation* precipitation, const char* temp_
 
         if (start < PRECIPITATION_INTERVALS) {
             int minutes_until = start * 5;
-            snprintf(precipitation->precipitation_string, MAX_STRING_LENGTH - 1,
+            snprintf(out, MAX_STRING_LENGTH,
                     "%s\n%s\nin %dm", temp_line, get_precipitation_string(type), minutes_until);
         } else {
-            snprintf(precipitation->precipitation_string, MAX_STRING_LENGTH - 1,
+            snprintf(out, MAX_STRING_LENGTH,
                     "%s\nNo precipitation", temp_line);
         }
     } else {
@@ -249,36 +31,80 @@ void format_precipitation_string(Precipitation* precipitation, const char* temp_
 
         int duration = (end + 1) * 5;
         if (duration > 60) {
-            snprintf(precipitation->precipitation_string, MAX_STRING_LENGTH - 1,
+            snprintf(out, MAX_STRING_LENGTH,
                     "%s\n%s\nfor 1h+", temp_line, get_precipitation_string(type));
         } else {
-            snprintf(precipitation->precipitation_string, MAX_STRING_LENGTH - 1,
+            snprintf(out, MAX_STRING_LENGTH,
                     "%s\n%s\nfor %dm", temp_line, get_precipitation_string(type), duration);
         }
     }
-    precipitation->precipitation_string[MAX_STRING_LENGTH - 1] = '\0';
+}
+
+void interpolate_precipitation_minutes(Precipitation* precipitation) {
+    const uint8_t* intensity = precipitation->precipitation_intensity;
+    for (int minute = 0; minute < PRECIPITATION_MINUTES; minute++) {
+        int interval = minute / PRECIPITATION_INTERVAL_MINUTES;
+        int into = minute % PRECIPITATION_INTERVAL_MINUTES;
+        int from = intensity[interval] * PRECIPITATION_LEVEL_STEPS;
+        int to = intensity[interval + 1] * PRECIPITATION_LEVEL_STEPS;
+        precipitation->minute_steps[minute] =
+            (from * (PRECIPITATION_INTERVAL_MINUTES - into) + to * into) / PRECIPITATION_INTERVAL_MINUTES;
+    }
 }
 
 void unpack_precipitation(PrecipitationPackage weather_data, Precipitation* precipitation) {
-    // First byte: precipitation type (uint8)
-    precipitation->precipitation_type = weather_data[0];
+    precipitation->precipitation_type = precip_type(weather_data);
+    precip_intensity_all(weather_data, precipitation->precipitation_intensity);
+    precipitation->chance = 0;
+    interpolate_precipitation_minutes(precipitation);
+}
 
-    // Next 6 bytes: 24 precipitation intensity values (2 bits each)
-    // Each byte contains 4 intensity values
-    for (int i = 0; i < 6; i++) {
-        uint8_t byte = weather_data[i + 1];
-        for (int j = 0; j < 4; j++) {
-            int index = i * 4 + j;
-            if (index < PRECIPITATION_INTERVALS) {
-                precipitation->precipitation_intensity[index] = (byte >> (j * 2)) & 0x03;
+bool unpack_precipitation_minutes(const uint8_t* data, uint16_t length, Precipitation* precipitation) {
+    // Later versions append fields, so anything at least this long is readable
+    if (length < PRECIPITATION_MINUTES_PACKAGE_SIZE || precip_minutes_version(data) < PRECIPITATION_MINUTES_VERSION) {
+        return false;
+    }
+    precipitation->precipitation_type = precip_minutes_type(data);
+    uint8_t chance = precip_minutes_chance(data);
+    precipitation->chance = chance < 100 ? chance : 100;
+    precip_minutes_steps_all(data, precipitation->minute_steps);
+
+    // The intervals in the first hour become the wettest minute of each; the
+    // second hour only comes in the legacy package
+    for (int interval = 0; interval < PRECIPITATION_MINUTES / PRECIPITATION_INTERVAL_MINUTES; interval++) {
+        uint8_t steps = 0;
+        for (int i = 0; i < PRECIPITATION_INTERVAL_MINUTES; i++) {
+            uint8_t minute_steps = precipitation->minute_steps[interval * PRECIPITATION_INTERVAL_MINUTES + i];
+            if (minute_steps > steps) {
+                steps = minute_steps;
             }
         }
+        precipitation->precipitation_intensity[interval] =
+            (steps + PRECIPITATION_LEVEL_STEPS - 1) / PRECIPITATION_LEVEL_STEPS;
     }
+    return true;
+}
+
+bool precipitation_receive(DictionaryIterator* iter) {
+    bool received = false;
 
-    // Get the temperature from the first forecast hour
-    char temp_line[MAX_STRING_LENGTH];
-    strncpy(temp_line, forecast_hours[0].conditions_string, strchr(forecast_hours[0].conditions_string, '\n') - forecast_hours[0].conditions_string);
-    temp_line[strchr(forecast_hours[0].conditions_string, '\n') - forecast_hours[0].conditions_string] = '\0';
+    Tuple* package_tuple = dict_find(iter, MESSAGE_KEY_PRECIPITATION_PACKAGE);
+    if (package_tuple && package_tuple->length < PRECIPITATION_PACKAGE_SIZE) {
+        UTIL_LOG(APP_LOG_LEVEL_ERROR, "Precipitation package too short: %d bytes", (int)package_tuple->length);
+    } else if (package_tuple) {
+        unpack_precipitation((PrecipitationPackage)package_tuple->value->data, &precipitation);
+        received = true;
+    }
 
-    format_precipitation_string(precipitation, temp_line);
+    // Newer phones send the minutes in the same message; they replace the
+    // first hour of the legacy package
+    Tuple* minutes_tuple = dict_find(iter, MESSAGE_KEY_PRECIPITATION_MINUTES);
+    if (minutes_tuple) {
+        if (unpack_precipitation_minutes(minutes_tuple->value->data, minutes_tuple->length, &precipitation)) {
+            received = true;
+        } else {
+            UTIL_LOG(APP_LOG_LEVEL_ERROR, "Unreadable precipitation minutes: %d bytes", (int)minutes_tuple->length);
+        }
+    }
+    return received;
 }
@@ -5,66 +5,47 @@
     The messages use a compact binary format to minimize data transfer while preserving
     precision of important weather metrics.
 
-    Two message types are supported:
+    Three message types are supported:
     1. Hourly forecast data (10 bytes per hour)
     2. Precipitation data (7 bytes for 2 hours of 5-min intervals)
+    3. Precipitation minutes (33 bytes for the next hour, minute by minute)
 */
 
 #pragma once
 
 #include <pebble.h>
 #include "weather.h"
+#include "wire_format.auto.h"
 
 /*
+    Both layouts are defined in app/schema/wire_format.json, which generates
+    the C accessors in wire_format.auto.h and the matching JS packers. Change
+    a field there, never by hand on one side.
 
-    managed to cram 12 fields into 10 bytes, so it can be sent easily at the expense of having to be unpacked
-    Weather data is sent as one big 80 bit value, packaged in this format:
-
-    uint8: hour of day
-    int8: temperature degrees (f)
-    int8: temperature (feels like) degrees (f)
-    uint8: wind speed (kph)
-    uint8: wind gust speed (kph)
-    uint8: visibility (km)
-    int8: pressure difference from 1000mb (-128 to 127)
-    uint4: wind direction (0-15) in 22.5 degree increments
-    uint4: air quality index (0-15) 0-500 in steps of 50
-    uint4: UV index (0-15)
-    uint4: data flags (0000 -> empty, windgust, winddir, airquality)
-    uint4: condition icon code
-    uint4: experiential icon code
-
-    Data flags indicate which optional fields are available:
-    - Bit 3: Unused (reserved)
-    - Bit 2: Wind gust available
-    - Bit 1: Wind direction available
-    - Bit 0: Air quality available
+    All 12 hour packages of a block arrive as a single 120-byte blob. They are
+    not unpacked; forecast.h reads fields straight out of it.
 */
 
-void unpack_hour_package(HourPackage weather_data, ForecastHour* forecast_hour);
-
-/*
-    Unpacks all 12 hour packages from a single 120-byte binary blob.
-    Each hour package is 10 bytes, stored sequentially.
-    
-    uint8[120]: 12 consecutive hour packages (10 bytes each)
-*/
-void unpack_all_hours(uint8_t* data, ForecastHour* forecast_hours_array);
+#define HOUR_DATA_SIZE (12 * HOUR_PACKAGE_SIZE)
 
-/*
-    Special details can be provided to the current hour, such as precipitation
+// Legacy 7-byte package: 24 five-minute levels. minute_steps is
+// interpolated between them.
+void unpack_precipitation(PrecipitationPackage weather_data, Precipitation* precipitation);
 
-    uint8: precipitation type (0 for none)
-    uint2 * [24]: precipitation intensity (on a scale of 0-3) in 5 minute intervals, for up to 2 hours
+// PRECIPITATION_MINUTES package: 60 one-minute samples and a chance. Fills
+// the first 12 five-minute levels from the minutes and leaves the rest.
+// False if the package is too short or older than this app understands.
+bool unpack_precipitation_minutes(const uint8_t* data, uint16_t length, Precipitation* precipitation);
 
-*/
+// Fills minute_steps from precipitation_intensity (demo data, legacy phones)
+void interpolate_precipitation_minutes(Precipitation* precipitation);
 
-void unpack_precipitation(PrecipitationPackage weather_data, Precipitation* precipitation);
+// Handles PRECIPITATION_PACKAGE and/or PRECIPITATION_MINUTES in an inbox
+// message into the global `precipitation`. Returns true if either was used.
+bool precipitation_receive(DictionaryIterator* iter);
 
 /*
-    Formats precipitation->precipitation_string based on
-    precipitation_intensity[] plus the supplied `temp_line` prefix.
-
-    Shared by msgproc (live data) and demo (preset data).
+    Formats the "72°F\nRain\nfor 15m" text into `out` (MAX_STRING_LENGTH
+    bytes) from precipitation_intensity[] plus the supplied `temp_line` prefix.
 */
-void format_precipitation_string(Precipitation* precipitation, const char* temp_line);
\ No newline at end of file
+void format_precipitation_string(const Precipitation* precipitation, const char* temp_line, char* out);
\ No newline at end of file
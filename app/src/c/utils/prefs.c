@@ -4,17 +4,102 @@
 
 static ClaySettings settings;
 
+// The layout before PREFS_VERSION existed: unit strings and full-width
+// numbers, saved without a version. Only read, to migrate it.
+typedef struct LegacySettings {
+    char temperature_units[4];
+    char velocity_units[4];
+    char distance_units[4];
+    char pressure_units[4];
+    char precipitation_units[4];
+    int32_t refresh_interval;
+    bool self_refresh;
+    int32_t display_interval;
+    bool animate;
+    int16_t wind_vane_direction;
+} LegacySettings;
+
+// The legacy layout is recognised by its size alone
+_Static_assert(sizeof(ClaySettings) != sizeof(LegacySettings), "settings layouts must differ in size");
+
 static void prv_default_settings(void) {
-    strcpy(settings.temperature_units, "F");
-    strcpy(settings.velocity_units, "mph");
-    strcpy(settings.distance_units, "mi");
-    strcpy(settings.pressure_units, "mb");
-    strcpy(settings.precipitation_units, "in");
-    settings.refresh_interval = 30;
-    settings.self_refresh = true;
-    settings.display_interval = 2;
-    settings.animate = true;
-    settings.wind_vane_direction = 0;
+    settings = (ClaySettings){
+        .version = PREFS_VERSION,
+        .temperature_units = TEMPERATURE_FAHRENHEIT,
+        .velocity_units = VELOCITY_MPH,
+        .distance_units = DISTANCE_MILES,
+        .pressure_units = PRESSURE_MILLIBARS,
+        .precipitation_units = PRECIPITATION_INCHES,
+        .refresh_interval = 30,
+        .self_refresh = true,
+        .display_interval = 2,
+        .animate = true,
+        .wind_vane_direction = 0,
+    };
+}
+
+static uint8_t prv_parse(const char* value, const char* const* names, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (strcmp(value, names[i]) == 0) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+TemperatureUnits prefs_parse_temperature_units(const char* value) {
+    static const char* const names[] = {"F", "C"};
+    return prv_parse(value, names, ARRAY_LENGTH(names));
+}
+
+VelocityUnits prefs_parse_velocity_units(const char* value) {
+    static const char* const names[] = {"mph", "kph", "m/s"};
+    return prv_parse(value, names, ARRAY_LENGTH(names));
+}
+
+DistanceUnits prefs_parse_distance_units(const char* value) {
+    static const char* const names[] = {"mi", "km"};
+    return prv_parse(value, names, ARRAY_LENGTH(names));
+}
+
+PressureUnits prefs_parse_pressure_units(const char* value) {
+    static const char* const names[] = {"mb", "in"};
+    return prv_parse(value, names, ARRAY_LENGTH(names));
+}
+
+PrecipitationUnits prefs_parse_precipitation_units(const char* value) {
+    static const char* const names[] = {"in", "mm"};
+    return prv_parse(value, names, ARRAY_LENGTH(names));
+}
+
+static void prv_migrate_legacy(LegacySettings* legacy) {
+    // Never trust a stored string to be terminated
+    legacy->temperature_units[3] = legacy->velocity_units[3] = legacy->distance_units[3] = '\0';
+    legacy->pressure_units[3] = legacy->precipitation_units[3] = '\0';
+
+    settings.temperature_units = prefs_parse_temperature_units(legacy->temperature_units);
+    settings.velocity_units = prefs_parse_velocity_units(legacy->velocity_units);
+    settings.distance_units = prefs_parse_distance_units(legacy->distance_units);
+    settings.pressure_units = prefs_parse_pressure_units(legacy->pressure_units);
+    settings.precipitation_units = prefs_parse_precipitation_units(legacy->precipitation_units);
+    if (legacy->refresh_interval > 0 && legacy->refresh_interval <= UINT8_MAX) {
+        settings.refresh_interval = legacy->refresh_interval;
+    }
+    settings.self_refresh = legacy->self_refresh;
+    if (legacy->display_interval == 1 || legacy->display_interval == 2) {
+        settings.display_interval = legacy->display_interval;
+    }
+    settings.animate = legacy->animate;
+    settings.wind_vane_direction = legacy->wind_vane_direction != 0;
+}
+
+// Brings a stored layout up to PREFS_VERSION. A new version only appends
+// fields, so older data is read over the defaults and whatever it lacks
+// keeps its default. A version that changes what an existing field means
+// gets a step here, converting from the version before it, ordered so
+// each step falls through to the next.
+static void prv_migrate(ClaySettings* stored) {
+    stored->version = PREFS_VERSION;
 }
 
 void prefs_init(void) {
@@ -22,14 +107,26 @@ void prefs_init(void) {
 }
 
 void prefs_load(void) {
-    // Load defaults first; keep them unless a full struct is recovered from
-    // persistent storage. Partial/short reads (e.g. after changing the
-    // struct layout) would otherwise leave some fields uninitialized.
     prv_default_settings();
 
-    int read = persist_read_data(SETTINGS_KEY, &settings, sizeof(settings));
-    if (read != (int)sizeof(settings)) {
-        prv_default_settings();
+    int size = persist_get_size(SETTINGS_KEY);
+    if (size == (int)sizeof(LegacySettings)) {
+        LegacySettings legacy;
+        persist_read_data(SETTINGS_KEY, &legacy, sizeof(legacy));
+        prv_migrate_legacy(&legacy);
+        prefs_save();
+    } else if (size > 0) {
+        ClaySettings stored = settings;
+        persist_read_data(SETTINGS_KEY, &stored, sizeof(stored));
+        // Written by a newer version of the app: its layout is unknown here
+        if (stored.version == 0 || stored.version > PREFS_VERSION) {
+            return;
+        }
+        settings = stored;
+        if (settings.version != PREFS_VERSION) {
+            prv_migrate(&settings);
+            prefs_save();
+        }
     }
 }
 
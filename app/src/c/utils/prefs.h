@@ -2,24 +2,35 @@
 
 #include <pebble.h>
 
-// Settings structure to hold all user preferences
+// Units, stored as they are shown: index the display strings with these
+typedef enum { TEMPERATURE_FAHRENHEIT, TEMPERATURE_CELSIUS } TemperatureUnits;
+typedef enum { VELOCITY_MPH, VELOCITY_KPH, VELOCITY_MPS } VelocityUnits;
+typedef enum { DISTANCE_MILES, DISTANCE_KILOMETERS } DistanceUnits;
+typedef enum { PRESSURE_MILLIBARS, PRESSURE_INCHES } PressureUnits;
+typedef enum { PRECIPITATION_INCHES, PRECIPITATION_MILLIMETERS } PrecipitationUnits;
+
+// Bumped whenever the layout below changes; see prefs_load()
+#define PREFS_VERSION 1
+
+// Settings structure to hold all user preferences, persisted as is
 typedef struct ClaySettings {
-    char temperature_units[4];    // "F" or "C"
-    char velocity_units[4];       // "mph", "kph", or "mps"
-    char distance_units[4];       // "mi" or "km"
-    char pressure_units[4];       // "mb" or "in"
-    char precipitation_units[4];  // "in" or "mm"
-    int32_t refresh_interval;     // 20, 30, or 60 minutes
-    bool self_refresh;            // true or false - enables self-refresh functionality
-    int32_t display_interval;     // 1 or 2 hours
-    bool animate;                 // true or false - enables animations
-    int16_t wind_vane_direction;  // 0 = wind heading, 1 = wind origin
+    uint8_t version;                  // PREFS_VERSION when saved
+    uint8_t temperature_units : 1;    // TemperatureUnits
+    uint8_t velocity_units : 2;       // VelocityUnits
+    uint8_t distance_units : 1;       // DistanceUnits
+    uint8_t pressure_units : 1;       // PressureUnits
+    uint8_t precipitation_units : 1;  // PrecipitationUnits
+    uint8_t self_refresh : 1;         // enables self-refresh functionality
+    uint8_t animate : 1;              // enables animations
+    uint8_t wind_vane_direction : 1;  // 0 = wind heading, 1 = wind origin
+    uint8_t display_interval : 2;     // 1 or 2 hours
+    uint8_t refresh_interval;         // 20, 30, or 60 minutes
 } ClaySettings;
 
 // Initialize preferences with default values
 void prefs_init(void);
 
-// Load preferences from persistent storage
+// Load preferences from persistent storage, migrating older layouts
 void prefs_load(void);
 
 // Save preferences to persistent storage
@@ -27,3 +38,11 @@ void prefs_save(void);
 
 // Get the current settings
 ClaySettings* prefs_get_settings(void);
+
+// Decode the unit values the config page sends ("C", "m/s", ...); anything
+// unrecognised reads as the default
+TemperatureUnits prefs_parse_temperature_units(const char* value);
+VelocityUnits prefs_parse_velocity_units(const char* value);
+DistanceUnits prefs_parse_distance_units(const char* value);
+PressureUnits prefs_parse_pressure_units(const char* value);
+PrecipitationUnits prefs_parse_precipitation_units(const char* value);
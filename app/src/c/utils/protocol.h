@@ -0,0 +1,64 @@
+/*
+    AppMessage Protocol
+
+    Every message type the watch and PebbleKit JS exchange, with the size of
+    its dictionary. The AppMessage buffers are opened at the largest of these,
+    so a new message type or a bigger payload grows them automatically.
+
+    PROTOCOL_DICT_SIZE is dict_calc_buffer_size() as a constant expression:
+    a 1-byte dictionary header plus a 7-byte header (key, type, length) per
+    tuple. PebbleKit JS sends every number as an int32, and the phone adds a
+    SEQ to each of its messages (see transport.h).
+
+    Phone to watch:
+      JS_READY                JS_READY, SEQ
+      RESPONSE_DATA           RESPONSE_DATA, SEQ
+      hour blocks             HOUR_DATA (up to a ring of hours), HOUR_BLOCK,
+                              FORECAST_HOURS, SEQ
+      no such block           HOUR_BLOCK, SEQ (answers a REQUEST_HOUR)
+      precipitation           PRECIPITATION_PACKAGE, PRECIPITATION_MINUTES
+                              (newer phones), SEQ
+      settings (Clay)         the CFG_* keys, sent by Clay itself (no SEQ):
+                              units as short strings ("mph", "m/s", ...),
+                              selects as number strings ("30"), toggles as
+                              int32. main.c parses them into the enums and
+                              bitfields of ClaySettings.
+
+    Watch to phone, one int32 each:
+      REQUEST_HOUR, REQUEST_DATA, INBOX_SIZE
+*/
+
+#pragma once
+
+#include <pebble.h>
+#include "forecast.h"
+
+#define PROTOCOL_DICT_HEADER_SIZE 1
+#define PROTOCOL_TUPLE_HEADER_SIZE 7
+#define PROTOCOL_INT_SIZE 4
+#define PROTOCOL_DICT_SIZE(tuples, payload_bytes) \
+    (PROTOCOL_DICT_HEADER_SIZE + (tuples) * PROTOCOL_TUPLE_HEADER_SIZE + (payload_bytes))
+#define PROTOCOL_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+// CFG_TEMPERATURE_UNITS through CFG_WIND_VANE_DIRECTION. No value is longer
+// than an int32: the longest strings are the velocity units, "mph", "kph"
+// and "m/s" with their terminator.
+#define PROTOCOL_SETTINGS_KEYS 10
+#define PROTOCOL_SETTING_SIZE PROTOCOL_INT_SIZE
+
+#define PROTOCOL_JS_READY_SIZE PROTOCOL_DICT_SIZE(2, 2 * PROTOCOL_INT_SIZE)
+#define PROTOCOL_RESPONSE_DATA_SIZE PROTOCOL_DICT_SIZE(2, 2 * PROTOCOL_INT_SIZE)
+#define PROTOCOL_HOUR_BLOCKS_SIZE \
+    PROTOCOL_DICT_SIZE(4, FORECAST_RING_HOURS * HOUR_PACKAGE_SIZE + 3 * PROTOCOL_INT_SIZE)
+#define PROTOCOL_PRECIPITATION_SIZE \
+    PROTOCOL_DICT_SIZE(3, PRECIPITATION_PACKAGE_SIZE + PRECIPITATION_MINUTES_PACKAGE_SIZE + PROTOCOL_INT_SIZE)
+#define PROTOCOL_SETTINGS_SIZE \
+    PROTOCOL_DICT_SIZE(PROTOCOL_SETTINGS_KEYS, PROTOCOL_SETTINGS_KEYS * PROTOCOL_SETTING_SIZE)
+
+#define PROTOCOL_REQUEST_SIZE PROTOCOL_DICT_SIZE(1, PROTOCOL_INT_SIZE)
+
+#define PROTOCOL_INBOX_SIZE                                                                        \
+    PROTOCOL_MAX(PROTOCOL_MAX(PROTOCOL_JS_READY_SIZE, PROTOCOL_RESPONSE_DATA_SIZE),                \
+                 PROTOCOL_MAX(PROTOCOL_MAX(PROTOCOL_HOUR_BLOCKS_SIZE, PROTOCOL_PRECIPITATION_SIZE), \
+                              PROTOCOL_SETTINGS_SIZE))
+#define PROTOCOL_OUTBOX_SIZE PROTOCOL_REQUEST_SIZE
@@ -0,0 +1,40 @@
+#include "startup.h"
+#include "utils_common.h"
+
+static const char* const STAGE_NAMES[STARTUP_STAGE_COUNT] = {
+    "splash shown",
+    "viewer built",
+    "icons loaded",
+    "data ready",
+    "viewer shown",
+};
+
+static StartupStats s_stats;
+static uint32_t s_start_ms;
+static uint8_t s_reached;   // One bit per stage
+
+static uint32_t prv_now_ms(void) {
+    time_t seconds;
+    uint16_t ms;
+    time_ms(&seconds, &ms);
+    return (uint32_t)seconds * 1000 + ms;
+}
+
+void startup_begin(void) {
+    s_stats = (StartupStats){0};
+    s_reached = 0;
+    s_start_ms = prv_now_ms();
+}
+
+void startup_mark(StartupStage stage) {
+    if (stage >= STARTUP_STAGE_COUNT || (s_reached & (1 << stage))) {
+        return;
+    }
+    s_reached |= 1 << stage;
+    s_stats.stage_ms[stage] = prv_now_ms() - s_start_ms;
+    UTIL_LOG(APP_LOG_LEVEL_DEBUG, "Startup: %s at %lu ms", STAGE_NAMES[stage], s_stats.stage_ms[stage]);
+}
+
+const StartupStats* startup_get_stats(void) {
+    return &s_stats;
+}
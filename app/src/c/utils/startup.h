@@ -0,0 +1,35 @@
+/*
+    Startup Stages
+
+    Timestamps for the staged startup in main.c. The viewer is built while
+    the splash waits on the phone, the forecast's icons are loaded as soon
+    as the first hours arrive and the viewer is pushed the moment the
+    forecast is complete, with no fixed delays in between. Each stage is
+    stamped the first time it is reached, in milliseconds since
+    startup_begin().
+*/
+
+#pragma once
+
+#include <pebble.h>
+
+typedef enum {
+    STARTUP_STAGE_SPLASH_SHOWN,     // Splash pushed
+    STARTUP_STAGE_VIEWER_BUILT,     // Viewer layers and forecast-independent images ready
+    STARTUP_STAGE_ICONS_LOADED,     // First hours in, their icons loaded
+    STARTUP_STAGE_DATA_READY,       // Hours and precipitation both in
+    STARTUP_STAGE_VIEWER_SHOWN,     // Viewer pushed over the splash
+    STARTUP_STAGE_COUNT,
+} StartupStage;
+
+typedef struct StartupStats {
+    uint32_t stage_ms[STARTUP_STAGE_COUNT];     // 0 until reached
+} StartupStats;
+
+// Starts the clock and forgets the stages of any earlier run
+void startup_begin(void);
+
+// Stamps a stage; only its first time counts
+void startup_mark(StartupStage stage);
+
+const StartupStats* startup_get_stats(void);
@@ -0,0 +1,207 @@
+#include "transport.h"
+#include "utils_common.h"
+#include "protocol.h"
+
+// Inbound SEQs remembered for spotting repeats; the phone keeps at most a
+// couple of messages in flight, so a repeat is always recent
+#define SEQ_WINDOW 8
+#define NO_SEQ -1
+
+typedef struct TransportRequest {
+    uint32_t key;
+    int32_t value;
+} TransportRequest;
+
+static AppMessageInboxReceived s_received;
+static TransportFailedHandler s_failed;
+static TransportStats s_stats;
+static uint32_t s_inbox_size;
+static uint32_t s_start_ms;
+static bool s_synced;
+
+static TransportRequest s_queue[TRANSPORT_QUEUE_LENGTH];
+static uint8_t s_queue_head;
+static uint8_t s_queue_count;
+static uint8_t s_attempts;  // attempts made on the request at the head
+static bool s_in_flight;
+static AppTimer* s_retry_timer;
+
+static int16_t s_recent_seqs[SEQ_WINDOW];
+static uint8_t s_recent_next;
+
+static uint32_t prv_now_ms(void) {
+    time_t seconds;
+    uint16_t ms;
+    time_ms(&seconds, &ms);
+    return (uint32_t)seconds * 1000 + ms;
+}
+
+// ── Outbound ─────────────────────────────────────────────────────────────────
+
+static void prv_pump(void);
+
+static void prv_pop(void) {
+    s_queue_head = (s_queue_head + 1) % TRANSPORT_QUEUE_LENGTH;
+    s_queue_count--;
+    s_attempts = 0;
+}
+
+static void prv_retry_timer_callback(void* context) {
+    s_retry_timer = NULL;
+    prv_pump();
+}
+
+static void prv_request_failed(void) {
+    if (s_attempts >= TRANSPORT_MAX_ATTEMPTS) {
+        TransportRequest request = s_queue[s_queue_head];
+        prv_pop();
+        s_stats.failed++;
+        UTIL_LOG(APP_LOG_LEVEL_ERROR, "Gave up on key %lu after %d attempts", request.key, TRANSPORT_MAX_ATTEMPTS);
+        if (s_failed) {
+            s_failed(request.key, request.value);
+        }
+        prv_pump();
+        return;
+    }
+    s_stats.retries++;
+    s_retry_timer = app_timer_register(TRANSPORT_BACKOFF_MS << (s_attempts - 1), prv_retry_timer_callback, NULL);
+}
+
+static void prv_pump(void) {
+    if (s_in_flight || s_retry_timer || s_queue_count == 0) {
+        return;
+    }
+
+    DictionaryIterator* iter;
+    if (app_message_outbox_begin(&iter) != APP_MSG_OK) {
+        // Outbox still busy; try again shortly without spending an attempt
+        s_retry_timer = app_timer_register(TRANSPORT_BACKOFF_MS, prv_retry_timer_callback, NULL);
+        return;
+    }
+    const TransportRequest* request = &s_queue[s_queue_head];
+    dict_write_int32(iter, request->key, request->value);
+
+    // The sent/failed callbacks may run before outbox_send returns
+    s_in_flight = true;
+    s_attempts++;
+    s_stats.sent++;
+    if (app_message_outbox_send() != APP_MSG_OK) {
+        s_in_flight = false;
+        prv_request_failed();
+    }
+}
+
+static void prv_outbox_sent(DictionaryIterator* iter, void* context) {
+    s_in_flight = false;
+    s_stats.delivered++;
+    prv_pop();
+    prv_pump();
+}
+
+static void prv_outbox_failed(DictionaryIterator* iter, AppMessageResult reason, void* context) {
+    UTIL_LOG(APP_LOG_LEVEL_ERROR, "Message send failed. Reason: %d", (int)reason);
+    s_in_flight = false;
+    prv_request_failed();
+}
+
+bool transport_send(uint32_t key, int32_t value) {
+    if (s_queue_count == TRANSPORT_QUEUE_LENGTH) {
+        s_stats.overflowed++;
+        return false;
+    }
+    s_queue[(s_queue_head + s_queue_count) % TRANSPORT_QUEUE_LENGTH] = (TransportRequest){key, value};
+    s_queue_count++;
+    prv_pump();
+    return true;
+}
+
+// ── Inbound ──────────────────────────────────────────────────────────────────
+
+static void prv_forget_seqs(void) {
+    for (int i = 0; i < SEQ_WINDOW; i++) {
+        s_recent_seqs[i] = NO_SEQ;
+    }
+}
+
+// Records `seq`; false if it was seen recently
+static bool prv_remember_seq(uint8_t seq) {
+    for (int i = 0; i < SEQ_WINDOW; i++) {
+        if (s_recent_seqs[i] == seq) {
+            return false;
+        }
+    }
+    s_recent_seqs[s_recent_next] = seq;
+    s_recent_next = (s_recent_next + 1) % SEQ_WINDOW;
+    return true;
+}
+
+static void prv_inbox_received(DictionaryIterator* iter, void* context) {
+    if (dict_find(iter, MESSAGE_KEY_JS_READY)) {
+        // A new PebbleKit JS session numbers its messages from the start
+        prv_forget_seqs();
+        // Nothing bigger than a full ring of hours is worth sending
+        transport_send(MESSAGE_KEY_INBOX_SIZE, s_inbox_size < PROTOCOL_HOUR_BLOCKS_SIZE ? s_inbox_size
+                                                                                        : PROTOCOL_HOUR_BLOCKS_SIZE);
+    }
+
+    Tuple* seq_tuple = dict_find(iter, MESSAGE_KEY_SEQ);
+    if (seq_tuple && !prv_remember_seq(seq_tuple->value->uint8)) {
+        // Our ACK was lost and the phone sent it again
+        s_stats.duplicates++;
+        return;
+    }
+    s_stats.received++;
+    s_received(iter, context);
+}
+
+static void prv_inbox_dropped(AppMessageResult reason, void* context) {
+    // The phone gets a NACK and sends the message again
+    UTIL_LOG(APP_LOG_LEVEL_ERROR, "Message dropped. Reason: %d", (int)reason);
+    s_stats.dropped++;
+}
+
+// ── Setup ────────────────────────────────────────────────────────────────────
+
+void transport_init(AppMessageInboxReceived received, TransportFailedHandler failed) {
+    s_received = received;
+    s_failed = failed;
+    s_stats = (TransportStats){0};
+    s_queue_head = 0;
+    s_queue_count = 0;
+    s_attempts = 0;
+    s_in_flight = false;
+    s_retry_timer = NULL;
+    prv_forget_seqs();
+    s_start_ms = prv_now_ms();
+    s_synced = false;
+
+    app_message_register_inbox_received(prv_inbox_received);
+    app_message_register_inbox_dropped(prv_inbox_dropped);
+    app_message_register_outbox_sent(prv_outbox_sent);
+    app_message_register_outbox_failed(prv_outbox_failed);
+
+    // Exactly what the protocol needs; the rest of the heap goes to icons
+    s_inbox_size = PROTOCOL_INBOX_SIZE;
+    if (s_inbox_size > app_message_inbox_size_maximum()) {
+        s_inbox_size = app_message_inbox_size_maximum();
+    }
+    app_message_open(s_inbox_size, PROTOCOL_OUTBOX_SIZE);
+    UTIL_LOG(APP_LOG_LEVEL_DEBUG, "AppMessage buffers: inbox %lu, outbox %d bytes", s_inbox_size, PROTOCOL_OUTBOX_SIZE);
+}
+
+void transport_mark_synced(void) {
+    if (!s_synced) {
+        s_synced = true;
+        s_stats.sync_ms = prv_now_ms() - s_start_ms;
+        UTIL_LOG(APP_LOG_LEVEL_DEBUG, "Synced in %lu ms: %lu sent, %lu retries, %lu received, %lu duplicates",
+                 s_stats.sync_ms, s_stats.sent, s_stats.retries, s_stats.received, s_stats.duplicates);
+    }
+}
+
+uint32_t transport_inbox_size(void) {
+    return s_inbox_size;
+}
+
+const TransportStats* transport_get_stats(void) {
+    return &s_stats;
+}
@@ -0,0 +1,53 @@
+/*
+    AppMessage Transport
+
+    Owns the AppMessage callbacks so the rest of the app never sees a lost
+    or repeated message.
+
+    Inbound: PebbleKit JS tags each message with SEQ. When the watch's ACK is
+    lost the phone sends the message again, and the copy is dropped here
+    instead of being handled twice. Messages without SEQ (Clay settings) are
+    passed through. JS_READY starts a new session and is answered with
+    INBOX_SIZE, which tells the phone how much one message may carry. The
+    buffers themselves are sized from protocol.h.
+
+    Outbound: the watch only ever sends small requests (a key and an integer),
+    so they go through a short queue. A failed send is retried with
+    exponential backoff; after TRANSPORT_MAX_ATTEMPTS the failure handler is
+    told the request was given up on.
+*/
+
+#pragma once
+
+#include <pebble.h>
+
+#define TRANSPORT_QUEUE_LENGTH 4
+#define TRANSPORT_MAX_ATTEMPTS 4
+#define TRANSPORT_BACKOFF_MS 250
+
+typedef void (*TransportFailedHandler)(uint32_t key, int32_t value);
+
+typedef struct TransportStats {
+    uint32_t sent;          // send attempts, retries included
+    uint32_t delivered;     // requests the phone ACKed
+    uint32_t retries;
+    uint32_t failed;        // requests given up on after the last attempt
+    uint32_t overflowed;    // requests refused because the queue was full
+    uint32_t received;      // inbound messages handled
+    uint32_t duplicates;    // inbound repeats dropped by SEQ
+    uint32_t dropped;       // inbound messages the system dropped
+    uint32_t sync_ms;       // transport_init() to transport_mark_synced()
+} TransportStats;
+
+// Opens AppMessage and registers the transport's callbacks. `received` gets
+// every message that is not a repeat.
+void transport_init(AppMessageInboxReceived received, TransportFailedHandler failed);
+
+// Queues a one-tuple request; false if the queue is full
+bool transport_send(uint32_t key, int32_t value);
+
+// Records the time the first full forecast took to arrive
+void transport_mark_synced(void);
+
+uint32_t transport_inbox_size(void);
+const TransportStats* transport_get_stats(void);
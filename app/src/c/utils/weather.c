@@ -28,9 +28,6 @@ static const char* PRECIPITATION_STRINGS[] = {
     "Mixed"
 };
 
-// Array of forecast hours
-ForecastHour forecast_hours[12];
-
 // Next-hour precipitation (single definition; declared extern in weather.h)
 Precipitation precipitation;
 
@@ -84,33 +81,28 @@ const char* get_uv_index_string(int uv_index) {
     return "Low";
 }
 
-uint8_t km_to_miles(uint8_t kilo) {
-    return (uint8_t)(kilo * 0.621371f + 0.5f);
-}
-
-int8_t fahrenheit_to_celsius(int8_t fahrenheit) {
-    return (int8_t)((fahrenheit - 32) * 5.0f / 9.0f + 0.5f);
-}
-
-uint8_t kph_to_mph(uint8_t kph) {
-    return (uint8_t)(kph * 0.621371f + 0.5f);
-}
-
-uint8_t kph_to_mps(uint8_t kph) {
-    return (uint8_t)(kph * 0.277778f + 0.5f);
-}
-
-uint16_t mb_to_inHg_x100(uint16_t mb) {
-    return (uint16_t)(mb * 2.953f + 0.5f); // Multiply by 100 to avoid decimal point
-}
-
-// Convert wind direction in degrees to 8-direction code (0-7)
-uint8_t get_wind_direction_code(uint16_t degrees) {
-    // Normalize degrees to 0-359
-    degrees = degrees % 360;
-    
-    // Convert to 8-direction code
-    // Each direction covers 45 degrees, centered on its angle
-    // For example, direction 0 (right) covers 337.5° to 22.5°
-    return ((degrees + 22) % 360) / 45;
-}
+// Unit conversion tables. Every input is a byte off the wire, so each table
+// has an entry per byte value; UNIT_TABLE expands an entry macro for 0-255
+// and the preprocessor does the arithmetic, leaving nothing to convert at
+// runtime (and no soft-float on the watch).
+#define UNIT_ROW(F, n) F(n), F(n + 1), F(n + 2), F(n + 3), F(n + 4), F(n + 5), F(n + 6), F(n + 7), \
+                       F(n + 8), F(n + 9), F(n + 10), F(n + 11), F(n + 12), F(n + 13), F(n + 14), F(n + 15)
+#define UNIT_TABLE(F) UNIT_ROW(F, 0), UNIT_ROW(F, 16), UNIT_ROW(F, 32), UNIT_ROW(F, 48), \
+                      UNIT_ROW(F, 64), UNIT_ROW(F, 80), UNIT_ROW(F, 96), UNIT_ROW(F, 112), \
+                      UNIT_ROW(F, 128), UNIT_ROW(F, 144), UNIT_ROW(F, 160), UNIT_ROW(F, 176), \
+                      UNIT_ROW(F, 192), UNIT_ROW(F, 208), UNIT_ROW(F, 224), UNIT_ROW(F, 240)
+
+// The int8 a table index stands for
+#define UNIT_SIGNED(n) ((n) < 128 ? (n) : (n) - 256)
+// Integer division rounded half away from zero
+#define UNIT_ROUND_DIV(x, d) ((x) >= 0 ? ((x) + (d) / 2) / (d) : -((-(x) + (d) / 2) / (d)))
+
+#define UNIT_KILO_TO_MILES(n) UNIT_ROUND_DIV((n) * 621371, 1000000)
+#define UNIT_KPH_TO_MPS(n) UNIT_ROUND_DIV((n) * 277778, 1000000)
+#define UNIT_FAHRENHEIT_TO_CELSIUS(n) UNIT_ROUND_DIV((UNIT_SIGNED(n) - 32) * 5, 9)
+#define UNIT_MB_TO_INHG_X100(n) UNIT_ROUND_DIV((PRESSURE_MB_BASE + UNIT_SIGNED(n)) * 2953, 1000)
+
+const uint8_t UNIT_KILO_TO_MILES_TABLE[256] = {UNIT_TABLE(UNIT_KILO_TO_MILES)};
+const uint8_t UNIT_KPH_TO_MPS_TABLE[256] = {UNIT_TABLE(UNIT_KPH_TO_MPS)};
+const int8_t UNIT_FAHRENHEIT_TO_CELSIUS_TABLE[256] = {UNIT_TABLE(UNIT_FAHRENHEIT_TO_CELSIUS)};
+const uint16_t UNIT_MB_TO_INHG_X100_TABLE[256] = {UNIT_TABLE(UNIT_MB_TO_INHG_X100)};
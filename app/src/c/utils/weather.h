@@ -9,6 +9,9 @@
     - Basic conditions (temperature, conditions) (plus precipitation if it's happening)
     - Wind and pressure information
     - Experiential factors (feels like, UV, visibility)
+
+    Hourly forecasts stay in their packed wire format and are read through
+    the accessors in forecast.h.
 */
 
 #pragma once
@@ -37,10 +40,20 @@
 // Number of weather conditions
 #define NUM_WEATHER_CONDITIONS 13
 
+// Experiential icon codes run 1-7; 0 means no icon
+#define NUM_EXPERIENTIAL_ICONS 7
+
 // Precipitation types
 #define NUM_PRECIPITATION_TYPES 7
 
 #define PRECIPITATION_INTERVALS 24
+#define PRECIPITATION_INTERVAL_MINUTES 5
+
+// Minute-by-minute levels for the next hour; each 0-3 intensity level is
+// PRECIPITATION_LEVEL_STEPS steps, so a level is (steps + 4) / 5
+#define PRECIPITATION_MINUTES 60
+#define PRECIPITATION_LEVEL_STEPS 5
+#define PRECIPITATION_MAX_STEPS (3 * PRECIPITATION_LEVEL_STEPS)
 
 // Custom type for the 10-byte hourly weather data package
 typedef uint8_t* HourPackage;
@@ -48,37 +61,18 @@ typedef uint8_t* HourPackage;
 //and the 7 byte precipitation package
 typedef uint8_t* PrecipitationPackage;
 
-// Forecast hour struct
-//HourPackage is unpacked into this struct
-//hour_string: "12PM"
-//conditions_string: "72°\nMostly\nCloudy"
-//airflow_string: "12mph SW\n18mph gusts\n1004mb"
-//experiential_string: "Feels 64°\nUVI 2\nVis. 20mi"
-typedef struct forecast_hour {
-    uint8_t wind_speed;
-    int8_t wind_direction;
-    uint32_t wind_speed_resource_id;  // Resource ID for the wind speed icon
-    uint8_t conditions_icon;
-    uint8_t experiential_icon;
-    char hour_string[5];
-    char conditions_string[MAX_STRING_LENGTH];
-    char airflow_string[MAX_STRING_LENGTH];
-    char experiential_string[MAX_STRING_LENGTH];
-    //TODO: store small&large icons (resource IDs) for all data here instead of per page
-} ForecastHour;
-
 // Precipitation struct
-//precipitation_string: "Rain\nfor 13m"
 //precipitation_intensity: [3, 2, 1, ... 0, 0, 0]
+//the "Rain\nfor 13m" text is formatted when shown (see format_precipitation_string)
+//minute_steps drives the graph; from a legacy package it is interpolated
+//between the 5-minute intervals
 typedef struct Precipitation{
     uint8_t precipitation_type;
-    char precipitation_string[MAX_STRING_LENGTH];
     uint8_t precipitation_intensity[PRECIPITATION_INTERVALS];
+    uint8_t chance;  // percent, 0 when the phone did not say
+    uint8_t minute_steps[PRECIPITATION_MINUTES];
 } Precipitation;
 
-// Array of forecast hours
-extern ForecastHour forecast_hours[12];
-
 //next hour precipitation
 extern Precipitation precipitation;
 
@@ -89,19 +83,32 @@ const char* get_wind_direction_string(int degrees);
 const char* get_precipitation_string(int precipitation_code);
 const char* get_uv_index_string(int uv_index);
 
-uint8_t km_to_miles(uint8_t kilo);
-int8_t fahrenheit_to_celsius(int8_t fahrenheit);
-uint8_t kph_to_mph(uint8_t kph);
-uint8_t kph_to_mps(uint8_t kph);
-uint16_t mb_to_inHg_x100(uint16_t mb);
-
-// Convert wind direction in degrees to 8-direction code (0-7)
-// 0: Right (0°)
-// 1: Bottom-right (45°)
-// 2: Down (90°)
-// 3: Bottom-left (135°)
-// 4: Left (180°)
-// 5: Top-left (225°)
-// 6: Up (270°)
-// 7: Top-right (315°)
-uint8_t get_wind_direction_code(uint16_t degrees);
\ No newline at end of file
+// Unit conversions, looked up in tables indexed by the raw byte (weather.c)
+// Pressure travels as a signed byte offset from this
+#define PRESSURE_MB_BASE 1000
+
+extern const uint8_t UNIT_KILO_TO_MILES_TABLE[256];
+extern const uint8_t UNIT_KPH_TO_MPS_TABLE[256];
+extern const int8_t UNIT_FAHRENHEIT_TO_CELSIUS_TABLE[256];
+extern const uint16_t UNIT_MB_TO_INHG_X100_TABLE[256];
+
+static inline uint8_t km_to_miles(uint8_t kilo) {
+    return UNIT_KILO_TO_MILES_TABLE[kilo];
+}
+
+static inline int8_t fahrenheit_to_celsius(int8_t fahrenheit) {
+    return UNIT_FAHRENHEIT_TO_CELSIUS_TABLE[(uint8_t)fahrenheit];
+}
+
+static inline uint8_t kph_to_mph(uint8_t kph) {
+    return UNIT_KILO_TO_MILES_TABLE[kph];
+}
+
+static inline uint8_t kph_to_mps(uint8_t kph) {
+    return UNIT_KPH_TO_MPS_TABLE[kph];
+}
+
+// For the pressures the wire can carry, 872-1127 mb
+static inline uint16_t mb_to_inHg_x100(int mb) {
+    return UNIT_MB_TO_INHG_X100_TABLE[(uint8_t)(mb - PRESSURE_MB_BASE)];
+}
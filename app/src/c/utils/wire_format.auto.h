@@ -0,0 +1,235 @@
+/*
+    Wire Format
+
+    Generated by app/tools/gen_wire_format.py from app/schema/wire_format.json, do not edit.
+    Each accessor reads one field straight out of a packed buffer.
+*/
+
+#pragma once
+
+#include <pebble.h>
+#include "weather.h"
+
+// One forecast hour. HOUR_DATA carries 12 of these back to back.
+#define HOUR_PACKAGE_SIZE 10
+
+#define HOUR_FLAG_WIND_GUST 0x4
+#define HOUR_FLAG_WIND_DIR 0x2
+#define HOUR_FLAG_AIR_QUALITY 0x1
+
+#if (NUM_WEATHER_CONDITIONS) != 13
+#error "hour_conditions_icon: schema has 13 codes, NUM_WEATHER_CONDITIONS disagrees"
+#endif
+#if (WEATHER_CONDITION_CLOUDY) != 1
+#error "hour_conditions_icon: schema falls back to 1, WEATHER_CONDITION_CLOUDY disagrees"
+#endif
+#if (NUM_EXPERIENTIAL_ICONS + 1) != 8
+#error "hour_experiential_icon: schema has 8 codes, NUM_EXPERIENTIAL_ICONS + 1 disagrees"
+#endif
+
+static inline const uint8_t* hour_package(const uint8_t* pkg, uint8_t i) {
+    return &pkg[i * HOUR_PACKAGE_SIZE];
+}
+
+// Hour of day (0-23)
+static inline uint8_t hour_of_day(const uint8_t* pkg, uint8_t i) {
+    return (hour_package(pkg, i)[0]) % 24;
+}
+
+// Temperature in degrees F
+static inline int8_t hour_temp(const uint8_t* pkg, uint8_t i) {
+    return (int8_t)hour_package(pkg, i)[1];
+}
+
+// Feels-like temperature in degrees F
+static inline int8_t hour_feels_like(const uint8_t* pkg, uint8_t i) {
+    return (int8_t)hour_package(pkg, i)[2];
+}
+
+// Wind speed in kph
+static inline uint8_t hour_wind_speed(const uint8_t* pkg, uint8_t i) {
+    return hour_package(pkg, i)[3];
+}
+
+// Wind gust speed in kph
+static inline uint8_t hour_wind_gust(const uint8_t* pkg, uint8_t i) {
+    return hour_package(pkg, i)[4];
+}
+
+// Visibility in km
+static inline uint8_t hour_visibility(const uint8_t* pkg, uint8_t i) {
+    return hour_package(pkg, i)[5];
+}
+
+// Pressure in mb
+static inline int hour_pressure_mb(const uint8_t* pkg, uint8_t i) {
+    return (int8_t)hour_package(pkg, i)[6] + 1000;
+}
+
+// Direction the wind comes from, in 22.5 degree steps (0-15)
+static inline uint8_t hour_wind_dir16(const uint8_t* pkg, uint8_t i) {
+    return (hour_package(pkg, i)[7] >> 4) & 0xF;
+}
+
+// Air quality index (0-750 in steps of 50)
+static inline int hour_aqi(const uint8_t* pkg, uint8_t i) {
+    return (hour_package(pkg, i)[7] & 0xF) * 50;
+}
+
+// UV index
+static inline uint8_t hour_uv_index(const uint8_t* pkg, uint8_t i) {
+    return (hour_package(pkg, i)[8] >> 4) & 0xF;
+}
+
+// Which optional fields are present
+static inline uint8_t hour_flags(const uint8_t* pkg, uint8_t i) {
+    return hour_package(pkg, i)[8] & 0xF;
+}
+
+// Condition icon code
+static inline uint8_t hour_conditions_icon(const uint8_t* pkg, uint8_t i) {
+    uint8_t value = (hour_package(pkg, i)[9] >> 4) & 0xF;
+    return value < (NUM_WEATHER_CONDITIONS) ? value : WEATHER_CONDITION_CLOUDY;
+}
+
+// Experiential icon code (1 to NUM_EXPERIENTIAL_ICONS, 0 for none)
+static inline uint8_t hour_experiential_icon(const uint8_t* pkg, uint8_t i) {
+    uint8_t value = hour_package(pkg, i)[9] & 0xF;
+    return value < (NUM_EXPERIENTIAL_ICONS + 1) ? value : 0;
+}
+
+// Precipitation over the next two hours, sent as PRECIPITATION_PACKAGE.
+#define PRECIPITATION_PACKAGE_SIZE 7
+
+#if (PRECIPITATION_INTERVALS) != 24
+#error "precip_intensity: schema has 24 values, PRECIPITATION_INTERVALS disagrees"
+#endif
+
+// Precipitation type (0 for none)
+static inline uint8_t precip_type(const uint8_t* pkg) {
+    return pkg[0];
+}
+
+// Intensity (0-3) in 5 minute intervals
+static inline uint8_t precip_intensity(const uint8_t* pkg, uint8_t n) {
+    return (pkg[1 + n / 4] >> ((n % 4) * 2)) & 0x3;
+}
+
+static inline void precip_intensity_all(const uint8_t* pkg, uint8_t out[24]) {
+    out[0] = pkg[1] & 0x3;
+    out[1] = (pkg[1] >> 2) & 0x3;
+    out[2] = (pkg[1] >> 4) & 0x3;
+    out[3] = (pkg[1] >> 6) & 0x3;
+    out[4] = pkg[2] & 0x3;
+    out[5] = (pkg[2] >> 2) & 0x3;
+    out[6] = (pkg[2] >> 4) & 0x3;
+    out[7] = (pkg[2] >> 6) & 0x3;
+    out[8] = pkg[3] & 0x3;
+    out[9] = (pkg[3] >> 2) & 0x3;
+    out[10] = (pkg[3] >> 4) & 0x3;
+    out[11] = (pkg[3] >> 6) & 0x3;
+    out[12] = pkg[4] & 0x3;
+    out[13] = (pkg[4] >> 2) & 0x3;
+    out[14] = (pkg[4] >> 4) & 0x3;
+    out[15] = (pkg[4] >> 6) & 0x3;
+    out[16] = pkg[5] & 0x3;
+    out[17] = (pkg[5] >> 2) & 0x3;
+    out[18] = (pkg[5] >> 4) & 0x3;
+    out[19] = (pkg[5] >> 6) & 0x3;
+    out[20] = pkg[6] & 0x3;
+    out[21] = (pkg[6] >> 2) & 0x3;
+    out[22] = (pkg[6] >> 4) & 0x3;
+    out[23] = (pkg[6] >> 6) & 0x3;
+}
+
+// The next hour minute by minute, sent as PRECIPITATION_MINUTES alongside the legacy package.
+#define PRECIPITATION_MINUTES_PACKAGE_SIZE 33
+
+#define PRECIPITATION_MINUTES_VERSION 2
+
+#if (PRECIPITATION_MINUTES) != 60
+#error "precip_minutes_steps: schema has 60 values, PRECIPITATION_MINUTES disagrees"
+#endif
+
+// Package version; later versions only append fields
+static inline uint8_t precip_minutes_version(const uint8_t* pkg) {
+    return pkg[0];
+}
+
+// Precipitation type (0 for none)
+static inline uint8_t precip_minutes_type(const uint8_t* pkg) {
+    return pkg[1];
+}
+
+// Highest chance of precipitation in the hour, percent
+static inline uint8_t precip_minutes_chance(const uint8_t* pkg) {
+    return pkg[2];
+}
+
+// Intensity in steps of 1/PRECIPITATION_LEVEL_STEPS of a 0-3 intensity level, one per minute
+static inline uint8_t precip_minutes_steps(const uint8_t* pkg, uint8_t n) {
+    return (pkg[3 + n / 2] >> (4 - (n % 2) * 4)) & 0xF;
+}
+
+static inline void precip_minutes_steps_all(const uint8_t* pkg, uint8_t out[60]) {
+    out[0] = (pkg[3] >> 4) & 0xF;
+    out[1] = pkg[3] & 0xF;
+    out[2] = (pkg[4] >> 4) & 0xF;
+    out[3] = pkg[4] & 0xF;
+    out[4] = (pkg[5] >> 4) & 0xF;
+    out[5] = pkg[5] & 0xF;
+    out[6] = (pkg[6] >> 4) & 0xF;
+    out[7] = pkg[6] & 0xF;
+    out[8] = (pkg[7] >> 4) & 0xF;
+    out[9] = pkg[7] & 0xF;
+    out[10] = (pkg[8] >> 4) & 0xF;
+    out[11] = pkg[8] & 0xF;
+    out[12] = (pkg[9] >> 4) & 0xF;
+    out[13] = pkg[9] & 0xF;
+    out[14] = (pkg[10] >> 4) & 0xF;
+    out[15] = pkg[10] & 0xF;
+    out[16] = (pkg[11] >> 4) & 0xF;
+    out[17] = pkg[11] & 0xF;
+    out[18] = (pkg[12] >> 4) & 0xF;
+    out[19] = pkg[12] & 0xF;
+    out[20] = (pkg[13] >> 4) & 0xF;
+    out[21] = pkg[13] & 0xF;
+    out[22] = (pkg[14] >> 4) & 0xF;
+    out[23] = pkg[14] & 0xF;
+    out[24] = (pkg[15] >> 4) & 0xF;
+    out[25] = pkg[15] & 0xF;
+    out[26] = (pkg[16] >> 4) & 0xF;
+    out[27] = pkg[16] & 0xF;
+    out[28] = (pkg[17] >> 4) & 0xF;
+    out[29] = pkg[17] & 0xF;
+    out[30] = (pkg[18] >> 4) & 0xF;
+    out[31] = pkg[18] & 0xF;
+    out[32] = (pkg[19] >> 4) & 0xF;
+    out[33] = pkg[19] & 0xF;
+    out[34] = (pkg[20] >> 4) & 0xF;
+    out[35] = pkg[20] & 0xF;
+    out[36] = (pkg[21] >> 4) & 0xF;
+    out[37] = pkg[21] & 0xF;
+    out[38] = (pkg[22] >> 4) & 0xF;
+    out[39] = pkg[22] & 0xF;
+    out[40] = (pkg[23] >> 4) & 0xF;
+    out[41] = pkg[23] & 0xF;
+    out[42] = (pkg[24] >> 4) & 0xF;
+    out[43] = pkg[24] & 0xF;
+    out[44] = (pkg[25] >> 4) & 0xF;
+    out[45] = pkg[25] & 0xF;
+    out[46] = (pkg[26] >> 4) & 0xF;
+    out[47] = pkg[26] & 0xF;
+    out[48] = (pkg[27] >> 4) & 0xF;
+    out[49] = pkg[27] & 0xF;
+    out[50] = (pkg[28] >> 4) & 0xF;
+    out[51] = pkg[28] & 0xF;
+    out[52] = (pkg[29] >> 4) & 0xF;
+    out[53] = pkg[29] & 0xF;
+    out[54] = (pkg[30] >> 4) & 0xF;
+    out[55] = pkg[30] & 0xF;
+    out[56] = (pkg[31] >> 4) & 0xF;
+    out[57] = pkg[31] & 0xF;
+    out[58] = (pkg[32] >> 4) & 0xF;
+    out[59] = pkg[32] & 0xF;
+}
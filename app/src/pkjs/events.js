@@ -65,8 +65,9 @@ function pushTestPin() {
  * @param {Date} endTime - End time of the precipitation event
  * @param {string} precipitationType - Type of precipitation (e.g., "Snow", "Rain", "Sleet")
  * @param {number} averageIntensityMmHr - Average precipitation intensity in mm/hr
+ * @param {string} [id] - Pin id, "next_hour_precipitation" by default
  */
-function createNextHourPrecipitationPin(startTime, endTime, precipitationType, averageIntensityMmHr) {
+function createNextHourPrecipitationPin(startTime, endTime, precipitationType, averageIntensityMmHr, id) {
 
   if (averageIntensityMmHr < 0.1) {
     return null;
@@ -150,7 +151,7 @@ function createNextHourPrecipitationPin(startTime, endTime, precipitationType, a
 
   // Create the pin
   var pin = {
-    "id": "next_hour_precipitation",
+    "id": id || "next_hour_precipitation",
     "time": startTime.toISOString(),
     "duration": durationMinutes,
     "layout": {
@@ -170,6 +171,34 @@ function createNextHourPrecipitationPin(startTime, endTime, precipitationType, a
   return pin;
 }
 
+/**
+ * Create one pin per precipitation window in the next hour
+ * @param {Object} forecastNextHour - WeatherKit forecastNextHour
+ * @returns {Array} Pins in time order. The first keeps the
+ *     "next_hour_precipitation" id; later ones are numbered from 2.
+ */
+function createNextHourPrecipitationPins(forecastNextHour) {
+  var pins = [];
+  var summaries = forecastNextHour.summary || [];
+  for (var i = 0; i < summaries.length; i++) {
+    var summary = summaries[i];
+    if (!summary.condition || summary.condition === "clear") {
+      continue;
+    }
+    var startTime = new Date(summary.startTime);
+    var endTime = summary.endTime
+      ? new Date(summary.endTime)
+      : new Date(forecastNextHour.forecastEnd);
+    var precipType = summary.condition.charAt(0).toUpperCase() + summary.condition.slice(1);
+    var id = "next_hour_precipitation" + (pins.length > 0 ? "_" + (pins.length + 1) : "");
+    var pin = createNextHourPrecipitationPin(startTime, endTime, precipType, summary.precipitationIntensity || 0, id);
+    if (pin) {
+      pins.push(pin);
+    }
+  }
+  return pins;
+}
 
 module.exports.pushTestPin = pushTestPin;
-module.exports.createNextHourPrecipitationPin = createNextHourPrecipitationPin;
\ No newline at end of file
+module.exports.createNextHourPrecipitationPin = createNextHourPrecipitationPin;
+module.exports.createNextHourPrecipitationPins = createNextHourPrecipitationPins;
\ No newline at end of file
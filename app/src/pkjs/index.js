@@ -2,7 +2,9 @@ var keys = require('message_keys');
 var msgproc = require('./msgproc');
 var weatherkit = require('./weatherkit');
 var events = require('./events');
-var timeline = require('./timeline');
+var pinmanager = require('./pinmanager');
+var transport = require('./transport');
+var replay = require('./replay');
 
 var Clay = require('@rebble/clay');
 var clayConfig = require('./config');
@@ -18,13 +20,20 @@ var language = "";
 
 var forecastHours = [];
 var precipitation = null;
+var precipitationMinutes = null;
 
-var MAX_HOURS = 12;
+// REQUEST_HOUR first hours that arrived while there were no hours to send
+// from (a fetch was rebuilding them); answered once it finishes
+var pendingHourRequests = [];
+
+// pinmanager group for the next-hour precipitation pins
+var PRECIPITATION_PIN_GROUP = 'next_hour_precipitation';
+
+var MAX_HOURS = 48;
+var HOURS_PER_BLOCK = 12; // One HOUR_DATA message
 var hourInterval = 2; // Default to 2 hours
 var refreshInterval = 30; // Default to 30 minutes
 
-var dummyMode = false;
-
 // Debug configuration
 var debug = false;
 var checkCache = true;
@@ -52,7 +61,7 @@ Pebble.addEventListener("ready",
 
         // Send JSReady signal to C app
         debugLog("Sending JSReady signal to C app");
-        Pebble.sendAppMessage({"JS_READY": 1}, function() {
+        transport.send({"JS_READY": 1}, function() {
             debugLog("JSReady signal sent successfully");
             // Now start fetching weather data (check cache first)
             if(checkCache) {
@@ -60,8 +69,8 @@ Pebble.addEventListener("ready",
             } else {
                 getLocation();
             }
-        }, function(e) {
-            debugLog("JSReady signal failed: " + JSON.stringify(e));
+        }, function() {
+            debugLog("JSReady signal failed");
             // Still try to fetch data even if JSReady failed
             if(checkCache) {
                 checkCacheOrFetchWeather();
@@ -74,16 +83,101 @@ Pebble.addEventListener("ready",
 
 
 
-// No AppMessage listener needed - C app only receives data, never sends requests
+Pebble.addEventListener("appmessage",
+    function (e) {
+        // Sent in reply to JS_READY; bounds how many blocks fit in a message
+        if (e.payload.INBOX_SIZE !== undefined) {
+            transport.setInboxSize(e.payload.INBOX_SIZE);
+        }
+
+        // The watch only keeps a couple of 12-hour blocks and asks for the
+        // next one (by its first hour) as the user scrolls toward it
+        if (e.payload.REQUEST_HOUR !== undefined) {
+            var firstHour = e.payload.REQUEST_HOUR;
+            debugLog("Watch requested hours from " + firstHour);
+            if (forecastHours.length > 0) {
+                answerHourRequest(firstHour);
+            } else if (pendingHourRequests.indexOf(firstHour) === -1) {
+                pendingHourRequests.push(firstHour);
+            }
+        }
+
+        // The watch's splash timed out waiting; resend what we have. If the
+        // fetch is still running it sends everything when it finishes.
+        if (e.payload.REQUEST_DATA !== undefined && forecastHours.length > 0) {
+            debugLog("Watch requested the forecast again");
+            sendAllWeatherData();
+        }
+    }
+);
+
+// How many 12-hour blocks fit in one message to the watch
+function blocksPerMessage() {
+    var overhead = transport.dictSize({ "HOUR_DATA": [], "HOUR_BLOCK": 0, "FORECAST_HOURS": 0 });
+    var bytesPerBlock = HOURS_PER_BLOCK * 10;
+    return Math.max(1, Math.floor((transport.maxBytes() - overhead) / bytesPerBlock));
+}
+
+// Sends up to `count` consecutive blocks starting at firstHour in one message
+function sendHourBlocks(firstHour, count, onSuccess, onFailure) {
+    var hourData = [];
+    for (var b = 0; b < count; b++) {
+        var start = firstHour + b * HOURS_PER_BLOCK;
+        if (start >= forecastHours.length) {
+            break;
+        }
+        hourData = hourData.concat(msgproc.packAllHourData(forecastHours.slice(start, start + HOURS_PER_BLOCK)));
+    }
+    if (hourData.length === 0) {
+        debugLog("No forecast hours from " + firstHour);
+        onFailure();
+        return;
+    }
+    transport.send({
+        "HOUR_DATA": hourData,
+        "HOUR_BLOCK": firstHour,
+        "FORECAST_HOURS": forecastHours.length
+    }, function () {
+        debugLog("Hours from " + firstHour + " sent");
+        onSuccess();
+    }, function () {
+        debugLog("Hours from " + firstHour + " failed");
+        onFailure();
+    });
+}
+
+// The watch holds off further requests until this one is answered, so every
+// REQUEST_HOUR gets a reply: the block, or HOUR_BLOCK on its own when there
+// is no such block. A send the transport gives up on is left to the watch's
+// request timeout.
+function answerHourRequest(firstHour) {
+    if (firstHour < forecastHours.length) {
+        sendHourBlocks(firstHour, 1, function () {}, function () {});
+        return;
+    }
+    transport.send({ "HOUR_BLOCK": firstHour }, function () {
+        debugLog("No hours from " + firstHour + ", told the watch");
+    }, function () {
+        debugLog("Hours unavailable reply failed");
+    });
+}
+
+// Answers the requests held while a fetch was running, from whatever it left
+function answerPendingHourRequests() {
+    var requests = pendingHourRequests;
+    pendingHourRequests = [];
+    requests.forEach(answerHourRequest);
+}
 
 //code 0 for success
 //1: hourly forecast failed
 //2: location error
 function sendResponseData(responseCode) {
-    Pebble.sendAppMessage({ "RESPONSE_DATA": responseCode }, function () {
+    answerPendingHourRequests();
+    transport.send({ "RESPONSE_DATA": responseCode }, function () {
         debugLog("Response data sent, expecting hour requests");
-    }, function (e) {
-        debugLog("Response data failed: " + JSON.stringify(e));
+    }, function () {
+        debugLog("Response data failed");
     });
 }
 
@@ -109,6 +203,7 @@ function checkCacheOrFetchWeather() {
         // Use cached data
         forecastHours = cachedData.hourPackages;
         precipitation = cachedData.precipitationData;
+        precipitationMinutes = cachedData.precipitationMinutes;
 
         // Send cached data immediately
         if (forecastHours && forecastHours.length > 0) {
@@ -129,6 +224,12 @@ function checkCacheOrFetchWeather() {
 
 // Get current location using geolocation
 function getLocation() {
+    // Recordings are answered wherever the phone is
+    if (replay.isEnabled()) {
+        requestWeatherAvailability("replay");
+        return;
+    }
+
     debugLog("Getting current location...");
 
     if (navigator.geolocation) {
@@ -163,72 +264,88 @@ function getLocation() {
 }
 
 
+// GETs a WeatherKit URL, or answers it from the recordings in replay mode
+function weatherKitGet(url, onLoad, onError) {
+    if (replay.isEnabled()) {
+        replay.get(url, onLoad, onError);
+        return;
+    }
+    var xhr = new XMLHttpRequest();
+    xhr.onload = function () {
+        onLoad(xhr.status, xhr.responseText);
+    };
+    xhr.onerror = onError;
+    xhr.open(method, url);
+    xhr.setRequestHeader("Authorization", "Bearer " + API_KEY);
+    xhr.send();
+}
 
 function sendAllWeatherData() {
     debugLog('Starting weather data transmission');
 
     if (forecastHours.length > 0) {
-        debugLog('Packing ' + forecastHours.length + ' forecast hours into single 120-byte message');
+        debugLog('Sending first blocks of ' + forecastHours.length + ' forecast hours');
+
+        // The hours and precipitation are independent, so both go out without
+        // waiting on each other. Only the first blocks are sent up front; the
+        // watch asks for the rest.
+        var started = Date.now();
+        var pending = 2;
+        var finished = function () {
+            if (--pending === 0) {
+                var stats = transport.getStats();
+                debugLog('Sync took ' + (Date.now() - started) + 'ms: ' + stats.acked + '/' + stats.sent +
+                    ' sends ACKed, ' + stats.retries + ' retries, ' + stats.failed + ' failed');
+            }
+        };
 
-        // Pack all hours into a single 120-byte array
-        var allHourData = msgproc.packAllHourData(forecastHours);
+        sendHourBlocks(0, blocksPerMessage(), finished, function() {
+            debugLog('Hour data transmission failed');
+            finished();
+        });
 
-        // Send all hour data in a single message
-        Pebble.sendAppMessage({ "HOUR_DATA": allHourData }, function() {
-            debugLog('All hourly data sent successfully! Sending precipitation...');
-            if(precipitation != null) {
-                debugLog('Sending precipitation data');
-                sendPrecipitation();
-            } else {
-                debugLog('No precipitation data available, sending empty precipitation data');
-                // Send empty precipitation data (type 0, all intensities 0)
-                var emptyPrecipitation = msgproc.packPrecipitation(0, filledArray(24, 0));
-                sendPrecipitationFromData(emptyPrecipitation);
-            }
-        }, function(e) {
-            debugLog('Hour data transmission failed: ' + JSON.stringify(e));
+        if(precipitation == null) {
+            debugLog('No precipitation data available, sending empty precipitation data');
+            // Empty precipitation data (type 0, all intensities 0)
+            precipitation = msgproc.packPrecipitation(0, filledArray(24, 0));
+        }
+        // Both forms in one message: the minutes for this watch app, the
+        // 5-minute package for builds that predate them
+        var precipitationMessage = { "PRECIPITATION_PACKAGE": precipitation };
+        if (precipitationMinutes) {
+            precipitationMessage.PRECIPITATION_MINUTES = precipitationMinutes;
+        }
+        transport.send(precipitationMessage, function () {
+            debugLog("Precipitation sent successfully!");
+            finished();
+        }, function () {
+            debugLog("Precipitation failed");
+            finished();
         });
+
+        answerPendingHourRequests();
     } else {
         debugLog('No forecast hours to send, sending error response');
         sendResponseData(1); // Send error if no data
     }
 }
 
-function sendPrecipitation() {
-    Pebble.sendAppMessage({ "PRECIPITATION_PACKAGE": precipitation }, function () {
-        debugLog("Precipitation sent successfully!");
-    }, function (e) {
-        debugLog("Precipitation failed: " + JSON.stringify(e));
-    });
-}
-
-function sendPrecipitationFromData(precipitationData) {
-    Pebble.sendAppMessage({ "PRECIPITATION_PACKAGE": precipitationData }, function () {
-        debugLog("Empty precipitation data sent successfully!");
-    }, function (e) {
-        debugLog("Empty precipitation data failed: " + JSON.stringify(e));
-    });
-}
-
-function celsiusToFahrenheit(celsius) {
-    return (celsius * 9/5) + 32;
-}
 
 //if the availability check is successful, request the actual weather data
 function requestWeatherData(location, dataSets) {
 
     forecastHours = [];
     precipitation = null;
+    precipitationMinutes = null;
 
     debugLog("Requesting weather data");
     var url = dataURL + "en_US/" + location + "?dataSets=" + dataSets;
-    var xhr = new XMLHttpRequest();
 
-    xhr.onload = function () {
-        if (xhr.status === 200) {
+    weatherKitGet(url, function (status, responseText) {
+        if (status === 200) {
             debugLog("Weather data responded");
-            //debugLog("Weather data: " + xhr.responseText);
-            var response = JSON.parse(xhr.responseText);
+            //debugLog("Weather data: " + responseText);
+            var response = JSON.parse(responseText);
 
 
             forecastHours = [];
@@ -236,9 +353,7 @@ function requestWeatherData(location, dataSets) {
             if ("forecastHourly" in response) {
                 var hours = response.forecastHourly.hours;
                 for (var i = 0; forecastHours.length < MAX_HOURS && i < hours.length; i += hourInterval) {
-                    var hour = hours[i];
-                    var forecastHour = parseWKForecastHour(hour, i);
-                    forecastHours.push(forecastHour);
+                    forecastHours.push(weatherkit.packForecastHour(hours[i]));
                 }
             }
 
@@ -268,15 +383,24 @@ function requestWeatherData(location, dataSets) {
 
             // Use weatherkit.processPrecipitationMinutes for precipitation logic
             if ("forecastNextHour" in response) {
+                // The wettest minute of each interval, so a short burst
+                // between two sampled minutes still shows
                 var processed = weatherkit.processPrecipitationMinutes(
                     nextHour,
-                    response.forecastNextHour.minutes
+                    response.forecastNextHour.minutes,
+                    Date.now(),
+                    weatherkit.RESAMPLE_MAX
                 );
                 if (processed) {
                     precipitation = msgproc.packPrecipitation(
                         processed.precipitationType,
                         processed.precipitationIntensities
                     );
+                    precipitationMinutes = msgproc.packPrecipitationMinutes(
+                        processed.precipitationType,
+                        processed.chance,
+                        processed.minuteSteps
+                    );
                 } else {
                     // No precipitation detected, send empty data
                     precipitation = msgproc.packPrecipitation(0, filledArray(24, 0));
@@ -286,33 +410,14 @@ function requestWeatherData(location, dataSets) {
                 precipitation = msgproc.packPrecipitation(0, filledArray(24, 0));
             }
 
-            // Precipitation pin: use first summary that isn't clear
+            // Precipitation pins: one per window in the next hour, sent
+            // only when they change
             if ("forecastNextHour" in response) {
-                var summaries = response.forecastNextHour.summary;
-                if (summaries && summaries.length > 0) {
-                    var firstPrecip = null;
-                    for (var k = 0; k < summaries.length; k++) {
-                        var candidate = summaries[k];
-                        if (candidate.condition && candidate.condition !== "clear") {
-                            firstPrecip = candidate;
-                            break;
-                        }
-                    }
-                    if (firstPrecip) {
-                        var startTime = new Date(firstPrecip.startTime);
-                        var endTime = firstPrecip.endTime
-                            ? new Date(firstPrecip.endTime)
-                            : new Date(response.forecastNextHour.forecastEnd);
-                        var averageIntensity = firstPrecip.precipitationIntensity || 0;
-                        var precipType = firstPrecip.condition.charAt(0).toUpperCase() + firstPrecip.condition.slice(1);
-                        var pin = events.createNextHourPrecipitationPin(startTime, endTime, precipType, averageIntensity);
-                        if (pin) {
-                            timeline.insertUserPin(pin, function (responseText) {
-                                debugLog("Precipitation pin pushed: " + responseText);
-                            });
-                        }
-                    }
-                }
+                pinmanager.sync(PRECIPITATION_PIN_GROUP,
+                    events.createNextHourPrecipitationPins(response.forecastNextHour),
+                    function (result) {
+                        debugLog("Precipitation pins: " + JSON.stringify(result));
+                    });
             }
 
             debugLog("Forecast hours assembled");
@@ -323,7 +428,7 @@ function requestWeatherData(location, dataSets) {
                 msgproc.saveWeatherCache(forecastHours);
 
                 // Cache precipitation data (always available now)
-                msgproc.savePrecipitationCache(precipitation);
+                msgproc.savePrecipitationCache(precipitation, precipitationMinutes);
 
                 // Send all weather data at once
                 sendAllWeatherData();
@@ -332,36 +437,31 @@ function requestWeatherData(location, dataSets) {
             }
 
         } else {
-            debugLog("Error requesting weather data: " + xhr.status);
+            debugLog("Error requesting weather data: " + status);
+            answerPendingHourRequests();
         }
-    };
-
-    xhr.onerror = function () {
+    }, function () {
         debugLog("Network error occurred while requesting weather data");
-    };
-
-    xhr.open(method, url);
-    xhr.setRequestHeader("Authorization", "Bearer " + API_KEY);
-    xhr.send();
+        answerPendingHourRequests();
+    });
 }
 
 function requestWeatherAvailability(location) {
     debugLog("Requesting weather availability");
     //var location = "35.602/-77.345";
     var url = availabilityURL + location;
-    var xhr = new XMLHttpRequest();
 
-    xhr.onload = function () {
-        if (xhr.status === 200) {
-            debugLog("Weather availability response: " + xhr.responseText);
+    weatherKitGet(url, function (status, responseText) {
+        if (status === 200) {
+            debugLog("Weather availability response: " + responseText);
             // If availability check is successful, request the actual weather data
             //requestWeatherData(location);
             var dataSets = "";
 
-            if (xhr.responseText.indexOf("forecastHourly") !== -1) {
+            if (responseText.indexOf("forecastHourly") !== -1) {
                 dataSets += "forecastHourly";
 
-                if (xhr.responseText.indexOf("forecastNextHour") !== -1) {
+                if (responseText.indexOf("forecastNextHour") !== -1) {
                     dataSets += ",forecastNextHour";
                 }
 
@@ -373,44 +473,14 @@ function requestWeatherAvailability(location) {
 
             requestWeatherData(location, dataSets);
         } else {
-            debugLog("Error requesting weather availability: " + xhr.status);
+            debugLog("Error requesting weather availability: " + status);
             sendResponseData(1);
             return;
         }
-    };
-
-    xhr.onerror = function () {
+    }, function () {
         debugLog("Network error occurred while requesting weather availability");
-    };
-
-    xhr.open(method, url);
-    xhr.setRequestHeader("Authorization", "Bearer " + API_KEY);
-    xhr.send();
-}
-
-function parseWKForecastHour(hour) {
-    var conditionKey = weatherkit.getConditionKey(hour.conditionCode);
-    if (hour.daylight === false) {
-        if (conditionKey === 0) conditionKey = 11;
-        else if (conditionKey === 2) conditionKey = 12;
-    }
-
-    var forecastHour = msgproc.packHourData(
-        getTimeStringHour(hour.forecastStart),
-        Math.round(celsiusToFahrenheit(hour.temperature)),
-        Math.round(celsiusToFahrenheit(hour.temperatureApparent)),
-        Math.round(hour.windSpeed),
-        "windGust" in hour ? Math.round(hour.windGust) : -1, //not required in response
-        Math.round(hour.visibility/1000),
-        Math.round(hour.pressure),
-        "windDirection" in hour ? hour.windDirection : -1, //not required in response
-        -1, //no air quality in response
-        hour.uvIndex,
-        conditionKey,
-        weatherkit.getExperientialIcon(hour)
-    );
-
-    return forecastHour;
+        answerPendingHourRequests();
+    });
 }
 
 // Export the debugLog function so it can be used by other modules
@@ -438,10 +508,3 @@ function formatTimeString(utcString) {
 
     return hour + period;
 }
-
-function getTimeStringHour(utcString) {
-    var date = new Date(utcString);
-    var hour = date.getHours();
-
-    return hour;
-}
@@ -1,4 +1,5 @@
 var getConditionKey = require('./weatherkit').getConditionKey;
+var wire = require('./wire_format.auto');
 
 var WEATHER_CACHE_KEY = 'weather_cache_data';
 var PRECIPITATION_CACHE_KEY = 'precipitation_cache_data';
@@ -13,20 +14,10 @@ function debugLog(message) {
 }
 
 /**
- * Packs weather data into a 10-byte message according to the format:
- * uint8: hour
- * int8: temperature degrees (f)
- * int8: temperature (feels like) degrees (f)
- * uint8: wind speed (kph)
- * uint8: wind gust speed (kph)
- * uint8: visibility (km)
- * int8: pressure difference from 1000mb (-128 mb to 127 mb)
- * uint4: wind direction (0-15) in 22.5 degree increments
- * uint4: air quality index (0-15) 0-500 in steps of 50
- * uint4: UV index (0-15)
- * uint4: data flags
- * uint4: condition icon code
- * uint4: experiential icon code
+ * Packs one forecast hour into a 10-byte package. The layout lives in
+ * app/schema/wire_format.json; wire.packHour() is generated from it.
+ * Optional values are -1 when the provider has none; their data flag is
+ * cleared and the field sent as 0.
  */
 function packHourData(
     hour,
@@ -42,99 +33,60 @@ function packHourData(
     condition,
     experientialIcon
 ) {
-    var buffer = new ArrayBuffer(10);
-    var view = new DataView(buffer);
-
-    // Hour (uint8)
-    view.setUint8(0, hour);
-
-    // Temperature (int8)
-    view.setInt8(1, Math.round(temperature));
-
-    // Feels like temperature (int8)
-    view.setInt8(2, Math.round(feelsLike));
-
-    // Wind speed (uint8)
-    view.setUint8(3, Math.round(windSpeed));
-
-    // Wind gust speed (uint8)
-    view.setUint8(4, Math.round(windGust));
-
-    // Visibility (uint8)
-    view.setUint8(5, Math.round(visibility));
-
-    // Pack pressure, wind direction, air quality index, uv index, and data flags into bytes 6-8
-    // Byte 6: int8 pressure difference from 1000mb (-128 to 127)
-    // Byte 7: 4 bits wind direction (0-15, 22.5 deg steps), 4 bits air quality index (0-15, 0-500 in steps of 50)
-    // Byte 8: 4 bits uv index (0-15), 4 bits data flags (0000 -> empty, windgust, winddir, airquality)
-    var pressureDiff = Math.max(-128, Math.min(127, Math.round(pressure) - 1000));
-    view.setInt8(6, pressureDiff);
-
-    // Calculate data flags
     var hasWindGust = windGust !== -1;
     var hasWindDir = windDirection !== -1;
     var hasAirQuality = airQualityIndex !== -1;
-    var dataFlags = (hasWindGust ? 0x4 : 0) | (hasWindDir ? 0x2 : 0) | (hasAirQuality ? 0x1 : 0);
-
-    // Clamp and pack wind direction and air quality index
-    // Center wind direction bins: shift by half a bin (11.25 deg) before dividing
-    var windDir4 = hasWindDir ? Math.floor(((windDirection + 11.25) % 360) / 22.5) : 0;
-    var aqi4 = hasAirQuality ? Math.max(0, Math.min(15, Math.round(airQualityIndex / 50))) : 0;
-    view.setUint8(7, (windDir4 << 4) | (aqi4 & 0x0F));
-
-    // Clamp and pack uv index and data flags
-    var uv4 = Math.max(0, Math.min(15, Math.round(uvIndex)));
-    view.setUint8(8, (uv4 << 4) | (dataFlags & 0x0F));
-
-    // Condition and experiential icons (uint4 each)
-    view.setUint8(9, (condition << 4) | (experientialIcon & 0x0F));
-
-    //debugLog("buffer ints: " + bufferToInts(buffer));
-    return bufferToInts(buffer);
+    var flags = (hasWindGust ? wire.HOUR_FLAGS.WIND_GUST : 0) |
+        (hasWindDir ? wire.HOUR_FLAGS.WIND_DIR : 0) |
+        (hasAirQuality ? wire.HOUR_FLAGS.AIR_QUALITY : 0);
+
+    return wire.packHour({
+        ofDay: hour,
+        temp: temperature,
+        feelsLike: feelsLike,
+        windSpeed: windSpeed,
+        windGust: hasWindGust ? windGust : 0,
+        visibility: visibility,
+        pressureMb: pressure,
+        // Center wind direction bins: shift by half a bin (11.25 deg) before dividing
+        windDir16: hasWindDir ? Math.floor(((windDirection + 11.25) % 360) / 22.5) : 0,
+        aqi: hasAirQuality ? airQualityIndex : 0,
+        uvIndex: uvIndex,
+        flags: flags,
+        conditionsIcon: condition,
+        experientialIcon: experientialIcon
+    });
 }
 
-
-/*
-    Special details can be provided to the current hour, such as precipitation
-
-    uint8: precipitation type (0 for none)
-    uint2 * [24]: precipitation intensity (on a scale of 0-3) in 5 minute intervals, for up to 2 hours
-
-*/
+/**
+ * Packs the precipitation outlook for the current hour into a 7-byte package
+ * @param {number} precipitationType - 0 for none
+ * @param {Array} precipitationMinutes - Intensities (0-3) in 5 minute
+ *     intervals; missing intervals are sent as 0
+ */
 function packPrecipitation(
     precipitationType,
     precipitationMinutes
 ) {
-    var buffer = new ArrayBuffer(7);
-    var view = new DataView(buffer);
-
-    // First byte: precipitation type (uint8)
-    view.setUint8(0, precipitationType);
-
-    // Next 6 bytes: 24 precipitation intensity values (2 bits each)
-    // Each byte can hold 4 intensity values
-    for (var i = 0; i < 6; i++) {
-        var byte = 0;
-        for (var j = 0; j < 4; j++) {
-            var intensityIndex = i * 4 + j;
-            if (intensityIndex < precipitationMinutes.length) {
-                // Shift each 2-bit value into position
-                byte |= (precipitationMinutes[intensityIndex] & 0x03) << (j * 2);
-            }
-        }
-        view.setUint8(i + 1, byte);
-    }
-
-    return bufferToInts(buffer);
+    return wire.packPrecipitation({
+        type: precipitationType,
+        intensity: precipitationMinutes
+    });
 }
 
-function bufferToInts(buffer) {
-    var view = new Uint8Array(buffer);
-    var ints = [];
-    for (var i = 0; i < view.length; i++) {
-        ints.push(view[i]);
-    }
-    return ints;
+/**
+ * Packs the next hour minute by minute into a 33-byte versioned package,
+ * sent next to the 7-byte one so older watch builds still get that
+ * @param {number} precipitationType - 0 for none
+ * @param {number} chance - Highest chance in the hour, percent
+ * @param {Array} minuteSteps - 60 values, 0-15 (see weatherkit.precipitationSteps)
+ */
+function packPrecipitationMinutes(precipitationType, chance, minuteSteps) {
+    return wire.packPrecipitationMinutes({
+        type: precipitationType,
+        chance: chance,
+        steps: minuteSteps
+    });
 }
 
 /**
@@ -185,12 +137,14 @@ function saveWeatherCache(hourPackages) {
 /**
  * Saves precipitation data to localStorage with timestamp
  * @param {Array} precipitationData - Packed precipitation data
+ * @param {Array} [precipitationMinutes] - Packed minute-by-minute data
  */
-function savePrecipitationCache(precipitationData) {
+function savePrecipitationCache(precipitationData, precipitationMinutes) {
     try {
         var cacheData = {
             timestamp: Date.now(),
-            precipitationData: precipitationData
+            precipitationData: precipitationData,
+            precipitationMinutes: precipitationMinutes || null
         };
         localStorage.setItem(PRECIPITATION_CACHE_KEY, JSON.stringify(cacheData));
         debugLog('Precipitation data cached successfully');
@@ -227,7 +181,8 @@ function getCachedWeatherData(maxAgeMinutes) {
 
         var result = {
             hourPackages: weatherCache.hourPackages,
-            precipitationData: null
+            precipitationData: null,
+            precipitationMinutes: null
         };
 
         // Check precipitation cache if it exists
@@ -237,6 +192,7 @@ function getCachedWeatherData(maxAgeMinutes) {
 
             if (precipitationAge <= maxAgeMs) {
                 result.precipitationData = precipitationCache.precipitationData;
+                result.precipitationMinutes = precipitationCache.precipitationMinutes || null;
                 debugLog('Using cached precipitation data (age: ' + Math.round(precipitationAge / (60 * 1000)) + ' minutes)');
             } else {
                 debugLog('Precipitation cache expired (age: ' + Math.round(precipitationAge / (60 * 1000)) + ' minutes)');
@@ -269,6 +225,7 @@ module.exports = {
     packHourData: packHourData,
     packAllHourData: packAllHourData,
     packPrecipitation: packPrecipitation,
+    packPrecipitationMinutes: packPrecipitationMinutes,
     saveWeatherCache: saveWeatherCache,
     savePrecipitationCache: savePrecipitationCache,
     getCachedWeatherData: getCachedWeatherData,
@@ -0,0 +1,270 @@
+/**
+ * pinmanager.js
+ *
+ * Keeps a group of timeline pins in step with the latest forecast without
+ * resending what the server already has. Each pin is hashed without its
+ * lastUpdated stamp; sync() PUTs only pins whose hash changed, DELETEs
+ * pins that dropped out of the group while they are still upcoming, and
+ * sends the whole batch under one timeline token. The token is cached
+ * until the server rejects it.
+ *
+ * Requests go through timeline.js, so timeline.setServer() also swaps the
+ * server this talks to.
+ */
+
+var timeline = require('./timeline');
+
+var STATE_KEY = 'timeline_pin_state';
+var TOKEN_KEY = 'timeline_token';
+
+// Statuses that mean the token is no longer any good
+var AUTH_FAILURES = [401, 403, 410];
+
+// Debug configuration
+var debug = false;
+
+function debugLog(message) {
+    if (debug) {
+        console.log(message);
+    }
+}
+
+// group -> pin id -> {hash, end}; loaded from localStorage on first use
+var state = null;
+var token = null;
+var tokenWaiters = null;
+
+var stats = {
+    syncs: 0,
+    tokenFetches: 0,
+    puts: 0,
+    deletes: 0,
+    skipped: 0,    // unchanged pins not resent
+    failed: 0
+};
+
+function hasStorage() {
+    return typeof localStorage !== 'undefined';
+}
+
+function loadState() {
+    if (state) {
+        return state;
+    }
+    state = {};
+    if (hasStorage()) {
+        try {
+            state = JSON.parse(localStorage.getItem(STATE_KEY)) || {};
+            token = localStorage.getItem(TOKEN_KEY);
+        } catch (error) {
+            debugLog('Failed to load pin state: ' + error.message);
+        }
+    }
+    return state;
+}
+
+function saveState() {
+    if (hasStorage()) {
+        try {
+            localStorage.setItem(STATE_KEY, JSON.stringify(state));
+        } catch (error) {
+            debugLog('Failed to save pin state: ' + error.message);
+        }
+    }
+}
+
+function setToken(value) {
+    token = value;
+    if (hasStorage()) {
+        if (value) {
+            localStorage.setItem(TOKEN_KEY, value);
+        } else {
+            localStorage.removeItem(TOKEN_KEY);
+        }
+    }
+}
+
+// JSON with sorted keys and lastUpdated left out, so only what the user
+// would see counts as a change
+function canonical(value) {
+    if (value === null || typeof value !== 'object') {
+        return JSON.stringify(value);
+    }
+    if (Array.isArray(value)) {
+        return '[' + value.map(canonical).join(',') + ']';
+    }
+    var keys = Object.keys(value).filter(function (key) {
+        return key !== 'lastUpdated' && value[key] !== undefined;
+    }).sort();
+    return '{' + keys.map(function (key) {
+        return JSON.stringify(key) + ':' + canonical(value[key]);
+    }).join(',') + '}';
+}
+
+/**
+ * 32-bit FNV-1a hash of a pin's material content
+ * @param {Object} pin - A timeline pin
+ * @returns {number}
+ */
+function hashPin(pin) {
+    var text = canonical(pin);
+    var hash = 0x811c9dc5;
+    for (var i = 0; i < text.length; i++) {
+        hash ^= text.charCodeAt(i);
+        // hash * 0x01000193 mod 2^32, in shifts the phone's JS can do exactly
+        hash = (hash + (hash << 1) + (hash << 4) + (hash << 7) + (hash << 8) + (hash << 24)) >>> 0;
+    }
+    return hash;
+}
+
+// When a pin stops being worth deleting
+function pinEnd(pin) {
+    return Date.parse(pin.time) + (pin.duration || 0) * 60 * 1000;
+}
+
+// Calls back with the cached token, or fetches one; syncs that ask while a
+// fetch is under way share it
+function withToken(onToken, onError) {
+    if (token) {
+        onToken(token);
+        return;
+    }
+    if (tokenWaiters) {
+        tokenWaiters.push({onToken: onToken, onError: onError});
+        return;
+    }
+    tokenWaiters = [{onToken: onToken, onError: onError}];
+    stats.tokenFetches++;
+    timeline.getToken(function (value) {
+        setToken(value);
+        var waiters = tokenWaiters;
+        tokenWaiters = null;
+        waiters.forEach(function (waiter) { waiter.onToken(value); });
+    }, function (error) {
+        debugLog('Error getting timeline token: ' + error);
+        var waiters = tokenWaiters;
+        tokenWaiters = null;
+        waiters.forEach(function (waiter) { waiter.onError(error); });
+    });
+}
+
+// Sends every request under one token. Requests the server turns away for
+// the token are tried once more with a fresh one.
+function sendBatch(requests, retried, done) {
+    withToken(function (value) {
+        var remaining = requests.length;
+        var rejected = [];
+        requests.forEach(function (request) {
+            timeline.sendWithToken(request.pin, request.type, null, null, value, function (status) {
+                if (status >= 200 && status < 300) {
+                    request.onSent();
+                } else if (AUTH_FAILURES.indexOf(status) !== -1 && !retried) {
+                    rejected.push(request);
+                } else {
+                    debugLog('Pin ' + request.type + ' ' + request.pin.id + ' failed: ' + status);
+                    stats.failed++;
+                }
+                if (--remaining === 0) {
+                    if (rejected.length > 0) {
+                        if (token === value) {
+                            setToken(null);
+                        }
+                        sendBatch(rejected, true, done);
+                    } else {
+                        done();
+                    }
+                }
+            });
+        });
+    }, function () {
+        stats.failed += requests.length;
+        done();
+    });
+}
+
+/**
+ * Makes the server's copy of `group` match `pins`
+ * @param {string} group - Names the set of pins `pins` replaces
+ * @param {Array} pins - Every pin the group should have now
+ * @param {Function} [callback] - Called with {put, deleted, skipped} once
+ *     every request has completed
+ */
+function sync(group, pins, callback) {
+    var groups = loadState();
+    var known = groups[group] || {};
+    var now = Date.now();
+    var requests = [];
+    var result = {put: 0, deleted: 0, skipped: 0};
+    var ids = {};
+    stats.syncs++;
+
+    pins.forEach(function (pin) {
+        var hash = hashPin(pin);
+        ids[pin.id] = true;
+        if (known[pin.id] && known[pin.id].hash === hash) {
+            result.skipped++;
+            return;
+        }
+        requests.push({type: 'PUT', pin: pin, onSent: function () {
+            known[pin.id] = {hash: hash, end: pinEnd(pin)};
+            result.put++;
+        }});
+    });
+
+    Object.keys(known).forEach(function (id) {
+        if (ids[id]) {
+            return;
+        }
+        // Past pins stay on the timeline as history
+        if (known[id].end <= now) {
+            delete known[id];
+            return;
+        }
+        requests.push({type: 'DELETE', pin: {id: id}, onSent: function () {
+            delete known[id];
+            result.deleted++;
+        }});
+    });
+
+    groups[group] = known;
+    stats.skipped += result.skipped;
+    if (requests.length === 0) {
+        saveState();
+        if (callback) {
+            callback(result);
+        }
+        return;
+    }
+
+    sendBatch(requests, false, function () {
+        stats.puts += result.put;
+        stats.deletes += result.deleted;
+        saveState();
+        debugLog('Pins ' + group + ': ' + JSON.stringify(result));
+        if (callback) {
+            callback(result);
+        }
+    });
+}
+
+/**
+ * Forgets every pin and the cached token, so the next sync() resends all
+ */
+function reset() {
+    state = {};
+    token = null;
+    tokenWaiters = null;
+    saveState();
+    setToken(null);
+}
+
+function getStats() {
+    return stats;
+}
+
+module.exports = {
+    hashPin: hashPin,
+    sync: sync,
+    reset: reset,
+    getStats: getStats
+};
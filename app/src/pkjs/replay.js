@@ -0,0 +1,131 @@
+/**
+ * replay.js
+ *
+ * Offline replay: recorded WeatherKit responses stand in for the network,
+ * so the forecast still goes through the real parse, pack, AppMessage and
+ * unpack path. The recordings come either from a stand-in server
+ * (app/host/js/replay_server.js, set REPLAY_URL to reach it from the phone)
+ * or straight from a harness through configure(). Every dataset's
+ * timestamps are moved so it reads as fetched just now, and each request
+ * is answered after an artificial latency.
+ */
+
+// e.g. 'http://192.168.1.20:8080/'; empty to fetch from WeatherKit
+var REPLAY_URL = '';
+
+var ISO_TIME = /"(\d{4}-\d\d-\d\dT\d\d:\d\d(?::\d\d(?:\.\d+)?)?Z)"/g;
+
+// Debug configuration
+var debug = false;
+
+function debugLog(message) {
+    if (debug) {
+        console.log(message);
+    }
+}
+
+var options = {
+    url: REPLAY_URL,
+    responses: null,
+    latencyMs: 0
+};
+
+/**
+ * Turns replay on or off
+ * @param {Object} [replayOptions] - null to fetch from WeatherKit again
+ * @param {string} [replayOptions.url] - Stand-in server to fetch recordings from
+ * @param {Array} [replayOptions.responses] - Recorded WeatherKit responses, merged
+ * @param {number} [replayOptions.latencyMs] - Added before each answer
+ */
+function configure(replayOptions) {
+    replayOptions = replayOptions || {};
+    options.url = replayOptions.url || '';
+    options.responses = replayOptions.responses || null;
+    options.latencyMs = replayOptions.latencyMs || 0;
+}
+
+function isEnabled() {
+    return options.url !== '' || options.responses !== null;
+}
+
+// Moves every timestamp in one dataset by the same amount, so it was read now
+function shiftDataset(dataset, now) {
+    var readTime = dataset.metadata && Date.parse(dataset.metadata.readTime);
+    if (!readTime) {
+        return dataset;
+    }
+    var shift = now - readTime;
+    return JSON.parse(JSON.stringify(dataset).replace(ISO_TIME, function (match, time) {
+        return '"' + new Date(Date.parse(time) + shift).toISOString() + '"';
+    }));
+}
+
+function mergedResponse() {
+    var merged = {};
+    options.responses.forEach(function (response) {
+        Object.keys(response).forEach(function (dataset) {
+            merged[dataset] = response[dataset];
+        });
+    });
+    return merged;
+}
+
+// "availability" or "weather" from a WeatherKit URL
+function endpoint(url) {
+    return url.indexOf('/availability/') !== -1 ? 'availability' : 'weather';
+}
+
+// The datasets a weather URL asks for
+function requestedDatasets(url) {
+    var match = /[?&]dataSets=([^&]*)/.exec(url);
+    return match ? decodeURIComponent(match[1]).split(',') : null;
+}
+
+function answer(url, merged, now) {
+    if (endpoint(url) === 'availability') {
+        return JSON.stringify(Object.keys(merged));
+    }
+    var datasets = requestedDatasets(url) || Object.keys(merged);
+    var response = {};
+    datasets.forEach(function (dataset) {
+        if (dataset in merged) {
+            response[dataset] = shiftDataset(merged[dataset], now);
+        }
+    });
+    return JSON.stringify(response);
+}
+
+/**
+ * Answers a WeatherKit GET from the recordings
+ * @param {string} url - The WeatherKit URL the live path would fetch
+ * @param {Function} onLoad - Called with (status, responseText)
+ * @param {Function} onError - Called if the stand-in server cannot be reached
+ */
+function get(url, onLoad, onError) {
+    if (options.responses) {
+        setTimeout(function () {
+            onLoad(200, answer(url, mergedResponse(), Date.now()));
+        }, options.latencyMs);
+        return;
+    }
+
+    var xhr = new XMLHttpRequest();
+    xhr.onload = function () {
+        if (xhr.status !== 200) {
+            onLoad(xhr.status, xhr.responseText);
+            return;
+        }
+        var text = answer(url, JSON.parse(xhr.responseText), Date.now());
+        setTimeout(function () { onLoad(200, text); }, options.latencyMs);
+    };
+    xhr.onerror = onError;
+    debugLog('Replaying ' + endpoint(url) + ' from ' + options.url);
+    xhr.open('GET', options.url + 'recording.json');
+    xhr.send();
+}
+
+module.exports = {
+    configure: configure,
+    isEnabled: isEnabled,
+    get: get
+};
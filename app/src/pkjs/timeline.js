@@ -2,40 +2,97 @@
 var API_URL_ROOT = 'https://timeline-api.rebble.io/';
 
 /**
- * Send a request to the Pebble public web timeline API.
- * @param pin The JSON pin to insert. Must contain 'id' field.
+ * The phone's side of the timeline: where tokens come from and how requests
+ * reach the server. setServer() swaps in a local stand-in so pins can be
+ * exercised offline (see app/host/js/bench_pins.js).
+ */
+var pebbleServer = {
+  /**
+   * @param onToken Called with the user's timeline token.
+   * @param onError Called with an error string.
+   */
+  getToken: function (onToken, onError) {
+    Pebble.getTimelineToken(onToken, onError);
+  },
+
+  /**
+   * @param type PUT or DELETE.
+   * @param url Full pin URL.
+   * @param headers Header names to values.
+   * @param body The request body.
+   * @param callback Called with (status, responseText).
+   */
+  send: function (type, url, headers, body, callback) {
+    var xhr = new XMLHttpRequest();
+    xhr.onload = function () {
+      console.log('timeline: response received: ' + this.responseText);
+      callback(this.status, this.responseText);
+    };
+    xhr.onerror = function () {
+      callback(0, '');
+    };
+    xhr.open(type, url);
+    for (var name in headers) {
+      xhr.setRequestHeader(name, headers[name]);
+    }
+    xhr.send(body);
+    console.log('timeline: request sent.');
+  }
+};
+
+var server = pebbleServer;
+
+/**
+ * Replace the timeline server. Pass null to go back to the real one.
+ * @param standIn An object with getToken() and send() as above.
+ */
+function setServer(standIn) {
+  server = standIn || pebbleServer;
+}
+
+/**
+ * Fetch the timeline token for this user.
+ * @param onToken Called with the token.
+ * @param onError Called with an error string.
+ */
+function getToken(onToken, onError) {
+  server.getToken(onToken, onError);
+}
+
+/**
+ * Send a request with a token the caller already has.
+ * @param pin The JSON pin. Must contain 'id' field.
  * @param type The type of request, either PUT or DELETE.
  * @param topics Array of topics if a shared pin, 'null' otherwise.
  * @param apiKey Timeline API key for this app, available from dev-portal.getpebble.com
- * @param callback The callback to receive the responseText after the request has completed.
+ * @param token The user's timeline token.
+ * @param callback Called with (status, responseText) after the request has completed.
  */
-function timelineRequest(pin, type, topics, apiKey, callback) {
+function sendWithToken(pin, type, topics, apiKey, token, callback) {
   // User or shared?
   var url = API_URL_ROOT + 'v1/' + ((topics != null) ? 'shared/' : 'user/') + 'pins/' + pin.id;
 
-  // Create XHR
-  var xhr = new XMLHttpRequest();
-  xhr.onload = function () {
-    console.log('timeline: response received: ' + this.responseText);
-    callback(this.responseText);
-  };
-  xhr.open(type, url);
-
-  // Set headers
-  xhr.setRequestHeader('Content-Type', 'application/json');
+  var headers = {'Content-Type': 'application/json', 'X-User-Token': '' + token};
   if(topics != null) {
-    xhr.setRequestHeader('X-Pin-Topics', '' + topics.join(','));
-    xhr.setRequestHeader('X-API-Key', '' + apiKey);
+    headers['X-Pin-Topics'] = '' + topics.join(',');
+    headers['X-API-Key'] = '' + apiKey;
   }
+  server.send(type, url, headers, JSON.stringify(pin), callback);
+}
 
-  // Get token
-  Pebble.getTimelineToken(function(token) {
-    // Add headers
-    xhr.setRequestHeader('X-User-Token', '' + token);
-
-    // Send
-    xhr.send(JSON.stringify(pin));
-    console.log('timeline: request sent.');
+/**
+ * Send a request to the Pebble public web timeline API.
+ * @param pin The JSON pin to insert. Must contain 'id' field.
+ * @param type The type of request, either PUT or DELETE.
+ * @param topics Array of topics if a shared pin, 'null' otherwise.
+ * @param apiKey Timeline API key for this app, available from dev-portal.getpebble.com
+ * @param callback The callback to receive the responseText after the request has completed.
+ */
+function timelineRequest(pin, type, topics, apiKey, callback) {
+  getToken(function(token) {
+    sendWithToken(pin, type, topics, apiKey, token, function (status, responseText) {
+      callback(responseText);
+    });
   }, function(error) { console.log('timeline: error getting timeline token: ' + error); });
 }
 
@@ -84,3 +141,6 @@ module.exports.insertUserPin = insertUserPin;
 module.exports.deleteUserPin = deleteUserPin;
 module.exports.insertSharedPin = insertSharedPin;
 module.exports.deleteSharedPin = deleteSharedPin;
+module.exports.getToken = getToken;
+module.exports.sendWithToken = sendWithToken;
+module.exports.setServer = setServer;
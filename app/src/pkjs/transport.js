@@ -0,0 +1,146 @@
+/**
+ * transport.js
+ *
+ * Reliable AppMessage sending for the watch app. Every message gets a SEQ
+ * so the watch can drop the copy it receives when its ACK is lost and the
+ * message is sent again. Messages are queued and up to MAX_IN_FLIGHT go out
+ * without waiting on each other; a NACKed message is retried with
+ * exponential backoff, up to MAX_ATTEMPTS times.
+ *
+ * The watch answers JS_READY with INBOX_SIZE, the largest message it wants.
+ * maxBytes() and dictSize() let callers pack as much as that allows.
+ */
+
+var MAX_IN_FLIGHT = 2;
+var MAX_ATTEMPTS = 5;
+var BACKOFF_MS = 250;
+
+// Until the watch reports its inbox size, assume room for one HOUR_DATA
+// block with its keys
+var DEFAULT_INBOX_SIZE = 160;
+
+// Dictionary header, and per-tuple header (key, type, length)
+var DICT_HEADER_BYTES = 1;
+var TUPLE_HEADER_BYTES = 7;
+// PebbleKit JS sends numbers as int32
+var INT_BYTES = 4;
+
+// Debug configuration
+var debug = false;
+
+function debugLog(message) {
+    if (debug) {
+        console.log(message);
+    }
+}
+
+var queue = [];
+var inFlight = 0;
+var seq = 0;
+var inboxSize = DEFAULT_INBOX_SIZE;
+
+var stats = {
+    queued: 0,
+    sent: 0,       // attempts, retries included
+    acked: 0,
+    nacked: 0,
+    retries: 0,
+    failed: 0,     // given up on after MAX_ATTEMPTS
+    maxQueued: 0
+};
+
+// SEQ runs 1-255 so it fits the uint8 the watch reads
+function nextSeq() {
+    seq = (seq % 255) + 1;
+    return seq;
+}
+
+/**
+ * Size in bytes of the dictionary a payload serializes to
+ * @param {Object} payload - Message keys to numbers or byte arrays
+ */
+function dictSize(payload) {
+    var size = DICT_HEADER_BYTES;
+    for (var key in payload) {
+        var value = payload[key];
+        size += TUPLE_HEADER_BYTES + (typeof value === 'number' ? INT_BYTES : value.length);
+    }
+    // SEQ is added to every message
+    return size + TUPLE_HEADER_BYTES + INT_BYTES;
+}
+
+function pump() {
+    while (inFlight < MAX_IN_FLIGHT && queue.length > 0) {
+        attempt(queue.shift());
+    }
+}
+
+function attempt(entry) {
+    inFlight++;
+    entry.attempts++;
+    stats.sent++;
+    Pebble.sendAppMessage(entry.payload, function () {
+        inFlight--;
+        stats.acked++;
+        entry.onSuccess();
+        pump();
+    }, function (e) {
+        inFlight--;
+        stats.nacked++;
+        if (entry.attempts >= MAX_ATTEMPTS) {
+            stats.failed++;
+            debugLog('Giving up on SEQ ' + entry.payload.SEQ + ': ' + JSON.stringify(e));
+            entry.onFailure();
+        } else {
+            // The same SEQ goes out again, so a copy that did arrive is dropped
+            stats.retries++;
+            var delay = BACKOFF_MS * Math.pow(2, entry.attempts - 1);
+            debugLog('Retrying SEQ ' + entry.payload.SEQ + ' in ' + delay + 'ms');
+            setTimeout(function () {
+                queue.unshift(entry);
+                pump();
+            }, delay);
+        }
+        pump();
+    });
+}
+
+/**
+ * Queues a message for the watch
+ * @param {Object} payload - Message keys to values; SEQ is added
+ * @param {Function} onSuccess - Called once the watch ACKs it
+ * @param {Function} onFailure - Called if every attempt is NACKed
+ */
+function send(payload, onSuccess, onFailure) {
+    payload.SEQ = nextSeq();
+    queue.push({
+        payload: payload,
+        attempts: 0,
+        onSuccess: onSuccess || function () {},
+        onFailure: onFailure || function () {}
+    });
+    stats.queued++;
+    stats.maxQueued = Math.max(stats.maxQueued, queue.length + inFlight);
+    pump();
+}
+
+function setInboxSize(size) {
+    debugLog('Watch inbox size: ' + size);
+    inboxSize = size;
+}
+
+function maxBytes() {
+    return inboxSize;
+}
+
+function getStats() {
+    return stats;
+}
+
+module.exports = {
+    dictSize: dictSize,
+    send: send,
+    setInboxSize: setInboxSize,
+    maxBytes: maxBytes,
+    getStats: getStats
+};
@@ -1,3 +1,5 @@
+var wire = require('./wire_format.auto');
+
 // Debug configuration
 var debug = false;
 
@@ -56,25 +58,36 @@ var conditionCodeMapping = {
 
 var precipitationTypes = ["clear", "precipitation", "rain", "snow", "sleet", "hail", "mixed"];
 
+// Condition code -> category index, flattened once at load. A code listed
+// under two categories keeps the first, as the old per-call scan did.
+var conditionKeys = Object.create(null);
+Object.keys(conditionCodeMapping).forEach(function (category, index) {
+    conditionCodeMapping[category].forEach(function (code) {
+        if (conditionKeys[code] === undefined) {
+            conditionKeys[code] = index;
+        }
+    });
+});
+
+// Category indexes the hour parsing cares about
+var CONDITION_CLEAR = 0;
+var CONDITION_PARTLY_CLOUDY = 2;
+var CONDITION_RAIN = 3;
+var CONDITION_MIXED = 6;
+var CONDITION_FOGGY = 9;
+// Night variants the watch draws for clear and partly cloudy
+var CONDITION_CLEAR_NIGHT = 11;
+var CONDITION_PARTLY_CLOUDY_NIGHT = 12;
+
 /**
  * Converts a condition code to a numerical key (0-15)
  * @param {string} conditionCode - The weather condition code to convert
  * @returns {number} A numerical key between 0-15 representing the condition category
  */
 function getConditionKey(conditionCode) {
-    debugLog("Getting condition key for: " + conditionCode);
-    // Create an array of category keys for consistent indexing
-    var categories = Object.keys(conditionCodeMapping);
-
-    // Find the category that contains the condition code
-    for (var i = 0; i < categories.length; i++) {
-        if (conditionCodeMapping[categories[i]].indexOf(conditionCode) !== -1) {
-            return i;
-        }
-    }
-
     // Default to 0 (Clear) if no match is found
-    return 0;
+    var key = conditionKeys[conditionCode];
+    return key !== undefined ? key : CONDITION_CLEAR;
 }
 
 function getPrecipitationIndex(precipitationType) {
@@ -90,10 +103,13 @@ function getPrecipitationIndex(precipitationType) {
 // 5: hat + scarf / really cold
 // 6: umbrella / wet precipitation
 // 7: fog / low visibility
-function getExperientialIcon(forecastHour) {
+function getExperientialIcon(forecastHour, conditionKey) {
+    if (conditionKey === undefined) {
+        conditionKey = getConditionKey(forecastHour.conditionCode);
+    }
 
     // 6: umbrella / wet precipitation
-    if (getConditionKey(forecastHour.conditionCode) === 3 || getConditionKey(forecastHour.conditionCode) === 6) {
+    if (conditionKey === CONDITION_RAIN || conditionKey === CONDITION_MIXED) {
         return 6;
     }
 
@@ -108,7 +124,7 @@ function getExperientialIcon(forecastHour) {
     }
 
     // 7: fog / low visibility
-    if (getConditionKey(forecastHour.conditionCode) === 9 || forecastHour.visibility < 2000) {
+    if (conditionKey === CONDITION_FOGGY || forecastHour.visibility < 2000) {
         return 7;
     }
 
@@ -126,74 +142,184 @@ function getExperientialIcon(forecastHour) {
     return 0;
 }
 
+function celsiusToFahrenheit(celsius) {
+    return (celsius * 9/5) + 32;
+}
+
+/**
+ * Packs one WeatherKit forecastHourly hour straight into a 10-byte hour
+ * package (see app/schema/wire_format.json), looking its condition up once
+ * @param {Object} hour - An entry of forecastHourly.hours
+ * @returns {Array} The packed bytes
+ */
+function packForecastHour(hour) {
+    var conditionKey = getConditionKey(hour.conditionCode);
+    var experientialIcon = getExperientialIcon(hour, conditionKey);
+    if (hour.daylight === false) {
+        if (conditionKey === CONDITION_CLEAR) conditionKey = CONDITION_CLEAR_NIGHT;
+        else if (conditionKey === CONDITION_PARTLY_CLOUDY) conditionKey = CONDITION_PARTLY_CLOUDY_NIGHT;
+    }
+
+    // windGust and windDirection are not required in the response, and
+    // WeatherKit has no air quality
+    var hasWindGust = "windGust" in hour;
+    var hasWindDir = "windDirection" in hour;
+
+    return wire.packHour({
+        ofDay: new Date(hour.forecastStart).getHours(),
+        temp: celsiusToFahrenheit(hour.temperature),
+        feelsLike: celsiusToFahrenheit(hour.temperatureApparent),
+        windSpeed: hour.windSpeed,
+        windGust: hasWindGust ? hour.windGust : 0,
+        visibility: hour.visibility / 1000,
+        pressureMb: hour.pressure,
+        // Center wind direction bins: shift by half a bin (11.25 deg) before dividing
+        windDir16: hasWindDir ? Math.floor(((hour.windDirection + 11.25) % 360) / 22.5) : 0,
+        aqi: 0,
+        uvIndex: hour.uvIndex,
+        flags: (hasWindGust ? wire.HOUR_FLAGS.WIND_GUST : 0) | (hasWindDir ? wire.HOUR_FLAGS.WIND_DIR : 0),
+        conditionsIcon: conditionKey,
+        experientialIcon: experientialIcon
+    });
+}
+
+var PRECIPITATION_INTERVALS = 24;
+var INTERVAL_MINUTES = 5;
+var PRECIPITATION_MINUTES = 60;
+var MINUTE_MS = 60 * 1000;
+
+// How each 5-minute interval is reduced from its minutes
+var RESAMPLE_SAMPLE = 'sample';  // the minute the interval starts on
+var RESAMPLE_MAX = 'max';
+var RESAMPLE_MEAN = 'mean';
+
+/**
+ * Resamples forecastNextHour minutes into the watch's 24 five-minute
+ * intervals, or any other fixed grid. Interval 0 starts on the first
+ * boundary at or after `now`; earlier minutes are dropped and intervals past
+ * the data stay 0. Minutes are taken to be consecutive from the first
+ * startTime, so only that one timestamp is parsed.
+ * @param {Array} minutes - Minute objects with startTime, precipitationIntensity (mm/hr)
+ * @param {number} now - Current time in ms since the epoch
+ * @param {string} [mode] - RESAMPLE_SAMPLE (default), RESAMPLE_MAX or RESAMPLE_MEAN
+ * @param {number} [intervalMinutes] - Interval length, default 5
+ * @param {number} [intervals] - Interval count, default 24
+ * @returns {Float64Array} mm/hr for each interval
+ */
+function resamplePrecipitationMinutes(minutes, now, mode, intervalMinutes, intervals) {
+    intervalMinutes = intervalMinutes || INTERVAL_MINUTES;
+    intervals = intervals || PRECIPITATION_INTERVALS;
+    var rates = new Float64Array(intervals);
+    var counts = mode === RESAMPLE_MEAN ? new Uint8Array(intervals) : null;
+
+    // Positions in whole minutes since the epoch; 5-minute boundaries line
+    // up with local :00/:05 in every real time zone
+    var origin = Math.ceil(Math.floor(now / MINUTE_MS) / intervalMinutes) * intervalMinutes;
+    var offset = Math.floor(Date.parse(minutes[0].startTime) / MINUTE_MS) - origin;
+    var end = Math.min(minutes.length, intervals * intervalMinutes - offset);
+
+    for (var i = Math.max(0, -offset); i < end; i++) {
+        var minute = offset + i;
+        var interval = (minute / intervalMinutes) | 0;
+        var rate = minutes[i].precipitationIntensity;
+        if (mode === RESAMPLE_MAX) {
+            if (rate > rates[interval]) {
+                rates[interval] = rate;
+            }
+        } else if (mode === RESAMPLE_MEAN) {
+            rates[interval] += rate;
+            counts[interval]++;
+        } else if (minute % intervalMinutes === 0) {
+            rates[interval] = rate;
+        }
+    }
+
+    if (counts) {
+        for (var k = 0; k < intervals; k++) {
+            if (counts[k] > 0) {
+                rates[k] /= counts[k];
+            }
+        }
+    }
+    return rates;
+}
+
+// Maps mm/hr to 0-3 using absolute thresholds (consistent with events.js)
+function precipitationLevel(mmhr, isSnowLike) {
+    if (mmhr < 0.1) return 0;
+    if (isSnowLike) {
+        if (mmhr > 2.5) return 3;
+        if (mmhr >= 1.0) return 2;
+        return 1;
+    }
+    if (mmhr > 7.6) return 3;
+    if (mmhr >= 2.5) return 2;
+    return 1;
+}
+
+// Upper ends of intensity levels 1-3 in mm/hr: level 1 starts at 0.1, level
+// 3 is open-ended and the last value only bounds its steps. Light rates get
+// the finest steps, since that is where the graph is usually drawn.
+var RAIN_LEVEL_BOUNDS = [0.1, 2.5, 7.6, 22.8];
+var SNOW_LEVEL_BOUNDS = [0.1, 1.0, 2.5, 7.5];
+var LEVEL_STEPS = 5;
+
+/**
+ * Quantises mm/hr onto the watch's minute scale: 0 for none, then
+ * LEVEL_STEPS steps per intensity level, spread over that level's own range.
+ * Math.ceil(steps / LEVEL_STEPS) is always precipitationLevel().
+ */
+function precipitationSteps(mmhr, isSnowLike) {
+    var bounds = isSnowLike ? SNOW_LEVEL_BOUNDS : RAIN_LEVEL_BOUNDS;
+    var level = precipitationLevel(mmhr, isSnowLike);
+    if (level === 0) {
+        return 0;
+    }
+    var lo = bounds[level - 1];
+    var hi = bounds[level];
+    var step = Math.floor((mmhr - lo) / (hi - lo) * LEVEL_STEPS);
+    return (level - 1) * LEVEL_STEPS + 1 + Math.max(0, Math.min(LEVEL_STEPS - 1, step));
+}
 
 /**
  * Processes precipitation minutes and returns processed data without packing.
  * @param {string} nextHour - The precipitation type/condition for the next hour (e.g., 'rain', 'clear', etc.)
  * @param {Array} precipitationMinutes - Array of minute objects with startTime, precipitationChance, precipitationIntensity
+ * @param {number} [now] - Current time in ms since the epoch; defaults to Date.now()
+ * @param {string} [mode] - How each 5-minute interval is reduced, see resamplePrecipitationMinutes()
  * @returns {Object|null} Processed precipitation data object or null if not enough data
  */
-function processPrecipitationMinutes(nextHour, precipitationMinutes) {
+function processPrecipitationMinutes(nextHour, precipitationMinutes, now, mode) {
     if (nextHour !== "clear" && precipitationMinutes && precipitationMinutes.length > 10) {
-        // Get current time and first precipitation minute time
-        var now = new Date();
-        var firstPrecipMinute = new Date(precipitationMinutes[0].startTime);
-
-        // If current time is before first minute, prepend empty entries
-        if (now < firstPrecipMinute) {
-            var minutesToAdd = [];
-            var currentMinute = new Date(now);
-            currentMinute.setMinutes(now.getMinutes());
-
-            while (currentMinute < firstPrecipMinute) {
-                minutesToAdd.push({
-                    startTime: currentMinute.toISOString(),
-                    precipitationChance: 0,
-                    precipitationIntensity: 0
-                });
-                currentMinute.setMinutes(currentMinute.getMinutes() + 1);
-            }
+        now = now === undefined ? Date.now() : now;
+        var rates = resamplePrecipitationMinutes(precipitationMinutes, now, mode);
 
-            precipitationMinutes = minutesToAdd.concat(precipitationMinutes);
+        var isSnowLike = (nextHour === "snow" || nextHour === "sleet");
+        var levels = new Uint8Array(PRECIPITATION_INTERVALS);
+        for (var i = 0; i < PRECIPITATION_INTERVALS; i++) {
+            levels[i] = precipitationLevel(rates[i], isSnowLike);
         }
 
-        // Filter precipitation minutes to only include those at 5-minute intervals
-        precipitationMinutes = precipitationMinutes.filter(function (minute) {
-            var minuteTime = new Date(minute.startTime);
-            return minuteTime.getMinutes() % 5 === 0;
-        });
-
-        // Ensure array is exactly 24 entries (2 hours of 5-minute intervals)
-        while (precipitationMinutes.length < 24) {
-            var lastEntry = precipitationMinutes[precipitationMinutes.length - 1];
-            var lastTime = new Date(lastEntry.startTime);
-            lastTime.setMinutes(lastTime.getMinutes() + 5);
-            precipitationMinutes.push({
-                startTime: lastTime.toISOString(),
-                precipitationChance: 0,
-                precipitationIntensity: 0
-            });
+        // The next hour minute by minute, for watches that take it. It starts
+        // on the same boundary as interval 0 so the watch can rebuild the
+        // intervals from it.
+        var intervalStart = Math.ceil(Math.floor(now / MINUTE_MS) / INTERVAL_MINUTES) * INTERVAL_MINUTES * MINUTE_MS;
+        var minuteRates = resamplePrecipitationMinutes(precipitationMinutes, intervalStart, RESAMPLE_SAMPLE,
+            1, PRECIPITATION_MINUTES);
+        var minuteSteps = new Uint8Array(PRECIPITATION_MINUTES);
+        for (var m = 0; m < PRECIPITATION_MINUTES; m++) {
+            minuteSteps[m] = precipitationSteps(minuteRates[m], isSnowLike);
+        }
+        var chance = 0;
+        for (var c = 0; c < precipitationMinutes.length && c < PRECIPITATION_MINUTES; c++) {
+            chance = Math.max(chance, precipitationMinutes[c].precipitationChance || 0);
         }
-
-        // Map intensities to 0-3 using absolute mm/hr thresholds (consistent with events.js)
-        var isSnowLike = (nextHour === "snow" || nextHour === "sleet");
-        var scaledIntensities = precipitationMinutes.map(function (minute) {
-            var mmhr = minute.precipitationIntensity;
-            if (mmhr < 0.1) return 0;
-            if (isSnowLike) {
-                if (mmhr > 2.5) return 3;
-                if (mmhr >= 1.0) return 2;
-                return 1;
-            } else {
-                if (mmhr > 7.6) return 3;
-                if (mmhr >= 2.5) return 2;
-                return 1;
-            }
-        });
 
         return {
             precipitationType: getPrecipitationIndex(nextHour),
-            precipitationIntensities: scaledIntensities
+            precipitationIntensities: levels,
+            minuteSteps: minuteSteps,
+            chance: Math.round(chance * 100)
         };
     }
     return null;
@@ -206,5 +332,11 @@ module.exports = {
     getConditionKey: getConditionKey,
     getPrecipitationIndex: getPrecipitationIndex,
     getExperientialIcon: getExperientialIcon,
+    packForecastHour: packForecastHour,
+    RESAMPLE_SAMPLE: RESAMPLE_SAMPLE,
+    RESAMPLE_MAX: RESAMPLE_MAX,
+    RESAMPLE_MEAN: RESAMPLE_MEAN,
+    resamplePrecipitationMinutes: resamplePrecipitationMinutes,
+    precipitationSteps: precipitationSteps,
     processPrecipitationMinutes: processPrecipitationMinutes
 };
@@ -0,0 +1,305 @@
+// Generated by app/tools/gen_wire_format.py from app/schema/wire_format.json, do not edit
+
+function clamp(value, lo, hi) {
+    return Math.max(lo, Math.min(hi, value));
+}
+
+function code(value, codes, fallback) {
+    return value < codes ? value : fallback;
+}
+
+var HOUR_PACKAGE_SIZE = 10;
+var HOUR_FLAGS = {
+    WIND_GUST: 0x4,
+    WIND_DIR: 0x2,
+    AIR_QUALITY: 0x1
+};
+
+/**
+ * One forecast hour. HOUR_DATA carries 12 of these back to back.
+ * Packs decoded values into HOUR_PACKAGE_SIZE bytes, rounding and clamping each field:
+ *   ofDay              Hour of day (0-23)
+ *   temp               Temperature in degrees F
+ *   feelsLike          Feels-like temperature in degrees F
+ *   windSpeed          Wind speed in kph
+ *   windGust           Wind gust speed in kph
+ *   visibility         Visibility in km
+ *   pressureMb         Pressure in mb
+ *   windDir16          Direction the wind comes from, in 22.5 degree steps (0-15)
+ *   aqi                Air quality index (0-750 in steps of 50)
+ *   uvIndex            UV index
+ *   flags              Which optional fields are present
+ *   conditionsIcon     Condition icon code
+ *   experientialIcon   Experiential icon code (1 to NUM_EXPERIENTIAL_ICONS, 0 for none)
+ */
+function packHour(fields) {
+    return [
+        clamp(Math.round(fields.ofDay), 0, 255),
+        (clamp(Math.round(fields.temp), -128, 127)) & 0xFF,
+        (clamp(Math.round(fields.feelsLike), -128, 127)) & 0xFF,
+        clamp(Math.round(fields.windSpeed), 0, 255),
+        clamp(Math.round(fields.windGust), 0, 255),
+        clamp(Math.round(fields.visibility), 0, 255),
+        (clamp(Math.round(fields.pressureMb - 1000), -128, 127)) & 0xFF,
+        (clamp(Math.round(fields.windDir16), 0, 15)) << 4 |
+        clamp(Math.round((fields.aqi) / 50), 0, 15),
+        (clamp(Math.round(fields.uvIndex), 0, 15)) << 4 |
+        clamp(Math.round(fields.flags), 0, 15),
+        (clamp(Math.round(fields.conditionsIcon), 0, 15)) << 4 |
+        clamp(Math.round(fields.experientialIcon), 0, 15)
+    ];
+}
+
+// Decodes a package starting at bytes[offset]
+function unpackHour(bytes, offset) {
+    var o = offset || 0;
+    return {
+        ofDay: (bytes[o + 0]) % 24,
+        temp: (bytes[o + 1] << 24) >> 24,
+        feelsLike: (bytes[o + 2] << 24) >> 24,
+        windSpeed: bytes[o + 3],
+        windGust: bytes[o + 4],
+        visibility: bytes[o + 5],
+        pressureMb: ((bytes[o + 6] << 24) >> 24) + 1000,
+        windDir16: (bytes[o + 7] >> 4) & 0xF,
+        aqi: (bytes[o + 7] & 0xF) * 50,
+        uvIndex: (bytes[o + 8] >> 4) & 0xF,
+        flags: bytes[o + 8] & 0xF,
+        conditionsIcon: code((bytes[o + 9] >> 4) & 0xF, 13, 1),
+        experientialIcon: code(bytes[o + 9] & 0xF, 8, 0)
+    };
+}
+
+var PRECIPITATION_PACKAGE_SIZE = 7;
+
+/**
+ * Precipitation over the next two hours, sent as PRECIPITATION_PACKAGE.
+ * Packs decoded values into PRECIPITATION_PACKAGE_SIZE bytes, rounding and clamping each field:
+ *   type               Precipitation type (0 for none)
+ *   intensity[24]      Intensity (0-3) in 5 minute intervals
+ */
+function packPrecipitation(fields) {
+    return [
+        clamp(Math.round(fields.type), 0, 255),
+        clamp(Math.round((fields.intensity[0] || 0)), 0, 3) |
+        (clamp(Math.round((fields.intensity[1] || 0)), 0, 3)) << 2 |
+        (clamp(Math.round((fields.intensity[2] || 0)), 0, 3)) << 4 |
+        (clamp(Math.round((fields.intensity[3] || 0)), 0, 3)) << 6,
+        clamp(Math.round((fields.intensity[4] || 0)), 0, 3) |
+        (clamp(Math.round((fields.intensity[5] || 0)), 0, 3)) << 2 |
+        (clamp(Math.round((fields.intensity[6] || 0)), 0, 3)) << 4 |
+        (clamp(Math.round((fields.intensity[7] || 0)), 0, 3)) << 6,
+        clamp(Math.round((fields.intensity[8] || 0)), 0, 3) |
+        (clamp(Math.round((fields.intensity[9] || 0)), 0, 3)) << 2 |
+        (clamp(Math.round((fields.intensity[10] || 0)), 0, 3)) << 4 |
+        (clamp(Math.round((fields.intensity[11] || 0)), 0, 3)) << 6,
+        clamp(Math.round((fields.intensity[12] || 0)), 0, 3) |
+        (clamp(Math.round((fields.intensity[13] || 0)), 0, 3)) << 2 |
+        (clamp(Math.round((fields.intensity[14] || 0)), 0, 3)) << 4 |
+        (clamp(Math.round((fields.intensity[15] || 0)), 0, 3)) << 6,
+        clamp(Math.round((fields.intensity[16] || 0)), 0, 3) |
+        (clamp(Math.round((fields.intensity[17] || 0)), 0, 3)) << 2 |
+        (clamp(Math.round((fields.intensity[18] || 0)), 0, 3)) << 4 |
+        (clamp(Math.round((fields.intensity[19] || 0)), 0, 3)) << 6,
+        clamp(Math.round((fields.intensity[20] || 0)), 0, 3) |
+        (clamp(Math.round((fields.intensity[21] || 0)), 0, 3)) << 2 |
+        (clamp(Math.round((fields.intensity[22] || 0)), 0, 3)) << 4 |
+        (clamp(Math.round((fields.intensity[23] || 0)), 0, 3)) << 6
+    ];
+}
+
+// Decodes a package starting at bytes[offset]
+function unpackPrecipitation(bytes, offset) {
+    var o = offset || 0;
+    return {
+        type: bytes[o + 0],
+        intensity: [
+            bytes[o + 1] & 0x3,
+            (bytes[o + 1] >> 2) & 0x3,
+            (bytes[o + 1] >> 4) & 0x3,
+            (bytes[o + 1] >> 6) & 0x3,
+            bytes[o + 2] & 0x3,
+            (bytes[o + 2] >> 2) & 0x3,
+            (bytes[o + 2] >> 4) & 0x3,
+            (bytes[o + 2] >> 6) & 0x3,
+            bytes[o + 3] & 0x3,
+            (bytes[o + 3] >> 2) & 0x3,
+            (bytes[o + 3] >> 4) & 0x3,
+            (bytes[o + 3] >> 6) & 0x3,
+            bytes[o + 4] & 0x3,
+            (bytes[o + 4] >> 2) & 0x3,
+            (bytes[o + 4] >> 4) & 0x3,
+            (bytes[o + 4] >> 6) & 0x3,
+            bytes[o + 5] & 0x3,
+            (bytes[o + 5] >> 2) & 0x3,
+            (bytes[o + 5] >> 4) & 0x3,
+            (bytes[o + 5] >> 6) & 0x3,
+            bytes[o + 6] & 0x3,
+            (bytes[o + 6] >> 2) & 0x3,
+            (bytes[o + 6] >> 4) & 0x3,
+            (bytes[o + 6] >> 6) & 0x3
+        ]
+    };
+}
+
+var PRECIPITATION_MINUTES_PACKAGE_SIZE = 33;
+
+/**
+ * The next hour minute by minute, sent as PRECIPITATION_MINUTES alongside the legacy package.
+ * Packs decoded values into PRECIPITATION_MINUTES_PACKAGE_SIZE bytes, rounding and clamping each field:
+ *   type               Precipitation type (0 for none)
+ *   chance             Highest chance of precipitation in the hour, percent
+ *   steps[60]          Intensity in steps of 1/PRECIPITATION_LEVEL_STEPS of a 0-3 intensity level, one per minute
+ */
+function packPrecipitationMinutes(fields) {
+    return [
+        2,
+        clamp(Math.round(fields.type), 0, 255),
+        clamp(Math.round(fields.chance), 0, 255),
+        (clamp(Math.round((fields.steps[0] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[1] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[2] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[3] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[4] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[5] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[6] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[7] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[8] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[9] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[10] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[11] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[12] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[13] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[14] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[15] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[16] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[17] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[18] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[19] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[20] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[21] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[22] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[23] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[24] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[25] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[26] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[27] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[28] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[29] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[30] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[31] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[32] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[33] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[34] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[35] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[36] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[37] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[38] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[39] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[40] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[41] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[42] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[43] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[44] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[45] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[46] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[47] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[48] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[49] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[50] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[51] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[52] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[53] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[54] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[55] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[56] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[57] || 0)), 0, 15),
+        (clamp(Math.round((fields.steps[58] || 0)), 0, 15)) << 4 |
+        clamp(Math.round((fields.steps[59] || 0)), 0, 15)
+    ];
+}
+
+// Decodes a package starting at bytes[offset]
+function unpackPrecipitationMinutes(bytes, offset) {
+    var o = offset || 0;
+    return {
+        version: bytes[o + 0],
+        type: bytes[o + 1],
+        chance: bytes[o + 2],
+        steps: [
+            (bytes[o + 3] >> 4) & 0xF,
+            bytes[o + 3] & 0xF,
+            (bytes[o + 4] >> 4) & 0xF,
+            bytes[o + 4] & 0xF,
+            (bytes[o + 5] >> 4) & 0xF,
+            bytes[o + 5] & 0xF,
+            (bytes[o + 6] >> 4) & 0xF,
+            bytes[o + 6] & 0xF,
+            (bytes[o + 7] >> 4) & 0xF,
+            bytes[o + 7] & 0xF,
+            (bytes[o + 8] >> 4) & 0xF,
+            bytes[o + 8] & 0xF,
+            (bytes[o + 9] >> 4) & 0xF,
+            bytes[o + 9] & 0xF,
+            (bytes[o + 10] >> 4) & 0xF,
+            bytes[o + 10] & 0xF,
+            (bytes[o + 11] >> 4) & 0xF,
+            bytes[o + 11] & 0xF,
+            (bytes[o + 12] >> 4) & 0xF,
+            bytes[o + 12] & 0xF,
+            (bytes[o + 13] >> 4) & 0xF,
+            bytes[o + 13] & 0xF,
+            (bytes[o + 14] >> 4) & 0xF,
+            bytes[o + 14] & 0xF,
+            (bytes[o + 15] >> 4) & 0xF,
+            bytes[o + 15] & 0xF,
+            (bytes[o + 16] >> 4) & 0xF,
+            bytes[o + 16] & 0xF,
+            (bytes[o + 17] >> 4) & 0xF,
+            bytes[o + 17] & 0xF,
+            (bytes[o + 18] >> 4) & 0xF,
+            bytes[o + 18] & 0xF,
+            (bytes[o + 19] >> 4) & 0xF,
+            bytes[o + 19] & 0xF,
+            (bytes[o + 20] >> 4) & 0xF,
+            bytes[o + 20] & 0xF,
+            (bytes[o + 21] >> 4) & 0xF,
+            bytes[o + 21] & 0xF,
+            (bytes[o + 22] >> 4) & 0xF,
+            bytes[o + 22] & 0xF,
+            (bytes[o + 23] >> 4) & 0xF,
+            bytes[o + 23] & 0xF,
+            (bytes[o + 24] >> 4) & 0xF,
+            bytes[o + 24] & 0xF,
+            (bytes[o + 25] >> 4) & 0xF,
+            bytes[o + 25] & 0xF,
+            (bytes[o + 26] >> 4) & 0xF,
+            bytes[o + 26] & 0xF,
+            (bytes[o + 27] >> 4) & 0xF,
+            bytes[o + 27] & 0xF,
+            (bytes[o + 28] >> 4) & 0xF,
+            bytes[o + 28] & 0xF,
+            (bytes[o + 29] >> 4) & 0xF,
+            bytes[o + 29] & 0xF,
+            (bytes[o + 30] >> 4) & 0xF,
+            bytes[o + 30] & 0xF,
+            (bytes[o + 31] >> 4) & 0xF,
+            bytes[o + 31] & 0xF,
+            (bytes[o + 32] >> 4) & 0xF,
+            bytes[o + 32] & 0xF
+        ]
+    };
+}
+
+module.exports = {
+    HOUR_PACKAGE_SIZE: HOUR_PACKAGE_SIZE,
+    HOUR_FLAGS: HOUR_FLAGS,
+    packHour: packHour,
+    unpackHour: unpackHour,
+    PRECIPITATION_PACKAGE_SIZE: PRECIPITATION_PACKAGE_SIZE,
+    packPrecipitation: packPrecipitation,
+    unpackPrecipitation: unpackPrecipitation,
+    PRECIPITATION_MINUTES_PACKAGE_SIZE: PRECIPITATION_MINUTES_PACKAGE_SIZE,
+    packPrecipitationMinutes: packPrecipitationMinutes,
+    unpackPrecipitationMinutes: unpackPrecipitationMinutes
+};
@@ -0,0 +1,412 @@
+#!/usr/bin/env python3
+"""
+Generate the wire format code from app/schema/wire_format.json.
+
+Writes, relative to the app directory:
+
+  src/c/utils/wire_format.auto.h            C accessors, straight-line shifts
+  src/pkjs/wire_format.auto.js              JS packers and unpackers
+  host/conformance/wire_format_fields.auto.h  field table for the round-trip test
+
+Run from anywhere: python3 tools/gen_wire_format.py [--check] [app dir].
+Only files whose contents change are written. The outputs are checked in
+so the JS bundle and editors see them too: run it after changing the
+schema and commit what it writes. The host Makefile runs it when the
+schema changes; the watch build (wscript) only checks, and stops if an
+output is out of date, so a build never rewrites them. With --check
+nothing is written and the exit status is 1 if a file would change.
+"""
+
+import json
+import os
+import sys
+
+HEADER = "Generated by app/tools/gen_wire_format.py from app/schema/wire_format.json, do not edit"
+
+
+def camel(name):
+    parts = name.split("_")
+    return parts[0] + "".join(p[:1].upper() + p[1:] for p in parts[1:])
+
+
+def field_range(field):
+    bits = field["bits"]
+    if field.get("signed"):
+        return -(1 << (bits - 1)), (1 << (bits - 1)) - 1
+    return 0, (1 << bits) - 1
+
+
+def layout(record):
+    """Assigns byte/shift positions; returns (fields, size in bytes)."""
+    bit = 0
+    fields = []
+    for field in record["fields"]:
+        bits = field["bits"]
+        count = field.get("count", 1)
+        if field.get("signed") and bits != 8:
+            raise ValueError("{}: only 8-bit fields can be signed".format(field["name"]))
+        if 8 % bits != 0 and bits != 8:
+            raise ValueError("{}: field widths must divide a byte".format(field["name"]))
+        slots = []
+        for k in range(count):
+            byte, within = divmod(bit, 8)
+            if within + bits > 8:
+                raise ValueError("{}: field straddles a byte".format(field["name"]))
+            if field.get("order") == "lsb":
+                shift = within
+            else:
+                shift = 8 - within - bits
+            slots.append((byte, shift))
+            bit += bits
+        fields.append(dict(field, slots=slots, count=count))
+    return fields, (bit + 7) // 8
+
+
+def size_macro(record):
+    return "{}_PACKAGE_SIZE".format(record["name"].upper())
+
+
+# ── C ─────────────────────────────────────────────────────────────────────────
+
+def c_raw(byte_expr, field, shift):
+    mask = (1 << field["bits"]) - 1
+    if field["bits"] == 8:
+        return "(int8_t){}".format(byte_expr) if field.get("signed") else byte_expr
+    if shift == 0:
+        return "{} & 0x{:X}".format(byte_expr, mask)
+    return "({} >> {}) & 0x{:X}".format(byte_expr, shift, mask)
+
+
+def c_type(field):
+    if field.get("scale", 1) != 1 or field.get("offset", 0) != 0:
+        return "int"
+    return "int8_t" if field.get("signed") else "uint8_t"
+
+
+def c_decode(field, raw):
+    """Expression for the decoded value of one slot."""
+    value = raw
+    if field.get("scale", 1) != 1:
+        value = "({}) * {}".format(value, field["scale"])
+    if field.get("offset", 0) != 0:
+        value = "{} + {}".format(value, field["offset"])
+    if "wrap" in field:
+        value = "({}) % {}".format(value, field["wrap"])
+    return value
+
+
+def c_record(out, record):
+    fields, size = layout(record)
+    prefix = record["c_prefix"]
+    out.append("// {}".format(record["doc"]))
+    out.append("#define {} {}".format(size_macro(record), size))
+    out.append("")
+
+    for field in fields:
+        if "c_const" in field:
+            out.append("#define {} {}".format(field["c_const"], field["const"]))
+            out.append("")
+        for flag, value in field.get("flags", {}).items():
+            out.append("#define {}FLAG_{} 0x{:X}".format(prefix.upper(), flag, value))
+        if field.get("flags"):
+            out.append("")
+        if "c_codes" in field:
+            out.append("#if ({}) != {}".format(field["c_codes"], field["codes"]))
+            out.append("#error \"{}{}: schema has {} codes, {} disagrees\"".format(
+                prefix, field["name"], field["codes"], field["c_codes"]))
+            out.append("#endif")
+        if "c_fallback" in field:
+            out.append("#if ({}) != {}".format(field["c_fallback"], field["fallback"]))
+            out.append("#error \"{}{}: schema falls back to {}, {} disagrees\"".format(
+                prefix, field["name"], field["fallback"], field["c_fallback"]))
+            out.append("#endif")
+        if "c_count" in field:
+            out.append("#if ({}) != {}".format(field["c_count"], field["count"]))
+            out.append("#error \"{}{}: schema has {} values, {} disagrees\"".format(
+                prefix, field["name"], field["count"], field["c_count"]))
+            out.append("#endif")
+    out.append("")
+
+    if record["indexed"]:
+        out.append("static inline const uint8_t* {}package(const uint8_t* pkg, uint8_t i) {{".format(prefix))
+        out.append("    return &pkg[i * {}];".format(size_macro(record)))
+        out.append("}")
+        out.append("")
+        params = "const uint8_t* pkg, uint8_t i"
+        base = "{}package(pkg, i)".format(prefix)
+    else:
+        params = "const uint8_t* pkg"
+        base = "pkg"
+
+    for field in fields:
+        name = prefix + field["name"]
+        ctype = c_type(field)
+        out.append("// {}".format(field["doc"]))
+        if field["count"] == 1:
+            byte, shift = field["slots"][0]
+            raw = c_raw("{}[{}]".format(base, byte), field, shift)
+            out.append("static inline {} {}({}) {{".format(ctype, name, params))
+            if "codes" in field:
+                codes = field.get("c_codes", field["codes"])
+                fallback = field.get("c_fallback", field["fallback"])
+                out.append("    {} value = {};".format(ctype, c_decode(field, raw)))
+                out.append("    return value < ({}) ? value : {};".format(codes, fallback))
+            else:
+                out.append("    return {};".format(c_decode(field, raw)))
+            out.append("}")
+        else:
+            # Indexed accessor, plus an unrolled unpack of the whole array
+            per_byte = 8 // field["bits"]
+            first_byte = field["slots"][0][0]
+            mask = (1 << field["bits"]) - 1
+            if field.get("order") == "lsb":
+                shift = "(n % {}) * {}".format(per_byte, field["bits"])
+            else:
+                shift = "{} - (n % {}) * {}".format(8 - field["bits"], per_byte, field["bits"])
+            out.append("static inline {} {}({}, uint8_t n) {{".format(ctype, name, params))
+            out.append("    return ({}[{} + n / {}] >> ({})) & 0x{:X};".format(
+                base, first_byte, per_byte, shift, mask))
+            out.append("}")
+            out.append("")
+            out.append("static inline void {}_all({}, {} out[{}]) {{".format(
+                name, params, ctype, field["count"]))
+            for k, (byte, slot_shift) in enumerate(field["slots"]):
+                raw = c_raw("{}[{}]".format(base, byte), field, slot_shift)
+                out.append("    out[{}] = {};".format(k, c_decode(field, raw)))
+            out.append("}")
+        out.append("")
+
+
+def gen_c(schema):
+    out = [
+        "/*",
+        "    Wire Format",
+        "",
+        "    " + HEADER + ".",
+        "    Each accessor reads one field straight out of a packed buffer.",
+        "*/",
+        "",
+        "#pragma once",
+        "",
+        "#include <pebble.h>",
+        "#include \"weather.h\"",
+        "",
+    ]
+    for record in schema["records"]:
+        c_record(out, record)
+    return "\n".join(out).rstrip("\n") + "\n"
+
+
+# ── JS ────────────────────────────────────────────────────────────────────────
+
+def js_encode(field, value):
+    lo, hi = field_range(field)
+    expr = value
+    if field.get("offset", 0) != 0:
+        expr = "{} - {}".format(expr, field["offset"])
+    if field.get("scale", 1) != 1:
+        expr = "({}) / {}".format(expr, field["scale"])
+    expr = "clamp(Math.round({}), {}, {})".format(expr, lo, hi)
+    if field.get("signed"):
+        expr = "({}) & 0xFF".format(expr)
+    return expr
+
+
+def js_decode(field, byte_expr, shift):
+    mask = (1 << field["bits"]) - 1
+    if field["bits"] == 8:
+        raw = "({} << 24) >> 24".format(byte_expr) if field.get("signed") else byte_expr
+    elif shift == 0:
+        raw = "{} & 0x{:X}".format(byte_expr, mask)
+    else:
+        raw = "({} >> {}) & 0x{:X}".format(byte_expr, shift, mask)
+    value = raw
+    if field.get("scale", 1) != 1:
+        value = "({}) * {}".format(value, field["scale"])
+    if field.get("offset", 0) != 0:
+        value = "({}) + {}".format(value, field["offset"])
+    if "wrap" in field:
+        value = "({}) % {}".format(value, field["wrap"])
+    if "codes" in field:
+        value = "code({}, {}, {})".format(value, field["codes"], field["fallback"])
+    return value
+
+
+def js_record(out, exports, record):
+    fields, size = layout(record)
+    name = record["js_name"]
+    size_name = size_macro(record)
+    out.append("var {} = {};".format(size_name, size))
+    exports.append(size_name)
+    for field in fields:
+        if field.get("flags"):
+            flags_name = "{}_FLAGS".format(record["name"].upper())
+            out.append("var {} = {{".format(flags_name))
+            items = list(field["flags"].items())
+            for i, (flag, value) in enumerate(items):
+                out.append("    {}: 0x{:X}{}".format(flag, value, "," if i + 1 < len(items) else ""))
+            out.append("};")
+            exports.append(flags_name)
+    out.append("")
+
+    # Packer: one statement per byte, fields OR-ed into place
+    out.append("/**")
+    out.append(" * {}".format(record["doc"]))
+    out.append(" * Packs decoded values into {} bytes, rounding and clamping each field:".format(size_name))
+    for field in fields:
+        if "const" in field:
+            continue
+        suffix = "[{}]".format(field["count"]) if field["count"] > 1 else ""
+        out.append(" *   {:<18} {}".format(camel(field["name"]) + suffix, field["doc"]))
+    out.append(" */")
+    out.append("function pack{}(fields) {{".format(name))
+    parts = [[] for _ in range(size)]
+    for field in fields:
+        key = "fields." + camel(field["name"])
+        for k, (byte, shift) in enumerate(field["slots"]):
+            value = key if field["count"] == 1 else "({}[{}] || 0)".format(key, k)
+            encoded = str(field["const"]) if "const" in field else js_encode(field, value)
+            parts[byte].append(encoded if shift == 0 else "({}) << {}".format(encoded, shift))
+    out.append("    return [")
+    for byte, byte_parts in enumerate(parts):
+        joiner = " |\n        "
+        out.append("        {}{}".format(joiner.join(byte_parts) if byte_parts else "0",
+                                        "," if byte + 1 < size else ""))
+    out.append("    ];")
+    out.append("}")
+    out.append("")
+
+    out.append("// Decodes a package starting at bytes[offset]")
+    out.append("function unpack{}(bytes, offset) {{".format(name))
+    out.append("    var o = offset || 0;")
+    out.append("    return {")
+    for i, field in enumerate(fields):
+        comma = "," if i + 1 < len(fields) else ""
+        if field["count"] == 1:
+            byte, shift = field["slots"][0]
+            out.append("        {}: {}{}".format(camel(field["name"]),
+                                                js_decode(field, "bytes[o + {}]".format(byte), shift), comma))
+        else:
+            values = [js_decode(field, "bytes[o + {}]".format(byte), shift) for byte, shift in field["slots"]]
+            out.append("        {}: [".format(camel(field["name"])))
+            for k, value in enumerate(values):
+                out.append("            {}{}".format(value, "," if k + 1 < len(values) else ""))
+            out.append("        ]{}".format(comma))
+    out.append("    };")
+    out.append("}")
+    out.append("")
+    exports.extend(["pack" + name, "unpack" + name])
+
+
+def gen_js(schema):
+    out = [
+        "// " + HEADER,
+        "",
+        "function clamp(value, lo, hi) {",
+        "    return Math.max(lo, Math.min(hi, value));",
+        "}",
+        "",
+        "function code(value, codes, fallback) {",
+        "    return value < codes ? value : fallback;",
+        "}",
+        "",
+    ]
+    exports = []
+    for record in schema["records"]:
+        js_record(out, exports, record)
+    out.append("module.exports = {")
+    for i, name in enumerate(exports):
+        out.append("    {}: {}{}".format(name, name, "," if i + 1 < len(exports) else ""))
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+# ── Host conformance table ────────────────────────────────────────────────────
+
+def gen_fields(schema):
+    out = [
+        "// " + HEADER,
+        "",
+        "#pragma once",
+        "",
+        "#include \"utils/wire_format.auto.h\"",
+        "",
+        "typedef struct WireField {",
+        "  const char* record;",
+        "  const char* name;",
+        "  uint8_t count;",
+        "  int (*get)(const uint8_t* pkg, uint8_t n);",
+        "} WireField;",
+        "",
+    ]
+    table = []
+    for record in schema["records"]:
+        fields, _ = layout(record)
+        prefix = record["c_prefix"]
+        args = "pkg, 0" if record["indexed"] else "pkg"
+        for field in fields:
+            name = prefix + field["name"]
+            if field["count"] == 1:
+                out.append("static int prv_{}(const uint8_t* pkg, uint8_t n) {{".format(name))
+                out.append("  return {}({});".format(name, args))
+                out.append("}")
+                table.append((record["name"], field["name"], 1, "prv_" + name))
+            else:
+                out.append("static int prv_{}(const uint8_t* pkg, uint8_t n) {{".format(name))
+                out.append("  return {}({}, n);".format(name, args))
+                out.append("}")
+                out.append("")
+                out.append("static int prv_{}_all(const uint8_t* pkg, uint8_t n) {{".format(name))
+                out.append("  uint8_t values[{}];".format(field["count"]))
+                out.append("  {}_all({}, values);".format(name, args))
+                out.append("  return values[n];")
+                out.append("}")
+                table.append((record["name"], field["name"], field["count"], "prv_" + name))
+                table.append((record["name"], field["name"], field["count"], "prv_{}_all".format(name)))
+            out.append("")
+    out.append("static const WireField s_wire_fields[] = {")
+    for record, name, count, getter in table:
+        out.append("  {{\"{}\", \"{}\", {}, {}}},".format(record, name, count, getter))
+    out.append("};")
+    return "\n".join(out) + "\n"
+
+
+def generate(app_dir, write=True):
+    """Returns the outputs that differ from what is on disk, writing them unless `write` is False."""
+    with open(os.path.join(app_dir, "schema", "wire_format.json")) as f:
+        schema = json.load(f)
+    outputs = {
+        os.path.join("src", "c", "utils", "wire_format.auto.h"): gen_c(schema),
+        os.path.join("src", "pkjs", "wire_format.auto.js"): gen_js(schema),
+        os.path.join("host", "conformance", "wire_format_fields.auto.h"): gen_fields(schema),
+    }
+    stale = []
+    for path, text in outputs.items():
+        full = os.path.join(app_dir, path)
+        try:
+            with open(full) as f:
+                if f.read() == text:
+                    continue
+        except FileNotFoundError:
+            pass
+        stale.append(full)
+        if write:
+            os.makedirs(os.path.dirname(full), exist_ok=True)
+            with open(full, "w") as f:
+                f.write(text)
+    return stale
+
+
+def main():
+    args = sys.argv[1:]
+    check = "--check" in args
+    args = [a for a in args if a != "--check"]
+    app_dir = args[0] if args else os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    stale = generate(os.path.abspath(app_dir), write=not check)
+    for path in stale:
+        print(("out of date: " if check else "wrote: ") + path)
+    return 1 if check and stale else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())